@@ -0,0 +1,329 @@
+/***************************************************************************//**
+* \file cy_qistack_auth_cache.c
+* \version 2.0
+*
+* Source file of the certificate chain cache of the QiStack middleware. The
+* chain and digest of each slot are read from the secure element once and
+* GET_DIGEST and GET_CERTIFICATE are then answered from RAM. A flash copy,
+* checked against its stored hash, saves that read at boot.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_debug_monitor.h"
+#include "cy_qistack_auth_optiga.h"
+
+#if CY_QI_AUTH_CACHE_EN
+
+/* Record bytes hashed per get_sha256_data call, after the running hash. */
+#define AUTH_CACHE_HASH_CHUNK               (96u)
+
+typedef struct
+{
+    uint8_t digest[WPC_CERTIFICATE_CHAIN_DIGEST_LENGTH];
+    uint8_t chain[WPC_CERTIFICATE_CHAIN_LENGTH];
+    uint16_t len;
+    bool valid;
+} cy_stc_qi_auth_cache_slot_t;
+
+/* The chain belongs to the device, so every coil shares the cache. */
+static cy_stc_qi_auth_cache_slot_t gl_authCache[CY_QI_AUTH_CACHE_SLOTS];
+static cy_stc_qi_auth_cache_stats_t gl_authCacheStats;
+static uint32_t gl_authReqStart;
+static uint8_t gl_authReq;
+static bool gl_authReqBusy;
+#if CY_QI_AUTH_REQ_HIST_EN
+static cy_stc_qi_auth_req_hist_t gl_authReqHist[CY_QI_AUTH_REQ_HIST_MAX];
+#endif /* CY_QI_AUTH_REQ_HIST_EN */
+
+static uint32_t auth_cache_timestamp(cy_stc_qi_context_t *qiCtx)
+{
+    uint32_t (*get_timestamp)(struct cy_stc_qi_context *qiCtx) = qiCtx->ptrAppCbk->get_timestamp;
+
+    return (get_timestamp != NULL) ? get_timestamp(qiCtx) : 0u;
+}
+
+static void auth_cache_store(uint8_t slot, const uint8_t *digest, const uint8_t *chain, uint16_t len)
+{
+    cy_stc_qi_auth_cache_slot_t *entry = &gl_authCache[slot];
+
+    (void)memcpy(entry->digest, digest, WPC_CERTIFICATE_CHAIN_DIGEST_LENGTH);
+    (void)memcpy(entry->chain, chain, len);
+    entry->len = len;
+    entry->valid = true;
+}
+
+cy_en_qi_status_t Cy_QiStack_Auth_Cache_Fill(uint8_t slot, const uint8_t *digest, const uint8_t *chain, uint16_t len)
+{
+    if ((slot >= CY_QI_AUTH_CACHE_SLOTS) || (digest == NULL) || (chain == NULL) ||
+            (len == 0u) || (len > WPC_CERTIFICATE_CHAIN_LENGTH))
+    {
+        return CY_QISTACK_STAT_BAD_PARAM;
+    }
+
+    auth_cache_store(slot, digest, chain, len);
+    gl_authCacheStats.fillCnt++;
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+void Cy_QiStack_Auth_Cache_Invalidate(uint8_t slot)
+{
+    if (slot < CY_QI_AUTH_CACHE_SLOTS)
+    {
+        gl_authCache[slot].valid = false;
+    }
+}
+
+const uint8_t *Cy_QiStack_Auth_Cache_Digest(uint8_t slot)
+{
+    if ((slot >= CY_QI_AUTH_CACHE_SLOTS) || (!gl_authCache[slot].valid))
+    {
+        gl_authCacheStats.missCnt++;
+        return NULL;
+    }
+
+    gl_authCacheStats.hitCnt++;
+    return gl_authCache[slot].digest;
+}
+
+const uint8_t *Cy_QiStack_Auth_Cache_Cert(uint8_t slot, uint16_t offset, uint16_t *len)
+{
+    const cy_stc_qi_auth_cache_slot_t *entry;
+
+    if ((slot >= CY_QI_AUTH_CACHE_SLOTS) || (len == NULL) ||
+            (!gl_authCache[slot].valid) || (offset >= gl_authCache[slot].len))
+    {
+        gl_authCacheStats.missCnt++;
+        return NULL;
+    }
+
+    entry = &gl_authCache[slot];
+    *len = GET_MIN(*len, (uint16_t)(entry->len - offset));
+    gl_authCacheStats.hitCnt++;
+
+    return &entry->chain[offset];
+}
+
+#if CY_QI_AUTH_CACHE_FLASH_EN
+/*
+ * get_sha256_data takes at most 255 bytes, so the record is hashed in chunks,
+ * each one together with the hash of the chunks before it.
+ */
+static bool auth_cache_hash(cy_stc_qi_context_t *qiCtx, const cy_stc_qi_auth_cache_rec_t *rec, uint8_t *hash)
+{
+    void (*get_sha256_data)(struct cy_stc_qi_context *qiCtx, uint8_t *in_buf, uint8_t buf_size,
+            uint8_t *out_buf) = qiCtx->ptrAppCbk->get_sha256_data;
+    uint8_t buf[AUTH_CACHE_HASH_LENGTH + AUTH_CACHE_HASH_CHUNK];
+    const uint8_t *data = (const uint8_t *)rec;
+    uint16_t total = (uint16_t)offsetof(cy_stc_qi_auth_cache_rec_t, hash);
+    uint16_t off;
+    uint8_t size;
+
+    if (get_sha256_data == NULL)
+    {
+        return false;
+    }
+
+    (void)memset(hash, 0, AUTH_CACHE_HASH_LENGTH);
+    for (off = 0u; off < total; off += size)
+    {
+        size = (uint8_t)GET_MIN((uint16_t)(total - off), AUTH_CACHE_HASH_CHUNK);
+        (void)memcpy(buf, hash, AUTH_CACHE_HASH_LENGTH);
+        (void)memcpy(&buf[AUTH_CACHE_HASH_LENGTH], &data[off], size);
+        get_sha256_data(qiCtx, buf, (uint8_t)(AUTH_CACHE_HASH_LENGTH + size), hash);
+    }
+
+    return true;
+}
+
+cy_en_qi_status_t Cy_QiStack_Auth_Cache_Save(cy_stc_qi_context_t *qiCtx, uint8_t slot, cy_stc_qi_auth_cache_rec_t *rec)
+{
+    const cy_stc_qi_auth_cache_slot_t *entry;
+
+    if ((slot >= CY_QI_AUTH_CACHE_SLOTS) || (rec == NULL))
+    {
+        return CY_QISTACK_STAT_BAD_PARAM;
+    }
+
+    entry = &gl_authCache[slot];
+    if (!entry->valid)
+    {
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    (void)memset(rec, 0, sizeof(cy_stc_qi_auth_cache_rec_t));
+    rec->magic = AUTH_CACHE_REC_MAGIC;
+    rec->len = entry->len;
+    rec->slot = slot;
+    (void)memcpy(rec->digest, entry->digest, WPC_CERTIFICATE_CHAIN_DIGEST_LENGTH);
+    (void)memcpy(rec->chain, entry->chain, entry->len);
+
+    return auth_cache_hash(qiCtx, rec, rec->hash) ? CY_QISTACK_STAT_SUCCESS : CY_QISTACK_STAT_FAILURE;
+}
+
+cy_en_qi_status_t Cy_QiStack_Auth_Cache_Load(cy_stc_qi_context_t *qiCtx, const cy_stc_qi_auth_cache_rec_t *rec)
+{
+    uint8_t hash[AUTH_CACHE_HASH_LENGTH];
+
+    if (rec == NULL)
+    {
+        return CY_QISTACK_STAT_BAD_PARAM;
+    }
+
+    /* A blank or foreign record is not counted as a verify error. */
+    if ((rec->magic != AUTH_CACHE_REC_MAGIC) || (rec->slot >= CY_QI_AUTH_CACHE_SLOTS) ||
+            (rec->len == 0u) || (rec->len > WPC_CERTIFICATE_CHAIN_LENGTH))
+    {
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    if (!auth_cache_hash(qiCtx, rec, hash))
+    {
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    if (memcmp(hash, rec->hash, AUTH_CACHE_HASH_LENGTH) != 0)
+    {
+        gl_authCacheStats.verifyErrCnt++;
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    auth_cache_store(rec->slot, rec->digest, rec->chain, rec->len);
+    gl_authCacheStats.loadCnt++;
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+#endif /* CY_QI_AUTH_CACHE_FLASH_EN */
+
+#if CY_QI_AUTH_REQ_HIST_EN
+static uint8_t auth_req_hist_index(uint8_t request)
+{
+    cy_en_qi_auth_req_hist_t idx;
+
+    switch (request)
+    {
+        case GET_DIGEST:
+            idx = CY_QI_AUTH_REQ_HIST_DIGEST;
+            break;
+        case GET_CERTIFICATE:
+            idx = CY_QI_AUTH_REQ_HIST_CERTIFICATE;
+            break;
+        case CHALLENGE:
+            idx = CY_QI_AUTH_REQ_HIST_CHALLENGE;
+            break;
+        default:
+            idx = CY_QI_AUTH_REQ_HIST_MAX;
+            break;
+    }
+
+    return (uint8_t)idx;
+}
+
+static void auth_req_hist_record(uint8_t request, uint32_t time)
+{
+    uint8_t idx = auth_req_hist_index(request);
+    cy_stc_qi_auth_req_hist_t *rec;
+
+    if (idx == (uint8_t)CY_QI_AUTH_REQ_HIST_MAX)
+    {
+        return;
+    }
+
+    rec = &gl_authReqHist[idx];
+    rec->cnt++;
+    if (time > rec->max)
+    {
+        rec->max = time;
+    }
+
+    cy_log2_hist_add(rec->hist, time);
+}
+#endif /* CY_QI_AUTH_REQ_HIST_EN */
+
+void Cy_QiStack_Auth_Cache_Req_Start(cy_stc_qi_context_t *qiCtx, uint8_t request)
+{
+#if CY_QI_AUTH_REQ_HIST_EN
+    uint8_t idx = auth_req_hist_index(request);
+#endif /* CY_QI_AUTH_REQ_HIST_EN */
+
+    if ((gl_authReqBusy) && (request == gl_authReq))
+    {
+#if CY_QI_AUTH_REQ_HIST_EN
+        if (idx != (uint8_t)CY_QI_AUTH_REQ_HIST_MAX)
+        {
+            gl_authReqHist[idx].retryCnt++;
+        }
+#endif /* CY_QI_AUTH_REQ_HIST_EN */
+        return;
+    }
+
+    gl_authReq = request;
+    gl_authReqBusy = true;
+    gl_authReqStart = auth_cache_timestamp(qiCtx);
+}
+
+void Cy_QiStack_Auth_Cache_Req_Done(cy_stc_qi_context_t *qiCtx, bool cached)
+{
+    cy_stc_qi_auth_cache_stats_t *stats = &gl_authCacheStats;
+    uint32_t time = auth_cache_timestamp(qiCtx) - gl_authReqStart;
+    uint8_t idx = cached ? 1u : 0u;
+
+    if (!gl_authReqBusy)
+    {
+        return;
+    }
+
+    gl_authReqBusy = false;
+#if CY_QI_AUTH_REQ_HIST_EN
+    auth_req_hist_record(gl_authReq, time);
+#endif /* CY_QI_AUTH_REQ_HIST_EN */
+
+    stats->reqCnt[idx]++;
+    stats->latSum[idx] += time;
+    if (time > stats->latMax[idx])
+    {
+        stats->latMax[idx] = time;
+    }
+}
+
+#if (CCG_HPI_WLC_CMD_ENABLE != 0)
+void Cy_QiStack_Get_Auth_Cache_Stats(cy_stc_qi_context_t *qiCtx, uint8_t *buffer)
+{
+    (void)qiCtx;
+    (void)memcpy(buffer, &gl_authCacheStats, sizeof(cy_stc_qi_auth_cache_stats_t));
+}
+
+void Cy_QiStack_Clear_Auth_Cache_Stats(cy_stc_qi_context_t *qiCtx)
+{
+    (void)qiCtx;
+    (void)memset(&gl_authCacheStats, 0, sizeof(cy_stc_qi_auth_cache_stats_t));
+}
+
+#if CY_QI_AUTH_REQ_HIST_EN
+void Cy_QiStack_Get_Auth_Req_Hist(cy_stc_qi_context_t *qiCtx, uint8_t *buffer)
+{
+    (void)qiCtx;
+    (void)memcpy(buffer, gl_authReqHist, sizeof(gl_authReqHist));
+}
+
+void Cy_QiStack_Clear_Auth_Req_Hist(cy_stc_qi_context_t *qiCtx)
+{
+    (void)qiCtx;
+    (void)memset(gl_authReqHist, 0, sizeof(gl_authReqHist));
+}
+#endif /* CY_QI_AUTH_REQ_HIST_EN */
+#endif /* CCG_HPI_WLC_CMD_ENABLE */
+
+#endif /* CY_QI_AUTH_CACHE_EN */
+
+/* [] END OF FILE */
@@ -73,6 +73,272 @@ uint16_t populate_cert_chain_data();
  * @param error_data
  */
 void Cy_QiStack_Transmit_Auth_Error(cy_stc_qi_context_t* qiCtx, uint8_t error_code, uint8_t error_data);
+
+#if CY_QI_AUTH_CACHE_EN
+/* Length of the get_sha256_data output. */
+#define AUTH_CACHE_HASH_LENGTH              (32u)
+/* Marks a valid flash copy: "QCRT". */
+#define AUTH_CACHE_REC_MAGIC                (0x54524351u)
+
+/**
+ * @brief Certificate cache counters. Request latency is from the request
+ * packet to the response being ready, in get_timestamp units, split by
+ * whether the cache answered it.
+ */
+typedef struct
+{
+    uint32_t fillCnt;                       /**< Slots filled from the secure element */
+    uint32_t loadCnt;                       /**< Slots restored from a verified flash copy */
+    uint32_t verifyErrCnt;                  /**< Flash copies rejected */
+    uint32_t hitCnt;                        /**< Digest and certificate reads served */
+    uint32_t missCnt;                       /**< Reads of an empty slot or out of range */
+    uint32_t reqCnt[2];                     /**< Requests, uncached then cached */
+    uint32_t latSum[2];                     /**< Sum of request latencies, uncached then cached */
+    uint32_t latMax[2];                     /**< Longest request latency, uncached then cached */
+} cy_stc_qi_auth_cache_stats_t;
+
+#if CY_QI_AUTH_REQ_HIST_EN
+/**
+ * Request latency histogram bins, counted by cy_log2_hist_add. Bin 0 counts
+ * responses within one get_timestamp unit, bin n latencies from 2^(n-1) to
+ * 2^n - 1 units.
+ */
+#define AUTH_REQ_HIST_BINS                  (CY_QI_LOG2_HIST_BINS)
+
+/**
+ * @brief Authentication requests with a latency histogram.
+ */
+typedef enum
+{
+    CY_QI_AUTH_REQ_HIST_DIGEST = 0,         /**< GET_DIGEST */
+    CY_QI_AUTH_REQ_HIST_CERTIFICATE,        /**< GET_CERTIFICATE */
+    CY_QI_AUTH_REQ_HIST_CHALLENGE,          /**< CHALLENGE */
+    CY_QI_AUTH_REQ_HIST_MAX                 /**< Number of histograms */
+} cy_en_qi_auth_req_hist_t;
+
+/**
+ * @brief Latency distribution of one authentication request. A repeated
+ * request counts as a retry and its latency runs from the first one.
+ */
+typedef struct
+{
+    uint16_t hist[AUTH_REQ_HIST_BINS];      /**< log2 latency histogram */
+    uint32_t cnt;                           /**< Responses */
+    uint32_t retryCnt;                      /**< Requests repeated before the response */
+    uint32_t max;                           /**< Longest latency */
+} cy_stc_qi_auth_req_hist_t;
+#endif /* CY_QI_AUTH_REQ_HIST_EN */
+
+#if CY_QI_AUTH_CACHE_FLASH_EN
+/**
+ * @brief Flash copy of one cache slot. The hash covers every field before it.
+ */
+typedef struct
+{
+    uint32_t magic;                                         /**< AUTH_CACHE_REC_MAGIC */
+    uint16_t len;                                           /**< Certificate chain length */
+    uint8_t slot;                                           /**< Certificate slot */
+    uint8_t rsvd;                                           /**< Zero */
+    uint8_t digest[WPC_CERTIFICATE_CHAIN_DIGEST_LENGTH];    /**< Certificate chain digest */
+    uint8_t chain[WPC_CERTIFICATE_CHAIN_LENGTH];            /**< Certificate chain */
+    uint8_t hash[AUTH_CACHE_HASH_LENGTH];                   /**< Chained get_sha256_data hash */
+} cy_stc_qi_auth_cache_rec_t;
+#endif /* CY_QI_AUTH_CACHE_FLASH_EN */
+
+/**
+ * @brief Stores the certificate chain and digest of a slot, as read once from
+ * the secure element.
+ *
+ * @param slot Certificate slot, below CY_QI_AUTH_CACHE_SLOTS
+ * @param digest WPC_CERTIFICATE_CHAIN_DIGEST_LENGTH bytes
+ * @param chain Certificate chain
+ * @param len Certificate chain length, up to WPC_CERTIFICATE_CHAIN_LENGTH
+ * @return CY_QISTACK_STAT_BAD_PARAM on an invalid slot or length
+ */
+cy_en_qi_status_t Cy_QiStack_Auth_Cache_Fill(uint8_t slot, const uint8_t* digest, const uint8_t* chain, uint16_t len);
+
+/**
+ * @brief Drops a slot, e.g. after the secure element was provisioned again.
+ *
+ * @param slot Certificate slot
+ */
+void Cy_QiStack_Auth_Cache_Invalidate(uint8_t slot);
+
+/**
+ * @brief GET_DIGEST answer from the cache.
+ *
+ * @param slot Certificate slot
+ * @return Cached digest, or NULL when the slot is empty
+ */
+const uint8_t* Cy_QiStack_Auth_Cache_Digest(uint8_t slot);
+
+/**
+ * @brief GET_CERTIFICATE answer from the cache. The returned bytes stay valid
+ * until the slot is filled or invalidated again, so they can be streamed by
+ * reference.
+ *
+ * @param slot Certificate slot
+ * @param offset Offset into the certificate chain
+ * @param len Requested length in, length available from offset out
+ * @return Cached chain at offset, or NULL when the slot is empty or offset is past the end
+ */
+const uint8_t* Cy_QiStack_Auth_Cache_Cert(uint8_t slot, uint16_t offset, uint16_t* len);
+
+#if CY_QI_AUTH_CACHE_FLASH_EN
+/**
+ * @brief Builds the flash copy of a slot, for the application to program.
+ *
+ * @param qiCtx
+ * @param slot Certificate slot
+ * @param rec Record to fill
+ * @return CY_QISTACK_STAT_FAILURE when the slot is empty or get_sha256_data is not set
+ */
+cy_en_qi_status_t Cy_QiStack_Auth_Cache_Save(cy_stc_qi_context_t* qiCtx, uint8_t slot, cy_stc_qi_auth_cache_rec_t* rec);
+
+/**
+ * @brief Restores a slot from its flash copy once the hash matches.
+ *
+ * @param qiCtx
+ * @param rec Record as read from flash
+ * @return CY_QISTACK_STAT_FAILURE when the record is blank, corrupt or get_sha256_data is not set
+ */
+cy_en_qi_status_t Cy_QiStack_Auth_Cache_Load(cy_stc_qi_context_t* qiCtx, const cy_stc_qi_auth_cache_rec_t* rec);
+#endif /* CY_QI_AUTH_CACHE_FLASH_EN */
+
+/**
+ * @brief Marks the arrival of an authentication request. The same request
+ * again before its response is a retry and keeps the first arrival time.
+ *
+ * @param qiCtx
+ * @param request Request type, qi_authentication_request
+ */
+void Cy_QiStack_Auth_Cache_Req_Start(cy_stc_qi_context_t* qiCtx, uint8_t request);
+
+/**
+ * @brief Marks the response to the request as ready and records its latency.
+ *
+ * @param qiCtx
+ * @param cached The response came from the cache
+ */
+void Cy_QiStack_Auth_Cache_Req_Done(cy_stc_qi_context_t* qiCtx, bool cached);
+#endif /* CY_QI_AUTH_CACHE_EN */
+
+#if CY_QI_AUTH_WARM_EN
+/**
+ * @brief OPTIGA session states.
+ */
+typedef enum
+{
+    CY_QI_AUTH_SESSION_CLOSED = 0,          /**< Not opened yet, or opening failed */
+    CY_QI_AUTH_SESSION_OPENING,             /**< Open or restore in progress */
+    CY_QI_AUTH_SESSION_READY,               /**< Application open, signatures take the sign time only */
+    CY_QI_AUTH_SESSION_HIBERNATING,         /**< Close with hibernate in progress */
+    CY_QI_AUTH_SESSION_HIBERNATED           /**< Context saved, OPTIGA may be powered down */
+} cy_en_qi_auth_session_state_t;
+
+/**
+ * @brief Signature completion callback, raised from Cy_QiStack_Auth_Session_Task.
+ */
+typedef void (*cy_cb_auth_sign_done_t)(
+        cy_stc_qi_context_t* qiCtx,         /**< Qi context. */
+        bool success,                       /**< Signature and its length are valid. */
+        uint16_t sigLen);                   /**< Signature length. */
+
+/**
+ * @brief OPTIGA session counters, times in get_timestamp units.
+ * Time to first signature runs from Cy_QiStack_Auth_Session_Auth_Start to
+ * the first signature of that authentication.
+ */
+typedef struct
+{
+    uint32_t openCnt;                       /**< Clean application opens */
+    uint32_t restoreCnt;                    /**< Opens restoring a hibernate context */
+    uint32_t restoreErrCnt;                 /**< Restores refused, the context dropped and a clean open retried */
+    uint32_t hibernateCnt;                  /**< Application hibernates */
+    uint32_t errCnt;                        /**< Failed OPTIGA operations */
+    uint32_t openTime;                      /**< Duration of the last open or restore */
+    uint32_t signCnt;                       /**< Signatures completed */
+    uint32_t coldSignCnt;                   /**< Signatures that waited for the session to open */
+    uint32_t signTime;                      /**< Duration of the last signature */
+    uint32_t signTimeMax;                   /**< Longest signature, including any wait for the session */
+    uint32_t ttfs;                          /**< Last time to first signature */
+    uint32_t ttfsMax;                       /**< Longest time to first signature */
+} cy_stc_qi_auth_session_stats_t;
+
+/**
+ * @brief Creates the OPTIGA instances and starts opening the application,
+ * restoring the hibernate context when the datastore holds one. A refused
+ * restore clears the context and is retried once as a clean open. Call at
+ * boot.
+ *
+ * @param qiCtx
+ * @return CY_QISTACK_STAT_FAILURE when the instances cannot be created or the open cannot start
+ */
+cy_en_qi_status_t Cy_QiStack_Auth_Session_Init(cy_stc_qi_context_t* qiCtx);
+
+/**
+ * @brief Completes the OPTIGA operations finished since the last call and
+ * starts a signature waiting for the session. Call from the main loop.
+ *
+ * @param qiCtx
+ */
+void Cy_QiStack_Auth_Session_Task(cy_stc_qi_context_t* qiCtx);
+
+/**
+ * @brief Saves the application context to the datastore and closes the
+ * application, before the OPTIGA is powered down for deep sleep.
+ *
+ * @param qiCtx
+ * @return CY_QISTACK_STAT_FAILURE when the session is not idle and ready
+ */
+cy_en_qi_status_t Cy_QiStack_Auth_Session_Hibernate(cy_stc_qi_context_t* qiCtx);
+
+/**
+ * @brief Starts restoring a hibernated session, e.g. right on deep sleep wake.
+ *
+ * @param qiCtx
+ * @return CY_QISTACK_STAT_FAILURE when the session is not hibernated or closed
+ */
+cy_en_qi_status_t Cy_QiStack_Auth_Session_Restore(cy_stc_qi_context_t* qiCtx);
+
+/**
+ * @brief Deep sleep is allowed while no OPTIGA operation is in progress.
+ *
+ * @return true when no OPTIGA operation is in progress
+ */
+bool Cy_QiStack_Auth_Session_Is_Sleep_Allowed(void);
+
+/**
+ * @brief Current session state.
+ *
+ * @return Session state
+ */
+cy_en_qi_auth_session_state_t Cy_QiStack_Auth_Session_State(void);
+
+/**
+ * @brief Marks the start of an authentication, e.g. on entering
+ * CY_QI_ST_7_NEG_AUTH. A hibernated session is restored at once.
+ *
+ * @param qiCtx
+ */
+void Cy_QiStack_Auth_Session_Auth_Start(cy_stc_qi_context_t* qiCtx);
+
+/**
+ * @brief Signs the CHALLENGE digest with CY_QI_AUTH_SIGN_KEY_OID. The
+ * signature starts at once on a ready session, otherwise as soon as the
+ * session is open. The buffers must stay valid until the callback.
+ *
+ * @param qiCtx
+ * @param digest Digest to sign
+ * @param digestLen Digest length
+ * @param sig Signature buffer
+ * @param sigLen Signature buffer size
+ * @param cb Completion callback
+ * @return CY_QISTACK_STAT_FAILURE when a signature is already in progress
+ */
+cy_en_qi_status_t Cy_QiStack_Auth_Session_Sign(cy_stc_qi_context_t* qiCtx, const uint8_t* digest, uint8_t digestLen,
+        uint8_t* sig, uint16_t sigLen, cy_cb_auth_sign_done_t cb);
+#endif /* CY_QI_AUTH_WARM_EN */
 #endif // _STACK_AUTH_H_
 
 /* [] END OF FILE */
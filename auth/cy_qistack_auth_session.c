@@ -0,0 +1,445 @@
+/***************************************************************************//**
+* \file cy_qistack_auth_session.c
+* \version 2.0
+*
+* Source file of the warm OPTIGA session of the QiStack middleware. The
+* application on the secure element is opened at boot and kept open; for
+* deep sleep it is hibernated to the datastore and restored on wake. A
+* CHALLENGE then costs the ECDSA signature only.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_debug_monitor.h"
+#include "cy_qistack_auth_optiga.h"
+
+#if CY_QI_AUTH_WARM_EN
+
+#include "optiga_util.h"
+#include "optiga_crypt.h"
+#include "pal_os_datastore.h"
+
+typedef struct
+{
+    optiga_util_t *util;
+    optiga_crypt_t *crypt;
+    cy_en_qi_auth_session_state_t state;
+
+    /* Open, restore or hibernate in flight; the status is set by the OPTIGA callback. */
+    bool opBusy;
+    volatile optiga_lib_status_t opStatus;
+    bool restore;
+    uint32_t opStart;
+
+    /* Signature waiting for the session, or in flight. */
+    bool signPending;
+    bool signBusy;
+    volatile optiga_lib_status_t signStatus;
+    const uint8_t *digest;
+    uint8_t digestLen;
+    uint8_t *sig;
+    uint16_t sigLen;
+    cy_cb_auth_sign_done_t cb;
+    uint32_t signStart;
+    uint32_t signIssue;
+
+    /* Time to first signature of the current authentication. */
+    bool ttfsArmed;
+    uint32_t ttfsStart;
+
+    cy_stc_qi_auth_session_stats_t stats;
+} cy_stc_qi_auth_session_t;
+
+/* One secure element serves every coil. */
+static cy_stc_qi_auth_session_t gl_authSession;
+
+static uint32_t auth_session_timestamp(cy_stc_qi_context_t *qiCtx)
+{
+    uint32_t (*get_timestamp)(struct cy_stc_qi_context *qiCtx) = qiCtx->ptrAppCbk->get_timestamp;
+
+    return (get_timestamp != NULL) ? get_timestamp(qiCtx) : 0u;
+}
+
+static void auth_session_util_cbk(void *ctx, optiga_lib_status_t event)
+{
+    (void)ctx;
+    gl_authSession.opStatus = event;
+}
+
+static void auth_session_crypt_cbk(void *ctx, optiga_lib_status_t event)
+{
+    (void)ctx;
+    gl_authSession.signStatus = event;
+}
+
+/* A hibernate context is a non zero application context handle. */
+static bool auth_session_has_context(void)
+{
+    uint8_t handle[APP_CONTEXT_SIZE];
+    uint16_t len = APP_CONTEXT_SIZE;
+    uint8_t idx;
+
+    if ((pal_os_datastore_read(OPTIGA_HIBERNATE_CONTEXT_ID, handle, &len) != PAL_STATUS_SUCCESS) ||
+            (len != APP_CONTEXT_SIZE))
+    {
+        return false;
+    }
+
+    for (idx = 0u; idx < APP_CONTEXT_SIZE; idx++)
+    {
+        if (handle[idx] != 0u)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static cy_en_qi_status_t auth_session_start(cy_stc_qi_context_t *qiCtx, bool restore)
+{
+    cy_stc_qi_auth_session_t *ses = &gl_authSession;
+
+    ses->restore = restore;
+    ses->opStatus = OPTIGA_LIB_BUSY;
+    ses->opStart = auth_session_timestamp(qiCtx);
+
+    if (optiga_util_open_application(ses->util, restore ? TRUE : FALSE) != OPTIGA_LIB_SUCCESS)
+    {
+        ses->stats.errCnt++;
+        ses->state = CY_QI_AUTH_SESSION_CLOSED;
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    ses->opBusy = true;
+    ses->state = CY_QI_AUTH_SESSION_OPENING;
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+/*
+ * A refused restore, e.g. after the OPTIGA lost power, would be refused again
+ * with the same context: it is dropped and the open retried once clean.
+ */
+static cy_en_qi_status_t auth_session_open_clean(cy_stc_qi_context_t *qiCtx)
+{
+    uint8_t handle[APP_CONTEXT_SIZE];
+
+    gl_authSession.stats.restoreErrCnt++;
+    (void)memset(handle, 0, APP_CONTEXT_SIZE);
+    (void)pal_os_datastore_write(OPTIGA_HIBERNATE_CONTEXT_ID, handle, APP_CONTEXT_SIZE);
+
+    return auth_session_start(qiCtx, false);
+}
+
+static cy_en_qi_status_t auth_session_open(cy_stc_qi_context_t *qiCtx)
+{
+    if (!auth_session_has_context())
+    {
+        return auth_session_start(qiCtx, false);
+    }
+
+    if (auth_session_start(qiCtx, true) == CY_QISTACK_STAT_SUCCESS)
+    {
+        return CY_QISTACK_STAT_SUCCESS;
+    }
+
+    return auth_session_open_clean(qiCtx);
+}
+
+static void auth_session_sign_done(cy_stc_qi_context_t *qiCtx, bool success)
+{
+    cy_stc_qi_auth_session_t *ses = &gl_authSession;
+    cy_stc_qi_auth_session_stats_t *stats = &ses->stats;
+    uint32_t now = auth_session_timestamp(qiCtx);
+    uint32_t time = now - ses->signStart;
+
+    ses->signPending = false;
+    ses->signBusy = false;
+
+    if (success)
+    {
+        stats->signCnt++;
+        if (time > stats->signTimeMax)
+        {
+            stats->signTimeMax = time;
+        }
+        if (ses->ttfsArmed)
+        {
+            ses->ttfsArmed = false;
+            stats->ttfs = now - ses->ttfsStart;
+            if (stats->ttfs > stats->ttfsMax)
+            {
+                stats->ttfsMax = stats->ttfs;
+            }
+        }
+    }
+
+    if (ses->cb != NULL)
+    {
+        ses->cb(qiCtx, success, success ? ses->sigLen : 0u);
+    }
+}
+
+static void auth_session_sign_start(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_auth_session_t *ses = &gl_authSession;
+
+    ses->signPending = false;
+    ses->signStatus = OPTIGA_LIB_BUSY;
+    ses->signIssue = auth_session_timestamp(qiCtx);
+
+    if (optiga_crypt_ecdsa_sign(ses->crypt, ses->digest, ses->digestLen, (optiga_key_id_t)CY_QI_AUTH_SIGN_KEY_OID,
+            ses->sig, &ses->sigLen) != OPTIGA_LIB_SUCCESS)
+    {
+        ses->stats.errCnt++;
+        auth_session_sign_done(qiCtx, false);
+        return;
+    }
+
+    ses->signBusy = true;
+}
+
+/* Starts a waiting signature, opening the session for it first when needed. */
+static void auth_session_sign_service(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_auth_session_t *ses = &gl_authSession;
+
+    if ((!ses->signPending) || (ses->opBusy))
+    {
+        return;
+    }
+
+    if (ses->state == CY_QI_AUTH_SESSION_READY)
+    {
+        auth_session_sign_start(qiCtx);
+    }
+    else if (auth_session_open(qiCtx) != CY_QISTACK_STAT_SUCCESS)
+    {
+        auth_session_sign_done(qiCtx, false);
+    }
+    else
+    {
+        /* The signature starts once the open completes. */
+    }
+}
+
+cy_en_qi_status_t Cy_QiStack_Auth_Session_Init(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_auth_session_t *ses = &gl_authSession;
+
+    if (ses->util == NULL)
+    {
+        ses->util = optiga_util_create(OPTIGA_INSTANCE_ID_0, auth_session_util_cbk, NULL);
+        ses->crypt = optiga_crypt_create(OPTIGA_INSTANCE_ID_0, auth_session_crypt_cbk, NULL);
+        if ((ses->util == NULL) || (ses->crypt == NULL))
+        {
+            ses->stats.errCnt++;
+            return CY_QISTACK_STAT_FAILURE;
+        }
+    }
+
+    if (ses->state != CY_QI_AUTH_SESSION_CLOSED)
+    {
+        return CY_QISTACK_STAT_SUCCESS;
+    }
+
+    return auth_session_open(qiCtx);
+}
+
+void Cy_QiStack_Auth_Session_Task(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_auth_session_t *ses = &gl_authSession;
+    cy_stc_qi_auth_session_stats_t *stats = &ses->stats;
+    bool success;
+
+    if ((ses->opBusy) && (ses->opStatus != OPTIGA_LIB_BUSY))
+    {
+        ses->opBusy = false;
+        success = (ses->opStatus == OPTIGA_LIB_SUCCESS);
+
+        if (ses->state == CY_QI_AUTH_SESSION_OPENING)
+        {
+            if (success)
+            {
+                ses->state = CY_QI_AUTH_SESSION_READY;
+                stats->openTime = auth_session_timestamp(qiCtx) - ses->opStart;
+                if (ses->restore)
+                {
+                    stats->restoreCnt++;
+                }
+                else
+                {
+                    stats->openCnt++;
+                }
+            }
+            else
+            {
+                ses->state = CY_QI_AUTH_SESSION_CLOSED;
+                stats->errCnt++;
+                if ((ses->restore) && (auth_session_open_clean(qiCtx) == CY_QISTACK_STAT_SUCCESS))
+                {
+                    /* A waiting signature starts once the clean open completes. */
+                }
+                else if (ses->signPending)
+                {
+                    /* No other retry here, the PRx is waiting. */
+                    auth_session_sign_done(qiCtx, false);
+                }
+                else
+                {
+                    /* Reopened by the next Restore, Auth_Start or Sign. */
+                }
+            }
+        }
+        else if (ses->state == CY_QI_AUTH_SESSION_HIBERNATING)
+        {
+            /* A refused hibernate leaves the application open. */
+            if (success)
+            {
+                ses->state = CY_QI_AUTH_SESSION_HIBERNATED;
+                stats->hibernateCnt++;
+            }
+            else
+            {
+                ses->state = CY_QI_AUTH_SESSION_READY;
+                stats->errCnt++;
+            }
+        }
+        else
+        {
+            /* No other state has an operation in flight. */
+        }
+    }
+
+    if ((ses->signBusy) && (ses->signStatus != OPTIGA_LIB_BUSY))
+    {
+        success = (ses->signStatus == OPTIGA_LIB_SUCCESS);
+        stats->signTime = auth_session_timestamp(qiCtx) - ses->signIssue;
+        if (!success)
+        {
+            stats->errCnt++;
+        }
+        auth_session_sign_done(qiCtx, success);
+    }
+
+    auth_session_sign_service(qiCtx);
+}
+
+cy_en_qi_status_t Cy_QiStack_Auth_Session_Hibernate(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_auth_session_t *ses = &gl_authSession;
+
+    if ((ses->state != CY_QI_AUTH_SESSION_READY) || (ses->signPending) || (ses->signBusy))
+    {
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    ses->opStatus = OPTIGA_LIB_BUSY;
+    ses->opStart = auth_session_timestamp(qiCtx);
+
+    /* The OPTIGA library writes the context to OPTIGA_HIBERNATE_CONTEXT_ID. */
+    if (optiga_util_close_application(ses->util, TRUE) != OPTIGA_LIB_SUCCESS)
+    {
+        ses->stats.errCnt++;
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    ses->opBusy = true;
+    ses->state = CY_QI_AUTH_SESSION_HIBERNATING;
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+cy_en_qi_status_t Cy_QiStack_Auth_Session_Restore(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_auth_session_t *ses = &gl_authSession;
+
+    if ((ses->util == NULL) ||
+            ((ses->state != CY_QI_AUTH_SESSION_HIBERNATED) && (ses->state != CY_QI_AUTH_SESSION_CLOSED)))
+    {
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    return auth_session_open(qiCtx);
+}
+
+bool Cy_QiStack_Auth_Session_Is_Sleep_Allowed(void)
+{
+    return ((!gl_authSession.opBusy) && (!gl_authSession.signBusy) && (!gl_authSession.signPending));
+}
+
+cy_en_qi_auth_session_state_t Cy_QiStack_Auth_Session_State(void)
+{
+    return gl_authSession.state;
+}
+
+void Cy_QiStack_Auth_Session_Auth_Start(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_auth_session_t *ses = &gl_authSession;
+
+    ses->ttfsArmed = true;
+    ses->ttfsStart = auth_session_timestamp(qiCtx);
+
+    /* The digest and certificate exchange cover the restore. */
+    (void)Cy_QiStack_Auth_Session_Restore(qiCtx);
+}
+
+cy_en_qi_status_t Cy_QiStack_Auth_Session_Sign(cy_stc_qi_context_t *qiCtx, const uint8_t *digest, uint8_t digestLen,
+        uint8_t *sig, uint16_t sigLen, cy_cb_auth_sign_done_t cb)
+{
+    cy_stc_qi_auth_session_t *ses = &gl_authSession;
+
+    if ((digest == NULL) || (sig == NULL))
+    {
+        return CY_QISTACK_STAT_BAD_PARAM;
+    }
+
+    if ((ses->signPending) || (ses->signBusy) || (ses->util == NULL))
+    {
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    ses->digest = digest;
+    ses->digestLen = digestLen;
+    ses->sig = sig;
+    ses->sigLen = sigLen;
+    ses->cb = cb;
+    ses->signStart = auth_session_timestamp(qiCtx);
+    ses->signPending = true;
+
+    if (ses->state != CY_QI_AUTH_SESSION_READY)
+    {
+        /* Cold path: the signature waits for the open. */
+        ses->stats.coldSignCnt++;
+    }
+    auth_session_sign_service(qiCtx);
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+#if (CCG_HPI_WLC_CMD_ENABLE != 0)
+void Cy_QiStack_Get_Auth_Session_Stats(cy_stc_qi_context_t *qiCtx, uint8_t *buffer)
+{
+    (void)qiCtx;
+    (void)memcpy(buffer, &gl_authSession.stats, sizeof(cy_stc_qi_auth_session_stats_t));
+}
+
+void Cy_QiStack_Clear_Auth_Session_Stats(cy_stc_qi_context_t *qiCtx)
+{
+    (void)qiCtx;
+    (void)memset(&gl_authSession.stats, 0, sizeof(cy_stc_qi_auth_session_stats_t));
+}
+#endif /* CCG_HPI_WLC_CMD_ENABLE */
+
+#endif /* CY_QI_AUTH_WARM_EN */
+
+/* [] END OF FILE */
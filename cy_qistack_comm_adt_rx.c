@@ -0,0 +1,180 @@
+/***************************************************************************//**
+* \file cy_qistack_comm_adt_rx.c
+* \version 2.0
+*
+* Source file of the PRx data stream reassembly of the QiStack middleware. ADT
+* payload is written straight into an application registered buffer and one
+* completion callback reports the whole transfer.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_manager.h"
+#include "cy_qistack_debug_monitor.h"
+
+#if CY_QI_ADT_RX_EN
+
+/* ADT header: data size in the upper nibble, even or odd type in the lower one. */
+#define CY_QI_ADT_RX_HDR_SIZE(hdr)                  ((uint8_t)((hdr) >> 4u))
+#define CY_QI_ADT_RX_HDR_TYPE(hdr)                  ((uint8_t)((hdr) & 0x0Fu))
+
+static void adt_rx_complete(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_adt_rx_t *rx = &qiCtx->adtRx;
+    cy_en_qi_adt_rx_status_t status = CY_QI_ADT_RX_OK;
+
+    if (rx->overflow)
+    {
+        status = CY_QI_ADT_RX_OVERFLOW;
+    }
+    else if ((rx->expLen != 0u) && (rx->len != rx->expLen))
+    {
+        status = CY_QI_ADT_RX_INCOMPLETE;
+    }
+    else
+    {
+        /* All announced data received. */
+    }
+
+    rx->active = false;
+    rx->stats.xferCnt++;
+
+    if (rx->cb != NULL)
+    {
+        rx->cb(qiCtx, rx->buf, rx->len, status);
+    }
+}
+
+cy_en_qi_status_t Cy_QiStack_Adt_Rx_Register(cy_stc_qi_context_t *qiCtx, uint8_t *buf, uint16_t size,
+        cy_cb_adt_rx_done_t cb)
+{
+    cy_stc_qi_adt_rx_t *rx = &qiCtx->adtRx;
+
+    if ((buf == NULL) || (size == 0u))
+    {
+        return CY_QISTACK_STAT_BAD_PARAM;
+    }
+
+    rx->buf = buf;
+    rx->size = size;
+    rx->cb = cb;
+    rx->len = 0u;
+    rx->active = false;
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+cy_en_qi_status_t Cy_QiStack_Adt_Rx_Start(cy_stc_qi_context_t *qiCtx, uint16_t expLen)
+{
+    cy_stc_qi_adt_rx_t *rx = &qiCtx->adtRx;
+
+    if (rx->buf == NULL)
+    {
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    rx->len = 0u;
+    rx->expLen = expLen;
+    rx->odd = false;
+    rx->overflow = false;
+    rx->active = true;
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+cy_en_qi_status_t Cy_QiStack_Adt_Rx_Pkt(cy_stc_qi_context_t *qiCtx, const cy_stc_qi_ask_pkt_t *pkt)
+{
+    cy_stc_qi_adt_rx_t *rx = &qiCtx->adtRx;
+    cy_stc_qi_adt_rx_stats_t *stats = &rx->stats;
+    uint8_t size = CY_QI_ADT_RX_HDR_SIZE(pkt->header);
+    uint8_t type = CY_QI_ADT_RX_HDR_TYPE(pkt->header);
+    bool odd = (type == CY_QI_ADT_ODD_MASK);
+
+    if (((type != CY_QI_ADT_EVEN_MASK) && (!odd)) || (size == 0u) || (size > CY_QI_ADT_LENGTH_MASK))
+    {
+        return CY_QISTACK_STAT_BAD_PARAM;
+    }
+
+    if (!rx->active)
+    {
+        /*
+         * The last packet of the transfer just completed, repeated as the
+         * PRx missed its ACK. Acknowledge again.
+         */
+        if ((rx->len != 0u) && (odd != rx->odd))
+        {
+            stats->dupCnt++;
+            return CY_QISTACK_STAT_SUCCESS;
+        }
+        stats->seqErrCnt++;
+        return CY_QISTACK_STAT_BAD_PARAM;
+    }
+
+    if (odd != rx->odd)
+    {
+        /*
+         * The toggle of the last stored packet: the PRx missed the ACK and
+         * repeats it. Acknowledge again without storing. Before the first
+         * packet there is nothing to repeat.
+         */
+        if (rx->len == 0u)
+        {
+            stats->seqErrCnt++;
+            return CY_QISTACK_STAT_FAILURE;
+        }
+        stats->dupCnt++;
+        return CY_QISTACK_STAT_SUCCESS;
+    }
+
+    if (size > (uint16_t)(rx->size - rx->len))
+    {
+        stats->overflowCnt++;
+        rx->overflow = true;
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    (void)memcpy(&rx->buf[rx->len], pkt->msg, size);
+    rx->len += size;
+    rx->odd = !odd;
+    stats->pktCnt++;
+    stats->byteCnt += size;
+
+    if ((rx->expLen != 0u) && (rx->len >= rx->expLen))
+    {
+        adt_rx_complete(qiCtx);
+    }
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+void Cy_QiStack_Adt_Rx_End(cy_stc_qi_context_t *qiCtx)
+{
+    if (qiCtx->adtRx.active)
+    {
+        adt_rx_complete(qiCtx);
+    }
+}
+
+#if (CCG_HPI_WLC_CMD_ENABLE != 0)
+void Cy_QiStack_Get_ADT_Rx_Stats(cy_stc_qi_context_t *qiCtx, uint8_t *buffer)
+{
+    (void)memcpy(buffer, &qiCtx->adtRx.stats, sizeof(cy_stc_qi_adt_rx_stats_t));
+}
+
+void Cy_QiStack_Clear_ADT_Rx_Stats(cy_stc_qi_context_t *qiCtx)
+{
+    (void)memset(&qiCtx->adtRx.stats, 0, sizeof(cy_stc_qi_adt_rx_stats_t));
+}
+#endif /* CCG_HPI_WLC_CMD_ENABLE */
+
+#endif /* CY_QI_ADT_RX_EN */
+
+/* [] END OF FILE */
@@ -0,0 +1,196 @@
+/***************************************************************************//**
+* \file cy_qistack_comm_adt_tx.c
+* \version 2.0
+*
+* Source file of the PTx data stream of the QiStack middleware. ADT packets
+* are encoded straight from the caller buffer, by reference. Optionally the
+* packets following the one in flight are encoded between polls, so that a
+* DSR poll is answered without any encoding.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_manager.h"
+#include "cy_qistack_debug_monitor.h"
+
+#if CY_QI_ADT_TX_EN
+
+/* ADT header: data size in the upper nibble, even or odd type in the lower one. */
+#define CY_QI_ADT_TX_HEADER(size, odd)              ((uint8_t)(((size) << 4u) | \
+                                                    ((odd) ? CY_QI_ADT_ODD_MASK : CY_QI_ADT_EVEN_MASK)))
+
+#if (CY_QI_ADT_TX_WINDOW != 0)
+#define CY_QI_ADT_TX_WINDOW_MASK                    (CY_QI_ADT_TX_WINDOW - 1u)
+#endif /* CY_QI_ADT_TX_WINDOW */
+
+static uint32_t adt_tx_timestamp(cy_stc_qi_context_t *qiCtx)
+{
+    uint32_t (*get_timestamp)(struct cy_stc_qi_context *qiCtx) = qiCtx->ptrAppCbk->get_timestamp;
+
+    return (get_timestamp != NULL) ? get_timestamp(qiCtx) : 0u;
+}
+
+/* Data bytes of the packet starting at off. */
+static uint8_t adt_tx_size(const cy_stc_qi_adt_tx_t *adt, uint16_t off)
+{
+    return (uint8_t)GET_MIN((uint16_t)(adt->len - off), CY_QI_FSK_ADT_MAX_DATA_SIZE);
+}
+
+/* Encodes the packet starting at off in place from the caller buffer. */
+static void adt_tx_build(const cy_stc_qi_adt_tx_t *adt, cy_stc_qi_fsk_sched_t *sched, uint16_t off, bool odd)
+{
+    uint8_t size = adt_tx_size(adt, off);
+
+    (void)Cy_QiStack_Fsk_Sched_Build_Msg(sched, CY_QI_ADT_TX_HEADER(size, odd), &adt->data[off], size);
+}
+
+cy_en_qi_status_t Cy_QiStack_Adt_Tx_Start(cy_stc_qi_context_t *qiCtx, const uint8_t *data, uint16_t len)
+{
+    cy_stc_qi_adt_tx_t *adt = &qiCtx->adtTx;
+
+    if ((data == NULL) || (len == 0u))
+    {
+        return CY_QISTACK_STAT_BAD_PARAM;
+    }
+
+    adt->data = data;
+    adt->len = len;
+    adt->ackOff = 0u;
+    adt->odd = false;
+    adt->sent = false;
+    adt->active = true;
+    adt->startTime = adt_tx_timestamp(qiCtx);
+
+#if (CY_QI_ADT_TX_WINDOW != 0)
+    adt->stageOff = 0u;
+    adt->head = 0u;
+    adt->tail = 0u;
+    Cy_QiStack_Adt_Tx_Stage(qiCtx);
+#endif /* CY_QI_ADT_TX_WINDOW */
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+#if (CY_QI_ADT_TX_WINDOW != 0)
+void Cy_QiStack_Adt_Tx_Stage(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_adt_tx_t *adt = &qiCtx->adtTx;
+    uint8_t count;
+
+    while ((adt->active) && (adt->stageOff < adt->len))
+    {
+        count = (uint8_t)(adt->head - adt->tail);
+        if (count >= CY_QI_ADT_TX_WINDOW)
+        {
+            break;
+        }
+
+        /* Headers alternate from the packet in flight on. */
+        adt_tx_build(adt, &adt->slot[adt->head & CY_QI_ADT_TX_WINDOW_MASK], adt->stageOff,
+                (adt->odd != ((count & 0x01u) != 0u)));
+
+        adt->stageOff += adt_tx_size(adt, adt->stageOff);
+        adt->head++;
+    }
+}
+#endif /* CY_QI_ADT_TX_WINDOW */
+
+cy_en_qi_status_t Cy_QiStack_Adt_Tx_Send(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_adt_tx_t *adt = &qiCtx->adtTx;
+    cy_stc_qi_fsk_sched_t *sched = &qiCtx->fskSched;
+
+    if ((!adt->active) || (sched->len != 0u))
+    {
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    if (adt->sent)
+    {
+        adt->stats.retryCnt++;
+    }
+    adt->sent = true;
+
+#if (CY_QI_ADT_TX_WINDOW != 0)
+    if (adt->head == adt->tail)
+    {
+        /* Staging fell behind: encode now and answer late. */
+        adt->stats.stallCnt++;
+        Cy_QiStack_Adt_Tx_Stage(qiCtx);
+    }
+
+    Cy_QiStack_Fsk_Sched_Load(qiCtx, &adt->slot[adt->tail & CY_QI_ADT_TX_WINDOW_MASK]);
+#else
+    adt_tx_build(adt, sched, adt->ackOff, adt->odd);
+#endif /* CY_QI_ADT_TX_WINDOW */
+
+    return Cy_QiStack_Fsk_Sched_Start(qiCtx);
+}
+
+bool Cy_QiStack_Adt_Tx_Ack(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_adt_tx_t *adt = &qiCtx->adtTx;
+    cy_stc_qi_adt_tx_stats_t *stats = &adt->stats;
+    uint32_t time;
+
+    if ((!adt->active) || (!adt->sent))
+    {
+        return false;
+    }
+
+    stats->pktCnt++;
+    adt->ackOff += adt_tx_size(adt, adt->ackOff);
+    adt->odd = !adt->odd;
+    adt->sent = false;
+
+    if (adt->ackOff == adt->len)
+    {
+        time = adt_tx_timestamp(qiCtx) - adt->startTime;
+
+        stats->xferCnt++;
+        stats->lastBytes = adt->len;
+        stats->lastTime = time;
+        stats->lastBytesPerSec = (time != 0u) ?
+                (uint32_t)(((uint64_t)adt->len * 1000u * CY_QI_TIMESTAMP_FREQ_KHZ) / time) : 0u;
+        adt->active = false;
+
+        return true;
+    }
+
+#if (CY_QI_ADT_TX_WINDOW != 0)
+    adt->tail++;
+    Cy_QiStack_Adt_Tx_Stage(qiCtx);
+#endif /* CY_QI_ADT_TX_WINDOW */
+
+    return false;
+}
+
+void Cy_QiStack_Adt_Tx_Abort(cy_stc_qi_context_t *qiCtx)
+{
+    qiCtx->adtTx.active = false;
+    qiCtx->adtTx.data = NULL;
+}
+
+#if (CCG_HPI_WLC_CMD_ENABLE != 0)
+void Cy_QiStack_Get_ADT_Tx_Stats(cy_stc_qi_context_t *qiCtx, uint8_t *buffer)
+{
+    (void)memcpy(buffer, &qiCtx->adtTx.stats, sizeof(cy_stc_qi_adt_tx_stats_t));
+}
+
+void Cy_QiStack_Clear_ADT_Tx_Stats(cy_stc_qi_context_t *qiCtx)
+{
+    (void)memset(&qiCtx->adtTx.stats, 0, sizeof(cy_stc_qi_adt_tx_stats_t));
+}
+#endif /* CCG_HPI_WLC_CMD_ENABLE */
+
+#endif /* CY_QI_ADT_TX_EN */
+
+/* [] END OF FILE */
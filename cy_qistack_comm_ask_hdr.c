@@ -0,0 +1,132 @@
+/***************************************************************************//**
+* \file cy_qistack_comm_ask_hdr.c
+* \version 2.0
+*
+* Source file of the ASK packet header table used for O(1) validation and
+* dispatch of received packets in the QiStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_manager.h"
+
+#if CY_QI_ASK_HDR_TABLE_EN
+
+#define CY_QI_ASK_PH_PING                           CY_QI_PHASE_MASK(CY_QI_PHASE_PING)
+#define CY_QI_ASK_PH_CFG                            CY_QI_PHASE_MASK(CY_QI_PHASE_CFG)
+#define CY_QI_ASK_PH_NEG                            CY_QI_PHASE_MASK(CY_QI_PHASE_NEG)
+#define CY_QI_ASK_PH_PWR                            CY_QI_PHASE_MASK(CY_QI_PHASE_PWR)
+#define CY_QI_ASK_PH_ANY                            (CY_QI_ASK_PH_PING | CY_QI_ASK_PH_CFG | \
+                                                     CY_QI_ASK_PH_NEG | CY_QI_ASK_PH_PWR)
+#define CY_QI_ASK_PH_NEG_PWR                        (CY_QI_ASK_PH_NEG | CY_QI_ASK_PH_PWR)
+#define CY_QI_ASK_PH_CFG_NEG_PWR                    (CY_QI_ASK_PH_CFG | CY_QI_ASK_PH_NEG | CY_QI_ASK_PH_PWR)
+
+/* Table entry for a defined header; all other entries stay zero (reserved). */
+#define CY_QI_ASK_HDR(hdr, phases, hdl)                                         \
+    [(hdr)] = { (uint8_t)CY_QI_ASK_HDR_SIZE((uint8_t)(hdr)), (uint8_t)(phases), (uint8_t)(hdl) }
+
+static const cy_stc_qi_ask_hdr_info_t gl_ask_hdr_table[256] =
+{
+    CY_QI_ASK_HDR(CY_QI_ASK_SIGNAL_STRENGTH,          CY_QI_ASK_PH_PING,        CY_QI_ASK_HDL_SIG_STRENGTH),
+    CY_QI_ASK_HDR(CY_QI_ASK_END_POWER_TRANSFER,       CY_QI_ASK_PH_ANY,         CY_QI_ASK_HDL_EPT),
+    CY_QI_ASK_HDR(CY_QI_ASK_CONTROL_ERROR,            CY_QI_ASK_PH_PWR,         CY_QI_ASK_HDL_CE),
+    CY_QI_ASK_HDR(CY_QI_ASK_RECEIVED_POWER_RP8,       CY_QI_ASK_PH_PWR,         CY_QI_ASK_HDL_RP),
+    CY_QI_ASK_HDR(CY_QI_ASK_CHARGE_STATUS,            CY_QI_ASK_PH_PWR,         CY_QI_ASK_HDL_CHS),
+    CY_QI_ASK_HDR(CY_QI_ASK_CONFIG_PCH,               CY_QI_ASK_PH_CFG,         CY_QI_ASK_HDL_PCH),
+    CY_QI_ASK_HDR(CY_QI_ASK_GENERAL_REQUEST,          CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_GRQ),
+    CY_QI_ASK_HDR(CY_QI_ASK_RENEGOTIATE,              CY_QI_ASK_PH_PWR,         CY_QI_ASK_HDL_RENEG),
+    CY_QI_ASK_HDR(CY_QI_ASK_DATA_STREAM_RESP,         CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_DSR),
+    CY_QI_ASK_HDR(CY_QI_ASK_SPECIFIC_REQUEST,         CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_SRQ),
+    CY_QI_ASK_HDR(CY_QI_ASK_FOD_STATUS,               CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_FOD),
+    CY_QI_ASK_HDR(CY_QI_ASK_DATA_AUX_DATA_CTRL,       CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_ADC),
+    CY_QI_ASK_HDR(CY_QI_ASK_RECEIVED_POWER_RP,        CY_QI_ASK_PH_PWR,         CY_QI_ASK_HDL_RP),
+    CY_QI_ASK_HDR(CY_QI_ASK_CONFIGURATION,            CY_QI_ASK_PH_CFG,         CY_QI_ASK_HDL_CFG),
+    CY_QI_ASK_HDR(CY_QI_ASK_WPID_MSB,                 CY_QI_ASK_PH_CFG,         CY_QI_ASK_HDL_WPID),
+    CY_QI_ASK_HDR(CY_QI_ASK_WPID_LSB,                 CY_QI_ASK_PH_CFG,         CY_QI_ASK_HDL_WPID),
+    CY_QI_ASK_HDR(CY_QI_ASK_IDENTIFICATION,           CY_QI_ASK_PH_CFG,         CY_QI_ASK_HDL_ID),
+    CY_QI_ASK_HDR(CY_QI_ASK_EXTENDED_IDENTIFICATION,  CY_QI_ASK_PH_CFG,         CY_QI_ASK_HDL_XID),
+    CY_QI_ASK_HDR(CY_QI_ASK_DATA_AUX_DATA_EVEN_1,     CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_ADT),
+    CY_QI_ASK_HDR(CY_QI_ASK_DATA_AUX_DATA_ODD_1,      CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_ADT),
+    CY_QI_ASK_HDR(CY_QI_ASK_DATA_AUX_DATA_EVEN_2,     CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_ADT),
+    CY_QI_ASK_HDR(CY_QI_ASK_DATA_AUX_DATA_ODD_2,      CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_ADT),
+    CY_QI_ASK_HDR(CY_QI_ASK_DATA_AUX_DATA_EVEN_3,     CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_ADT),
+    CY_QI_ASK_HDR(CY_QI_ASK_DATA_AUX_DATA_ODD_3,      CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_ADT),
+    CY_QI_ASK_HDR(CY_QI_ASK_DATA_AUX_DATA_EVEN_4,     CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_ADT),
+    CY_QI_ASK_HDR(CY_QI_ASK_DATA_AUX_DATA_ODD_4,      CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_ADT),
+    CY_QI_ASK_HDR(CY_QI_ASK_DATA_AUX_DATA_EVEN_5,     CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_ADT),
+    CY_QI_ASK_HDR(CY_QI_ASK_DATA_AUX_DATA_ODD_5,      CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_ADT),
+    CY_QI_ASK_HDR(CY_QI_ASK_DATA_AUX_DATA_EVEN_6,     CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_ADT),
+    CY_QI_ASK_HDR(CY_QI_ASK_DATA_AUX_DATA_ODD_6,      CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_ADT),
+    CY_QI_ASK_HDR(CY_QI_ASK_DATA_AUX_DATA_EVEN_7,     CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_ADT),
+    CY_QI_ASK_HDR(CY_QI_ASK_DATA_AUX_DATA_ODD_7,      CY_QI_ASK_PH_NEG_PWR,     CY_QI_ASK_HDL_ADT),
+    CY_QI_ASK_HDR(CY_QI_ASK_CONFIG_PROP_1E,           CY_QI_ASK_PH_CFG_NEG_PWR, CY_QI_ASK_HDL_PROP),
+    CY_QI_ASK_HDR(CY_QI_ASK_CONFIG_PROP_1O,           CY_QI_ASK_PH_CFG_NEG_PWR, CY_QI_ASK_HDL_PROP),
+    CY_QI_ASK_HDR(CY_QI_ASK_CONFIG_PROP_2E,           CY_QI_ASK_PH_CFG_NEG_PWR, CY_QI_ASK_HDL_PROP),
+    CY_QI_ASK_HDR(CY_QI_ASK_CONFIG_PROP_2O,           CY_QI_ASK_PH_CFG_NEG_PWR, CY_QI_ASK_HDL_PROP),
+    CY_QI_ASK_HDR(CY_QI_ASK_CONFIG_PROP_3,            CY_QI_ASK_PH_CFG_NEG_PWR, CY_QI_ASK_HDL_PROP),
+    CY_QI_ASK_HDR(CY_QI_ASK_CONFIG_PROP_4,            CY_QI_ASK_PH_CFG_NEG_PWR, CY_QI_ASK_HDL_PROP),
+    CY_QI_ASK_HDR(CY_QI_ASK_CONFIG_PROP_5,            CY_QI_ASK_PH_CFG_NEG_PWR, CY_QI_ASK_HDL_PROP),
+    CY_QI_ASK_HDR(CY_QI_ASK_CONFIG_PROP_6,            CY_QI_ASK_PH_CFG_NEG_PWR, CY_QI_ASK_HDL_PROP),
+    CY_QI_ASK_HDR(CY_QI_ASK_CONFIG_PROP_7,            CY_QI_ASK_PH_CFG_NEG_PWR, CY_QI_ASK_HDL_PROP),
+    CY_QI_ASK_HDR(CY_QI_ASK_CONFIG_PROP_8,            CY_QI_ASK_PH_CFG_NEG_PWR, CY_QI_ASK_HDL_PROP),
+    CY_QI_ASK_HDR(CY_QI_ASK_CONFIG_PROP_12,           CY_QI_ASK_PH_CFG_NEG_PWR, CY_QI_ASK_HDL_PROP),
+    CY_QI_ASK_HDR(CY_QI_ASK_CONFIG_PROP_16,           CY_QI_ASK_PH_CFG_NEG_PWR, CY_QI_ASK_HDL_PROP),
+    CY_QI_ASK_HDR(CY_QI_ASK_CONFIG_PROP_20,           CY_QI_ASK_PH_CFG_NEG_PWR, CY_QI_ASK_HDL_PROP),
+};
+
+const cy_stc_qi_ask_hdr_info_t * Cy_QiStack_Ask_Hdr_Info(uint8_t header)
+{
+    return &gl_ask_hdr_table[header];
+}
+
+cy_en_qi_status_t Cy_QiStack_Ask_Pkt_Validate(cy_stc_qi_context_t *qiCtx, const cy_stc_qi_ask_pkt_t *pkt)
+{
+    const cy_stc_qi_ask_hdr_info_t *info;
+
+    if ((qiCtx == NULL) || (pkt == NULL))
+    {
+        return CY_QISTACK_STAT_BAD_PARAM;
+    }
+
+    info = &gl_ask_hdr_table[pkt->header];
+
+    /* Reserved headers have no phase bits set, so one test covers both cases. */
+    if (((info->phaseMask & CY_QI_PHASE_MASK(qiCtx->qiStat.phase)) == 0u) ||
+        (info->dataSize != pkt->dataSize))
+    {
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+cy_en_qi_status_t Cy_QiStack_Ask_Pkt_Dispatch(cy_stc_qi_context_t *qiCtx, const cy_stc_qi_ask_pkt_t *pkt,
+        const cy_cb_ask_hdl_t handlers[CY_QI_ASK_HDL_MAX])
+{
+    cy_cb_ask_hdl_t handler;
+    cy_en_qi_status_t status;
+
+    status = Cy_QiStack_Ask_Pkt_Validate(qiCtx, pkt);
+    if (status != CY_QISTACK_STAT_SUCCESS)
+    {
+        return status;
+    }
+
+    handler = (handlers != NULL) ? handlers[gl_ask_hdr_table[pkt->header].handler] : NULL;
+    if (handler == NULL)
+    {
+        return CY_QISTACK_STAT_NO_RESPONSE;
+    }
+
+    return handler(qiCtx, pkt);
+}
+
+#endif /* CY_QI_ASK_HDR_TABLE_EN */
+
+/* [] END OF FILE */
@@ -0,0 +1,102 @@
+/***************************************************************************//**
+* \file cy_qistack_comm_ask_queue.c
+* \version 2.0
+*
+* Source file of the ASK packet queue of the QiStack middleware: a copy of
+* the packets decoded by the BMC receiver, popped by the application.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_manager.h"
+#include "cy_syslib.h"
+
+#if (CY_QI_ASK_PKT_QUEUE_DEPTH != 0)
+
+#define CY_QI_ASK_PKT_QUEUE_MASK                    (CY_QI_ASK_PKT_QUEUE_DEPTH - 1u)
+
+void Cy_QiStack_Ask_Pkt_Queue_Reset(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_ask_pkt_queue_t *queue = &qiCtx->askPktQueue;
+
+    queue->head = 0u;
+    queue->tail = 0u;
+    queue->highWater = 0u;
+    queue->overflowCnt = 0u;
+}
+
+bool Cy_QiStack_Ask_Pkt_Queue_Push(cy_stc_qi_context_t *qiCtx, const cy_stc_qi_ask_pkt_t *pkt,
+        uint32_t timestamp)
+{
+    cy_stc_qi_ask_pkt_queue_t *queue = &qiCtx->askPktQueue;
+    cy_stc_qi_ask_pkt_entry_t *entry;
+    uint8_t head = queue->head;
+    uint8_t used = (uint8_t)(head - queue->tail);
+
+    if (used >= CY_QI_ASK_PKT_QUEUE_DEPTH)
+    {
+        queue->overflowCnt++;
+        return false;
+    }
+
+    entry = &queue->entry[head & CY_QI_ASK_PKT_QUEUE_MASK];
+    entry->pkt = *pkt;
+    entry->timestamp = timestamp;
+
+    /* Slot contents must be visible before the consumer sees the new head. */
+    __DMB();
+    queue->head = (uint8_t)(head + 1u);
+
+    used++;
+    if (used > queue->highWater)
+    {
+        queue->highWater = used;
+    }
+
+    return true;
+}
+
+bool Cy_QiStack_Ask_Pkt_Queue_Pop(cy_stc_qi_context_t *qiCtx, cy_stc_qi_ask_pkt_t *pkt,
+        uint32_t *timestamp)
+{
+    cy_stc_qi_ask_pkt_queue_t *queue = &qiCtx->askPktQueue;
+    const cy_stc_qi_ask_pkt_entry_t *entry;
+    uint8_t tail = queue->tail;
+
+    if (queue->head == tail)
+    {
+        return false;
+    }
+
+    /* Do not read the slot before the head update that published it. */
+    __DMB();
+    entry = &queue->entry[tail & CY_QI_ASK_PKT_QUEUE_MASK];
+    *pkt = entry->pkt;
+    if (timestamp != NULL)
+    {
+        *timestamp = entry->timestamp;
+    }
+
+    /* Slot must be fully read before the producer may reuse it. */
+    __DMB();
+    queue->tail = (uint8_t)(tail + 1u);
+
+    return true;
+}
+
+uint8_t Cy_QiStack_Ask_Pkt_Queue_Count(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_ask_pkt_queue_t *queue = &qiCtx->askPktQueue;
+
+    return (uint8_t)(queue->head - queue->tail);
+}
+
+#endif /* CY_QI_ASK_PKT_QUEUE_DEPTH */
+
+/* [] END OF FILE */
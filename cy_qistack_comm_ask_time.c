@@ -0,0 +1,48 @@
+/***************************************************************************//**
+* \file cy_qistack_comm_ask_time.c
+* \version 2.0
+*
+* Source file of the ASK packet timing of the QiStack middleware. Protocol
+* timers that follow a received packet are measured from its checksum edge.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_manager.h"
+
+#if CY_QI_ASK_PKT_TIMESTAMP_EN
+
+uint32_t Cy_QiStack_Ask_Pkt_Age(cy_stc_qi_context_t *qiCtx, uint32_t pktTime)
+{
+    uint32_t (*get_timestamp)(struct cy_stc_qi_context *qiCtx) = qiCtx->ptrAppCbk->get_timestamp;
+
+    if (get_timestamp == NULL)
+    {
+        return 0u;
+    }
+
+    /* Unsigned subtraction handles the counter wrap. */
+    return get_timestamp(qiCtx) - pktTime;
+}
+
+#if CY_QI_TIMER_WHEEL_EN
+bool Cy_QiStack_Ask_Pkt_Timer_Start(cy_stc_qi_context_t *qiCtx, cy_stc_qi_timer_wheel_t *wheel,
+        uint32_t pktTime, cy_timer_id_t id, uint16_t period, cy_cb_timer_t cb)
+{
+    uint32_t age = Cy_QiStack_Ask_Pkt_Age(qiCtx, pktTime) / CY_QI_TIMESTAMP_FREQ_KHZ;
+
+    period = (age < period) ? (uint16_t)(period - age) : 1u;
+
+    return Cy_QiStack_Timer_Wheel_Start(wheel, qiCtx, id, period, cb);
+}
+#endif /* CY_QI_TIMER_WHEEL_EN */
+
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN */
+
+/* [] END OF FILE */
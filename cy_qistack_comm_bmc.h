@@ -102,6 +102,61 @@
 /** Get bit from raw data. */
 #define CY_QI_BMC_RX_RAW_DATA_GET_BIT(ptr,pos)      ((((ptr)[(pos) >> 3u] >> ((pos) & 0x7u))) & 0x01u
 
+/**
+ * Minimum samples for a half bit run. Shorter runs are treated as glitches
+ * by the table driven decoder.
+ */
+#define CY_QI_BMC_RX_HALF_MIN_COUNT                 (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE >> 2u)
+
+/**
+ * Maximum samples for a full bit run. Longer runs are treated as idle line
+ * by the table driven decoder.
+ */
+#define CY_QI_BMC_RX_FULL_MAX_COUNT                 (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE + \
+                                                     (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE >> 1u))
+
+/*
+ * Routes the stack's bmc_rx_start_scan and bmc_rx_task calls to the single
+ * path table driven receiver. Link with -Wl,--wrap=bmc_rx_start_scan and
+ * -Wl,--wrap=bmc_rx_task. See bmc_rx_lut_scb_fifo_handler.
+ */
+#ifndef CY_QI_BMC_RX_LUT_WRAP_EN
+#define CY_QI_BMC_RX_LUT_WRAP_EN                    (0u)
+#endif /* CY_QI_BMC_RX_LUT_WRAP_EN */
+
+#if ((CY_QI_BMC_RX_LUT_WRAP_EN != 0) && (CY_QI_BMC_RX_LUT_EN == 0))
+#error "BMC receiver wrapping requires the table driven BMC decoder (CY_QI_BMC_RX_LUT_EN)."
+#endif
+
+#if (CY_QI_BMC_RX_CAPTURE_EN != 0)
+/**
+ * ASK capture format version. A capture is a plain sequence of records, each
+ * made of a type byte, a payload length byte and the payload. Multi-byte
+ * fields are little endian. Timestamps are raw sample indexes since the last
+ * start record, at CY_QI_BMC_RX_FREQ * CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE.
+ */
+#define CY_QI_BMC_CAP_VERSION                       (1u)
+
+/** Size of the record type and length fields. */
+#define CY_QI_BMC_CAP_REC_HDR_SIZE                  (2u)
+
+/** Largest record payload: one full SPI RX FIFO. */
+#define CY_QI_BMC_CAP_REC_MAX_PAYLOAD               (CY_QI_BMC_RX_SPI_FIFO_SIZE * \
+                                                     (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE >> 3u))
+
+/** Scan start record. Payload: version, over sample rate, ASK path. */
+#define CY_QI_BMC_CAP_REC_START                     (0x01u)
+
+/** SPI data record. Payload: raw SPI words as drained from the RX FIFO. */
+#define CY_QI_BMC_CAP_REC_SPI                       (0x02u)
+
+/** Comparator event record. Payload: event ID, 16-bit timestamp. */
+#define CY_QI_BMC_CAP_REC_CMP                       (0x03u)
+
+/** Packet end record. Payload: cy_en_qi_ask_pkt_evt_t, 16-bit timestamp. */
+#define CY_QI_BMC_CAP_REC_END                       (0x04u)
+#endif /* CY_QI_BMC_RX_CAPTURE_EN */
+
 /** \} group_qistack_comm_macros */
 
 /**
@@ -158,6 +213,349 @@ void bmc_rx_task(cy_stc_qi_context_t *qiCtx);
  */
 cy_en_qi_status_t Cy_Cb_BMC_Event(void *callbackContext,cy_en_qi_ask_pkt_evt_t pktEvt);
 
+#if (CY_QI_BMC_RX_LUT_EN != 0)
+/*******************************************************************************
+* Function Name: bmc_rx_lut_init
+****************************************************************************//**
+*
+* This function resets the table driven BMC decoder and binds it to the packet
+* structure which receives the decoded data.
+*
+* \param dec
+* Pointer to the decoder state.
+*
+* \param pkt
+* Pointer to the destination packet.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void bmc_rx_lut_init(cy_stc_qi_bmc_lut_dec_t *dec, cy_stc_qi_ask_pkt_t *pkt);
+
+/*******************************************************************************
+* Function Name: bmc_rx_lut_decode
+****************************************************************************//**
+*
+* This function decodes a buffer of oversampled BMC data. The raw samples are
+* consumed a byte (8X) or a half word (16X) at a time and the transitions are
+* looked up from a precomputed table, so the cost scales with the number of
+* line transitions instead of the number of samples.
+*
+* \param dec
+* Pointer to the decoder state.
+*
+* \param raw
+* Raw sample buffer in CY_QI_BMC_RX_RAW_DATA_GET_BIT order.
+*
+* \param bitCount
+* Number of valid samples in the buffer.
+*
+* \return
+* CY_QI_ASK_EVT_PKT_READY if a packet with valid checksum is decoded,
+* CY_QI_ASK_EVT_PKT_ERR if a packet was started but failed to decode,
+* CY_QI_ASK_EVT_PKT_NONE if no packet start was found.
+*
+*******************************************************************************/
+cy_en_qi_ask_pkt_evt_t bmc_rx_lut_decode(cy_stc_qi_bmc_lut_dec_t *dec,
+              const uint8_t *raw, uint16_t bitCount);
+
+/*******************************************************************************
+* Function Name: bmc_rx_lut_feed
+****************************************************************************//**
+*
+* This function feeds a chunk of raw samples to the table driven decoder
+* without terminating the packet, so that a packet can be decoded while the
+* SPI FIFO is still filling. The header derived packet length is available in
+* the decoder as soon as the header character is received, and the packet is
+* completed on the first half of the checksum stop bit.
+*
+* \param dec
+* Pointer to the decoder state.
+*
+* \param raw
+* Raw sample chunk in CY_QI_BMC_RX_RAW_DATA_GET_BIT order.
+*
+* \param bitCount
+* Number of valid samples in the chunk.
+*
+* \return
+* CY_QI_ASK_EVT_PKT_READY or CY_QI_ASK_EVT_PKT_ERR once the packet is final,
+* CY_QI_ASK_EVT_START_BIT when the header start bit is detected,
+* CY_QI_ASK_EVT_BIT_ERR when a preamble was abandoned as noise,
+* CY_QI_ASK_EVT_PKT_NONE otherwise.
+*
+*******************************************************************************/
+cy_en_qi_ask_pkt_evt_t bmc_rx_lut_feed(cy_stc_qi_bmc_lut_dec_t *dec,
+              const uint8_t *raw, uint16_t bitCount);
+
+/*******************************************************************************
+* Function Name: bmc_rx_lut_flush
+****************************************************************************//**
+*
+* This function terminates the open run of the decoder as idle line. Used
+* when the receiver stops collecting samples.
+*
+* \param dec
+* Pointer to the decoder state.
+*
+* \return
+* Decoder event resulting from the idle line.
+*
+*******************************************************************************/
+cy_en_qi_ask_pkt_evt_t bmc_rx_lut_flush(cy_stc_qi_bmc_lut_dec_t *dec);
+
+#if (CY_QI_BMC_RX_EDGE_CAPTURE_EN != 0)
+/*******************************************************************************
+* Function Name: bmc_rx_lut_edge
+****************************************************************************//**
+*
+* This function feeds one demodulated line transition to the decoder. The run
+* length since the previous edge is decoded directly into bits, so no raw
+* sample buffer is needed. To be called from a comparator or timer capture
+* interrupt.
+*
+* \param dec
+* Pointer to the decoder state.
+*
+* \param timestamp
+* Free running 16-bit capture counter value at the edge, in units of one raw
+* sample (CY_QI_BMC_RX_FREQ * CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE).
+*
+* \return
+* Same events as bmc_rx_lut_feed.
+*
+*******************************************************************************/
+cy_en_qi_ask_pkt_evt_t bmc_rx_lut_edge(cy_stc_qi_bmc_lut_dec_t *dec, uint16_t timestamp);
+
+/*******************************************************************************
+* Function Name: bmc_rx_lut_rx_edge
+****************************************************************************//**
+*
+* This function feeds one demodulated line transition to the single path
+* receiver. Events are reported through the ASK packet event callback as they
+* happen, and a packet completed by this edge is delivered immediately. To be
+* called from the comparator or timer capture interrupt.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param timestamp
+* Capture counter value at the edge, see bmc_rx_lut_edge.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void bmc_rx_lut_rx_edge(cy_stc_qi_context_t *qiCtx, uint16_t timestamp);
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+
+/*******************************************************************************
+* Function Name: bmc_rx_lut_task
+****************************************************************************//**
+*
+* This function completes a reception that ended without a packet. Samples
+* are decoded as they arrive and a valid packet is delivered from interrupt
+* context, so once reception is done the open packet of the decoder is only
+* terminated and CY_QI_ASK_EVT_PKT_ERR is notified through the ASK packet
+* event callback. rawData is not decoded again.
+*
+* Replaces the library bmc_rx_task in the main loop. The library must not run
+* its own decode on the same reception, as both write askBmc.pkt and raise the
+* ASK packet event callback. With CY_QI_BMC_RX_LUT_WRAP_EN the stack's
+* bmc_rx_task calls end up here.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void bmc_rx_lut_task(cy_stc_qi_context_t *qiCtx);
+
+/*******************************************************************************
+* Function Name: bmc_rx_lut_rx_start
+****************************************************************************//**
+*
+* This function prepares the BMC receiver for incremental decoding. To be
+* called whenever the SCB starts collecting a new packet.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void bmc_rx_lut_rx_start(cy_stc_qi_context_t *qiCtx);
+
+/*******************************************************************************
+* Function Name: bmc_rx_lut_scb_fifo_handler
+****************************************************************************//**
+*
+* This function drains the SCB RX FIFO on the CY_QI_BMC_RX_SPI_FIFO_THRESHOLD
+* watermark interrupt and decodes the new samples immediately. Samples are also
+* copied to rawData while they fit. The ASK packet event callback is invoked
+* with CY_QI_ASK_EVT_START_BIT, CY_QI_ASK_EVT_BIT_ERR, CY_QI_ASK_EVT_PKT_READY
+* or CY_QI_ASK_EVT_PKT_ERR as they happen. With CY_QI_BMC_RX_EDGE_CAPTURE_EN
+* the FIFO is only drained: rawData holds the edge log and the packet is
+* decoded from bmc_rx_lut_rx_edge.
+*
+* Has the signature of askBmc.scb_int_handler and replaces the library
+* handler there: once bmc_rx_start_scan has armed the SCB, call
+* bmc_rx_lut_rx_start and store this function in askBmc.scb_int_handler, so
+* the SCB interrupt hands the FIFO to the table driven decoder. Pair it with
+* bmc_rx_lut_task in place of bmc_rx_task. With CY_QI_BMC_RX_LUT_WRAP_EN the
+* wrapped bmc_rx_start_scan does both steps.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void bmc_rx_lut_scb_fifo_handler(cy_stc_qi_context_t *qiCtx);
+
+#if (CY_QI_BMC_RX_CAPTURE_EN != 0)
+/*******************************************************************************
+* Function Name: bmc_rx_lut_cap_cmp_event
+****************************************************************************//**
+*
+* This function adds a comparator event record to the ASK capture. To be
+* called from the comparator interrupt handler of the demodulator.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param cmpEvt
+* Application defined comparator event ID.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void bmc_rx_lut_cap_cmp_event(cy_stc_qi_context_t *qiCtx, uint8_t cmpEvt);
+
+/*******************************************************************************
+* Function Name: bmc_rx_lut_replay
+****************************************************************************//**
+*
+* This function replays an ASK capture through the BMC receive path exactly
+* as the SCB FIFO interrupt and the BMC task would process it, so the same
+* ASK packet events are raised through cy_cb_ask_pkt_evt. Intended for
+* running a corpus of field captures through the decoder on a host.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param cap
+* Capture data made of CY_QI_BMC_CAP_REC_* records.
+*
+* \param len
+* Capture length in bytes.
+*
+* \return
+* CY_QISTACK_STAT_SUCCESS if the whole capture is replayed,
+* CY_QISTACK_STAT_BAD_PARAM if a record is truncated or the capture was taken
+* with a different version or over sample rate.
+*
+*******************************************************************************/
+cy_en_qi_status_t bmc_rx_lut_replay(cy_stc_qi_context_t *qiCtx, const uint8_t *cap, uint32_t len);
+#endif /* CY_QI_BMC_RX_CAPTURE_EN */
+
+#if (CY_QI_BMC_RX_MULTI_PATH_EN != 0)
+/*******************************************************************************
+* Function Name: bmc_rx_lut_multi_rx_start
+****************************************************************************//**
+*
+* This function prepares one decoder per ASK path of askPathSeq for a new
+* packet. The paths are expected to be sampled concurrently, either by
+* alternating comparator/ADC windows or by separate SCBs, and each sample
+* stream is decoded on its own. The first path to deliver a packet with a
+* valid checksum wins.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void bmc_rx_lut_multi_rx_start(cy_stc_qi_context_t *qiCtx);
+
+/*******************************************************************************
+* Function Name: bmc_rx_lut_multi_feed
+****************************************************************************//**
+*
+* This function decodes raw samples of one ASK path and arbitrates the result
+* against the other paths. CY_QI_ASK_EVT_START_BIT is reported for the first
+* path to see a start bit. CY_QI_ASK_EVT_PKT_READY is reported for the first
+* checksum valid packet, which is copied to pkt. CY_QI_ASK_EVT_PKT_ERR is
+* reported only once all paths have failed.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param pathIdx
+* Index of the path in askPathSeq.
+*
+* \param raw
+* Raw sample chunk in CY_QI_BMC_RX_RAW_DATA_GET_BIT order.
+*
+* \param bitCount
+* Number of valid samples in the chunk.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void bmc_rx_lut_multi_feed(cy_stc_qi_context_t *qiCtx, uint8_t pathIdx,
+              const uint8_t *raw, uint16_t bitCount);
+
+#if (CY_QI_BMC_RX_EDGE_CAPTURE_EN != 0)
+/*******************************************************************************
+* Function Name: bmc_rx_lut_multi_edge
+****************************************************************************//**
+*
+* This function is the edge capture variant of bmc_rx_lut_multi_feed.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param pathIdx
+* Index of the path in askPathSeq.
+*
+* \param timestamp
+* Capture counter value at the edge, see bmc_rx_lut_edge.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void bmc_rx_lut_multi_edge(cy_stc_qi_context_t *qiCtx, uint8_t pathIdx, uint16_t timestamp);
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+
+/*******************************************************************************
+* Function Name: bmc_rx_lut_multi_flush
+****************************************************************************//**
+*
+* This function terminates all path decoders at the end of the receive window.
+* If no path has delivered a valid packet by then, CY_QI_ASK_EVT_PKT_ERR is
+* reported.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* None
+*
+*******************************************************************************/
+void bmc_rx_lut_multi_flush(cy_stc_qi_context_t *qiCtx);
+#endif /* CY_QI_BMC_RX_MULTI_PATH_EN */
+#endif /* CY_QI_BMC_RX_LUT_EN */
+
 /** \} group_qistack_comm_bmc_functions */
 
 #endif /* CY_QISTACK_COMM_BMC_H */
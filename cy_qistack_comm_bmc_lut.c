@@ -0,0 +1,1269 @@
+/***************************************************************************//**
+* \file cy_qistack_comm_bmc_lut.c
+* \version 2.0
+*
+* Source file of Qi table driven BMC decoder of the QiStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_bmc.h"
+#include "cy_qistack_comm_manager.h"
+#include "cy_qistack_debug_monitor.h"
+#include "cy_qistack_pm.h"
+#include "cy_scb_spi.h"
+
+#if (CY_QI_BMC_RX_LUT_EN != 0)
+
+/* Number of bits in a Qi character: start, 8 data, parity and stop. */
+#define CY_QI_BMC_RX_CHAR_BITS                      (11u)
+
+/* Bit position of the stop bit inside a Qi character. */
+#define CY_QI_BMC_RX_CHAR_STOP_POS                  (10u)
+
+/* Raw bytes delivered by one SPI FIFO entry. */
+#define CY_QI_BMC_RX_SPI_WORD_BYTES                 (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE >> 3u)
+
+#if CY_QI_ASK_PKT_TIMESTAMP_EN
+/* Raw samples per millisecond. */
+#define CY_QI_BMC_RX_SAMPLES_PER_MS                 ((CY_QI_BMC_RX_FREQ * CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE) / 1000u)
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN */
+
+/*
+ * Open runs stop growing here, far above any idle threshold, so that a long
+ * idle line can not wrap the run length back into the bit range.
+ */
+#define CY_QI_BMC_RX_RUN_SAT                        (0x8000u)
+
+/* Run length classes. */
+#define CY_QI_BMC_RX_RUN_GLITCH                     (0u)
+#define CY_QI_BMC_RX_RUN_HALF                       (1u)
+#define CY_QI_BMC_RX_RUN_FULL                       (2u)
+#define CY_QI_BMC_RX_RUN_IDLE                       (3u)
+
+#if (CY_QI_BMC_RX_CLK_RECOVERY_EN != 0)
+/* Nominal half bit period in 1/16 raw samples, and the tracking limits. */
+#define CY_QI_BMC_RX_HALF_EST_NOMINAL               ((CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE >> 1u) << 4u)
+#define CY_QI_BMC_RX_HALF_EST_MIN                   (CY_QI_BMC_RX_HALF_EST_NOMINAL - \
+                                                     (CY_QI_BMC_RX_HALF_EST_NOMINAL >> 2u))
+#define CY_QI_BMC_RX_HALF_EST_MAX                   (CY_QI_BMC_RX_HALF_EST_NOMINAL + \
+                                                     (CY_QI_BMC_RX_HALF_EST_NOMINAL >> 2u))
+
+/* Tracking gain as a power of 2 divider, in the preamble and in the packet. */
+#define CY_QI_BMC_RX_TRACK_PREAMBLE_SHIFT           (3u)
+#define CY_QI_BMC_RX_TRACK_DATA_SHIFT               (5u)
+#endif /* CY_QI_BMC_RX_CLK_RECOVERY_EN */
+
+/* Edge table entry layout: count in bits [3:0], then 3-bit positions. */
+#define CY_QI_BMC_RX_LUT_CNT_MASK                   (0x0Fu)
+#define CY_QI_BMC_RX_LUT_POS_SHIFT                  (4u)
+#define CY_QI_BMC_RX_LUT_POS_BITS                   (3u)
+#define CY_QI_BMC_RX_LUT_POS_MASK                   (0x07u)
+
+/*
+ * Transition table indexed by the edge mask of one raw byte. Bit n of the edge
+ * mask is set when sample n differs from sample n - 1. Each entry holds the
+ * number of edges and their sample positions in ascending order.
+ */
+static const uint32_t gl_bmc_rx_edge_lut[256] =
+{
+    0x00000000u, 0x00000001u, 0x00000011u, 0x00000082u, 0x00000021u, 0x00000102u, 0x00000112u, 0x00000883u,
+    0x00000031u, 0x00000182u, 0x00000192u, 0x00000C83u, 0x000001A2u, 0x00000D03u, 0x00000D13u, 0x00006884u,
+    0x00000041u, 0x00000202u, 0x00000212u, 0x00001083u, 0x00000222u, 0x00001103u, 0x00001113u, 0x00008884u,
+    0x00000232u, 0x00001183u, 0x00001193u, 0x00008C84u, 0x000011A3u, 0x00008D04u, 0x00008D14u, 0x00046885u,
+    0x00000051u, 0x00000282u, 0x00000292u, 0x00001483u, 0x000002A2u, 0x00001503u, 0x00001513u, 0x0000A884u,
+    0x000002B2u, 0x00001583u, 0x00001593u, 0x0000AC84u, 0x000015A3u, 0x0000AD04u, 0x0000AD14u, 0x00056885u,
+    0x000002C2u, 0x00001603u, 0x00001613u, 0x0000B084u, 0x00001623u, 0x0000B104u, 0x0000B114u, 0x00058885u,
+    0x00001633u, 0x0000B184u, 0x0000B194u, 0x00058C85u, 0x0000B1A4u, 0x00058D05u, 0x00058D15u, 0x002C6886u,
+    0x00000061u, 0x00000302u, 0x00000312u, 0x00001883u, 0x00000322u, 0x00001903u, 0x00001913u, 0x0000C884u,
+    0x00000332u, 0x00001983u, 0x00001993u, 0x0000CC84u, 0x000019A3u, 0x0000CD04u, 0x0000CD14u, 0x00066885u,
+    0x00000342u, 0x00001A03u, 0x00001A13u, 0x0000D084u, 0x00001A23u, 0x0000D104u, 0x0000D114u, 0x00068885u,
+    0x00001A33u, 0x0000D184u, 0x0000D194u, 0x00068C85u, 0x0000D1A4u, 0x00068D05u, 0x00068D15u, 0x00346886u,
+    0x00000352u, 0x00001A83u, 0x00001A93u, 0x0000D484u, 0x00001AA3u, 0x0000D504u, 0x0000D514u, 0x0006A885u,
+    0x00001AB3u, 0x0000D584u, 0x0000D594u, 0x0006AC85u, 0x0000D5A4u, 0x0006AD05u, 0x0006AD15u, 0x00356886u,
+    0x00001AC3u, 0x0000D604u, 0x0000D614u, 0x0006B085u, 0x0000D624u, 0x0006B105u, 0x0006B115u, 0x00358886u,
+    0x0000D634u, 0x0006B185u, 0x0006B195u, 0x00358C86u, 0x0006B1A5u, 0x00358D06u, 0x00358D16u, 0x01AC6887u,
+    0x00000071u, 0x00000382u, 0x00000392u, 0x00001C83u, 0x000003A2u, 0x00001D03u, 0x00001D13u, 0x0000E884u,
+    0x000003B2u, 0x00001D83u, 0x00001D93u, 0x0000EC84u, 0x00001DA3u, 0x0000ED04u, 0x0000ED14u, 0x00076885u,
+    0x000003C2u, 0x00001E03u, 0x00001E13u, 0x0000F084u, 0x00001E23u, 0x0000F104u, 0x0000F114u, 0x00078885u,
+    0x00001E33u, 0x0000F184u, 0x0000F194u, 0x00078C85u, 0x0000F1A4u, 0x00078D05u, 0x00078D15u, 0x003C6886u,
+    0x000003D2u, 0x00001E83u, 0x00001E93u, 0x0000F484u, 0x00001EA3u, 0x0000F504u, 0x0000F514u, 0x0007A885u,
+    0x00001EB3u, 0x0000F584u, 0x0000F594u, 0x0007AC85u, 0x0000F5A4u, 0x0007AD05u, 0x0007AD15u, 0x003D6886u,
+    0x00001EC3u, 0x0000F604u, 0x0000F614u, 0x0007B085u, 0x0000F624u, 0x0007B105u, 0x0007B115u, 0x003D8886u,
+    0x0000F634u, 0x0007B185u, 0x0007B195u, 0x003D8C86u, 0x0007B1A5u, 0x003D8D06u, 0x003D8D16u, 0x01EC6887u,
+    0x000003E2u, 0x00001F03u, 0x00001F13u, 0x0000F884u, 0x00001F23u, 0x0000F904u, 0x0000F914u, 0x0007C885u,
+    0x00001F33u, 0x0000F984u, 0x0000F994u, 0x0007CC85u, 0x0000F9A4u, 0x0007CD05u, 0x0007CD15u, 0x003E6886u,
+    0x00001F43u, 0x0000FA04u, 0x0000FA14u, 0x0007D085u, 0x0000FA24u, 0x0007D105u, 0x0007D115u, 0x003E8886u,
+    0x0000FA34u, 0x0007D185u, 0x0007D195u, 0x003E8C86u, 0x0007D1A5u, 0x003E8D06u, 0x003E8D16u, 0x01F46887u,
+    0x00001F53u, 0x0000FA84u, 0x0000FA94u, 0x0007D485u, 0x0000FAA4u, 0x0007D505u, 0x0007D515u, 0x003EA886u,
+    0x0000FAB4u, 0x0007D585u, 0x0007D595u, 0x003EAC86u, 0x0007D5A5u, 0x003EAD06u, 0x003EAD16u, 0x01F56887u,
+    0x0000FAC4u, 0x0007D605u, 0x0007D615u, 0x003EB086u, 0x0007D625u, 0x003EB106u, 0x003EB116u, 0x01F58887u,
+    0x0007D635u, 0x003EB186u, 0x003EB196u, 0x01F58C87u, 0x003EB1A6u, 0x01F58D07u, 0x01F58D17u, 0x0FAC6888u
+};
+
+/* Fails the packet, deriving the reason from the character position. */
+static cy_en_qi_ask_pkt_evt_t bmc_rx_lut_fail(cy_stc_qi_bmc_lut_dec_t *dec,
+        cy_en_qi_ask_fail_type_t failType)
+{
+    if (dec->byteIdx == 0u)
+    {
+        dec->failRs = CY_QI_ASK_FAIL_RS_BAD_HEADER;
+    }
+    else if ((dec->byteIdx + 1u) == dec->pktLen)
+    {
+        dec->failRs = CY_QI_ASK_FAIL_RS_INV_CHECKSUM;
+    }
+    else
+    {
+        dec->failRs = CY_QI_ASK_FAIL_RS_BAD_DATA;
+    }
+
+    dec->failType = failType;
+    dec->state = CY_QI_BMC_LUT_ST_ERROR;
+
+    return CY_QI_ASK_EVT_PKT_ERR;
+}
+
+/* Stores a completed character and checks for end of packet. */
+static cy_en_qi_ask_pkt_evt_t bmc_rx_lut_char_done(cy_stc_qi_bmc_lut_dec_t *dec)
+{
+    cy_stc_qi_ask_pkt_t *pkt = dec->pkt;
+    uint8_t data = (uint8_t)(dec->charBits >> 1u);
+
+    if ((dec->charBits & 0x01u) != 0u)
+    {
+        return bmc_rx_lut_fail(dec, CY_QI_ASK_FAIL_TYPE_NO_START_BIT);
+    }
+
+    if (((dec->charBits >> CY_QI_BMC_RX_CHAR_STOP_POS) & 0x01u) == 0u)
+    {
+        return bmc_rx_lut_fail(dec, CY_QI_ASK_FAIL_TYPE_NO_STOP_BIT);
+    }
+
+    /* Start 0 and stop 1 are checked, so the XOR of all bits is 0 for odd parity. */
+    if (dec->charPar != 0u)
+    {
+        return bmc_rx_lut_fail(dec, CY_QI_ASK_FAIL_TYPE_BAD_PARITY_BIT);
+    }
+
+    if (dec->byteIdx == 0u)
+    {
+        pkt->header = data;
+        pkt->dataSize = (uint8_t)CY_QI_ASK_HDR_SIZE(data);
+        dec->pktLen = (uint8_t)(pkt->dataSize + 2u);
+    }
+    else if (dec->byteIdx < (dec->pktLen - 1u))
+    {
+        pkt->msg[dec->byteIdx - 1u] = data;
+    }
+    else
+    {
+        pkt->checksum = data;
+    }
+
+    dec->pktChk ^= data;
+    dec->byteIdx++;
+    dec->bitIdx = 0u;
+    dec->charBits = 0u;
+    dec->charPar = 0u;
+
+    if (dec->byteIdx < dec->pktLen)
+    {
+        return CY_QI_ASK_EVT_PKT_NONE;
+    }
+
+    /* Header, message and checksum XOR to zero for a valid packet. */
+    if (dec->pktChk != 0u)
+    {
+        dec->failRs = CY_QI_ASK_FAIL_RS_BAD_CHECKSUM;
+        dec->failType = CY_QI_ASK_FAIL_TYPE_NONE;
+        dec->state = CY_QI_BMC_LUT_ST_ERROR;
+        return CY_QI_ASK_EVT_PKT_ERR;
+    }
+
+    dec->state = CY_QI_BMC_LUT_ST_DONE;
+    return CY_QI_ASK_EVT_PKT_READY;
+}
+
+/* Adds a decoded bit to the current character. */
+static cy_en_qi_ask_pkt_evt_t bmc_rx_lut_bit(cy_stc_qi_bmc_lut_dec_t *dec, uint16_t bit)
+{
+    dec->charBits |= (uint16_t)(bit << dec->bitIdx);
+    dec->charPar ^= (uint8_t)bit;
+    dec->bitIdx++;
+
+    if (dec->bitIdx < CY_QI_BMC_RX_CHAR_BITS)
+    {
+        return CY_QI_ASK_EVT_PKT_NONE;
+    }
+
+    return bmc_rx_lut_char_done(dec);
+}
+
+/* Returns true if the event terminates the packet decode. */
+static bool bmc_rx_lut_is_final(cy_en_qi_ask_pkt_evt_t evt)
+{
+    return ((evt == CY_QI_ASK_EVT_PKT_READY) || (evt == CY_QI_ASK_EVT_PKT_ERR));
+}
+
+/* Classifies one run of equal samples and advances the decoder. */
+static uint8_t bmc_rx_lut_classify(const cy_stc_qi_bmc_lut_dec_t *dec, uint16_t len)
+{
+    uint8_t cls;
+#if (CY_QI_BMC_RX_CLK_RECOVERY_EN != 0)
+    /*
+     * Thresholds follow the tracked half bit period: glitch below half of it,
+     * half bit below 1.5 times, full bit up to 3 times. Compared in 1/16
+     * samples to keep the fraction of the estimate.
+     */
+    uint32_t len16 = (uint32_t)len << 4u;
+    uint32_t est = dec->halfEst;
+
+    if (len16 < (est >> 1u))
+    {
+        cls = CY_QI_BMC_RX_RUN_GLITCH;
+    }
+    else if (len16 < (est + (est >> 1u)))
+    {
+        cls = CY_QI_BMC_RX_RUN_HALF;
+    }
+    else if (len16 <= (est * 3u))
+    {
+        cls = CY_QI_BMC_RX_RUN_FULL;
+    }
+    else
+    {
+        cls = CY_QI_BMC_RX_RUN_IDLE;
+    }
+#else
+    (void)dec;
+
+    if (len < CY_QI_BMC_RX_HALF_MIN_COUNT)
+    {
+        cls = CY_QI_BMC_RX_RUN_GLITCH;
+    }
+    else if (len < CY_QI_BMC_RX_ZERO_MIN_COUNT)
+    {
+        cls = CY_QI_BMC_RX_RUN_HALF;
+    }
+    else if (len <= CY_QI_BMC_RX_FULL_MAX_COUNT)
+    {
+        cls = CY_QI_BMC_RX_RUN_FULL;
+    }
+    else
+    {
+        cls = CY_QI_BMC_RX_RUN_IDLE;
+    }
+#endif /* CY_QI_BMC_RX_CLK_RECOVERY_EN */
+
+    return cls;
+}
+
+#if (CY_QI_BMC_RX_CLK_RECOVERY_EN != 0)
+/* Moves the half bit period estimate towards a measured half bit period. */
+static void bmc_rx_lut_track(cy_stc_qi_bmc_lut_dec_t *dec, uint32_t half16, uint8_t shift)
+{
+    int32_t est = (int32_t)dec->halfEst;
+
+    est += ((int32_t)half16 - est) / (int32_t)(1u << shift);
+
+    if (est < (int32_t)CY_QI_BMC_RX_HALF_EST_MIN)
+    {
+        est = (int32_t)CY_QI_BMC_RX_HALF_EST_MIN;
+    }
+    else if (est > (int32_t)CY_QI_BMC_RX_HALF_EST_MAX)
+    {
+        est = (int32_t)CY_QI_BMC_RX_HALF_EST_MAX;
+    }
+    else
+    {
+        /* Within tracking range. */
+    }
+
+    dec->halfEst = (uint16_t)est;
+}
+#endif /* CY_QI_BMC_RX_CLK_RECOVERY_EN */
+
+static cy_en_qi_ask_pkt_evt_t bmc_rx_lut_run(cy_stc_qi_bmc_lut_dec_t *dec, uint16_t len)
+{
+    cy_en_qi_ask_pkt_evt_t evt = CY_QI_ASK_EVT_PKT_NONE;
+    uint8_t cls = bmc_rx_lut_classify(dec, len);
+    uint16_t bin;
+
+    if (dec->state == CY_QI_BMC_LUT_ST_PREAMBLE)
+    {
+        if (cls == CY_QI_BMC_RX_RUN_HALF)
+        {
+            if (dec->preambleHalfCnt < UINT8_MAX)
+            {
+                dec->preambleHalfCnt++;
+            }
+#if (CY_QI_BMC_RX_CLK_RECOVERY_EN != 0)
+            /* The preamble is all ones: every run is a half bit period. */
+            bmc_rx_lut_track(dec, (uint32_t)len << 4u, CY_QI_BMC_RX_TRACK_PREAMBLE_SHIFT);
+#endif /* CY_QI_BMC_RX_CLK_RECOVERY_EN */
+        }
+        else if ((cls == CY_QI_BMC_RX_RUN_FULL) &&
+                 ((dec->preambleHalfCnt >> 1u) >= CY_QI_BMC_RX_MIN_PREAMBLE_COUNT))
+        {
+            /* Full bit after the preamble is the start bit of the header. */
+            dec->state = CY_QI_BMC_LUT_ST_DATA;
+            dec->halfPending = false;
+            dec->bitIdx = 1u;
+            dec->charBits = 0u;
+            dec->charPar = 0u;
+            dec->byteIdx = 0u;
+            dec->pktChk = 0u;
+            evt = CY_QI_ASK_EVT_START_BIT;
+
+            if (dec->stats != NULL)
+            {
+                bin = (uint16_t)(dec->preambleHalfCnt >> 3u);
+                dec->stats->preambleHist[(bin < CY_QI_ASK_STATS_PREAMBLE_BINS) ?
+                    bin : (CY_QI_ASK_STATS_PREAMBLE_BINS - 1u)]++;
+            }
+        }
+        else
+        {
+            /*
+             * Preamble broken after at least one bit: report it as noise. It
+             * is counted once the reception ends without a packet.
+             */
+            if (dec->preambleHalfCnt > 1u)
+            {
+                evt = CY_QI_ASK_EVT_BIT_ERR;
+                dec->failRs = CY_QI_ASK_FAIL_RS_BAD_PREAMBLE;
+            }
+            dec->preambleHalfCnt = 0u;
+#if (CY_QI_BMC_RX_CLK_RECOVERY_EN != 0)
+            dec->halfEst = CY_QI_BMC_RX_HALF_EST_NOMINAL;
+#endif /* CY_QI_BMC_RX_CLK_RECOVERY_EN */
+        }
+    }
+    else if (dec->state == CY_QI_BMC_LUT_ST_DATA)
+    {
+        if ((dec->stats != NULL) && (cls != CY_QI_BMC_RX_RUN_IDLE))
+        {
+            /* Deviation from the nominal width: half or full bit. */
+            bin = (cls != CY_QI_BMC_RX_RUN_FULL) ?
+                (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE >> 1u) : CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE;
+            bin = (len > bin) ? (uint16_t)(len - bin) : (uint16_t)(bin - len);
+            dec->stats->jitterHist[(bin < CY_QI_ASK_STATS_JITTER_BINS) ?
+                bin : (CY_QI_ASK_STATS_JITTER_BINS - 1u)]++;
+        }
+
+#if (CY_QI_BMC_RX_CLK_RECOVERY_EN != 0)
+        if (cls == CY_QI_BMC_RX_RUN_HALF)
+        {
+            bmc_rx_lut_track(dec, (uint32_t)len << 4u, CY_QI_BMC_RX_TRACK_DATA_SHIFT);
+        }
+        else if (cls == CY_QI_BMC_RX_RUN_FULL)
+        {
+            bmc_rx_lut_track(dec, (uint32_t)len << 3u, CY_QI_BMC_RX_TRACK_DATA_SHIFT);
+        }
+        else
+        {
+            /* Glitch or idle: no timing information. */
+        }
+#endif /* CY_QI_BMC_RX_CLK_RECOVERY_EN */
+
+        if (cls == CY_QI_BMC_RX_RUN_GLITCH)
+        {
+            evt = bmc_rx_lut_fail(dec, CY_QI_ASK_FAIL_TYPE_BIT_UNDERFLOW);
+        }
+        else if (cls == CY_QI_BMC_RX_RUN_HALF)
+        {
+            dec->halfPending = !dec->halfPending;
+            if (!dec->halfPending)
+            {
+                evt = bmc_rx_lut_bit(dec, 1u);
+            }
+            else if ((dec->bitIdx == CY_QI_BMC_RX_CHAR_STOP_POS) &&
+                     ((dec->byteIdx + 1u) == dec->pktLen))
+            {
+                /*
+                 * First half of the checksum stop bit. Nothing after this can
+                 * change the packet, so complete it without waiting for the
+                 * second half or the idle line.
+                 */
+                dec->halfPending = false;
+                evt = bmc_rx_lut_bit(dec, 1u);
+            }
+            else
+            {
+                /* Wait for the second half of the one bit. */
+            }
+        }
+        else if (cls == CY_QI_BMC_RX_RUN_FULL)
+        {
+            if (dec->halfPending)
+            {
+                evt = bmc_rx_lut_fail(dec, CY_QI_ASK_FAIL_TYPE_BIT_UNDERFLOW);
+            }
+            else
+            {
+                evt = bmc_rx_lut_bit(dec, 0u);
+            }
+        }
+        else
+        {
+            /* Line went idle in the middle of the packet. */
+            evt = bmc_rx_lut_fail(dec, CY_QI_ASK_FAIL_TYPE_BIT_UNDERFLOW);
+        }
+    }
+    else
+    {
+        /* Packet already completed or failed: ignore the tail. */
+    }
+
+    return evt;
+}
+
+/* Extends the open run by count samples. */
+static void bmc_rx_lut_extend(cy_stc_qi_bmc_lut_dec_t *dec, uint8_t count)
+{
+    if (dec->runLen < CY_QI_BMC_RX_RUN_SAT)
+    {
+        dec->runLen += count;
+    }
+}
+
+/* Feeds up to eight raw samples, LSB first, through the edge table. */
+static cy_en_qi_ask_pkt_evt_t bmc_rx_lut_byte(cy_stc_qi_bmc_lut_dec_t *dec,
+        uint8_t sample, uint8_t count)
+{
+    cy_en_qi_ask_pkt_evt_t result = CY_QI_ASK_EVT_PKT_NONE;
+    cy_en_qi_ask_pkt_evt_t evt;
+    uint32_t edges;
+    uint32_t entry;
+    uint8_t num;
+    uint8_t pos = 0u;
+    uint8_t edgePos;
+
+    edges = ((uint32_t)sample ^ (((uint32_t)sample << 1u) | dec->level)) &
+            ((1u << count) - 1u);
+    dec->level = (uint8_t)((sample >> (count - 1u)) & 0x01u);
+
+    if (edges == 0u)
+    {
+        bmc_rx_lut_extend(dec, count);
+        return result;
+    }
+
+    entry = gl_bmc_rx_edge_lut[edges];
+    num = (uint8_t)(entry & CY_QI_BMC_RX_LUT_CNT_MASK);
+    entry >>= CY_QI_BMC_RX_LUT_POS_SHIFT;
+
+    while (num != 0u)
+    {
+        edgePos = (uint8_t)(entry & CY_QI_BMC_RX_LUT_POS_MASK);
+        entry >>= CY_QI_BMC_RX_LUT_POS_BITS;
+        num--;
+
+        evt = bmc_rx_lut_run(dec, (uint16_t)(dec->runLen + edgePos - pos));
+        dec->runLen = 0u;
+        pos = edgePos;
+
+        if (evt != CY_QI_ASK_EVT_PKT_NONE)
+        {
+            result = evt;
+            if (bmc_rx_lut_is_final(evt))
+            {
+#if ((CY_QI_ASK_PKT_TIMESTAMP_EN != 0) && (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0))
+                dec->endSample = (uint16_t)(dec->sampleIdx + edgePos);
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN && !CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+                return result;
+            }
+        }
+    }
+
+    dec->runLen = (uint16_t)(count - pos);
+    return result;
+}
+
+void bmc_rx_lut_init(cy_stc_qi_bmc_lut_dec_t *dec, cy_stc_qi_ask_pkt_t *pkt)
+{
+    dec->pkt = pkt;
+    dec->stats = NULL;
+    dec->state = CY_QI_BMC_LUT_ST_PREAMBLE;
+    dec->isPrimed = false;
+    dec->level = 0u;
+    dec->runLen = 0u;
+    dec->preambleHalfCnt = 0u;
+    dec->halfPending = false;
+    dec->bitIdx = 0u;
+    dec->charBits = 0u;
+    dec->charPar = 0u;
+    dec->byteIdx = 0u;
+    dec->pktChk = 0u;
+    dec->pktLen = 0u;
+    dec->failRs = CY_QI_ASK_FAIL_RS_NONE;
+    dec->failType = CY_QI_ASK_FAIL_TYPE_NONE;
+#if (CY_QI_BMC_RX_CLK_RECOVERY_EN != 0)
+    dec->halfEst = CY_QI_BMC_RX_HALF_EST_NOMINAL;
+#endif /* CY_QI_BMC_RX_CLK_RECOVERY_EN */
+#if ((CY_QI_ASK_PKT_TIMESTAMP_EN != 0) && (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0))
+    dec->sampleIdx = 0u;
+    dec->endSample = 0u;
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN && !CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+#if (CY_QI_BMC_RX_EDGE_CAPTURE_EN != 0)
+    dec->edgeTime = 0u;
+    dec->edgeLogIdx = 0u;
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+}
+
+cy_en_qi_ask_pkt_evt_t bmc_rx_lut_feed(cy_stc_qi_bmc_lut_dec_t *dec,
+              const uint8_t *raw, uint16_t bitCount)
+{
+    cy_en_qi_ask_pkt_evt_t result = CY_QI_ASK_EVT_PKT_NONE;
+    cy_en_qi_ask_pkt_evt_t evt;
+    uint16_t idx = 0u;
+    uint16_t byteCount = bitCount >> 3u;
+
+    if ((bitCount == 0u) || (dec->state == CY_QI_BMC_LUT_ST_DONE) ||
+        (dec->state == CY_QI_BMC_LUT_ST_ERROR))
+    {
+        return result;
+    }
+
+    if (!dec->isPrimed)
+    {
+        /* Start with the idle level so that the first sample is not an edge. */
+        dec->level = raw[0] & 0x01u;
+        dec->isPrimed = true;
+    }
+
+    while (idx < byteCount)
+    {
+#if (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE > 8u)
+        /* At 16X most half words carry no transition at all. */
+        if ((idx + 1u) < byteCount)
+        {
+            uint16_t word = MAKE_WORD(raw[idx + 1u], raw[idx]);
+
+            if (word == ((dec->level != 0u) ? 0xFFFFu : 0x0000u))
+            {
+                bmc_rx_lut_extend(dec, 16u);
+#if ((CY_QI_ASK_PKT_TIMESTAMP_EN != 0) && (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0))
+                dec->sampleIdx += 16u;
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN && !CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+                idx += 2u;
+                continue;
+            }
+        }
+#endif /* (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE > 8u) */
+
+        evt = bmc_rx_lut_byte(dec, raw[idx], 8u);
+        idx++;
+#if ((CY_QI_ASK_PKT_TIMESTAMP_EN != 0) && (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0))
+        dec->sampleIdx += 8u;
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN && !CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+
+        if (evt != CY_QI_ASK_EVT_PKT_NONE)
+        {
+            result = evt;
+            if (bmc_rx_lut_is_final(evt))
+            {
+                return result;
+            }
+        }
+    }
+
+    if ((bitCount & 0x07u) != 0u)
+    {
+        evt = bmc_rx_lut_byte(dec, raw[idx], (uint8_t)(bitCount & 0x07u));
+        if (evt != CY_QI_ASK_EVT_PKT_NONE)
+        {
+            result = evt;
+        }
+#if ((CY_QI_ASK_PKT_TIMESTAMP_EN != 0) && (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0))
+        dec->sampleIdx += (uint16_t)(bitCount & 0x07u);
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN && !CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+    }
+
+    return result;
+}
+
+cy_en_qi_ask_pkt_evt_t bmc_rx_lut_flush(cy_stc_qi_bmc_lut_dec_t *dec)
+{
+    cy_en_qi_ask_pkt_evt_t evt = CY_QI_ASK_EVT_PKT_NONE;
+
+    if ((dec->state == CY_QI_BMC_LUT_ST_PREAMBLE) || (dec->state == CY_QI_BMC_LUT_ST_DATA))
+    {
+        /* Treat the open run as idle line. */
+        evt = bmc_rx_lut_run(dec, UINT16_MAX);
+    }
+
+    return evt;
+}
+
+#if (CY_QI_BMC_RX_EDGE_CAPTURE_EN != 0)
+cy_en_qi_ask_pkt_evt_t bmc_rx_lut_edge(cy_stc_qi_bmc_lut_dec_t *dec, uint16_t timestamp)
+{
+    cy_en_qi_ask_pkt_evt_t evt = CY_QI_ASK_EVT_PKT_NONE;
+
+    if ((dec->state == CY_QI_BMC_LUT_ST_DONE) || (dec->state == CY_QI_BMC_LUT_ST_ERROR))
+    {
+        return evt;
+    }
+
+    if (dec->isPrimed)
+    {
+        /* Unsigned subtraction handles the counter wrap. */
+        evt = bmc_rx_lut_run(dec, (uint16_t)(timestamp - dec->edgeTime));
+    }
+
+    dec->isPrimed = true;
+    dec->level ^= 0x01u;
+    dec->edgeTime = timestamp;
+
+    return evt;
+}
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+
+cy_en_qi_ask_pkt_evt_t bmc_rx_lut_decode(cy_stc_qi_bmc_lut_dec_t *dec,
+              const uint8_t *raw, uint16_t bitCount)
+{
+    cy_en_qi_ask_pkt_evt_t evt;
+
+    evt = bmc_rx_lut_feed(dec, raw, bitCount);
+
+    if (!bmc_rx_lut_is_final(evt))
+    {
+        evt = bmc_rx_lut_flush(dec);
+    }
+
+    if (!bmc_rx_lut_is_final(evt))
+    {
+        evt = CY_QI_ASK_EVT_PKT_NONE;
+    }
+
+    return evt;
+}
+
+#if (CY_QI_BMC_RX_CAPTURE_EN != 0)
+static void bmc_rx_lut_cap_record(cy_stc_qi_context_t *qiCtx, uint8_t type,
+        const uint8_t *payload, uint8_t len)
+{
+    cy_stc_qi_bmc_lut_t *bmcLut = &qiCtx->bmcLut;
+    uint8_t rec[CY_QI_BMC_CAP_REC_HDR_SIZE + CY_QI_BMC_CAP_REC_MAX_PAYLOAD];
+
+    if ((bmcLut->cy_cb_ask_capture == NULL) || (len > CY_QI_BMC_CAP_REC_MAX_PAYLOAD))
+    {
+        return;
+    }
+
+    rec[0] = type;
+    rec[1] = len;
+    (void)memcpy(&rec[CY_QI_BMC_CAP_REC_HDR_SIZE], payload, len);
+
+    bmcLut->cy_cb_ask_capture(qiCtx, rec, (uint8_t)(len + CY_QI_BMC_CAP_REC_HDR_SIZE));
+}
+
+static void bmc_rx_lut_cap_event(cy_stc_qi_context_t *qiCtx, uint8_t type, uint8_t id)
+{
+    uint16_t idx = qiCtx->bmcLut.capSampleIdx;
+    uint8_t payload[3];
+
+    payload[0] = id;
+    payload[1] = (uint8_t)GET_LOWER_BYTE(idx);
+    payload[2] = (uint8_t)GET_HIGHER_BYTE(idx);
+
+    bmc_rx_lut_cap_record(qiCtx, type, payload, (uint8_t)sizeof(payload));
+}
+#endif /* CY_QI_BMC_RX_CAPTURE_EN */
+
+#if CY_QI_ASK_PKT_TIMESTAMP_EN
+/*
+ * Stamps the packet of a decoder with the time of its end of checksum edge.
+ * The edge lies age raw samples before now; the age is taken off the current
+ * count.
+ */
+static void bmc_rx_lut_stamp(cy_stc_qi_context_t *qiCtx, cy_stc_qi_bmc_lut_dec_t *dec, uint16_t age)
+{
+    uint32_t (*get_timestamp)(struct cy_stc_qi_context *qiCtx) = qiCtx->ptrAppCbk->get_timestamp;
+    uint32_t now = (get_timestamp != NULL) ? get_timestamp(qiCtx) : 0u;
+
+    dec->pktTime = now - (((uint32_t)age * CY_QI_TIMESTAMP_FREQ_KHZ) / CY_QI_BMC_RX_SAMPLES_PER_MS);
+}
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN */
+
+#if (CY_QI_ASK_PKT_QUEUE_DEPTH != 0)
+/* Receive time of a completed packet: its checksum edge, or now without packet timestamps. */
+static uint32_t bmc_rx_lut_pkt_time(cy_stc_qi_context_t *qiCtx, const cy_stc_qi_bmc_lut_dec_t *dec)
+{
+#if CY_QI_ASK_PKT_TIMESTAMP_EN
+    (void)qiCtx;
+    return dec->pktTime;
+#else
+    uint32_t (*get_timestamp)(struct cy_stc_qi_context *qiCtx) = qiCtx->ptrAppCbk->get_timestamp;
+
+    (void)dec;
+    return (get_timestamp != NULL) ? get_timestamp(qiCtx) : 0u;
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN */
+}
+#endif /* CY_QI_ASK_PKT_QUEUE_DEPTH */
+
+/* Accounts the final result of a reception, queues a packet and posts the packet event. */
+static void bmc_rx_lut_pkt_final(cy_stc_qi_context_t *qiCtx, const cy_stc_qi_bmc_lut_dec_t *dec,
+        cy_en_qi_ask_path_t path, cy_en_qi_ask_pkt_evt_t evt)
+{
+    cy_stc_qi_ask_stats_t *stats = &qiCtx->bmcLut.askStats;
+    cy_en_qi_ask_fail_rs_t failRs = dec->failRs;
+    cy_en_qi_ask_fail_type_t failType = dec->failType;
+
+#if CY_QI_TASK_EVT_EN
+    /* A failed reception is handled by the communication layer as well. */
+    Cy_QiStack_Evt_Set(qiCtx, CY_QI_EVT_ASK_PKT);
+#endif /* CY_QI_TASK_EVT_EN */
+
+    if (evt == CY_QI_ASK_EVT_PKT_READY)
+    {
+        stats->pktOkCnt++;
+        if (path < CY_QI_ASK_PATH_MAX)
+        {
+            stats->pathOkCnt[path]++;
+        }
+#if CY_QI_ASK_PKT_TIMESTAMP_EN
+        qiCtx->bmcLut.pktTime = dec->pktTime;
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN */
+#if (CY_QI_ASK_PKT_QUEUE_DEPTH != 0)
+        (void)Cy_QiStack_Ask_Pkt_Queue_Push(qiCtx, &qiCtx->qiCommStat.askBmc.pkt,
+                bmc_rx_lut_pkt_time(qiCtx, dec));
+#endif /* CY_QI_ASK_PKT_QUEUE_DEPTH */
+        return;
+    }
+
+    if (dec->state != CY_QI_BMC_LUT_ST_ERROR)
+    {
+        /* Still in the preamble: one reason per reception, even after noise. */
+        if (failRs != CY_QI_ASK_FAIL_RS_BAD_PREAMBLE)
+        {
+            failRs = CY_QI_ASK_FAIL_RS_NO_PKT_START;
+        }
+        failType = CY_QI_ASK_FAIL_TYPE_NONE;
+    }
+
+    stats->failRsCnt[failRs]++;
+    stats->failTypeCnt[failType]++;
+
+#if QI_STACK_ASK_DEBUG
+    qiCtx->qiCommStat.askBmc.askFailReason = failRs;
+    qiCtx->qiCommStat.askBmc.askFailType = failType;
+    qiCtx->qiCommStat.askBmc.askFailByteLoc = dec->byteIdx;
+    qiCtx->qiCommStat.askBmc.askFailBitLoc =
+        (uint16_t)((dec->byteIdx * CY_QI_BMC_RX_CHAR_BITS) + dec->bitIdx);
+#endif /* QI_STACK_ASK_DEBUG */
+}
+
+/* Reports a decoder event of the single path receiver. */
+static void bmc_rx_lut_rx_evt(cy_stc_qi_context_t *qiCtx, cy_en_qi_ask_pkt_evt_t evt)
+{
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &qiCtx->qiCommStat.askBmc;
+
+    if (evt == CY_QI_ASK_EVT_START_BIT)
+    {
+        askBmc->startBitDet = true;
+        if (qiCtx->qiCommStat.askCfg.askPath < CY_QI_ASK_PATH_MAX)
+        {
+            qiCtx->bmcLut.askStats.pathStartCnt[qiCtx->qiCommStat.askCfg.askPath]++;
+        }
+    }
+
+    /* Intermediate events are reported as they occur, not per FIFO batch. */
+    if ((evt != CY_QI_ASK_EVT_PKT_NONE) && (!bmc_rx_lut_is_final(evt)) &&
+        (askBmc->cy_cb_ask_pkt_evt != NULL))
+    {
+        (void)askBmc->cy_cb_ask_pkt_evt(qiCtx, evt);
+    }
+}
+
+/* Completes the packet of the single path receiver from interrupt context. */
+static void bmc_rx_lut_rx_final(cy_stc_qi_context_t *qiCtx, cy_en_qi_ask_pkt_evt_t evt)
+{
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &qiCtx->qiCommStat.askBmc;
+
+    askBmc->isRcvDone = true;
+    askBmc->isDataReady = true;
+    bmc_rx_lut_pkt_final(qiCtx, &qiCtx->bmcLut.lutDec, qiCtx->qiCommStat.askCfg.askPath, evt);
+
+#if (CY_QI_BMC_RX_CAPTURE_EN != 0)
+    bmc_rx_lut_cap_event(qiCtx, CY_QI_BMC_CAP_REC_END, (uint8_t)evt);
+#endif /* CY_QI_BMC_RX_CAPTURE_EN */
+
+    if (askBmc->cy_cb_ask_pkt_evt != NULL)
+    {
+        (void)askBmc->cy_cb_ask_pkt_evt(qiCtx, evt);
+    }
+}
+
+#if ((CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0) || (CY_QI_BMC_RX_CAPTURE_EN != 0))
+/* Processes raw SPI data drained from the RX FIFO or replayed, one SPI word at a time. */
+static void bmc_rx_lut_rx_data(cy_stc_qi_context_t *qiCtx, const uint8_t *data, uint8_t len)
+{
+#if (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0)
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &qiCtx->qiCommStat.askBmc;
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+    cy_en_qi_ask_pkt_evt_t evt = CY_QI_ASK_EVT_PKT_NONE;
+    uint8_t idx;
+#if ((CY_QI_ASK_PKT_TIMESTAMP_EN != 0) && (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0))
+    /* The last sample of the batch was taken about when the FIFO was drained. */
+    uint16_t batchEnd = (uint16_t)(qiCtx->bmcLut.lutDec.sampleIdx + ((uint16_t)len << 3u));
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN && !CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+
+#if (CY_QI_BMC_RX_CAPTURE_EN != 0)
+    bmc_rx_lut_cap_record(qiCtx, CY_QI_BMC_CAP_REC_SPI, data, len);
+#endif /* CY_QI_BMC_RX_CAPTURE_EN */
+
+    for (idx = 0u; (idx < len) && (!bmc_rx_lut_is_final(evt)); idx += CY_QI_BMC_RX_SPI_WORD_BYTES)
+    {
+#if (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0)
+        /* Keep the raw copy while it fits; decoding does not depend on it. */
+        if ((askBmc->rawDataCount + CY_QI_BMC_RX_SPI_WORD_BYTES) <= CY_QI_BMC_RX_SPI_RAW_DATA_SIZE)
+        {
+            (void)memcpy(&askBmc->rawData[askBmc->rawDataCount], &data[idx], CY_QI_BMC_RX_SPI_WORD_BYTES);
+            askBmc->rawDataCount += CY_QI_BMC_RX_SPI_WORD_BYTES;
+            askBmc->rawBitCount += (uint16_t)(CY_QI_BMC_RX_SPI_WORD_BYTES << 3u);
+        }
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+
+#if (CY_QI_BMC_RX_CAPTURE_EN != 0)
+        if (qiCtx->bmcLut.capSampleIdx <= (UINT16_MAX - (CY_QI_BMC_RX_SPI_WORD_BYTES << 3u)))
+        {
+            qiCtx->bmcLut.capSampleIdx += (uint16_t)(CY_QI_BMC_RX_SPI_WORD_BYTES << 3u);
+        }
+#endif /* CY_QI_BMC_RX_CAPTURE_EN */
+
+        evt = bmc_rx_lut_feed(&qiCtx->bmcLut.lutDec, &data[idx], (uint16_t)(CY_QI_BMC_RX_SPI_WORD_BYTES << 3u));
+        bmc_rx_lut_rx_evt(qiCtx, evt);
+    }
+
+    if (bmc_rx_lut_is_final(evt))
+    {
+#if ((CY_QI_ASK_PKT_TIMESTAMP_EN != 0) && (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0))
+        bmc_rx_lut_stamp(qiCtx, &qiCtx->bmcLut.lutDec, (uint16_t)(batchEnd - qiCtx->bmcLut.lutDec.endSample));
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN && !CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+        bmc_rx_lut_rx_final(qiCtx, evt);
+    }
+}
+#endif /* !CY_QI_BMC_RX_EDGE_CAPTURE_EN || CY_QI_BMC_RX_CAPTURE_EN */
+
+#if (CY_QI_BMC_RX_EDGE_CAPTURE_EN != 0)
+/*
+ * Logs the run a new edge closes in the slice of askBmc.rawData that belongs
+ * to the decoder. SPI samples are not kept in this mode.
+ */
+static void bmc_rx_lut_edge_log(cy_stc_qi_context_t *qiCtx, cy_stc_qi_bmc_lut_dec_t *dec,
+        uint8_t slice, uint16_t timestamp)
+{
+    uint16_t len = (uint16_t)(timestamp - dec->edgeTime);
+
+    if ((dec->isPrimed) && (dec->state != CY_QI_BMC_LUT_ST_DONE) && (dec->state != CY_QI_BMC_LUT_ST_ERROR))
+    {
+        qiCtx->qiCommStat.askBmc.rawData[(slice * CY_QI_BMC_RX_EDGE_LOG_SIZE) + dec->edgeLogIdx] =
+            (len > UINT8_MAX) ? UINT8_MAX : (uint8_t)len;
+        dec->edgeLogIdx = (uint8_t)((dec->edgeLogIdx + 1u) & (CY_QI_BMC_RX_EDGE_LOG_SIZE - 1u));
+    }
+}
+
+void bmc_rx_lut_rx_edge(cy_stc_qi_context_t *qiCtx, uint16_t timestamp)
+{
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &qiCtx->qiCommStat.askBmc;
+    cy_en_qi_ask_pkt_evt_t evt;
+
+    if (askBmc->isDataReady)
+    {
+        return;
+    }
+
+    bmc_rx_lut_edge_log(qiCtx, &qiCtx->bmcLut.lutDec, 0u, timestamp);
+    evt = bmc_rx_lut_edge(&qiCtx->bmcLut.lutDec, timestamp);
+    bmc_rx_lut_rx_evt(qiCtx, evt);
+
+    if (bmc_rx_lut_is_final(evt))
+    {
+#if CY_QI_ASK_PKT_TIMESTAMP_EN
+        /* This edge closed the checksum. */
+        bmc_rx_lut_stamp(qiCtx, &qiCtx->bmcLut.lutDec, 0u);
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN */
+        bmc_rx_lut_rx_final(qiCtx, evt);
+    }
+}
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+
+void bmc_rx_lut_rx_start(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &qiCtx->qiCommStat.askBmc;
+#if (CY_QI_BMC_RX_CAPTURE_EN != 0)
+    uint8_t payload[3];
+#endif /* CY_QI_BMC_RX_CAPTURE_EN */
+
+    bmc_rx_lut_init(&qiCtx->bmcLut.lutDec, &askBmc->pkt);
+    qiCtx->bmcLut.lutDec.stats = &qiCtx->bmcLut.askStats;
+#if (CY_QI_BMC_RX_EDGE_CAPTURE_EN != 0)
+    (void)memset(askBmc->rawData, 0, CY_QI_BMC_RX_EDGE_LOG_SIZE);
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+    askBmc->rawDataCount = 0u;
+    askBmc->rawBitCount = 0u;
+    askBmc->isRcvDone = false;
+    askBmc->isDataReady = false;
+
+#if (CY_QI_BMC_RX_CAPTURE_EN != 0)
+    qiCtx->bmcLut.capSampleIdx = 0u;
+    payload[0] = CY_QI_BMC_CAP_VERSION;
+    payload[1] = CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE;
+    payload[2] = (uint8_t)qiCtx->qiCommStat.askCfg.askPath;
+    bmc_rx_lut_cap_record(qiCtx, CY_QI_BMC_CAP_REC_START, payload, (uint8_t)sizeof(payload));
+#endif /* CY_QI_BMC_RX_CAPTURE_EN */
+}
+
+void bmc_rx_lut_scb_fifo_handler(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &qiCtx->qiCommStat.askBmc;
+    uint8_t data[CY_QI_BMC_RX_SPI_FIFO_SIZE * CY_QI_BMC_RX_SPI_WORD_BYTES];
+    uint32_t num;
+    uint32_t word;
+    uint8_t len = 0u;
+
+    num = Cy_SCB_SPI_GetNumInRxFifo(askBmc->scb);
+    if (num > CY_QI_BMC_RX_SPI_FIFO_SIZE)
+    {
+        num = CY_QI_BMC_RX_SPI_FIFO_SIZE;
+    }
+
+    while (num != 0u)
+    {
+        word = Cy_SCB_SPI_Read(askBmc->scb);
+        num--;
+
+        data[len] = (uint8_t)GET_LOWER_BYTE(word);
+#if (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE > 8u)
+        data[len + 1u] = (uint8_t)GET_HIGHER_BYTE(word);
+#endif /* (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE > 8u) */
+        len += CY_QI_BMC_RX_SPI_WORD_BYTES;
+    }
+
+    Cy_SCB_ClearRxInterrupt(askBmc->scb, CY_SCB_RX_INTR_LEVEL);
+
+#if (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0)
+    if ((len != 0u) && (!askBmc->isDataReady))
+    {
+        bmc_rx_lut_rx_data(qiCtx, data, len);
+    }
+#else
+    /* Transitions come from bmc_rx_lut_rx_edge: the samples are dropped. */
+    (void)data;
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+}
+
+#if (CY_QI_BMC_RX_MULTI_PATH_EN != 0)
+static void bmc_rx_lut_multi_notify(cy_stc_qi_context_t *qiCtx, uint8_t pathIdx,
+        cy_en_qi_ask_pkt_evt_t evt)
+{
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &qiCtx->qiCommStat.askBmc;
+
+    if (bmc_rx_lut_is_final(evt))
+    {
+        askBmc->isRcvDone = true;
+        askBmc->isDataReady = true;
+        bmc_rx_lut_pkt_final(qiCtx, &qiCtx->bmcLut.pathDec[pathIdx],
+                qiCtx->qiCommStat.askCfg.askPathSeq[pathIdx], evt);
+    }
+
+    if (askBmc->cy_cb_ask_pkt_evt != NULL)
+    {
+        (void)askBmc->cy_cb_ask_pkt_evt(qiCtx, evt);
+    }
+}
+
+static void bmc_rx_lut_multi_arbitrate(cy_stc_qi_context_t *qiCtx, uint8_t pathIdx,
+        cy_en_qi_ask_pkt_evt_t evt)
+{
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &qiCtx->qiCommStat.askBmc;
+    cy_en_qi_ask_path_t path = qiCtx->qiCommStat.askCfg.askPathSeq[pathIdx];
+    uint8_t idx;
+
+    if (askBmc->isDataReady)
+    {
+        /* Packet already delivered by another path. */
+        return;
+    }
+
+    if (evt == CY_QI_ASK_EVT_START_BIT)
+    {
+        if (path < CY_QI_ASK_PATH_MAX)
+        {
+            qiCtx->bmcLut.askStats.pathStartCnt[path]++;
+        }
+
+        if (!askBmc->startBitDet)
+        {
+            askBmc->startBitDet = true;
+            bmc_rx_lut_multi_notify(qiCtx, pathIdx, evt);
+        }
+    }
+    else if (evt == CY_QI_ASK_EVT_PKT_READY)
+    {
+        askBmc->pkt = qiCtx->bmcLut.pathPkt[pathIdx];
+        qiCtx->bmcLut.pathWinIdx = pathIdx;
+        bmc_rx_lut_multi_notify(qiCtx, pathIdx, evt);
+    }
+    else if (evt == CY_QI_ASK_EVT_PKT_ERR)
+    {
+        /* Only fail once no other path can deliver the packet anymore. */
+        for (idx = 0u; idx < CY_QI_MAX_NUM_ASK_SWITCH_OVER; idx++)
+        {
+            if (qiCtx->bmcLut.pathDec[idx].state != CY_QI_BMC_LUT_ST_ERROR)
+            {
+                return;
+            }
+        }
+
+        bmc_rx_lut_multi_notify(qiCtx, pathIdx, evt);
+    }
+    else
+    {
+        /* Preamble noise on a single path is not reported. */
+    }
+}
+
+void bmc_rx_lut_multi_rx_start(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &qiCtx->qiCommStat.askBmc;
+    uint8_t idx;
+
+    for (idx = 0u; idx < CY_QI_MAX_NUM_ASK_SWITCH_OVER; idx++)
+    {
+        bmc_rx_lut_init(&qiCtx->bmcLut.pathDec[idx], &qiCtx->bmcLut.pathPkt[idx]);
+        qiCtx->bmcLut.pathDec[idx].stats = &qiCtx->bmcLut.askStats;
+    }
+
+    qiCtx->bmcLut.pathWinIdx = CY_QI_MAX_NUM_ASK_SWITCH_OVER;
+#if (CY_QI_BMC_RX_EDGE_CAPTURE_EN != 0)
+    (void)memset(askBmc->rawData, 0, CY_QI_BMC_RX_EDGE_LOG_SIZE * CY_QI_MAX_NUM_ASK_SWITCH_OVER);
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+    askBmc->startBitDet = false;
+    askBmc->isRcvDone = false;
+    askBmc->isDataReady = false;
+}
+
+void bmc_rx_lut_multi_feed(cy_stc_qi_context_t *qiCtx, uint8_t pathIdx,
+              const uint8_t *raw, uint16_t bitCount)
+{
+    cy_en_qi_ask_pkt_evt_t evt;
+    cy_stc_qi_bmc_lut_dec_t *dec;
+#if ((CY_QI_ASK_PKT_TIMESTAMP_EN != 0) && (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0))
+    uint16_t batchEnd;
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN && !CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+
+    if (pathIdx >= CY_QI_MAX_NUM_ASK_SWITCH_OVER)
+    {
+        return;
+    }
+
+    dec = &qiCtx->bmcLut.pathDec[pathIdx];
+#if ((CY_QI_ASK_PKT_TIMESTAMP_EN != 0) && (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0))
+    batchEnd = (uint16_t)(dec->sampleIdx + bitCount);
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN && !CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+
+    evt = bmc_rx_lut_feed(dec, raw, bitCount);
+#if ((CY_QI_ASK_PKT_TIMESTAMP_EN != 0) && (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0))
+    if (evt == CY_QI_ASK_EVT_PKT_READY)
+    {
+        bmc_rx_lut_stamp(qiCtx, dec, (uint16_t)(batchEnd - dec->endSample));
+    }
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN && !CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+    bmc_rx_lut_multi_arbitrate(qiCtx, pathIdx, evt);
+}
+
+#if (CY_QI_BMC_RX_EDGE_CAPTURE_EN != 0)
+void bmc_rx_lut_multi_edge(cy_stc_qi_context_t *qiCtx, uint8_t pathIdx, uint16_t timestamp)
+{
+    cy_en_qi_ask_pkt_evt_t evt;
+
+    if (pathIdx >= CY_QI_MAX_NUM_ASK_SWITCH_OVER)
+    {
+        return;
+    }
+
+    bmc_rx_lut_edge_log(qiCtx, &qiCtx->bmcLut.pathDec[pathIdx], pathIdx, timestamp);
+    evt = bmc_rx_lut_edge(&qiCtx->bmcLut.pathDec[pathIdx], timestamp);
+#if CY_QI_ASK_PKT_TIMESTAMP_EN
+    if (evt == CY_QI_ASK_EVT_PKT_READY)
+    {
+        bmc_rx_lut_stamp(qiCtx, &qiCtx->bmcLut.pathDec[pathIdx], 0u);
+    }
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN */
+    bmc_rx_lut_multi_arbitrate(qiCtx, pathIdx, evt);
+}
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+
+void bmc_rx_lut_multi_flush(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &qiCtx->qiCommStat.askBmc;
+    uint8_t errIdx = 0u;
+    uint8_t idx;
+
+    for (idx = 0u; (idx < CY_QI_MAX_NUM_ASK_SWITCH_OVER) && (!askBmc->isDataReady); idx++)
+    {
+        bmc_rx_lut_multi_arbitrate(qiCtx, idx, bmc_rx_lut_flush(&qiCtx->bmcLut.pathDec[idx]));
+    }
+
+    if (!askBmc->isDataReady)
+    {
+        /*
+         * Paths that never saw a preamble leave nothing to arbitrate. Report
+         * the reason of a failed path if there is one.
+         */
+        for (idx = CY_QI_MAX_NUM_ASK_SWITCH_OVER; idx != 0u; idx--)
+        {
+            if (qiCtx->bmcLut.pathDec[idx - 1u].state == CY_QI_BMC_LUT_ST_ERROR)
+            {
+                errIdx = idx - 1u;
+            }
+        }
+
+        bmc_rx_lut_multi_notify(qiCtx, errIdx, CY_QI_ASK_EVT_PKT_ERR);
+    }
+}
+#endif /* CY_QI_BMC_RX_MULTI_PATH_EN */
+
+void bmc_rx_lut_task(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &qiCtx->qiCommStat.askBmc;
+
+    if ((!askBmc->isRcvDone) || (askBmc->isDataReady))
+    {
+        return;
+    }
+
+    /*
+     * Samples were decoded as they arrived and a completed packet was already
+     * delivered from the interrupt: only terminate the open packet. A flush
+     * can fail the packet but never complete it.
+     */
+    (void)bmc_rx_lut_flush(&qiCtx->bmcLut.lutDec);
+
+    askBmc->isDataReady = true;
+    bmc_rx_lut_pkt_final(qiCtx, &qiCtx->bmcLut.lutDec, qiCtx->qiCommStat.askCfg.askPath,
+            CY_QI_ASK_EVT_PKT_ERR);
+
+#if (CY_QI_BMC_RX_CAPTURE_EN != 0)
+    bmc_rx_lut_cap_event(qiCtx, CY_QI_BMC_CAP_REC_END, (uint8_t)CY_QI_ASK_EVT_PKT_ERR);
+#endif /* CY_QI_BMC_RX_CAPTURE_EN */
+
+    if (askBmc->cy_cb_ask_pkt_evt != NULL)
+    {
+        (void)askBmc->cy_cb_ask_pkt_evt(qiCtx, CY_QI_ASK_EVT_PKT_ERR);
+    }
+}
+
+#if (CY_QI_BMC_RX_CAPTURE_EN != 0)
+void bmc_rx_lut_cap_cmp_event(cy_stc_qi_context_t *qiCtx, uint8_t cmpEvt)
+{
+    bmc_rx_lut_cap_event(qiCtx, CY_QI_BMC_CAP_REC_CMP, cmpEvt);
+}
+
+cy_en_qi_status_t bmc_rx_lut_replay(cy_stc_qi_context_t *qiCtx, const uint8_t *cap, uint32_t len)
+{
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &qiCtx->qiCommStat.askBmc;
+    const uint8_t *payload;
+    uint32_t pos = 0u;
+    uint8_t type;
+    uint8_t size;
+
+    while (pos < len)
+    {
+        if ((len - pos) < CY_QI_BMC_CAP_REC_HDR_SIZE)
+        {
+            return CY_QISTACK_STAT_BAD_PARAM;
+        }
+
+        type = cap[pos];
+        size = cap[pos + 1u];
+        payload = &cap[pos + CY_QI_BMC_CAP_REC_HDR_SIZE];
+        pos += CY_QI_BMC_CAP_REC_HDR_SIZE;
+
+        if ((len - pos) < size)
+        {
+            return CY_QISTACK_STAT_BAD_PARAM;
+        }
+        pos += size;
+
+        switch (type)
+        {
+            case CY_QI_BMC_CAP_REC_START:
+                if ((size < 2u) || (payload[0] != CY_QI_BMC_CAP_VERSION) ||
+                    (payload[1] != CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE))
+                {
+                    return CY_QISTACK_STAT_BAD_PARAM;
+                }
+                bmc_rx_lut_rx_start(qiCtx);
+                break;
+
+            case CY_QI_BMC_CAP_REC_SPI:
+                /* Drop a partial trailing SPI word. */
+                size = (uint8_t)(size - (size % CY_QI_BMC_RX_SPI_WORD_BYTES));
+                if ((size != 0u) && (!askBmc->isDataReady))
+                {
+                    bmc_rx_lut_rx_data(qiCtx, payload, size);
+                }
+                break;
+
+            case CY_QI_BMC_CAP_REC_END:
+                /* The receiver stopped collecting samples here. */
+                askBmc->isRcvDone = true;
+                bmc_rx_lut_task(qiCtx);
+                break;
+
+            default:
+                /* Comparator events and unknown records carry no samples. */
+                break;
+        }
+    }
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+#endif /* CY_QI_BMC_RX_CAPTURE_EN */
+
+#if (CCG_HPI_WLC_CMD_ENABLE != 0)
+void Cy_QiStack_Get_ASK_Stats(cy_stc_qi_context_t *qiCtx, uint8_t *buffer)
+{
+    (void)memcpy(buffer, &qiCtx->bmcLut.askStats, sizeof(cy_stc_qi_ask_stats_t));
+}
+
+void Cy_QiStack_Clear_ASK_Stats(cy_stc_qi_context_t *qiCtx)
+{
+    (void)memset(&qiCtx->bmcLut.askStats, 0, sizeof(cy_stc_qi_ask_stats_t));
+}
+#endif /* CCG_HPI_WLC_CMD_ENABLE */
+
+#if (CY_QI_BMC_RX_LUT_WRAP_EN != 0)
+void __real_bmc_rx_start_scan(cy_stc_qi_context_t *qiCtx);
+
+void __wrap_bmc_rx_start_scan(cy_stc_qi_context_t *qiCtx)
+{
+    __real_bmc_rx_start_scan(qiCtx);
+
+    /* The library arms the SCB; its samples go to the table driven decoder. */
+    bmc_rx_lut_rx_start(qiCtx);
+    qiCtx->qiCommStat.askBmc.scb_int_handler = bmc_rx_lut_scb_fifo_handler;
+}
+
+void __wrap_bmc_rx_task(cy_stc_qi_context_t *qiCtx)
+{
+    bmc_rx_lut_task(qiCtx);
+}
+#endif /* CY_QI_BMC_RX_LUT_WRAP_EN */
+
+#endif /* CY_QI_BMC_RX_LUT_EN */
+
+/* [] END OF FILE */
@@ -0,0 +1,260 @@
+/***************************************************************************//**
+* \file cy_qistack_comm_fsk_model.c
+* \version 2.0
+*
+* Source file of the FSK waveform model of the QiStack middleware. Renders the
+* inverter period sequence of an FSK transmission and checks a period sequence
+* against the Qi FSK timing rules. Builds on a host without target hardware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_manager.h"
+
+#if CY_QI_FSK_MODEL_EN
+
+/* Inverter cycles per FSK half bit and bit cell. */
+#define CY_QI_FSK_MODEL_HALF_CYCLES                 (1u << CY_QI_FSK_HALF_BIT_SHIFT)
+#define CY_QI_FSK_MODEL_CELL_CYCLES                 (CY_QI_FSK_MODEL_HALF_CYCLES << 1u)
+
+/* Bits per byte of a data frame and of a response pattern. */
+#define CY_QI_FSK_MODEL_FRAME_BITS                  (11u)
+#define CY_QI_FSK_MODEL_PATTERN_BITS                (8u)
+
+static const uint8_t gl_fsk_model_depth[] =
+{
+    CY_QI_FSK_RESOLUTION_DEPTH_0,
+    CY_QI_FSK_RESOLUTION_DEPTH_1,
+    CY_QI_FSK_RESOLUTION_DEPTH_2,
+    CY_QI_FSK_RESOLUTION_DEPTH_3
+};
+
+static uint16_t fsk_model_bit_count(const cy_stc_qi_comm_fsk_oper_t *oper)
+{
+    return (uint16_t)((uint16_t)oper->dataLen *
+            (oper->frame ? CY_QI_FSK_MODEL_FRAME_BITS : CY_QI_FSK_MODEL_PATTERN_BITS));
+}
+
+/* Returns bit n of the transmission in transmit order. */
+static bool fsk_model_bit(const cy_stc_qi_comm_fsk_oper_t *oper, uint16_t n)
+{
+    uint8_t data;
+    uint8_t pos;
+    bool bit;
+
+    if (oper->frame)
+    {
+        data = oper->data[n / CY_QI_FSK_MODEL_FRAME_BITS];
+        pos = (uint8_t)(n % CY_QI_FSK_MODEL_FRAME_BITS);
+        if (pos == 0u)
+        {
+            bit = false;
+        }
+        else if (pos <= 8u)
+        {
+            bit = (((data >> (pos - 1u)) & 0x01u) != 0u);
+        }
+        else if (pos == 9u)
+        {
+            bit = CY_QI_ODD_PARITY(data);
+        }
+        else
+        {
+            bit = true;
+        }
+    }
+    else
+    {
+        data = oper->data[n / CY_QI_FSK_MODEL_PATTERN_BITS];
+        pos = (uint8_t)(n % CY_QI_FSK_MODEL_PATTERN_BITS);
+        bit = (((data >> (7u - pos)) & 0x01u) != 0u);
+    }
+
+    return bit;
+}
+
+static uint32_t fsk_model_fill(uint16_t *period, uint32_t idx, uint16_t value, uint32_t count)
+{
+    uint32_t end = idx + count;
+
+    while (idx < end)
+    {
+        period[idx] = value;
+        idx++;
+    }
+
+    return end;
+}
+
+uint32_t Cy_QiStack_Fsk_Model_Mod_Period(uint32_t opCnt, uint8_t depth, uint8_t polarity)
+{
+    uint32_t delta = gl_fsk_model_depth[depth & 0x03u];
+
+    return (polarity == 0u) ? (opCnt - delta) : (opCnt + delta);
+}
+
+uint32_t Cy_QiStack_Fsk_Model_Render(const cy_stc_qi_comm_fsk_oper_t *oper, uint32_t leadCycles,
+        uint16_t *period, uint32_t maxCycles)
+{
+    uint16_t opCnt;
+    uint16_t modCnt;
+    uint16_t bitCnt;
+    uint16_t bit;
+    uint32_t idx;
+    bool isMod = false;
+
+    if ((oper == NULL) || (period == NULL))
+    {
+        return 0u;
+    }
+
+    bitCnt = fsk_model_bit_count(oper);
+
+    /* Lead, bit cells and one half bit of operating period after the frame. */
+    if ((leadCycles + ((uint32_t)bitCnt * CY_QI_FSK_MODEL_CELL_CYCLES) + CY_QI_FSK_MODEL_HALF_CYCLES) > maxCycles)
+    {
+        return 0u;
+    }
+
+    opCnt = (uint16_t)oper->periodOpPwmCnt;
+    modCnt = (uint16_t)oper->periodModPwmCnt;
+
+    idx = fsk_model_fill(period, 0u, opCnt, leadCycles);
+    for (bit = 0u; bit < bitCnt; bit++)
+    {
+        isMod = !isMod;
+        idx = fsk_model_fill(period, idx, isMod ? modCnt : opCnt, CY_QI_FSK_MODEL_HALF_CYCLES);
+        if (fsk_model_bit(oper, bit))
+        {
+            isMod = !isMod;
+        }
+        idx = fsk_model_fill(period, idx, isMod ? modCnt : opCnt, CY_QI_FSK_MODEL_HALF_CYCLES);
+    }
+
+    return fsk_model_fill(period, idx, opCnt, CY_QI_FSK_MODEL_HALF_CYCLES);
+}
+
+cy_en_qi_status_t Cy_QiStack_Fsk_Model_Check(const cy_stc_qi_comm_fsk_oper_t *oper, const uint16_t *period,
+        uint32_t cycles, uint32_t pwmClkKhz, cy_stc_qi_fsk_model_result_t *result)
+{
+    uint16_t opCnt;
+    uint16_t modCnt;
+    uint16_t bitCnt;
+    uint32_t first;
+    uint32_t end;
+    uint32_t idx;
+    uint32_t rel;
+    uint64_t clk = 0u;
+    bool trans;
+
+    if ((oper == NULL) || (period == NULL) || (result == NULL) || (pwmClkKhz == 0u))
+    {
+        return CY_QISTACK_STAT_BAD_PARAM;
+    }
+
+    opCnt = (uint16_t)oper->periodOpPwmCnt;
+    modCnt = (uint16_t)oper->periodModPwmCnt;
+    bitCnt = fsk_model_bit_count(oper);
+    result->err = CY_QI_FSK_MODEL_OK;
+    result->errCycle = 0u;
+    result->bitCnt = 0u;
+    result->respDelayUs = 0u;
+
+    /* Response time: operating cycles up to the first modulated one. */
+    for (first = 0u; (first < cycles) && (period[first] == opCnt); first++)
+    {
+        clk += period[first];
+    }
+
+    if (first == cycles)
+    {
+        result->err = CY_QI_FSK_MODEL_ERR_NO_MOD;
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    result->respDelayUs = (uint32_t)((clk * 1000u) / pwmClkKhz);
+    result->errCycle = first;
+    if (result->respDelayUs < (CY_QI_TIMER_FSK_RESP_TIME * 1000u))
+    {
+        result->err = CY_QI_FSK_MODEL_ERR_RESP_EARLY;
+        return CY_QISTACK_STAT_FAILURE;
+    }
+    if (result->respDelayUs > (CY_QI_TIMER_FSK_RESP_MAX_TIME * 1000u))
+    {
+        result->err = CY_QI_FSK_MODEL_ERR_RESP_LATE;
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    end = first + ((uint32_t)bitCnt * CY_QI_FSK_MODEL_CELL_CYCLES);
+    if (end > cycles)
+    {
+        result->err = CY_QI_FSK_MODEL_ERR_SHORT;
+        result->errCycle = cycles;
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    for (idx = first; idx < end; idx++)
+    {
+        result->errCycle = idx;
+        if ((period[idx] != opCnt) && (period[idx] != modCnt))
+        {
+            result->err = CY_QI_FSK_MODEL_ERR_PERIOD;
+            break;
+        }
+
+        rel = idx - first;
+        trans = (idx == first) || (period[idx] != period[idx - 1u]);
+
+        if ((rel % CY_QI_FSK_MODEL_CELL_CYCLES) == 0u)
+        {
+            if (!trans)
+            {
+                result->err = CY_QI_FSK_MODEL_ERR_CELL;
+                break;
+            }
+        }
+        else if ((rel % CY_QI_FSK_MODEL_CELL_CYCLES) == CY_QI_FSK_MODEL_HALF_CYCLES)
+        {
+            if (trans != fsk_model_bit(oper, result->bitCnt))
+            {
+                result->err = CY_QI_FSK_MODEL_ERR_DATA;
+                break;
+            }
+            result->bitCnt++;
+        }
+        else if (trans)
+        {
+            result->err = CY_QI_FSK_MODEL_ERR_HALF;
+            break;
+        }
+        else
+        {
+            /* Steady cycle inside a half bit. */
+        }
+    }
+
+    if (result->err == CY_QI_FSK_MODEL_OK)
+    {
+        for (idx = end; idx < cycles; idx++)
+        {
+            if (period[idx] != opCnt)
+            {
+                result->err = CY_QI_FSK_MODEL_ERR_TAIL;
+                result->errCycle = idx;
+                break;
+            }
+        }
+    }
+
+    return (result->err == CY_QI_FSK_MODEL_OK) ? CY_QISTACK_STAT_SUCCESS : CY_QISTACK_STAT_FAILURE;
+}
+
+#endif /* CY_QI_FSK_MODEL_EN */
+
+/* [] END OF FILE */
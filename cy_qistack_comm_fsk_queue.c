@@ -0,0 +1,161 @@
+/***************************************************************************//**
+* \file cy_qistack_comm_fsk_queue.c
+* \version 2.0
+*
+* Source file of the FSK transmit queue of the QiStack middleware. Responses
+* and data stream frames wait here for a response window and are started on
+* the precompiled FSK edge schedule as soon as the transmitter is free.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_manager.h"
+#include "cy_syslib.h"
+
+#if (CY_QI_FSK_TX_QUEUE_DEPTH != 0)
+
+#define CY_QI_FSK_TX_QUEUE_MASK                     (CY_QI_FSK_TX_QUEUE_DEPTH - 1u)
+
+static uint32_t fsk_tx_timestamp(cy_stc_qi_context_t *qiCtx)
+{
+    uint32_t (*get_timestamp)(struct cy_stc_qi_context *qiCtx) = qiCtx->ptrAppCbk->get_timestamp;
+
+    return (get_timestamp != NULL) ? get_timestamp(qiCtx) : 0u;
+}
+
+void Cy_QiStack_Fsk_Tx_Queue_Reset(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_fsk_tx_queue_t *queue = &qiCtx->fskTxQueue;
+    uint32_t intr = Cy_SysLib_EnterCriticalSection();
+
+    (void)memset(queue->head, 0, sizeof(queue->head));
+    (void)memset(queue->tail, 0, sizeof(queue->tail));
+    queue->slotOpen = false;
+    queue->overflowCnt = 0u;
+    queue->startCnt = 0u;
+    queue->missedCnt = 0u;
+    queue->waitSum = 0u;
+    queue->waitMax = 0u;
+
+    Cy_SysLib_ExitCriticalSection(intr);
+}
+
+cy_en_qi_status_t Cy_QiStack_Fsk_Tx_Queue_Push(cy_stc_qi_context_t *qiCtx, const uint8_t *data,
+        uint8_t len, bool frame, cy_en_qi_fsk_tx_prio_t prio)
+{
+    cy_stc_qi_fsk_tx_queue_t *queue = &qiCtx->fskTxQueue;
+    cy_stc_qi_fsk_tx_entry_t *entry;
+    uint32_t intr;
+
+    if ((data == NULL) || (len == 0u) || (len > CY_QI_FSK_DATA_SIZE) || (prio >= CY_QI_FSK_TX_PRIO_MAX))
+    {
+        return CY_QISTACK_STAT_BAD_PARAM;
+    }
+
+    /* Entries are only taken from the queue, so free space cannot shrink. */
+    if ((uint8_t)(queue->head[prio] - queue->tail[prio]) >= CY_QI_FSK_TX_QUEUE_DEPTH)
+    {
+        queue->overflowCnt++;
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    /*
+     * Encode into the entry while it is not yet visible to the edge interrupt,
+     * so that starting it later is only a copy.
+     */
+    entry = &queue->entry[prio][queue->head[prio] & CY_QI_FSK_TX_QUEUE_MASK];
+    (void)Cy_QiStack_Fsk_Sched_Build(&entry->sched, data, len, frame);
+
+    intr = Cy_SysLib_EnterCriticalSection();
+    entry->timestamp = fsk_tx_timestamp(qiCtx);
+    queue->head[prio]++;
+    Cy_SysLib_ExitCriticalSection(intr);
+
+    Cy_QiStack_Fsk_Tx_Queue_Service(qiCtx);
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+void Cy_QiStack_Fsk_Tx_Slot_Open(cy_stc_qi_context_t *qiCtx)
+{
+    qiCtx->fskTxQueue.slotOpen = true;
+    Cy_QiStack_Fsk_Tx_Queue_Service(qiCtx);
+}
+
+void Cy_QiStack_Fsk_Tx_Slot_Close(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_fsk_tx_queue_t *queue = &qiCtx->fskTxQueue;
+    uint32_t intr = Cy_SysLib_EnterCriticalSection();
+    uint8_t prio;
+
+    if (queue->slotOpen)
+    {
+        queue->slotOpen = false;
+        for (prio = 0u; prio < (uint8_t)CY_QI_FSK_TX_PRIO_MAX; prio++)
+        {
+            if (queue->head[prio] != queue->tail[prio])
+            {
+                queue->missedCnt++;
+                break;
+            }
+        }
+    }
+
+    Cy_SysLib_ExitCriticalSection(intr);
+}
+
+void Cy_QiStack_Fsk_Tx_Queue_Service(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_fsk_tx_queue_t *queue = &qiCtx->fskTxQueue;
+    cy_stc_qi_fsk_tx_entry_t *entry;
+    uint32_t intr = Cy_SysLib_EnterCriticalSection();
+    uint32_t wait;
+    uint8_t prio;
+
+    /* A non-empty schedule is still being transmitted. */
+    if ((!queue->slotOpen) || (qiCtx->fskSched.len != 0u))
+    {
+        Cy_SysLib_ExitCriticalSection(intr);
+        return;
+    }
+
+    for (prio = 0u; prio < (uint8_t)CY_QI_FSK_TX_PRIO_MAX; prio++)
+    {
+        if (queue->head[prio] != queue->tail[prio])
+        {
+            break;
+        }
+    }
+
+    if (prio < (uint8_t)CY_QI_FSK_TX_PRIO_MAX)
+    {
+        entry = &queue->entry[prio][queue->tail[prio] & CY_QI_FSK_TX_QUEUE_MASK];
+        Cy_QiStack_Fsk_Sched_Load(qiCtx, &entry->sched);
+        queue->tail[prio]++;
+        queue->slotOpen = false;
+
+        wait = fsk_tx_timestamp(qiCtx) - entry->timestamp;
+        queue->waitSum += wait;
+        if (wait > queue->waitMax)
+        {
+            queue->waitMax = wait;
+        }
+        queue->startCnt++;
+
+        (void)Cy_QiStack_Fsk_Sched_Start(qiCtx);
+    }
+
+    Cy_SysLib_ExitCriticalSection(intr);
+}
+
+#endif /* CY_QI_FSK_TX_QUEUE_DEPTH */
+
+/* [] END OF FILE */
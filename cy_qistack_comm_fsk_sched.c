@@ -0,0 +1,317 @@
+/***************************************************************************//**
+* \file cy_qistack_comm_fsk_sched.c
+* \version 2.0
+*
+* Source file of the precompiled FSK edge schedule of the QiStack middleware.
+* The outgoing response is encoded once when it is queued; the edge counter
+* interrupt only steps through the resulting interval table.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_manager.h"
+#include "cy_qistack_debug_monitor.h"
+#include "cy_qistack_pm.h"
+#include "cy_tcpwm_counter.h"
+#if CY_QI_FSK_HW_SWAP_EN
+#include "cy_tcpwm_pwm.h"
+#endif /* CY_QI_FSK_HW_SWAP_EN */
+
+#if CY_QI_FSK_SCHED_EN
+
+/* Number of bits in a response pattern byte. */
+#define CY_QI_FSK_PATTERN_BITS                      (8u)
+
+/* Schedule under construction. */
+typedef struct
+{
+    cy_stc_qi_fsk_sched_t *sched;
+    uint8_t gap;
+    bool first;
+} cy_stc_qi_fsk_sched_ctx_t;
+
+#if CY_QI_FSK_SCHED_ISR_TIME_EN
+static uint32_t fsk_sched_timestamp(cy_stc_qi_context_t *qiCtx)
+{
+    uint32_t (*get_timestamp)(struct cy_stc_qi_context *qiCtx) = qiCtx->ptrAppCbk->get_timestamp;
+
+    return (get_timestamp != NULL) ? get_timestamp(qiCtx) : 0u;
+}
+#endif /* CY_QI_FSK_SCHED_ISR_TIME_EN */
+
+#if CY_QI_FSK_HW_SWAP_EN
+/* Loads the inverter period applied by the next swap, at 50% duty. */
+static void fsk_sched_hw_arm(cy_stc_qi_context_t *qiCtx, uint32_t period)
+{
+    Cy_TCPWM_PWM_SetPeriod1(qiCtx->qiStat.invPwm, qiCtx->qiStat.invPwmIndex, period);
+    Cy_TCPWM_PWM_SetCompare1(qiCtx->qiStat.invPwm, qiCtx->qiStat.invPwmIndex, period >> 1u);
+}
+#endif /* CY_QI_FSK_HW_SWAP_EN */
+
+/* Records a frequency change after the current gap. */
+static void fsk_sched_change(cy_stc_qi_fsk_sched_ctx_t *ctx)
+{
+    if (ctx->first)
+    {
+        /* The change at the start of the first bit is applied by Start. */
+        ctx->first = false;
+    }
+    else
+    {
+        ctx->sched->halfCnt[ctx->sched->len] = ctx->gap;
+        ctx->sched->len++;
+    }
+    ctx->sched->halfTotal += ctx->gap;
+    ctx->gap = 0u;
+}
+
+/* Differential bi-phase: change at every bit start and mid bit for a one. */
+static void fsk_sched_bit(cy_stc_qi_fsk_sched_ctx_t *ctx, bool bit)
+{
+    fsk_sched_change(ctx);
+    ctx->gap++;
+
+    if (bit)
+    {
+        fsk_sched_change(ctx);
+    }
+    ctx->gap++;
+}
+
+/* Data frame character: start bit, data LSB first, odd parity and stop bit. */
+static void fsk_sched_char(cy_stc_qi_fsk_sched_ctx_t *ctx, uint8_t data)
+{
+    uint8_t bit;
+
+    fsk_sched_bit(ctx, false);
+    for (bit = 0u; bit < 8u; bit++)
+    {
+        fsk_sched_bit(ctx, ((data >> bit) & 0x01u) != 0u);
+    }
+    fsk_sched_bit(ctx, CY_QI_ODD_PARITY(data));
+    fsk_sched_bit(ctx, true);
+}
+
+static void fsk_sched_begin(cy_stc_qi_fsk_sched_ctx_t *ctx, cy_stc_qi_fsk_sched_t *sched)
+{
+    sched->len = 0u;
+    sched->idx = 0u;
+    sched->isMod = false;
+    sched->halfTotal = 0u;
+    ctx->sched = sched;
+    ctx->gap = 0u;
+    ctx->first = true;
+}
+
+static void fsk_sched_end(cy_stc_qi_fsk_sched_ctx_t *ctx)
+{
+    cy_stc_qi_fsk_sched_t *sched = ctx->sched;
+
+    /* Final interval: up to the end of the last bit. */
+    sched->halfCnt[sched->len] = ctx->gap;
+    sched->halfTotal += ctx->gap;
+    sched->len++;
+}
+
+cy_en_qi_status_t Cy_QiStack_Fsk_Sched_Build(cy_stc_qi_fsk_sched_t *sched, const uint8_t *data,
+        uint8_t len, bool frame)
+{
+    cy_stc_qi_fsk_sched_ctx_t ctx;
+    uint8_t idx;
+    uint8_t bit;
+
+    if ((sched == NULL) || (data == NULL) || (len == 0u) || (len > CY_QI_FSK_DATA_SIZE))
+    {
+        return CY_QISTACK_STAT_BAD_PARAM;
+    }
+
+    fsk_sched_begin(&ctx, sched);
+
+    for (idx = 0u; idx < len; idx++)
+    {
+        if (frame)
+        {
+            fsk_sched_char(&ctx, data[idx]);
+        }
+        else
+        {
+            for (bit = CY_QI_FSK_PATTERN_BITS; bit > 0u; bit--)
+            {
+                fsk_sched_bit(&ctx, ((data[idx] >> (bit - 1u)) & 0x01u) != 0u);
+            }
+        }
+    }
+
+    fsk_sched_end(&ctx);
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+cy_en_qi_status_t Cy_QiStack_Fsk_Sched_Build_Msg(cy_stc_qi_fsk_sched_t *sched, uint8_t header,
+        const uint8_t *msg, uint8_t len)
+{
+    cy_stc_qi_fsk_sched_ctx_t ctx;
+    uint8_t checksum = header;
+    uint8_t idx;
+
+    if ((sched == NULL) || ((msg == NULL) && (len != 0u)) || ((len + 2u) > CY_QI_FSK_DATA_SIZE))
+    {
+        return CY_QISTACK_STAT_BAD_PARAM;
+    }
+
+    fsk_sched_begin(&ctx, sched);
+
+    fsk_sched_char(&ctx, header);
+    for (idx = 0u; idx < len; idx++)
+    {
+        fsk_sched_char(&ctx, msg[idx]);
+        checksum ^= msg[idx];
+    }
+    fsk_sched_char(&ctx, checksum);
+
+    fsk_sched_end(&ctx);
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+void Cy_QiStack_Fsk_Sched_Load(cy_stc_qi_context_t *qiCtx, const cy_stc_qi_fsk_sched_t *sched)
+{
+    cy_stc_qi_fsk_sched_t *dst = &qiCtx->fskSched;
+
+    (void)memcpy(dst->halfCnt, sched->halfCnt, sched->len);
+    dst->halfTotal = sched->halfTotal;
+    dst->idx = 0u;
+    dst->isMod = false;
+    dst->len = sched->len;
+}
+
+cy_en_qi_status_t Cy_QiStack_Fsk_Sched_Start(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_comm_fsk_oper_t *oper = &qiCtx->qiCommStat.fskOper;
+    cy_stc_qi_fsk_sched_t *sched = &qiCtx->fskSched;
+
+    if (sched->len == 0u)
+    {
+        return CY_QISTACK_STAT_FAILURE;
+    }
+
+    sched->idx = 0u;
+    sched->isMod = true;
+    qiCtx->qiCommStat.fskCfg.pktDone = false;
+#if CY_QI_FSK_HW_SWAP_EN
+    /*
+     * Swap to the modulated period at the end of the current inverter cycle.
+     * The buffer then holds the operating period, so later swaps alternate.
+     */
+    fsk_sched_hw_arm(qiCtx, oper->periodModPwmCnt);
+    Cy_TCPWM_TriggerCaptureOrSwap(qiCtx->qiStat.invPwm, qiCtx->qiStat.invPwmMask);
+#else
+    qiCtx->ptrAppCbk->fsk_pwm_configure(qiCtx, true);
+#endif /* CY_QI_FSK_HW_SWAP_EN */
+
+    Cy_TCPWM_Counter_SetCounter(oper->edgeCounter, oper->edgeCounterIndex, 0u);
+    Cy_TCPWM_Counter_SetPeriod(oper->edgeCounter, oper->edgeCounterIndex,
+            ((uint32_t)sched->halfCnt[0] << CY_QI_FSK_HALF_BIT_SHIFT) - 1u);
+    Cy_TCPWM_TriggerStart(oper->edgeCounter, oper->edgeCounterMask);
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+void Cy_QiStack_Fsk_Sched_Edge_Handler(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_comm_fsk_oper_t *oper = &qiCtx->qiCommStat.fskOper;
+    cy_stc_qi_fsk_sched_t *sched = &qiCtx->fskSched;
+    uint8_t idx = (uint8_t)(sched->idx + 1u);
+#if CY_QI_FSK_SCHED_ISR_TIME_EN
+    uint32_t start = fsk_sched_timestamp(qiCtx);
+    uint32_t time;
+#endif /* CY_QI_FSK_SCHED_ISR_TIME_EN */
+
+    Cy_TCPWM_ClearInterrupt(oper->edgeCounter, oper->edgeCounterIndex, CY_TCPWM_INT_ON_TC);
+    sched->stats.irqCnt++;
+
+    if (idx < sched->len)
+    {
+        /* The counter has wrapped at this edge; the new period covers the next interval. */
+        Cy_TCPWM_Counter_SetPeriod(oper->edgeCounter, oper->edgeCounterIndex,
+                ((uint32_t)sched->halfCnt[idx] << CY_QI_FSK_HALF_BIT_SHIFT) - 1u);
+        sched->isMod = !sched->isMod;
+#if CY_QI_FSK_HW_SWAP_EN
+        /*
+         * The terminal count has already swapped the period. Only a frame
+         * ending on the operating frequency needs the buffer changed, so that
+         * the swap at its last edge keeps the operating period.
+         */
+        if (((idx + 1u) == sched->len) && (!sched->isMod))
+        {
+            fsk_sched_hw_arm(qiCtx, oper->periodOpPwmCnt);
+        }
+#else
+        qiCtx->ptrAppCbk->fsk_pwm_configure(qiCtx, sched->isMod);
+#endif /* CY_QI_FSK_HW_SWAP_EN */
+        sched->idx = idx;
+    }
+    else
+    {
+        Cy_TCPWM_TriggerStopOrKill(oper->edgeCounter, oper->edgeCounterMask);
+#if CY_QI_FSK_HW_SWAP_EN
+        /* The swap at this edge has restored the operating period. */
+        sched->isMod = false;
+#else
+        if (sched->isMod)
+        {
+            sched->isMod = false;
+            qiCtx->ptrAppCbk->fsk_pwm_configure(qiCtx, false);
+        }
+#endif /* CY_QI_FSK_HW_SWAP_EN */
+        sched->stats.frameCnt++;
+        sched->stats.halfBitCnt += sched->halfTotal;
+        sched->len = 0u;
+#if (CY_QI_FSK_TX_QUEUE_DEPTH != 0)
+        /* Start a frame already waiting for an open response window. */
+        Cy_QiStack_Fsk_Tx_Queue_Service(qiCtx);
+        if (sched->len == 0u)
+        {
+            qiCtx->qiCommStat.fskCfg.pktDone = true;
+        }
+#else
+        qiCtx->qiCommStat.fskCfg.pktDone = true;
+#endif /* CY_QI_FSK_TX_QUEUE_DEPTH */
+#if CY_QI_TASK_EVT_EN
+        Cy_QiStack_Evt_Set(qiCtx, CY_QI_EVT_FSK_DONE);
+#endif /* CY_QI_TASK_EVT_EN */
+    }
+
+#if CY_QI_FSK_SCHED_ISR_TIME_EN
+    time = fsk_sched_timestamp(qiCtx) - start;
+    sched->stats.isrTimeSum += time;
+    if (time > sched->stats.isrTimeMax)
+    {
+        sched->stats.isrTimeMax = time;
+    }
+#endif /* CY_QI_FSK_SCHED_ISR_TIME_EN */
+}
+
+#if (CCG_HPI_WLC_CMD_ENABLE != 0)
+void Cy_QiStack_Get_FSK_Isr_Stats(cy_stc_qi_context_t *qiCtx, uint8_t *buffer)
+{
+    (void)memcpy(buffer, &qiCtx->fskSched.stats, sizeof(cy_stc_qi_fsk_isr_stats_t));
+}
+
+void Cy_QiStack_Clear_FSK_Isr_Stats(cy_stc_qi_context_t *qiCtx)
+{
+    (void)memset(&qiCtx->fskSched.stats, 0, sizeof(cy_stc_qi_fsk_isr_stats_t));
+}
+#endif /* CCG_HPI_WLC_CMD_ENABLE */
+
+#endif /* CY_QI_FSK_SCHED_EN */
+
+/* [] END OF FILE */
@@ -189,6 +189,856 @@ void Cy_QiStack_Ask_Mod_Update(
 void Cy_QiStack_DTS_Reset(cy_stc_qi_context_t *qiCtx);
 
 
+#if (CY_QI_ASK_PKT_QUEUE_DEPTH != 0)
+/*******************************************************************************
+* Function Name: Cy_QiStack_Ask_Pkt_Queue_Reset
+******************************************************************************
+*
+* This function empties the ASK packet queue. Must not be called while the BMC
+* receiver can deliver packets.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_QiStack_Ask_Pkt_Queue_Reset(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Ask_Pkt_Queue_Push
+******************************************************************************
+*
+* This function queues a decoded ASK packet with its receive time. Producer
+* side: only to be called from the BMC receive path. When the queue is full
+* the packet is dropped and counted in overflowCnt, so packets already queued
+* keep their order.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param pkt
+* Decoded packet.
+*
+* \param timestamp
+* Receive time in get_timestamp units: the checksum edge when
+* CY_QI_ASK_PKT_TIMESTAMP_EN is enabled, otherwise the current time.
+*
+* \return
+* true if the packet was queued, false if the queue was full.
+*
+*******************************************************************************/
+bool Cy_QiStack_Ask_Pkt_Queue_Push(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx,
+       /* Decoded packet. */
+       const cy_stc_qi_ask_pkt_t *pkt,
+       /* Receive time. */
+       uint32_t timestamp);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Ask_Pkt_Queue_Pop
+******************************************************************************
+*
+* This function takes the oldest ASK packet from the queue. Consumer side: only
+* to be called from the application task context. The stack does not call it;
+* its comm path keeps processing askBmc.pkt, so popping a packet does not take
+* it away from the stack.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param pkt
+* Destination for the packet.
+*
+* \param timestamp
+* Destination for the receive time. Can be NULL.
+*
+* \return
+* true if a packet was returned, false if the queue is empty.
+*
+*******************************************************************************/
+bool Cy_QiStack_Ask_Pkt_Queue_Pop(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx,
+       /* Destination for the packet. */
+       cy_stc_qi_ask_pkt_t *pkt,
+       /* Destination for the receive time. */
+       uint32_t *timestamp);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Ask_Pkt_Queue_Count
+******************************************************************************
+*
+* This function returns the number of ASK packets waiting in the queue.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* Number of queued packets.
+*
+*******************************************************************************/
+uint8_t Cy_QiStack_Ask_Pkt_Queue_Count(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx);
+#endif /* CY_QI_ASK_PKT_QUEUE_DEPTH */
+
+#if CY_QI_ASK_PKT_TIMESTAMP_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Ask_Pkt_Age
+******************************************************************************
+*
+* This function returns the time elapsed since the checksum edge of an ASK
+* packet, however late the packet is processed.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param pktTime
+* Checksum edge time of the packet: bmcLut.pktTime for askBmc.pkt, or the
+* receive time returned by Cy_QiStack_Ask_Pkt_Queue_Pop.
+*
+* \return
+* Packet age in get_timestamp units.
+*
+*******************************************************************************/
+uint32_t Cy_QiStack_Ask_Pkt_Age(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx,
+       /* Checksum edge time of the packet. */
+       uint32_t pktTime);
+
+#if CY_QI_TIMER_WHEEL_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Ask_Pkt_Timer_Start
+******************************************************************************
+*
+* This function starts a timer measured from the checksum edge of an ASK
+* packet rather than from now. The time already spent since the edge is taken
+* off the period; a timer that is already due expires on the next tick.
+*
+* \param qiCtx
+* QiStack Library Context pointer. Passed as the callback context.
+*
+* \param wheel
+* Pointer to the timer wheel.
+*
+* \param pktTime
+* Checksum edge time of the packet the timer refers to, see
+* Cy_QiStack_Ask_Pkt_Age.
+*
+* \param id
+* Timer ID.
+*
+* \param period
+* Timer period in milliseconds from the checksum edge.
+*
+* \param cb
+* Expiry callback.
+*
+* \return
+* true if the timer was started, false if no timer node was free.
+*
+*******************************************************************************/
+bool Cy_QiStack_Ask_Pkt_Timer_Start(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx,
+       /* Pointer to the timer wheel. */
+       cy_stc_qi_timer_wheel_t *wheel,
+       /* Checksum edge time of the packet. */
+       uint32_t pktTime,
+       /* Timer ID. */
+       cy_timer_id_t id,
+       /* Period in milliseconds from the checksum edge. */
+       uint16_t period,
+       /* Expiry callback. */
+       cy_cb_timer_t cb);
+#endif /* CY_QI_TIMER_WHEEL_EN */
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN */
+
+#if CY_QI_ASK_HDR_TABLE_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Ask_Hdr_Info
+******************************************************************************
+*
+* This function returns the header table entry of an ASK packet header:
+* expected message size, allowed phases and handler class. Reserved headers
+* return an entry with all fields zero.
+*
+* \param header
+* ASK packet header.
+*
+* \return
+* Pointer to the constant header table entry.
+*
+*******************************************************************************/
+const cy_stc_qi_ask_hdr_info_t * Cy_QiStack_Ask_Hdr_Info(
+       /* ASK packet header. */
+       uint8_t header);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Ask_Pkt_Validate
+******************************************************************************
+*
+* This function checks a received ASK packet against the header table. The
+* packet is rejected if the header is reserved, not allowed in the current
+* phase or the message size does not match the header.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param pkt
+* Received packet.
+*
+* \return
+* CY_QISTACK_STAT_SUCCESS if the packet is valid
+* CY_QISTACK_STAT_BAD_PARAM if a pointer is invalid
+* CY_QISTACK_STAT_FAILURE if the packet is rejected.
+*
+*******************************************************************************/
+cy_en_qi_status_t Cy_QiStack_Ask_Pkt_Validate(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx,
+       /* Received packet. */
+       const cy_stc_qi_ask_pkt_t *pkt);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Ask_Pkt_Dispatch
+******************************************************************************
+*
+* This function validates a received ASK packet and calls the handler of its
+* header class. No handler is called for a rejected packet.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param pkt
+* Received packet.
+*
+* \param handlers
+* Handler per cy_en_qi_ask_hdl_t class. NULL entries are skipped.
+*
+* \return
+* Status returned by the handler
+* CY_QISTACK_STAT_NO_RESPONSE if no handler is registered for the class
+* CY_QISTACK_STAT_BAD_PARAM or CY_QISTACK_STAT_FAILURE as for
+* Cy_QiStack_Ask_Pkt_Validate.
+*
+*******************************************************************************/
+cy_en_qi_status_t Cy_QiStack_Ask_Pkt_Dispatch(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx,
+       /* Received packet. */
+       const cy_stc_qi_ask_pkt_t *pkt,
+       /* Handler per class. */
+       const cy_cb_ask_hdl_t handlers[CY_QI_ASK_HDL_MAX]);
+#endif /* CY_QI_ASK_HDR_TABLE_EN */
+
+#if CY_QI_FSK_SCHED_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Fsk_Sched_Build
+******************************************************************************
+*
+* This function compiles an FSK response pattern or data frame into the
+* intervals between frequency changes of the differential bi-phase encoding.
+* A pattern is sent MSB first as is. A frame is sent as 11-bit characters:
+* start bit, data LSB first, odd parity and stop bit. To be called when the
+* response is queued, so that the edge handler does no encoding.
+*
+* \param sched
+* Schedule to fill.
+*
+* \param data
+* Pattern or frame bytes, header through checksum.
+*
+* \param len
+* Number of bytes, 1 to CY_QI_FSK_DATA_SIZE.
+*
+* \param frame
+* true for a data frame, false for a response pattern.
+*
+* \return
+* CY_QISTACK_STAT_SUCCESS if the schedule is built
+* CY_QISTACK_STAT_BAD_PARAM if a parameter is invalid.
+*
+*******************************************************************************/
+cy_en_qi_status_t Cy_QiStack_Fsk_Sched_Build(
+       /* Schedule to fill. */
+       cy_stc_qi_fsk_sched_t *sched,
+       /* Pattern or frame bytes. */
+       const uint8_t *data,
+       /* Number of bytes. */
+       uint8_t len,
+       /* Data frame or response pattern. */
+       bool frame);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Fsk_Sched_Build_Msg
+******************************************************************************
+*
+* This function compiles an FSK data packet into a schedule straight from its
+* parts: the header, the message read in place from the caller buffer and the
+* checksum computed on the way. No contiguous copy of the packet is needed.
+*
+* \param sched
+* Schedule to fill.
+*
+* \param header
+* Packet header.
+*
+* \param msg
+* Message bytes. Can be NULL if len is 0.
+*
+* \param len
+* Number of message bytes, up to CY_QI_FSK_DATA_SIZE - 2.
+*
+* \return
+* CY_QISTACK_STAT_SUCCESS if the schedule is built
+* CY_QISTACK_STAT_BAD_PARAM if a parameter is invalid.
+*
+*******************************************************************************/
+cy_en_qi_status_t Cy_QiStack_Fsk_Sched_Build_Msg(
+       /* Schedule to fill. */
+       cy_stc_qi_fsk_sched_t *sched,
+       /* Packet header. */
+       uint8_t header,
+       /* Message bytes. */
+       const uint8_t *msg,
+       /* Number of message bytes. */
+       uint8_t len);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Fsk_Sched_Load
+******************************************************************************
+*
+* This function copies a schedule built ahead of time into fskSched, ready for
+* Cy_QiStack_Fsk_Sched_Start. Only the intervals are copied; the edge
+* interrupt counters of fskSched are kept. Must not be called while a frame
+* is in transmission.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param sched
+* Built schedule.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_QiStack_Fsk_Sched_Load(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx,
+       /* Built schedule. */
+       const cy_stc_qi_fsk_sched_t *sched);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Fsk_Sched_Start
+******************************************************************************
+*
+* This function starts transmission of the schedule in fskSched: switches the
+* inverter to the modulated frequency and loads the first interval into the
+* FSK edge counter.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* CY_QISTACK_STAT_SUCCESS if transmission started
+* CY_QISTACK_STAT_FAILURE if the schedule is empty.
+*
+*******************************************************************************/
+cy_en_qi_status_t Cy_QiStack_Fsk_Sched_Start(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Fsk_Sched_Edge_Handler
+******************************************************************************
+*
+* FSK edge counter interrupt handler for a precompiled schedule. Can be
+* installed as fskOper.edge_int_handler. Toggles the inverter frequency and
+* loads the next interval; after the last interval the inverter is left on the
+* operating frequency, the edge counter is stopped and fskCfg.pktDone is set.
+* With CY_QI_FSK_HW_SWAP_EN the frequency change is done by the hardware period
+* swap at the terminal count, so the handler only reloads the edge counter and
+* its latency does not affect the modulation timing. Runs once per frequency
+* change, which is at most once per half bit.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_QiStack_Fsk_Sched_Edge_Handler(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx);
+#endif /* CY_QI_FSK_SCHED_EN */
+
+#if CY_QI_FSK_MODEL_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Fsk_Model_Mod_Period
+******************************************************************************
+*
+* This function returns the modulated PWM period for an operating PWM period,
+* FSK depth and polarity as negotiated with the FSK parameters request.
+*
+* \param opCnt
+* Operating frequency PWM clock cycles.
+*
+* \param depth
+* FSK depth 0 to 3, see CY_QI_FSK_RESOLUTION_DEPTH_0 to 3.
+*
+* \param polarity
+* 0: positive, the modulated frequency is higher. 1: negative.
+*
+* \return
+* Modulated frequency PWM clock cycles.
+*
+*******************************************************************************/
+uint32_t Cy_QiStack_Fsk_Model_Mod_Period(
+       /* Operating frequency PWM clock cycles. */
+       uint32_t opCnt,
+       /* FSK depth. */
+       uint8_t depth,
+       /* FSK polarity. */
+       uint8_t polarity);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Fsk_Model_Render
+******************************************************************************
+*
+* This function renders the inverter period of every cycle for the FSK
+* transmission described by oper: data, dataLen, frame, periodOpPwmCnt and
+* periodModPwmCnt. The waveform starts with leadCycles at the operating period,
+* as seen from the end of the ASK packet, and is encoded directly from the Qi
+* bit rules so that it is independent of the edge schedule.
+*
+* \param oper
+* FSK operation settings.
+*
+* \param leadCycles
+* Operating cycles before the first bit.
+*
+* \param period
+* Destination for one PWM period per inverter cycle.
+*
+* \param maxCycles
+* Size of period in entries.
+*
+* \return
+* Number of cycles rendered, 0 if period is too small.
+*
+*******************************************************************************/
+uint32_t Cy_QiStack_Fsk_Model_Render(
+       /* FSK operation settings. */
+       const cy_stc_qi_comm_fsk_oper_t *oper,
+       /* Operating cycles before the first bit. */
+       uint32_t leadCycles,
+       /* Destination period sequence. */
+       uint16_t *period,
+       /* Size of period. */
+       uint32_t maxCycles);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Fsk_Model_Check
+******************************************************************************
+*
+* This function checks a cycle by cycle period sequence, starting at the end
+* of the ASK packet, against the FSK transmission described by oper. It
+* verifies the response time window, that only the operating and modulated
+* periods are used, a transition at the start of every 512 cycle bit cell,
+* transitions only on the 256 cycle half bit grid, the decoded bits and a
+* clean return to the operating period.
+*
+* \param oper
+* FSK operation settings.
+*
+* \param period
+* Period sequence.
+*
+* \param cycles
+* Number of entries in period.
+*
+* \param pwmClkKhz
+* PWM clock in kHz used to convert cycles into time.
+*
+* \param result
+* Check result.
+*
+* \return
+* CY_QISTACK_STAT_SUCCESS if the waveform is valid
+* CY_QISTACK_STAT_BAD_PARAM if a pointer is invalid
+* CY_QISTACK_STAT_FAILURE otherwise, details in result.
+*
+*******************************************************************************/
+cy_en_qi_status_t Cy_QiStack_Fsk_Model_Check(
+       /* FSK operation settings. */
+       const cy_stc_qi_comm_fsk_oper_t *oper,
+       /* Period sequence. */
+       const uint16_t *period,
+       /* Number of entries. */
+       uint32_t cycles,
+       /* PWM clock in kHz. */
+       uint32_t pwmClkKhz,
+       /* Check result. */
+       cy_stc_qi_fsk_model_result_t *result);
+#endif /* CY_QI_FSK_MODEL_EN */
+
+#if (CY_QI_FSK_TX_QUEUE_DEPTH != 0)
+/*******************************************************************************
+* Function Name: Cy_QiStack_Fsk_Tx_Queue_Reset
+******************************************************************************
+*
+* This function empties the FSK transmit queue, closes the response window and
+* clears the queue counters.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_QiStack_Fsk_Tx_Queue_Reset(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Fsk_Tx_Queue_Push
+******************************************************************************
+*
+* This function queues an FSK response pattern or data frame. Entries of a
+* higher priority are always started first; entries of the same priority keep
+* their order. The entry is started at once if the transmitter is idle and a
+* response window is open. The edge schedule is built here, in the caller
+* context, so that starting the entry later is only a copy. Entries of one
+* priority must be pushed from one context.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param data
+* Pattern or frame bytes, header through checksum.
+*
+* \param len
+* Number of bytes, 1 to CY_QI_FSK_DATA_SIZE.
+*
+* \param frame
+* true for a data frame, false for a response pattern.
+*
+* \param prio
+* Queue priority.
+*
+* \return
+* CY_QISTACK_STAT_SUCCESS if the entry is queued
+* CY_QISTACK_STAT_BAD_PARAM if a parameter is invalid
+* CY_QISTACK_STAT_FAILURE if the queue of this priority is full.
+*
+*******************************************************************************/
+cy_en_qi_status_t Cy_QiStack_Fsk_Tx_Queue_Push(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx,
+       /* Pattern or frame bytes. */
+       const uint8_t *data,
+       /* Number of bytes. */
+       uint8_t len,
+       /* Data frame or response pattern. */
+       bool frame,
+       /* Queue priority. */
+       cy_en_qi_fsk_tx_prio_t prio);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Fsk_Tx_Slot_Open
+******************************************************************************
+*
+* This function opens a response window, typically on expiry of
+* CY_QI_TIMER_FSK_RESP_TIME after an ASK packet. The first queued entry is
+* started as soon as the transmitter is idle; one entry is sent per window.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_QiStack_Fsk_Tx_Slot_Open(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Fsk_Tx_Slot_Close
+******************************************************************************
+*
+* This function closes the response window, typically at
+* CY_QI_TIMER_FSK_RESP_MAX_TIME after an ASK packet. A window that closes with
+* entries still queued is counted in missedCnt.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_QiStack_Fsk_Tx_Slot_Close(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Fsk_Tx_Queue_Service
+******************************************************************************
+*
+* This function starts the highest priority queued entry if a response window
+* is open and no frame is in transmission, by loading its prebuilt schedule.
+* Called by the queue functions and by the FSK edge handler at the end of a
+* frame.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_QiStack_Fsk_Tx_Queue_Service(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx);
+#endif /* CY_QI_FSK_TX_QUEUE_DEPTH */
+
+#if CY_QI_ADT_TX_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Adt_Tx_Start
+******************************************************************************
+*
+* This function starts a PTx data stream transfer, e.g. the certificate chain
+* requested by GET_CERTIFICATE, from a caller owned buffer such as
+* authTxBuffer. The data is sent by reference: only a cursor and the retry
+* state of the packet in flight are kept. With CY_QI_ADT_TX_WINDOW the first
+* packets are staged. The transfer time is measured from this call to the ACK
+* of the last packet.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param data
+* Transfer data. Not copied: must stay valid until the transfer is done.
+*
+* \param len
+* Transfer length in bytes.
+*
+* \return
+* CY_QISTACK_STAT_SUCCESS if the transfer is started
+* CY_QISTACK_STAT_BAD_PARAM if a parameter is invalid.
+*
+*******************************************************************************/
+cy_en_qi_status_t Cy_QiStack_Adt_Tx_Start(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx,
+       /* Transfer data. */
+       const uint8_t *data,
+       /* Transfer length in bytes. */
+       uint16_t len);
+
+#if (CY_QI_ADT_TX_WINDOW != 0)
+/*******************************************************************************
+* Function Name: Cy_QiStack_Adt_Tx_Stage
+******************************************************************************
+*
+* This function encodes the following ADT packets into the free window slots,
+* alternating the even and odd headers. To be called from the task between
+* polls; the ACK handling calls it as well.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_QiStack_Adt_Tx_Stage(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx);
+#endif /* CY_QI_ADT_TX_WINDOW */
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Adt_Tx_Send
+******************************************************************************
+*
+* This function answers a DSR poll with the oldest unacknowledged ADT packet.
+* The packet is encoded into fskSched straight from the caller buffer, or with
+* CY_QI_ADT_TX_WINDOW its staged schedule is loaded without encoding. A packet
+* sent again after a NAK or ND is counted as a retry.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* CY_QISTACK_STAT_SUCCESS if the packet is started
+* CY_QISTACK_STAT_FAILURE if no transfer is active or an FSK frame is still
+* in transmission.
+*
+*******************************************************************************/
+cy_en_qi_status_t Cy_QiStack_Adt_Tx_Send(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Adt_Tx_Ack
+******************************************************************************
+*
+* This function retires the packet acknowledged by a DSR ACK and moves the
+* cursor to the next one. The ACK of the last packet completes the transfer and updates
+* the delivery counters.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* true if the transfer is complete.
+*
+*******************************************************************************/
+bool Cy_QiStack_Adt_Tx_Ack(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Adt_Tx_Abort
+******************************************************************************
+*
+* This function drops the transfer in progress, e.g. on a data stream reset.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_QiStack_Adt_Tx_Abort(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx);
+#endif /* CY_QI_ADT_TX_EN */
+
+#if CY_QI_ADT_RX_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Adt_Rx_Register
+******************************************************************************
+*
+* This function registers the buffer that PRx data stream transfers are
+* reassembled into and the callback raised when a transfer completes. The
+* buffer belongs to the stack from the start of a transfer until its
+* completion callback.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param buf
+* Receive buffer.
+*
+* \param size
+* Receive buffer size in bytes.
+*
+* \param cb
+* Completion callback. Can be NULL.
+*
+* \return
+* CY_QISTACK_STAT_SUCCESS if the buffer is registered
+* CY_QISTACK_STAT_BAD_PARAM if a parameter is invalid.
+*
+*******************************************************************************/
+cy_en_qi_status_t Cy_QiStack_Adt_Rx_Register(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx,
+       /* Receive buffer. */
+       uint8_t *buf,
+       /* Receive buffer size. */
+       uint16_t size,
+       /* Completion callback. */
+       cy_cb_adt_rx_done_t cb);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Adt_Rx_Start
+******************************************************************************
+*
+* This function starts a PRx data stream transfer, on an ADC start request.
+* A transfer still in progress is dropped without a callback.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param expLen
+* Announced transfer length. The transfer completes when it is reached. 0 if
+* unknown: the transfer then completes on Cy_QiStack_Adt_Rx_End.
+*
+* \return
+* CY_QISTACK_STAT_SUCCESS if the transfer is started
+* CY_QISTACK_STAT_FAILURE if no buffer is registered.
+*
+*******************************************************************************/
+cy_en_qi_status_t Cy_QiStack_Adt_Rx_Start(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx,
+       /* Announced transfer length. */
+       uint16_t expLen);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Adt_Rx_Pkt
+******************************************************************************
+*
+* This function stores the payload of a received ADT packet at the end of the
+* data received so far. The even/odd toggle is checked against the next
+* expected one: a packet with the toggle of the last stored packet is a
+* repeat after a missed ACK and is acknowledged without being stored, also
+* once the transfer is complete. Can be installed as the CY_QI_ASK_HDL_ADT
+* handler of Cy_QiStack_Ask_Pkt_Dispatch.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param pkt
+* Received ADT packet.
+*
+* \return
+* CY_QISTACK_STAT_SUCCESS if the packet is to be acknowledged
+* CY_QISTACK_STAT_FAILURE if it is to be not acknowledged: out of sequence
+* or no room left in the buffer
+* CY_QISTACK_STAT_BAD_PARAM if it is not an ADT packet or no transfer is
+* active.
+*
+*******************************************************************************/
+cy_en_qi_status_t Cy_QiStack_Adt_Rx_Pkt(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx,
+       /* Received ADT packet. */
+       const cy_stc_qi_ask_pkt_t *pkt);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Adt_Rx_End
+******************************************************************************
+*
+* This function completes the PRx data stream transfer in progress, on an ADC
+* end request, and raises the completion callback with the total length.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* None.
+*
+*******************************************************************************/
+void Cy_QiStack_Adt_Rx_End(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx);
+#endif /* CY_QI_ADT_RX_EN */
+
 /** \} group_qistack_comm_functions */
 
 #endif /* CY_QISTACK_COMM_MANAGER_H */
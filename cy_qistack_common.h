@@ -189,6 +189,283 @@
 #define CY_QI_EPP_MODE_EN                       (1u)
 #endif /* CY_QI_EPP_MODE_EN */
 
+#ifndef CY_QI_BMC_RX_LUT_EN
+#define CY_QI_BMC_RX_LUT_EN                     (0u)
+#endif /* CY_QI_BMC_RX_LUT_EN */
+
+/*
+ * BMC edge capture. Line transitions are decoded from capture timestamps as
+ * they happen instead of from SPI samples. askBmc.rawData keeps its place, as
+ * the prebuilt libraries share that layout, and holds the edge log instead of
+ * SPI samples. The context can not shrink below the baseline, as the buffer
+ * stays; edge capture costs no RAM over the table driven decoder.
+ */
+#ifndef CY_QI_BMC_RX_EDGE_CAPTURE_EN
+#define CY_QI_BMC_RX_EDGE_CAPTURE_EN            (0u)
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+
+#if ((CY_QI_BMC_RX_EDGE_CAPTURE_EN != 0) && (CY_QI_BMC_RX_LUT_EN == 0))
+#error "BMC edge capture requires the table driven BMC decoder (CY_QI_BMC_RX_LUT_EN)."
+#endif
+
+#ifndef CY_QI_BMC_RX_MULTI_PATH_EN
+#define CY_QI_BMC_RX_MULTI_PATH_EN              (0u)
+#endif /* CY_QI_BMC_RX_MULTI_PATH_EN */
+
+#if ((CY_QI_BMC_RX_MULTI_PATH_EN != 0) && (CY_QI_BMC_RX_LUT_EN == 0))
+#error "Multi-path ASK demodulation requires the table driven BMC decoder (CY_QI_BMC_RX_LUT_EN)."
+#endif
+
+/*
+ * ASK packet queue. An application side tap only: the prebuilt comm path
+ * keeps taking packets from askBmc.pkt and nothing in the stack pops the
+ * queue. The application drains it with Cy_QiStack_Ask_Pkt_Queue_Pop, e.g.
+ * for logging with receive times; when it does not, packets are dropped and
+ * counted once the queue is full.
+ */
+#ifndef CY_QI_ASK_PKT_QUEUE_DEPTH
+#define CY_QI_ASK_PKT_QUEUE_DEPTH               (0u)
+#endif /* CY_QI_ASK_PKT_QUEUE_DEPTH */
+
+#if (CY_QI_ASK_PKT_QUEUE_DEPTH != 0)
+#if (((CY_QI_ASK_PKT_QUEUE_DEPTH & (CY_QI_ASK_PKT_QUEUE_DEPTH - 1u)) != 0u) || (CY_QI_ASK_PKT_QUEUE_DEPTH > 128u))
+#error "CY_QI_ASK_PKT_QUEUE_DEPTH must be a power of 2 not larger than 128."
+#endif
+#if (CY_QI_BMC_RX_LUT_EN == 0)
+#error "ASK packet queue requires the table driven BMC decoder (CY_QI_BMC_RX_LUT_EN)."
+#endif
+#endif /* CY_QI_ASK_PKT_QUEUE_DEPTH */
+
+#ifndef CY_QI_BMC_RX_CLK_RECOVERY_EN
+#define CY_QI_BMC_RX_CLK_RECOVERY_EN            (0u)
+#endif /* CY_QI_BMC_RX_CLK_RECOVERY_EN */
+
+#if ((CY_QI_BMC_RX_CLK_RECOVERY_EN != 0) && (CY_QI_BMC_RX_LUT_EN == 0))
+#error "BMC clock recovery requires the table driven BMC decoder (CY_QI_BMC_RX_LUT_EN)."
+#endif
+
+#ifndef CY_QI_BMC_RX_CAPTURE_EN
+#define CY_QI_BMC_RX_CAPTURE_EN                 (0u)
+#endif /* CY_QI_BMC_RX_CAPTURE_EN */
+
+#if ((CY_QI_BMC_RX_CAPTURE_EN != 0) && (CY_QI_BMC_RX_LUT_EN == 0))
+#error "ASK capture recording requires the table driven BMC decoder (CY_QI_BMC_RX_LUT_EN)."
+#endif
+
+/*
+ * Every decoded ASK packet is stamped with the get_timestamp time of its
+ * checksum stop bit edge, recovered from the decoder sample position, so that
+ * protocol timing does not depend on when the task sees the packet. The time
+ * is kept in bmcLut.pktTime and in the ASK packet queue entry.
+ */
+#ifndef CY_QI_ASK_PKT_TIMESTAMP_EN
+#define CY_QI_ASK_PKT_TIMESTAMP_EN              (0u)
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN */
+
+#if ((CY_QI_ASK_PKT_TIMESTAMP_EN != 0) && (CY_QI_BMC_RX_LUT_EN == 0))
+#error "ASK packet timestamps require the table driven BMC decoder (CY_QI_BMC_RX_LUT_EN)."
+#endif
+
+/* Frequency of the get_timestamp counter in kHz, i.e. counts per millisecond. */
+#ifndef CY_QI_TIMESTAMP_FREQ_KHZ
+#define CY_QI_TIMESTAMP_FREQ_KHZ                (1000u)
+#endif /* CY_QI_TIMESTAMP_FREQ_KHZ */
+
+#ifndef CY_QI_ASK_HDR_TABLE_EN
+#define CY_QI_ASK_HDR_TABLE_EN                  (0u)
+#endif /* CY_QI_ASK_HDR_TABLE_EN */
+
+#ifndef CY_QI_FSK_SCHED_EN
+#define CY_QI_FSK_SCHED_EN                      (0u)
+#endif /* CY_QI_FSK_SCHED_EN */
+
+/*
+ * FSK frequency changes through the inverter PWM period/compare swap. Requires
+ * the FSK edge counter terminal count to be routed to the swap input of the
+ * inverter PWM and period and compare swap to be enabled in the PWM
+ * configuration.
+ */
+#ifndef CY_QI_FSK_HW_SWAP_EN
+#define CY_QI_FSK_HW_SWAP_EN                    (0u)
+#endif /* CY_QI_FSK_HW_SWAP_EN */
+
+#if ((CY_QI_FSK_HW_SWAP_EN != 0) && (CY_QI_FSK_SCHED_EN == 0))
+#error "FSK hardware period swap requires the FSK edge schedule (CY_QI_FSK_SCHED_EN)."
+#endif
+
+/*
+ * Run time of the FSK edge handler in isrTimeSum and isrTimeMax. Costs two
+ * get_timestamp calls per edge interrupt, so it is meant for profiling only;
+ * the other interrupt load counters are always kept.
+ */
+#ifndef CY_QI_FSK_SCHED_ISR_TIME_EN
+#define CY_QI_FSK_SCHED_ISR_TIME_EN             (0u)
+#endif /* CY_QI_FSK_SCHED_ISR_TIME_EN */
+
+#if ((CY_QI_FSK_SCHED_ISR_TIME_EN != 0) && (CY_QI_FSK_SCHED_EN == 0))
+#error "FSK edge handler timing requires the FSK edge schedule (CY_QI_FSK_SCHED_EN)."
+#endif
+
+/* Host model and checker of the FSK waveform. No hardware dependencies. */
+#ifndef CY_QI_FSK_MODEL_EN
+#define CY_QI_FSK_MODEL_EN                      (0u)
+#endif /* CY_QI_FSK_MODEL_EN */
+
+#ifndef CY_QI_FSK_TX_QUEUE_DEPTH
+#define CY_QI_FSK_TX_QUEUE_DEPTH                (0u)
+#endif /* CY_QI_FSK_TX_QUEUE_DEPTH */
+
+#if (CY_QI_FSK_TX_QUEUE_DEPTH != 0)
+#if (((CY_QI_FSK_TX_QUEUE_DEPTH & (CY_QI_FSK_TX_QUEUE_DEPTH - 1u)) != 0u) || (CY_QI_FSK_TX_QUEUE_DEPTH > 128u))
+#error "CY_QI_FSK_TX_QUEUE_DEPTH must be a power of 2 not larger than 128."
+#endif
+#if (CY_QI_FSK_SCHED_EN == 0)
+#error "FSK transmit queue requires the FSK edge schedule (CY_QI_FSK_SCHED_EN)."
+#endif
+#endif /* CY_QI_FSK_TX_QUEUE_DEPTH */
+
+/*
+ * PTx data stream sent by reference: ADT packets are encoded straight from a
+ * caller owned buffer, e.g. authTxBuffer, without a staging copy.
+ */
+#ifndef CY_QI_ADT_TX_EN
+#define CY_QI_ADT_TX_EN                         (0u)
+#endif /* CY_QI_ADT_TX_EN */
+
+#if ((CY_QI_ADT_TX_EN != 0) && (CY_QI_FSK_SCHED_EN == 0))
+#error "ADT transmit by reference requires the FSK edge schedule (CY_QI_FSK_SCHED_EN)."
+#endif
+
+/*
+ * Number of outgoing ADT packets of the PTx data stream kept staged ahead of
+ * the PRx polls, each already encoded into an FSK edge schedule. 0 encodes
+ * each packet on the poll.
+ */
+#ifndef CY_QI_ADT_TX_WINDOW
+#define CY_QI_ADT_TX_WINDOW                     (0u)
+#endif /* CY_QI_ADT_TX_WINDOW */
+
+#if (CY_QI_ADT_TX_WINDOW != 0)
+#if (((CY_QI_ADT_TX_WINDOW & (CY_QI_ADT_TX_WINDOW - 1u)) != 0u) || (CY_QI_ADT_TX_WINDOW > 8u))
+#error "CY_QI_ADT_TX_WINDOW must be a power of 2 not larger than 8."
+#endif
+#if (CY_QI_ADT_TX_EN == 0)
+#error "ADT transmit staging requires the ADT transmit by reference (CY_QI_ADT_TX_EN)."
+#endif
+#endif /* CY_QI_ADT_TX_WINDOW */
+
+/*
+ * PRx data stream reassembled straight into an application registered buffer
+ * of any size, with one completion callback per transfer.
+ */
+#ifndef CY_QI_ADT_RX_EN
+#define CY_QI_ADT_RX_EN                         (0u)
+#endif /* CY_QI_ADT_RX_EN */
+
+/*
+ * Event driven stack task. Interrupts and timer expiries post wake reasons
+ * to a single event word and Cy_QiStack_Evt_Task runs the stack only when an
+ * event is pending. Stack timer expiries are seen through the wrapped soft
+ * timer calls, so CY_QI_TIMER_WHEEL_WRAP_EN is required. Received packets,
+ * good or bad, are posted by the table driven ASK receiver and completed
+ * transmissions by the FSK edge schedule, so both are required as well.
+ * Wake sources internal to the prebuilt libraries are not posted: fault and
+ * protection handling, analog ping detection and other interrupt flags that
+ * Cy_QiStack_Task polls. The application posts CY_QI_EVT_POLICY for them.
+ */
+#ifndef CY_QI_TASK_EVT_EN
+#define CY_QI_TASK_EVT_EN                       (0u)
+#endif /* CY_QI_TASK_EVT_EN */
+
+#if ((CY_QI_TASK_EVT_EN != 0) && (CY_QI_TIMER_WHEEL_WRAP_EN == 0))
+#error "The event driven task requires the wrapped soft timer calls (CY_QI_TIMER_WHEEL_WRAP_EN) to see the stack timer expiries."
+#endif
+
+#if ((CY_QI_TASK_EVT_EN != 0) && (CY_QI_BMC_RX_LUT_EN == 0))
+#error "The event driven task requires the table driven ASK receiver (CY_QI_BMC_RX_LUT_EN) to see the received packets."
+#endif
+
+#if ((CY_QI_TASK_EVT_EN != 0) && (CY_QI_FSK_SCHED_EN == 0))
+#error "The event driven task requires the FSK edge schedule (CY_QI_FSK_SCHED_EN) to see the completed transmissions."
+#endif
+
+/*
+ * Tickless idle. The soft timer tick is stopped while the stack may deep
+ * sleep; a low power wake timer is programmed for the earliest Qi timer
+ * deadline and the elapsed ticks are applied to the timing wheel on wake.
+ */
+#ifndef CY_QI_TICKLESS_EN
+#define CY_QI_TICKLESS_EN                       (0u)
+#endif /* CY_QI_TICKLESS_EN */
+
+#if ((CY_QI_TICKLESS_EN != 0) && (CY_QI_TIMER_WHEEL_EN == 0))
+#error "Tickless idle requires the timing wheel timer backend (CY_QI_TIMER_WHEEL_EN)."
+#endif
+
+/* Shortest sleep in ticks worth the deep sleep entry and exit. */
+#ifndef CY_QI_TICKLESS_MIN_TICKS
+#define CY_QI_TICKLESS_MIN_TICKS                (2u)
+#endif /* CY_QI_TICKLESS_MIN_TICKS */
+
+/* Longest sleep in ticks, limited by the range of the wake timer. */
+#ifndef CY_QI_TICKLESS_MAX_TICKS
+#define CY_QI_TICKLESS_MAX_TICKS                (2000u)
+#endif /* CY_QI_TICKLESS_MAX_TICKS */
+
+/*
+ * Certificate chain cache. GET_DIGEST and GET_CERTIFICATE are answered from a
+ * RAM copy of the chain and its digest, so that only CHALLENGE goes to the
+ * secure element.
+ */
+#ifndef CY_QI_AUTH_CACHE_EN
+#define CY_QI_AUTH_CACHE_EN                     (0u)
+#endif /* CY_QI_AUTH_CACHE_EN */
+
+/* Number of certificate slots held by the cache. */
+#ifndef CY_QI_AUTH_CACHE_SLOTS
+#define CY_QI_AUTH_CACHE_SLOTS                  (1u)
+#endif /* CY_QI_AUTH_CACHE_SLOTS */
+
+/*
+ * Flash copy of the cache, protected by a hash computed with the
+ * get_sha256_data application callback and checked before it is used.
+ */
+#ifndef CY_QI_AUTH_CACHE_FLASH_EN
+#define CY_QI_AUTH_CACHE_FLASH_EN               (0u)
+#endif /* CY_QI_AUTH_CACHE_FLASH_EN */
+
+#if ((CY_QI_AUTH_CACHE_FLASH_EN != 0) && (CY_QI_AUTH_CACHE_EN == 0))
+#error "The certificate cache flash copy requires the certificate cache (CY_QI_AUTH_CACHE_EN)."
+#endif
+
+/*
+ * Latency distribution of the authentication requests. GET_DIGEST,
+ * GET_CERTIFICATE and CHALLENGE each keep a log2 histogram of the time from
+ * request to response and the number of requests the PRx repeated.
+ */
+#ifndef CY_QI_AUTH_REQ_HIST_EN
+#define CY_QI_AUTH_REQ_HIST_EN                  (0u)
+#endif /* CY_QI_AUTH_REQ_HIST_EN */
+
+#if ((CY_QI_AUTH_REQ_HIST_EN != 0) && (CY_QI_AUTH_CACHE_EN == 0))
+#error "Authentication request histograms require the certificate cache request hooks (CY_QI_AUTH_CACHE_EN)."
+#endif
+
+/*
+ * Warm OPTIGA session. The application on the secure element is opened at
+ * boot and kept open, hibernated through the OPTIGA_HIBERNATE_CONTEXT_ID
+ * datastore for deep sleep and restored on wake, so that a CHALLENGE only
+ * pays for the signature.
+ */
+#ifndef CY_QI_AUTH_WARM_EN
+#define CY_QI_AUTH_WARM_EN                      (0u)
+#endif /* CY_QI_AUTH_WARM_EN */
+
+/* Private key OID used to sign the CHALLENGE response. */
+#ifndef CY_QI_AUTH_SIGN_KEY_OID
+#define CY_QI_AUTH_SIGN_KEY_OID                 (0xE0F0u)
+#endif /* CY_QI_AUTH_SIGN_KEY_OID */
+
 #define CY_QI_AUTOMATION_DEBUG_EN               (1u)
 
 /**
@@ -358,6 +635,24 @@
 /** MAX FSK ADT Message Size including header and Checksum*/
 #define CY_QI_FSK_ADT_MAX_MSG_SIZE                  (9u)
 
+/** MAX data bytes in one FSK ADT packet. */
+#define CY_QI_FSK_ADT_MAX_DATA_SIZE                 (CY_QI_FSK_ADT_MAX_MSG_SIZE - 2u)
+
+/** FSK bit period in inverter cycles is 2 ^ (CY_QI_FSK_HALF_BIT_SHIFT + 1). */
+#define CY_QI_FSK_HALF_BIT_SHIFT                    (8u)
+
+/**
+ * FSK edge schedule size: up to two frequency changes per bit of a frame
+ * of 11-bit characters. The first change is applied at start.
+ */
+#define CY_QI_FSK_SCHED_SIZE                        (CY_QI_FSK_DATA_SIZE * 11u * 2u)
+
+/** FSK response patterns, sent MSB first. */
+#define CY_QI_FSK_PATTERN_ACK                       (0xFFu)
+#define CY_QI_FSK_PATTERN_NAK                       (0x00u)
+#define CY_QI_FSK_PATTERN_ND                        (0x55u)
+#define CY_QI_FSK_PATTERN_ATN                       (0x33u)
+
 /** BMC RX baud rate. This is 2KHz as defined by Qi specification. */
 #define CY_QI_BMC_RX_FREQ                           (2000u)
 
@@ -377,8 +672,35 @@
  */
 #define CY_QI_BMC_RX_SPI_RAW_DATA_SIZE              (64u * (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE))
 
+/**
+ * Number of run lengths kept per decoder in the edge capture log. The log is
+ * only used for debug as runs are decoded as soon as they are captured. It
+ * lives in askBmc.rawData, one slice per ASK path. Must be a power of 2.
+ */
+#define CY_QI_BMC_RX_EDGE_LOG_SIZE                  (128u)
+#if ((CY_QI_BMC_RX_EDGE_LOG_SIZE & (CY_QI_BMC_RX_EDGE_LOG_SIZE - 1u)) != 0u)
+#error "CY_QI_BMC_RX_EDGE_LOG_SIZE must be a power of 2."
+#endif
+
+/**
+ * Number of bins in the ASK bit width jitter histogram. Bin n counts runs
+ * which deviate by n raw samples from the nominal half or full bit width,
+ * the last bin collects everything above.
+ */
+#define CY_QI_ASK_STATS_JITTER_BINS                 (8u)
+
+/**
+ * Number of bins in the ASK preamble length histogram. Bin n counts preambles
+ * of 4n to 4n + 3 bits, the last bin collects everything above.
+ */
+#define CY_QI_ASK_STATS_PREAMBLE_BINS               (8u)
+
 #define CY_QI_MAX_NUM_ASK_SWITCH_OVER               (3u)
 
+#if ((CY_QI_BMC_RX_EDGE_LOG_SIZE * CY_QI_MAX_NUM_ASK_SWITCH_OVER) > CY_QI_BMC_RX_SPI_RAW_DATA_SIZE)
+#error "The edge capture logs of all ASK paths must fit in askBmc.rawData."
+#endif
+
 #define CY_QI_ASK_MOD_DEFAULT                       (CY_QI_ASK_PATH_VOLT_H)
 
 #define CY_QI_EPP_5W_VAL                            (10u)
@@ -612,7 +934,20 @@ typedef enum
     CY_QI_ASK_EVT_MAX                              /**< 0xNN: Total number of ASK BMC events. */
 } cy_en_qi_ask_pkt_evt_t;
 
-#if QI_STACK_ASK_DEBUG
+#if (CY_QI_BMC_RX_LUT_EN != 0)
+/**
+ * @typedef cy_en_qi_bmc_lut_st_t
+ * @brief Enum of table driven BMC decoder states.
+ */
+typedef enum
+{
+    CY_QI_BMC_LUT_ST_PREAMBLE = 0x00,              /**< 0x00: Looking for preamble and start bit. */
+    CY_QI_BMC_LUT_ST_DATA,                         /**< 0x01: Assembling packet characters. */
+    CY_QI_BMC_LUT_ST_DONE,                         /**< 0x02: Valid packet decoded. */
+    CY_QI_BMC_LUT_ST_ERROR                         /**< 0x03: Packet decode failed. */
+} cy_en_qi_bmc_lut_st_t;
+#endif /* CY_QI_BMC_RX_LUT_EN */
+
 /**
  * @typedef cy_en_qi_ask_fail_rs_t
  * @brief Enum of ASK BMC decoder fail reason.
@@ -625,7 +960,8 @@ typedef enum
     CY_QI_ASK_FAIL_RS_BAD_HEADER,                  /**< 0x03: Invalid header seen. */
     CY_QI_ASK_FAIL_RS_BAD_DATA,                    /**< 0x04: Invalid data seen. */
     CY_QI_ASK_FAIL_RS_INV_CHECKSUM,                /**< 0x05: Invalid checksum seen. */
-    CY_QI_ASK_FAIL_RS_BAD_CHECKSUM                 /**< 0x06: Checksum does not match. */
+    CY_QI_ASK_FAIL_RS_BAD_CHECKSUM,                /**< 0x06: Checksum does not match. */
+    CY_QI_ASK_FAIL_RS_MAX                          /**< 0xNN: Total number of fail reasons. */
 
 } cy_en_qi_ask_fail_rs_t;
 
@@ -639,10 +975,10 @@ typedef enum
     CY_QI_ASK_FAIL_TYPE_NO_START_BIT,              /**< 0x01: No valid start bit. */
     CY_QI_ASK_FAIL_TYPE_NO_STOP_BIT,               /**< 0x02: No valid stop bit. */
     CY_QI_ASK_FAIL_TYPE_BAD_PARITY_BIT,            /**< 0x03: Invalid parity bit. */
-    CY_QI_ASK_FAIL_TYPE_BIT_UNDERFLOW              /**< 0x04: In sufficient bit count. */
+    CY_QI_ASK_FAIL_TYPE_BIT_UNDERFLOW,             /**< 0x04: In sufficient bit count. */
+    CY_QI_ASK_FAIL_TYPE_MAX                        /**< 0xNN: Total number of fail types. */
 
 } cy_en_qi_ask_fail_type_t;
-#endif /* QI_STACK_ASK_DEBUG */
 
 
 
@@ -1604,6 +1940,24 @@ typedef struct
     uint8_t *in_buf,                         /** Input buf */
     uint8_t buf_size,                        /** Size of Input buf */
     uint8_t *out_buf);                       /** Output buf */
+#if ((CY_QI_ASK_PKT_QUEUE_DEPTH != 0) || (CY_QI_FSK_SCHED_EN != 0) || (CY_QI_ASK_PKT_TIMESTAMP_EN != 0) || \
+     (CY_QI_AUTH_CACHE_EN != 0) || (CY_QI_AUTH_WARM_EN != 0))
+    uint32_t (*get_timestamp)(
+            struct cy_stc_qi_context *qiCtx        /**< Qi context. */
+            );      /**< Free running time used to stamp received packets and time the FSK ISR. Optional. */
+#endif /* CY_QI_ASK_PKT_QUEUE_DEPTH || CY_QI_FSK_SCHED_EN || CY_QI_ASK_PKT_TIMESTAMP_EN || CY_QI_AUTH_CACHE_EN || CY_QI_AUTH_WARM_EN */
+#if CY_QI_TICKLESS_EN
+    void (*lp_timer_start)(
+            struct cy_stc_qi_context *qiCtx,       /**< Qi context. */
+            uint32_t ticks                         /**< Soft timer ticks from now */
+            );      /**< Stop the soft timer tick and program the low power wake timer. */
+    uint32_t (*lp_timer_stop)(
+            struct cy_stc_qi_context *qiCtx        /**< Qi context. */
+            );      /**< Stop the wake timer, restart the soft timer tick and return the elapsed ticks. */
+    void (*deep_sleep_enter)(
+            struct cy_stc_qi_context *qiCtx        /**< Qi context. */
+            );      /**< Enter deep sleep. Called with interrupts masked; returns on any pending interrupt. */
+#endif /* CY_QI_TICKLESS_EN */
 } cy_stc_qi_app_cbk_t;
 
 /**
@@ -2142,6 +2496,117 @@ typedef struct
 
 } cy_stc_qi_ask_pkt_t;
 
+/**
+ * @brief Message size in bytes of an ASK packet as encoded in its header.
+ * Used by the header table and the table driven BMC decoder.
+ */
+#define CY_QI_ASK_HDR_SIZE(hdr)                                                 \
+    (((hdr) < 0x20u) ? 1u :                                                     \
+     ((hdr) < 0x80u) ? (2u + (((hdr) - 0x20u) >> 4u)) :                         \
+     ((hdr) < 0xE0u) ? (8u + (((hdr) - 0x80u) >> 3u)) :                         \
+                       (20u + (((hdr) - 0xE0u) >> 2u)))
+
+#if CY_QI_ASK_HDR_TABLE_EN
+/**
+ * @brief Bit of a Qi phase in the phaseMask of an ASK header table entry.
+ */
+#define CY_QI_PHASE_MASK(phase)                 ((uint8_t)(1u << (uint8_t)(phase)))
+
+/**
+ * @typedef cy_en_qi_ask_hdl_t
+ * @brief Enum of ASK packet handler classes used by the header table.
+ */
+typedef enum {
+    CY_QI_ASK_HDL_NONE = 0,                 /**< 0x00: Reserved header, packet is rejected. */
+    CY_QI_ASK_HDL_SIG_STRENGTH,             /**< 0x01: Signal Strength. */
+    CY_QI_ASK_HDL_EPT,                      /**< 0x02: End Power Transfer. */
+    CY_QI_ASK_HDL_CE,                       /**< 0x03: Control Error. */
+    CY_QI_ASK_HDL_RP,                       /**< 0x04: Received Power (8 and 24 bit). */
+    CY_QI_ASK_HDL_CHS,                      /**< 0x05: Charge Status. */
+    CY_QI_ASK_HDL_PCH,                      /**< 0x06: Power Control Hold-off. */
+    CY_QI_ASK_HDL_GRQ,                      /**< 0x07: General Request. */
+    CY_QI_ASK_HDL_RENEG,                    /**< 0x08: Renegotiate. */
+    CY_QI_ASK_HDL_SRQ,                      /**< 0x09: Specific Request. */
+    CY_QI_ASK_HDL_FOD,                      /**< 0x0A: FOD Status. */
+    CY_QI_ASK_HDL_DSR,                      /**< 0x0B: Data Stream Response. */
+    CY_QI_ASK_HDL_ADC,                      /**< 0x0C: Auxiliary Data Control. */
+    CY_QI_ASK_HDL_ADT,                      /**< 0x0D: Auxiliary Data Transport, even and odd. */
+    CY_QI_ASK_HDL_CFG,                      /**< 0x0E: Configuration. */
+    CY_QI_ASK_HDL_ID,                       /**< 0x0F: Identification. */
+    CY_QI_ASK_HDL_XID,                      /**< 0x10: Extended Identification. */
+    CY_QI_ASK_HDL_WPID,                     /**< 0x11: Wireless Power ID, MSB and LSB. */
+    CY_QI_ASK_HDL_PROP,                     /**< 0x12: Proprietary configuration packets. */
+    CY_QI_ASK_HDL_MAX                       /**< 0xNN: Total handler classes. */
+} cy_en_qi_ask_hdl_t;
+
+/**
+ * @brief Structure to hold one entry of the ASK header table.
+ */
+typedef struct
+{
+    /** Expected message size, 0 for reserved headers. */
+    uint8_t dataSize;
+
+    /** Phases in which the packet is allowed, see CY_QI_PHASE_MASK. */
+    uint8_t phaseMask;
+
+    /** Handler class, cy_en_qi_ask_hdl_t. */
+    uint8_t handler;
+
+} cy_stc_qi_ask_hdr_info_t;
+
+/**
+ * @typedef cy_cb_ask_hdl_t
+ * @brief ASK packet handler called by Cy_QiStack_Ask_Pkt_Dispatch.
+ */
+typedef cy_en_qi_status_t (*cy_cb_ask_hdl_t)(
+        struct cy_stc_qi_context *qiCtx,
+        const cy_stc_qi_ask_pkt_t *pkt);
+#endif /* CY_QI_ASK_HDR_TABLE_EN */
+
+#if (CY_QI_ASK_PKT_QUEUE_DEPTH != 0)
+/**
+ * @brief Structure to hold a decoded ASK packet with its receive time.
+ */
+typedef struct
+{
+    /** Decoded packet */
+    cy_stc_qi_ask_pkt_t pkt;
+
+    /**
+     * Receive time in get_timestamp units: the checksum edge with
+     * CY_QI_ASK_PKT_TIMESTAMP_EN, otherwise the time the packet was queued
+     */
+    uint32_t timestamp;
+
+} cy_stc_qi_ask_pkt_entry_t;
+
+/**
+ * @brief Single producer, single consumer queue of decoded ASK packets. The
+ * BMC receive interrupt only writes head and the application task only
+ * writes tail, so no critical section is needed. The stack itself does not
+ * consume the queue, see CY_QI_ASK_PKT_QUEUE_DEPTH.
+ */
+typedef struct
+{
+    /** Packet slots */
+    cy_stc_qi_ask_pkt_entry_t entry[CY_QI_ASK_PKT_QUEUE_DEPTH];
+
+    /** Free running write index, owned by the producer */
+    volatile uint8_t head;
+
+    /** Free running read index, owned by the consumer */
+    volatile uint8_t tail;
+
+    /** Largest number of packets seen pending at once */
+    uint8_t highWater;
+
+    /** Packets dropped because the queue was full */
+    uint32_t overflowCnt;
+
+} cy_stc_qi_ask_pkt_queue_t;
+#endif /* CY_QI_ASK_PKT_QUEUE_DEPTH */
+
 /**
  * @brief Structure to hold the Qi Communication layer ASK Configuration.
  */
@@ -2317,6 +2782,336 @@ typedef struct {
 
 } cy_stc_qi_comm_fsk_oper_t;
 
+#if CY_QI_FSK_MODEL_EN
+/**
+ * @typedef cy_en_qi_fsk_model_err_t
+ * @brief Enum of FSK waveform check results.
+ */
+typedef enum {
+    CY_QI_FSK_MODEL_OK = 0,                 /**< 0x00: Waveform is valid. */
+    CY_QI_FSK_MODEL_ERR_NO_MOD,             /**< 0x01: No modulation found. */
+    CY_QI_FSK_MODEL_ERR_RESP_EARLY,         /**< 0x02: Response started before CY_QI_TIMER_FSK_RESP_TIME. */
+    CY_QI_FSK_MODEL_ERR_RESP_LATE,          /**< 0x03: Response started after CY_QI_TIMER_FSK_RESP_MAX_TIME. */
+    CY_QI_FSK_MODEL_ERR_PERIOD,             /**< 0x04: Cycle at neither the operating nor the modulated period. */
+    CY_QI_FSK_MODEL_ERR_CELL,               /**< 0x05: No transition at the start of a bit cell. */
+    CY_QI_FSK_MODEL_ERR_HALF,               /**< 0x06: Transition off the half bit grid. */
+    CY_QI_FSK_MODEL_ERR_DATA,               /**< 0x07: Decoded bits differ from the expected data. */
+    CY_QI_FSK_MODEL_ERR_TAIL,               /**< 0x08: Modulation after the last bit or not ending on the operating period. */
+    CY_QI_FSK_MODEL_ERR_SHORT               /**< 0x09: Waveform ends before the last bit. */
+} cy_en_qi_fsk_model_err_t;
+
+/**
+ * @brief Structure to hold the result of an FSK waveform check.
+ */
+typedef struct
+{
+    /** Check result */
+    cy_en_qi_fsk_model_err_t err;
+
+    /** Cycle index of the first error, from the start of the waveform */
+    uint32_t errCycle;
+
+    /** Number of bits decoded */
+    uint16_t bitCnt;
+
+    /** Time from the start of the waveform to the first modulated cycle, in us */
+    uint32_t respDelayUs;
+
+} cy_stc_qi_fsk_model_result_t;
+#endif /* CY_QI_FSK_MODEL_EN */
+
+#if CY_QI_FSK_SCHED_EN
+/**
+ * @brief Structure to hold the FSK edge interrupt load counters.
+ */
+typedef struct
+{
+    /** Frames completed */
+    uint32_t frameCnt;
+
+    /** Half bits transmitted in completed frames */
+    uint32_t halfBitCnt;
+
+    /** Edge counter interrupts taken, at most one per half bit */
+    uint32_t irqCnt;
+
+    /**
+     * Sum of edge handler run times, in get_timestamp units. Only kept with
+     * CY_QI_FSK_SCHED_ISR_TIME_EN, otherwise 0
+     */
+    uint32_t isrTimeSum;
+
+    /** Longest edge handler run time, in get_timestamp units, see isrTimeSum */
+    uint32_t isrTimeMax;
+
+} cy_stc_qi_fsk_isr_stats_t;
+
+/**
+ * @brief Structure to hold an FSK frame precompiled into the intervals between
+ * frequency changes. The frame starts with a change to the modulated frequency
+ * and ends on the operating frequency.
+ */
+typedef struct {
+
+    /**
+     * Half bits per interval. Each interval but the last ends with a frequency
+     * change; the last one ends the frame.
+     */
+    uint8_t halfCnt[CY_QI_FSK_SCHED_SIZE];
+
+    /** Number of intervals in halfCnt */
+    uint8_t len;
+
+    /** Interval currently being counted by the edge counter */
+    volatile uint8_t idx;
+
+    /** Inverter currently runs at the modulated frequency */
+    volatile bool isMod;
+
+    /** Half bits in the frame */
+    uint16_t halfTotal;
+
+    /** Edge interrupt load counters, kept across frames */
+    cy_stc_qi_fsk_isr_stats_t stats;
+
+} cy_stc_qi_fsk_sched_t;
+#endif /* CY_QI_FSK_SCHED_EN */
+
+#if (CY_QI_FSK_TX_QUEUE_DEPTH != 0)
+/**
+ * @typedef cy_en_qi_fsk_tx_prio_t
+ * @brief Enum of FSK transmit queue priorities, highest first.
+ */
+typedef enum {
+    CY_QI_FSK_TX_PRIO_RESP = 0,             /**< 0x00: Protocol response: ACK, NAK, ND, ATN, ID, CAP. */
+    CY_QI_FSK_TX_PRIO_DATA,                 /**< 0x01: Data stream: ADT. */
+    CY_QI_FSK_TX_PRIO_MAX                   /**< 0xNN: Total priorities. */
+} cy_en_qi_fsk_tx_prio_t;
+
+/**
+ * @brief Structure to hold a queued FSK pattern or frame.
+ */
+typedef struct
+{
+    /** Pattern or frame, encoded when queued. Its edge interrupt counters are unused. */
+    cy_stc_qi_fsk_sched_t sched;
+
+    /** Enqueue time from the get_timestamp application callback */
+    uint32_t timestamp;
+
+} cy_stc_qi_fsk_tx_entry_t;
+
+/**
+ * @brief Structure to hold the FSK transmit queue, one FIFO per priority.
+ */
+typedef struct
+{
+    /** Queued entries per priority */
+    cy_stc_qi_fsk_tx_entry_t entry[CY_QI_FSK_TX_PRIO_MAX][CY_QI_FSK_TX_QUEUE_DEPTH];
+
+    /** Write index per priority */
+    uint8_t head[CY_QI_FSK_TX_PRIO_MAX];
+
+    /** Read index per priority */
+    uint8_t tail[CY_QI_FSK_TX_PRIO_MAX];
+
+    /** Response window is open and no frame was started in it yet */
+    volatile bool slotOpen;
+
+    /** Entries dropped because their priority was full */
+    uint32_t overflowCnt;
+
+    /** Frames started from the queue */
+    uint32_t startCnt;
+
+    /** Response windows closed while entries were waiting */
+    uint32_t missedCnt;
+
+    /** Sum of enqueue to start times, in get_timestamp units */
+    uint32_t waitSum;
+
+    /** Longest enqueue to start time, in get_timestamp units */
+    uint32_t waitMax;
+
+} cy_stc_qi_fsk_tx_queue_t;
+#endif /* CY_QI_FSK_TX_QUEUE_DEPTH */
+
+#if (CY_QI_BMC_RX_LUT_EN != 0)
+/**
+ * @brief Structure to hold the ASK decode quality counters. Updated by the
+ * table driven BMC decoder in all builds.
+ */
+typedef struct
+{
+    /** Packets decoded with a valid checksum */
+    uint32_t pktOkCnt;
+
+    /** Failed packets per cy_en_qi_ask_fail_rs_t */
+    uint32_t failRsCnt[CY_QI_ASK_FAIL_RS_MAX];
+
+    /** Failed packets per cy_en_qi_ask_fail_type_t */
+    uint32_t failTypeCnt[CY_QI_ASK_FAIL_TYPE_MAX];
+
+    /** Bit width deviation histogram of data runs, see CY_QI_ASK_STATS_JITTER_BINS */
+    uint32_t jitterHist[CY_QI_ASK_STATS_JITTER_BINS];
+
+    /** Preamble length histogram, see CY_QI_ASK_STATS_PREAMBLE_BINS */
+    uint32_t preambleHist[CY_QI_ASK_STATS_PREAMBLE_BINS];
+
+    /** Start bits detected per cy_en_qi_ask_path_t */
+    uint32_t pathStartCnt[CY_QI_ASK_PATH_MAX];
+
+    /** Packets decoded with a valid checksum per cy_en_qi_ask_path_t */
+    uint32_t pathOkCnt[CY_QI_ASK_PATH_MAX];
+
+} cy_stc_qi_ask_stats_t;
+
+/**
+ * @brief Structure to hold the table driven BMC decoder state.
+ */
+typedef struct
+{
+    /** Destination packet for the decoded data */
+    cy_stc_qi_ask_pkt_t *pkt;
+
+    /** Quality counters to update, NULL if not required */
+    cy_stc_qi_ask_stats_t *stats;
+
+    /** Decoder state */
+    cy_en_qi_bmc_lut_st_t state;
+
+    /** First raw sample has been seen and level is valid */
+    bool isPrimed;
+
+    /** Last raw sample level seen by the decoder */
+    uint8_t level;
+
+    /** Number of raw samples in the current run */
+    uint16_t runLen;
+
+    /** Half bit runs seen in the preamble */
+    uint8_t preambleHalfCnt;
+
+    /** First half of a one bit has been received */
+    bool halfPending;
+
+    /** Bit index inside the current 11-bit character */
+    uint8_t bitIdx;
+
+    /** Bits of the current character, start bit in bit 0 */
+    uint16_t charBits;
+
+    /** XOR of all bits of the current character, 0 for a valid odd parity character */
+    uint8_t charPar;
+
+    /** Running XOR of all bytes received, 0 after a valid checksum byte */
+    uint8_t pktChk;
+
+    /** Number of bytes received including header */
+    uint8_t byteIdx;
+
+    /**
+     * Expected packet length: header, message and checksum.
+     * Valid as soon as the header character is received.
+     */
+    uint8_t pktLen;
+
+#if (CY_QI_BMC_RX_CLK_RECOVERY_EN != 0)
+    /** Tracked half bit period in 1/16 raw samples */
+    uint16_t halfEst;
+#endif /* CY_QI_BMC_RX_CLK_RECOVERY_EN */
+
+    /**
+     * Fail reason once the decoder is in CY_QI_BMC_LUT_ST_ERROR. In the
+     * preamble, CY_QI_ASK_FAIL_RS_BAD_PREAMBLE once a preamble was broken.
+     */
+    cy_en_qi_ask_fail_rs_t failRs;
+
+    /** Fail type once the decoder is in CY_QI_BMC_LUT_ST_ERROR */
+    cy_en_qi_ask_fail_type_t failType;
+
+#if CY_QI_ASK_PKT_TIMESTAMP_EN
+    /** get_timestamp time of the checksum stop bit edge of pkt */
+    uint32_t pktTime;
+
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN */
+#if ((CY_QI_ASK_PKT_TIMESTAMP_EN != 0) && (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0))
+    /** Raw samples fed since init, wrapping */
+    uint16_t sampleIdx;
+
+    /** Sample index of the edge that completed the packet */
+    uint16_t endSample;
+
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN && !CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+#if (CY_QI_BMC_RX_EDGE_CAPTURE_EN != 0)
+    /** Sample time of the last edge passed to bmc_rx_lut_edge() */
+    uint16_t edgeTime;
+
+    /**
+     * Index of the next entry to be written in the edge log of the decoder:
+     * its CY_QI_BMC_RX_EDGE_LOG_SIZE slice of askBmc.rawData, with the most
+     * recent run lengths in raw samples, saturated to 255.
+     */
+    uint8_t edgeLogIdx;
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+
+} cy_stc_qi_bmc_lut_dec_t;
+
+/**
+ * @brief Structure to hold the table driven BMC receiver state. Kept apart
+ * from cy_stc_qi_comm_ask_bmc_t, whose layout is shared with the prebuilt
+ * libraries.
+ */
+typedef struct
+{
+    /** Table driven decoder state */
+    cy_stc_qi_bmc_lut_dec_t lutDec;
+
+    /** ASK decode quality counters */
+    cy_stc_qi_ask_stats_t askStats;
+
+#if CY_QI_ASK_PKT_TIMESTAMP_EN
+    /**
+     * get_timestamp time of the checksum stop bit edge of askBmc.pkt. Kept
+     * here as cy_stc_qi_ask_pkt_t is shared with the prebuilt libraries.
+     */
+    uint32_t pktTime;
+
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN */
+#if (CY_QI_BMC_RX_MULTI_PATH_EN != 0)
+    /** Per path decoder state, indexed like askPathSeq */
+    cy_stc_qi_bmc_lut_dec_t pathDec[CY_QI_MAX_NUM_ASK_SWITCH_OVER];
+
+    /** Per path decoded packet, indexed like askPathSeq */
+    cy_stc_qi_ask_pkt_t pathPkt[CY_QI_MAX_NUM_ASK_SWITCH_OVER];
+
+    /**
+     * askPathSeq index of the path which delivered the current packet.
+     * CY_QI_MAX_NUM_ASK_SWITCH_OVER while no path has won. Wins per path are
+     * counted in askStats.pathOkCnt.
+     */
+    uint8_t pathWinIdx;
+#endif /* CY_QI_BMC_RX_MULTI_PATH_EN */
+
+#if (CY_QI_BMC_RX_CAPTURE_EN != 0)
+    /** Raw samples received since the last capture start record */
+    uint16_t capSampleIdx;
+
+    /**
+     * ASK capture record callback. Called from interrupt context with one
+     * complete capture record, see CY_QI_BMC_CAP_REC_START. NULL disables
+     * recording.
+     */
+    void (*cy_cb_ask_capture)(
+        void * callbackContext,       /**< Context. */
+        const uint8_t *rec,           /**< Capture record */
+        uint8_t len                   /**< Record length in bytes */
+        );
+#endif /* CY_QI_BMC_RX_CAPTURE_EN */
+
+} cy_stc_qi_bmc_lut_t;
+#endif /* CY_QI_BMC_RX_LUT_EN */
+
 /**
  * @brief Structure to hold the ASK BMC decoder status.
  */
@@ -2435,6 +3230,164 @@ typedef struct
 
 } cy_stc_qi_data_stream_t;
 
+#if CY_QI_ADT_TX_EN
+/**
+ * @brief Structure to hold the PTx data stream delivery counters.
+ */
+typedef struct
+{
+    /** Transfers completed */
+    uint32_t xferCnt;
+
+    /** ADT packets acknowledged */
+    uint32_t pktCnt;
+
+    /** ADT packets transmitted again after a NAK or ND */
+    uint32_t retryCnt;
+
+    /** Polls answered late because no packet was staged */
+    uint32_t stallCnt;
+
+    /** Bytes of the last completed transfer */
+    uint16_t lastBytes;
+
+    /** Start to last ACK time of the last completed transfer, in get_timestamp units */
+    uint32_t lastTime;
+
+    /** Throughput of the last completed transfer in bytes per second */
+    uint32_t lastBytesPerSec;
+
+} cy_stc_qi_adt_tx_stats_t;
+
+/**
+ * @brief Structure to hold the PTx data stream transfer: a cursor into the
+ * caller buffer and the retry state of the packet in flight.
+ */
+typedef struct
+{
+    /** Data of the transfer, owned by the caller until it is done */
+    const uint8_t *data;
+
+    /** Length of the transfer */
+    uint16_t len;
+
+    /** Bytes acknowledged; the packet in flight starts here */
+    uint16_t ackOff;
+
+    /** Packet in flight uses the odd ADT header */
+    bool odd;
+
+    /** Packet in flight was transmitted at least once */
+    bool sent;
+
+    /** Transfer in progress */
+    bool active;
+
+#if (CY_QI_ADT_TX_WINDOW != 0)
+    /** Packets encoded ahead, the one in flight first */
+    cy_stc_qi_fsk_sched_t slot[CY_QI_ADT_TX_WINDOW];
+
+    /** Bytes staged so far */
+    uint16_t stageOff;
+
+    /** Staging index */
+    uint8_t head;
+
+    /** Index of the packet in flight */
+    uint8_t tail;
+
+#endif /* CY_QI_ADT_TX_WINDOW */
+    /** get_timestamp time of the transfer start */
+    uint32_t startTime;
+
+    /** Delivery counters */
+    cy_stc_qi_adt_tx_stats_t stats;
+
+} cy_stc_qi_adt_tx_t;
+#endif /* CY_QI_ADT_TX_EN */
+
+#if CY_QI_ADT_RX_EN
+/**
+ * @typedef cy_en_qi_adt_rx_status_t
+ * @brief Enum of PRx data stream transfer results.
+ */
+typedef enum
+{
+    CY_QI_ADT_RX_OK = 0,                    /**< 0x00: Transfer complete. */
+    CY_QI_ADT_RX_OVERFLOW,                  /**< 0x01: Data did not fit the buffer; the excess was dropped. */
+    CY_QI_ADT_RX_INCOMPLETE                 /**< 0x02: Transfer ended before the announced length. */
+} cy_en_qi_adt_rx_status_t;
+
+/**
+ * @typedef cy_cb_adt_rx_done_t
+ * @brief PRx data stream completion callback, raised once per transfer.
+ */
+typedef void (*cy_cb_adt_rx_done_t)(
+        struct cy_stc_qi_context *qiCtx,    /**< Qi context. */
+        uint8_t *buf,                       /**< Registered buffer holding the data. */
+        uint16_t len,                       /**< Total bytes received. */
+        cy_en_qi_adt_rx_status_t status);   /**< Transfer result. */
+
+/**
+ * @brief Structure to hold the PRx data stream counters.
+ */
+typedef struct
+{
+    /** Transfers completed, whatever the result */
+    uint32_t xferCnt;
+
+    /** ADT packets stored */
+    uint32_t pktCnt;
+
+    /** Payload bytes stored */
+    uint32_t byteCnt;
+
+    /** Repeated ADT packets, acknowledged and dropped */
+    uint32_t dupCnt;
+
+    /** ADT packets out of sequence or outside a transfer */
+    uint32_t seqErrCnt;
+
+    /** ADT packets that did not fit the buffer */
+    uint32_t overflowCnt;
+
+} cy_stc_qi_adt_rx_stats_t;
+
+/**
+ * @brief Structure to hold the PRx data stream reassembly.
+ */
+typedef struct
+{
+    /** Registered buffer */
+    uint8_t *buf;
+
+    /** Registered buffer size */
+    uint16_t size;
+
+    /** Bytes received in the current transfer */
+    uint16_t len;
+
+    /** Announced transfer length, 0 if unknown */
+    uint16_t expLen;
+
+    /** Completion callback */
+    cy_cb_adt_rx_done_t cb;
+
+    /** Transfer in progress */
+    bool active;
+
+    /** Next new packet uses the odd ADT header */
+    bool odd;
+
+    /** Some data did not fit the buffer */
+    bool overflow;
+
+    /** Counters */
+    cy_stc_qi_adt_rx_stats_t stats;
+
+} cy_stc_qi_adt_rx_t;
+#endif /* CY_QI_ADT_RX_EN */
+
 /**
  * @brief Structure to hold the Qi Coil Power parameters.
  */
@@ -2664,6 +3617,59 @@ typedef struct
 
 }cy_stc_qi_samsung_ppde_t;
 
+#if CY_QI_TASK_EVT_EN
+/** Full stack pass requested by the application (start, stop, configuration change). */
+#define CY_QI_EVT_POLICY                            (0x0001u)
+/** Stack soft timer expired. The owning layer is not known, so all layers run. */
+#define CY_QI_EVT_TIMER                             (0x0002u)
+/** ASK packet received, or a reception failed. */
+#define CY_QI_EVT_ASK_PKT                           (0x0004u)
+/** FSK transmission completed. */
+#define CY_QI_EVT_FSK_DONE                          (0x0008u)
+
+/** Events handled by a full Cy_QiStack_Task pass. Other events run the layers in order. */
+#define CY_QI_EVT_ALL_MASK                          (CY_QI_EVT_POLICY | CY_QI_EVT_TIMER)
+
+/**
+ * @brief Structure to hold the pending stack events.
+ */
+typedef struct
+{
+    /** Pending event bits, set from interrupt context */
+    volatile uint32_t pending;
+
+    /** Task passes that found pending events */
+    uint32_t wakeCnt;
+
+    /** Task passes without pending events */
+    uint32_t emptyCnt;
+
+} cy_stc_qi_evt_t;
+
+#endif /* CY_QI_TASK_EVT_EN */
+
+#if CY_QI_TICKLESS_EN
+/**
+ * @brief Structure to hold the tickless idle statistics.
+ */
+typedef struct
+{
+    /** Deep sleep entries */
+    uint32_t sleepCnt;
+
+    /** Ticks spent in deep sleep */
+    uint32_t sleepTicks;
+
+    /** Wakes before the programmed deadline */
+    uint32_t earlyWakeCnt;
+
+    /** Idle calls that stayed awake */
+    uint32_t skipCnt;
+
+} cy_stc_qi_tickless_t;
+
+#endif /* CY_QI_TICKLESS_EN */
+
 /**
  * @brief Structure to QISTACK Middleware context information.
  */
@@ -2709,6 +3715,51 @@ typedef struct cy_stc_qi_context
 
     /** Stack Timer Context */
     cy_stc_pdutils_sw_timer_t *ptrTimerContext;
+
+    /*
+     * Members below are not known to the prebuilt libraries. They must stay
+     * after all library owned members so that those keep their offsets.
+     */
+#if CY_QI_TASK_EVT_EN
+    /** Pending stack events */
+    cy_stc_qi_evt_t evt;
+
+#endif /* CY_QI_TASK_EVT_EN */
+#if CY_QI_TICKLESS_EN
+    /** Tickless idle statistics */
+    cy_stc_qi_tickless_t tickless;
+
+#endif /* CY_QI_TICKLESS_EN */
+#if CY_QI_ADT_TX_EN
+    /** PTx data stream transfer */
+    cy_stc_qi_adt_tx_t adtTx;
+
+#endif /* CY_QI_ADT_TX_EN */
+#if CY_QI_ADT_RX_EN
+    /** PRx data stream reassembly */
+    cy_stc_qi_adt_rx_t adtRx;
+
+#endif /* CY_QI_ADT_RX_EN */
+#if (CY_QI_BMC_RX_LUT_EN != 0)
+    /** Table driven BMC receiver */
+    cy_stc_qi_bmc_lut_t bmcLut;
+
+#endif /* CY_QI_BMC_RX_LUT_EN */
+#if (CY_QI_ASK_PKT_QUEUE_DEPTH != 0)
+    /** Decoded packets for the application, see CY_QI_ASK_PKT_QUEUE_DEPTH */
+    cy_stc_qi_ask_pkt_queue_t askPktQueue;
+
+#endif /* CY_QI_ASK_PKT_QUEUE_DEPTH */
+#if CY_QI_FSK_SCHED_EN
+    /** FSK edge schedule of the frame in transmission */
+    cy_stc_qi_fsk_sched_t fskSched;
+
+#endif /* CY_QI_FSK_SCHED_EN */
+#if (CY_QI_FSK_TX_QUEUE_DEPTH != 0)
+    /** Patterns and frames waiting for a response window */
+    cy_stc_qi_fsk_tx_queue_t fskTxQueue;
+
+#endif /* CY_QI_FSK_TX_QUEUE_DEPTH */
 } cy_stc_qi_context_t;
 
 /** \} group_qistack_enums */
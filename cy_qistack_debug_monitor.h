@@ -636,6 +636,270 @@ void Cy_QiStack_Get_Max_Pwr_Cap(cy_stc_qi_context_t *qiCtx, uint8_t *buffer);
 *******************************************************************************/
 void Cy_QiStack_Set_Max_Pwr_Cap(cy_stc_qi_context_t *qiCtx, uint8_t *buffer);
 
+#if (CY_QI_BMC_RX_LUT_EN != 0)
+/*******************************************************************************
+* Function Name: Cy_QiStack_Get_ASK_Stats
+******************************************************************************
+*
+* This function copies the ASK decode quality counters (cy_stc_qi_ask_stats_t)
+* from stack.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+* \param buffer
+* buffer of at least sizeof(cy_stc_qi_ask_stats_t) bytes
+* \return
+* none
+*
+*******************************************************************************/
+void Cy_QiStack_Get_ASK_Stats(cy_stc_qi_context_t *qiCtx, uint8_t *buffer);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Clear_ASK_Stats
+******************************************************************************
+*
+* This function clears the ASK decode quality counters.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+* \return
+* none
+*
+*******************************************************************************/
+void Cy_QiStack_Clear_ASK_Stats(cy_stc_qi_context_t *qiCtx);
+#endif /* CY_QI_BMC_RX_LUT_EN */
+
+#if CY_QI_FSK_SCHED_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Get_FSK_Isr_Stats
+******************************************************************************
+*
+* This function copies the FSK edge interrupt load counters
+* (cy_stc_qi_fsk_isr_stats_t) from stack.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+* \param buffer
+* buffer of at least sizeof(cy_stc_qi_fsk_isr_stats_t) bytes
+* \return
+* none
+*
+*******************************************************************************/
+void Cy_QiStack_Get_FSK_Isr_Stats(cy_stc_qi_context_t *qiCtx, uint8_t *buffer);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Clear_FSK_Isr_Stats
+******************************************************************************
+*
+* This function clears the FSK edge interrupt load counters.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+* \return
+* none
+*
+*******************************************************************************/
+void Cy_QiStack_Clear_FSK_Isr_Stats(cy_stc_qi_context_t *qiCtx);
+#endif /* CY_QI_FSK_SCHED_EN */
+
+#if CY_QI_ADT_TX_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Get_ADT_Tx_Stats
+******************************************************************************
+*
+* This function copies the PTx data stream delivery counters
+* (cy_stc_qi_adt_tx_stats_t) from stack.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+* \param buffer
+* buffer of at least sizeof(cy_stc_qi_adt_tx_stats_t) bytes
+* \return
+* none
+*
+*******************************************************************************/
+void Cy_QiStack_Get_ADT_Tx_Stats(cy_stc_qi_context_t *qiCtx, uint8_t *buffer);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Clear_ADT_Tx_Stats
+******************************************************************************
+*
+* This function clears the PTx data stream delivery counters.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+* \return
+* none
+*
+*******************************************************************************/
+void Cy_QiStack_Clear_ADT_Tx_Stats(cy_stc_qi_context_t *qiCtx);
+#endif /* CY_QI_ADT_TX_EN */
+
+#if CY_QI_ADT_RX_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Get_ADT_Rx_Stats
+******************************************************************************
+*
+* This function copies the PRx data stream counters
+* (cy_stc_qi_adt_rx_stats_t) from stack.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+* \param buffer
+* buffer of at least sizeof(cy_stc_qi_adt_rx_stats_t) bytes
+* \return
+* none
+*
+*******************************************************************************/
+void Cy_QiStack_Get_ADT_Rx_Stats(cy_stc_qi_context_t *qiCtx, uint8_t *buffer);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Clear_ADT_Rx_Stats
+******************************************************************************
+*
+* This function clears the PRx data stream counters.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+* \return
+* none
+*
+*******************************************************************************/
+void Cy_QiStack_Clear_ADT_Rx_Stats(cy_stc_qi_context_t *qiCtx);
+#endif /* CY_QI_ADT_RX_EN */
+
+#if CY_QI_AUTH_CACHE_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Get_Auth_Cache_Stats
+******************************************************************************
+*
+* This function copies the certificate cache counters and request latencies
+* (cy_stc_qi_auth_cache_stats_t) from stack.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+* \param buffer
+* buffer of at least sizeof(cy_stc_qi_auth_cache_stats_t) bytes
+* \return
+* none
+*
+*******************************************************************************/
+void Cy_QiStack_Get_Auth_Cache_Stats(cy_stc_qi_context_t *qiCtx, uint8_t *buffer);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Clear_Auth_Cache_Stats
+******************************************************************************
+*
+* This function clears the certificate cache counters.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+* \return
+* none
+*
+*******************************************************************************/
+void Cy_QiStack_Clear_Auth_Cache_Stats(cy_stc_qi_context_t *qiCtx);
+#endif /* CY_QI_AUTH_CACHE_EN */
+
+#if CY_QI_AUTH_REQ_HIST_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Get_Auth_Req_Hist
+******************************************************************************
+*
+* This function copies the authentication request latency histograms,
+* cy_stc_qi_auth_req_hist_t indexed by cy_en_qi_auth_req_hist_t.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+* \param buffer
+* buffer of at least CY_QI_AUTH_REQ_HIST_MAX * sizeof(cy_stc_qi_auth_req_hist_t) bytes
+* \return
+* none
+*
+*******************************************************************************/
+void Cy_QiStack_Get_Auth_Req_Hist(cy_stc_qi_context_t *qiCtx, uint8_t *buffer);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Clear_Auth_Req_Hist
+******************************************************************************
+*
+* This function clears the authentication request latency histograms.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+* \return
+* none
+*
+*******************************************************************************/
+void Cy_QiStack_Clear_Auth_Req_Hist(cy_stc_qi_context_t *qiCtx);
+#endif /* CY_QI_AUTH_REQ_HIST_EN */
+
+#if CY_QI_AUTH_WARM_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Get_Auth_Session_Stats
+******************************************************************************
+*
+* This function copies the OPTIGA session counters and time to first
+* signature (cy_stc_qi_auth_session_stats_t) from stack.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+* \param buffer
+* buffer of at least sizeof(cy_stc_qi_auth_session_stats_t) bytes
+* \return
+* none
+*
+*******************************************************************************/
+void Cy_QiStack_Get_Auth_Session_Stats(cy_stc_qi_context_t *qiCtx, uint8_t *buffer);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Clear_Auth_Session_Stats
+******************************************************************************
+*
+* This function clears the OPTIGA session counters.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+* \return
+* none
+*
+*******************************************************************************/
+void Cy_QiStack_Clear_Auth_Session_Stats(cy_stc_qi_context_t *qiCtx);
+#endif /* CY_QI_AUTH_WARM_EN */
+
+#if CY_QI_TIMER_LATE_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Get_Timer_Late_Stats
+******************************************************************************
+*
+* This function copies the expiry lateness histograms of the critical Qi
+* timers, cy_stc_qi_timer_late_t indexed by cy_en_qi_timer_late_t.
+*
+* \param wheel
+* Timing wheel pointer.
+* \param buffer
+* buffer of at least CY_QI_TIMER_LATE_MAX * sizeof(cy_stc_qi_timer_late_t) bytes
+* \return
+* none
+*
+*******************************************************************************/
+void Cy_QiStack_Get_Timer_Late_Stats(cy_stc_qi_timer_wheel_t *wheel, uint8_t *buffer);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Clear_Timer_Late_Stats
+******************************************************************************
+*
+* This function clears the expiry lateness histograms.
+*
+* \param wheel
+* Timing wheel pointer.
+* \return
+* none
+*
+*******************************************************************************/
+void Cy_QiStack_Clear_Timer_Late_Stats(cy_stc_qi_timer_wheel_t *wheel);
+#endif /* CY_QI_TIMER_LATE_EN */
+
 #endif /* CCG_HPI_WLC_CMD_ENABLE */
 /** \} group_debug_monitor_functions */
 
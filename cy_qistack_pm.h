@@ -193,6 +193,126 @@ bool Cy_QiStack_Update_Guaranteed_Max_Power(cy_stc_qi_context_t *qiCtx, uint8_t
  */
 void Cy_Qistack_Auth_Start_Transmission(cy_stc_qi_context_t *qiCtx, uint16_t buffer_size);
 
+#if CY_QI_TASK_EVT_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Evt_Init
+****************************************************************************//**
+*
+* This function clears the event counters, posts CY_QI_EVT_POLICY for the
+* first full pass and makes the stack timer expiries post CY_QI_EVT_TIMER to
+* this context. Call once before the first Cy_QiStack_Evt_Task.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+*******************************************************************************/
+void Cy_QiStack_Evt_Init(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Evt_Timer_Expired
+****************************************************************************//**
+*
+* This function posts CY_QI_EVT_TIMER to the context given to
+* Cy_QiStack_Evt_Init. Called by the timer backend for every stack timer
+* expiry, after the timer callback.
+*
+*******************************************************************************/
+void Cy_QiStack_Evt_Timer_Expired(void);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Evt_Set
+****************************************************************************//**
+*
+* This function posts stack events. Safe to call from interrupt context and
+* from soft timer callbacks.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param evtMask
+* CY_QI_EVT_* bits to set.
+*
+*******************************************************************************/
+void Cy_QiStack_Evt_Set(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx,
+       /* Event bits to post. */
+       uint32_t evtMask);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Evt_Task
+****************************************************************************//**
+*
+* This function runs the Qi stack when events are pending and returns
+* immediately when none is. Replaces Cy_QiStack_Task in the application main
+* loop. CY_QI_EVT_POLICY and CY_QI_EVT_TIMER run a full Cy_QiStack_Task pass;
+* packet events run the communication, object and power layers in order.
+* When a layer fails, the layers after it are skipped and the events are
+* posted again for the next pass. Fault handling, analog ping detection and
+* the other interrupt flags internal to the prebuilt libraries post no event:
+* the application posts CY_QI_EVT_POLICY for them, or calls Cy_QiStack_Task.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* CY_QISTACK_STAT_SUCCESS if operation is successful
+* CY_QISTACK_STAT_BAD_PARAM if the context pointer is invalid
+* Status of the failing layer otherwise
+*
+*******************************************************************************/
+cy_en_qi_status_t Cy_QiStack_Evt_Task(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Evt_Is_Sleep_Allowed
+****************************************************************************//**
+*
+* This function returns Qi stack Sleep entry status of the event driven task.
+* Must be called with interrupts disabled, right before the wait for
+* interrupt instruction, so that no event is lost.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \return
+* True if no event is pending, otherwise False.
+*
+*******************************************************************************/
+bool Cy_QiStack_Evt_Is_Sleep_Allowed(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx);
+#endif /* CY_QI_TASK_EVT_EN */
+#if CY_QI_TICKLESS_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Tickless_Idle
+****************************************************************************//**
+*
+* This function puts the device in deep sleep up to the earliest Qi timer
+* deadline, when Cy_QiStack_Is_DeepSleep_Alowed permits it, and applies the
+* elapsed ticks to the timing wheel on wake. Expired timer callbacks run
+* before it returns. Call from the application idle path in place of the
+* deep sleep entry. Soft timers outside the timing wheel are not considered.
+*
+* \param qiCtx
+* QiStack Library Context pointer.
+*
+* \param wheel
+* Timing wheel holding the Qi timers.
+*
+* \return
+* Ticks spent in deep sleep, 0 if the device stayed awake.
+*
+*******************************************************************************/
+uint32_t Cy_QiStack_Tickless_Idle(
+       /* Pointer to the qistack context. */
+       cy_stc_qi_context_t *qiCtx,
+       /* Pointer to the timing wheel. */
+       cy_stc_qi_timer_wheel_t *wheel);
+#endif /* CY_QI_TICKLESS_EN */
 
 /** \} group_qistack_functions */
 
@@ -0,0 +1,113 @@
+/***************************************************************************//**
+* \file cy_qistack_task_evt.c
+* \version 2.0
+*
+* Source file of the event driven stack task of the QiStack middleware.
+* Interrupts and timer expiries post wake reasons to one event word; the task
+* takes the word in one step and runs the stack only when an event is pending.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_pm.h"
+#include "cy_qistack_comm_manager.h"
+#include "cy_qistack_object_manager.h"
+#include "cy_qistack_power_manager.h"
+#include "cy_syslib.h"
+
+#if CY_QI_TASK_EVT_EN
+
+/* Context the stack timer expiries are posted to. */
+static cy_stc_qi_context_t *gl_evt_ctx = NULL;
+
+void Cy_QiStack_Evt_Init(cy_stc_qi_context_t *qiCtx)
+{
+    uint32_t intr = Cy_SysLib_EnterCriticalSection();
+
+    qiCtx->evt.pending = CY_QI_EVT_POLICY;
+    qiCtx->evt.wakeCnt = 0u;
+    qiCtx->evt.emptyCnt = 0u;
+    gl_evt_ctx = qiCtx;
+
+    Cy_SysLib_ExitCriticalSection(intr);
+}
+
+void Cy_QiStack_Evt_Timer_Expired(void)
+{
+    if (gl_evt_ctx != NULL)
+    {
+        Cy_QiStack_Evt_Set(gl_evt_ctx, CY_QI_EVT_TIMER);
+    }
+}
+
+void Cy_QiStack_Evt_Set(cy_stc_qi_context_t *qiCtx, uint32_t evtMask)
+{
+    /* No exclusive access instructions on CM0; mask interrupts for the update. */
+    uint32_t intr = Cy_SysLib_EnterCriticalSection();
+
+    qiCtx->evt.pending |= evtMask;
+
+    Cy_SysLib_ExitCriticalSection(intr);
+}
+
+cy_en_qi_status_t Cy_QiStack_Evt_Task(cy_stc_qi_context_t *qiCtx)
+{
+    cy_en_qi_status_t status;
+    uint32_t intr;
+    uint32_t evt;
+
+    if (qiCtx == NULL)
+    {
+        return CY_QISTACK_STAT_BAD_PARAM;
+    }
+
+    if (qiCtx->evt.pending == 0u)
+    {
+        qiCtx->evt.emptyCnt++;
+        return CY_QISTACK_STAT_SUCCESS;
+    }
+
+    /* Events posted while the layers run are kept for the next pass. */
+    intr = Cy_SysLib_EnterCriticalSection();
+    evt = qiCtx->evt.pending;
+    qiCtx->evt.pending = 0u;
+    Cy_SysLib_ExitCriticalSection(intr);
+
+    qiCtx->evt.wakeCnt++;
+
+    if ((evt & CY_QI_EVT_ALL_MASK) != 0u)
+    {
+        return Cy_QiStack_Task(qiCtx);
+    }
+
+    /* Communication first: a received packet or a sent response feeds the object and power layers. */
+    status = Cy_QiStack_Comm_Task(qiCtx);
+    if (status == CY_QISTACK_STAT_SUCCESS)
+    {
+        status = Cy_QiStack_Object_Task(qiCtx);
+        if (status == CY_QISTACK_STAT_SUCCESS)
+        {
+            return Cy_QiStack_Power_Task(qiCtx);
+        }
+    }
+
+    /* The skipped layers have not seen the events: keep them for the next pass. */
+    Cy_QiStack_Evt_Set(qiCtx, evt);
+
+    return status;
+}
+
+bool Cy_QiStack_Evt_Is_Sleep_Allowed(cy_stc_qi_context_t *qiCtx)
+{
+    return (qiCtx->evt.pending == 0u);
+}
+
+#endif /* CY_QI_TASK_EVT_EN */
+
+/* [] END OF FILE */
@@ -0,0 +1,78 @@
+/***************************************************************************//**
+* \file cy_qistack_tickless.c
+* \version 2.0
+*
+* Source file of the tickless idle mode of the QiStack middleware. Between
+* pings the soft timer tick is stopped and the device deep sleeps up to the
+* earliest Qi timer deadline.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_pm.h"
+#include "cy_syslib.h"
+#if CY_QI_AUTH_WARM_EN
+#include "cy_qistack_auth_optiga.h"
+#endif /* CY_QI_AUTH_WARM_EN */
+
+#if CY_QI_TICKLESS_EN
+
+uint32_t Cy_QiStack_Tickless_Idle(cy_stc_qi_context_t *qiCtx, cy_stc_qi_timer_wheel_t *wheel)
+{
+    cy_stc_qi_tickless_t *stat = &qiCtx->tickless;
+    cy_stc_qi_app_cbk_t *app = qiCtx->ptrAppCbk;
+    uint32_t next;
+    uint32_t elapsed;
+    uint32_t intr;
+
+    /* Interrupts stay masked from the checks to the sleep entry, so that no wake reason is lost. */
+    intr = Cy_SysLib_EnterCriticalSection();
+
+    next = Cy_QiStack_Timer_Wheel_Next(wheel);
+    if ((!Cy_QiStack_Is_DeepSleep_Alowed(qiCtx)) ||
+#if CY_QI_TASK_EVT_EN
+            (!Cy_QiStack_Evt_Is_Sleep_Allowed(qiCtx)) ||
+#endif /* CY_QI_TASK_EVT_EN */
+#if CY_QI_AUTH_WARM_EN
+            (!Cy_QiStack_Auth_Session_Is_Sleep_Allowed()) ||
+#endif /* CY_QI_AUTH_WARM_EN */
+            (next < CY_QI_TICKLESS_MIN_TICKS))
+    {
+        stat->skipCnt++;
+        Cy_SysLib_ExitCriticalSection(intr);
+        return 0u;
+    }
+
+    if (next > CY_QI_TICKLESS_MAX_TICKS)
+    {
+        next = CY_QI_TICKLESS_MAX_TICKS;
+    }
+
+    app->lp_timer_start(qiCtx, next);
+    app->deep_sleep_enter(qiCtx);
+    elapsed = app->lp_timer_stop(qiCtx);
+
+    stat->sleepCnt++;
+    stat->sleepTicks += elapsed;
+    if (elapsed < next)
+    {
+        stat->earlyWakeCnt++;
+    }
+
+    Cy_SysLib_ExitCriticalSection(intr);
+
+    /* Catch up on the ticks missed in deep sleep; due timers expire in one batch. */
+    Cy_QiStack_Timer_Wheel_Tick(wheel, elapsed);
+
+    return elapsed;
+}
+
+#endif /* CY_QI_TICKLESS_EN */
+
+/* [] END OF FILE */
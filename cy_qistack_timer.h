@@ -17,6 +17,7 @@
 #define CY_QISTACK_TIMER_H
 
 #include "cy_pdutils_sw_timer.h"
+#include "cy_qistack_utils.h"
 
 /*******************************************************************************
 *                              Type Definitions
@@ -241,6 +242,371 @@
 
 /** \} group_qistack_timer_value_macros */
 
+/*
+ * Timing wheel backend for the Qi and solution timer IDs. Start, stop and
+ * expiry are O(1); timers expiring on the same tick are called back in one
+ * batch after the wheel update.
+ */
+#ifndef CY_QI_TIMER_WHEEL_EN
+#define CY_QI_TIMER_WHEEL_EN                                (0u)
+#endif /* CY_QI_TIMER_WHEEL_EN */
+
+/*
+ * Expiry lateness of the critical Qi timers, kept as log2 histograms in the
+ * timing wheel. Needs a free running time source, see
+ * Cy_QiStack_Timer_Late_Init.
+ */
+#ifndef CY_QI_TIMER_LATE_EN
+#define CY_QI_TIMER_LATE_EN                                 (0u)
+#endif /* CY_QI_TIMER_LATE_EN */
+
+#if ((CY_QI_TIMER_LATE_EN != 0) && (CY_QI_TIMER_WHEEL_EN == 0))
+#error "Timer lateness instrumentation requires the timing wheel (CY_QI_TIMER_WHEEL_EN)."
+#endif
+
+#if CY_QI_TIMER_WHEEL_EN
+
+/**
+* \addtogroup group_qistack_timer_wheel
+* \{
+*/
+
+/** Wheel slots, one per tick. Power of 2; longer periods take extra laps. */
+#ifndef CY_QI_TIMER_WHEEL_SIZE
+#define CY_QI_TIMER_WHEEL_SIZE                              (64u)
+#endif /* CY_QI_TIMER_WHEEL_SIZE */
+
+/** Maximum number of timers running at the same time. */
+#ifndef CY_QI_TIMER_WHEEL_NUM_TIMERS
+#define CY_QI_TIMER_WHEEL_NUM_TIMERS                        (32u)
+#endif /* CY_QI_TIMER_WHEEL_NUM_TIMERS */
+
+/*
+ * Routes the stack's Cy_PdUtils_SwTimer Start, Stop, StopRange and IsRunning
+ * calls for Qi and solution timer IDs to the wheel passed to
+ * Cy_QiStack_Timer_Wheel_Init. Link with -Wl,--wrap=<function> for each of
+ * them. Other IDs stay on the PDUtils soft timer. With CY_QI_TASK_EVT_EN,
+ * every Qi and solution timer expiry posts CY_QI_EVT_TIMER, also for timers
+ * started on the soft timer before the wheel was initialized.
+ */
+#ifndef CY_QI_TIMER_WHEEL_WRAP_EN
+#define CY_QI_TIMER_WHEEL_WRAP_EN                           (0u)
+#endif /* CY_QI_TIMER_WHEEL_WRAP_EN */
+
+#if (((CY_QI_TIMER_WHEEL_SIZE & (CY_QI_TIMER_WHEEL_SIZE - 1u)) != 0u) || (CY_QI_TIMER_WHEEL_SIZE > 256u))
+#error "CY_QI_TIMER_WHEEL_SIZE must be a power of 2 not larger than 256."
+#endif
+
+#if (CY_QI_TIMER_WHEEL_NUM_TIMERS > 255u)
+#error "CY_QI_TIMER_WHEEL_NUM_TIMERS must not be larger than 255."
+#endif
+
+/** Number of Qi timer IDs handled by the wheel, from CY_QI_TIMER_ID_OFFSET. */
+#define CY_QI_TIMER_WHEEL_QI_IDS                            ((CY_QI_TIMER_PWR_END_ID - CY_QI_TIMER_ID_OFFSET) + 1u)
+
+/** Number of solution timer IDs handled by the wheel, from CY_SOLN_TIMER_ID_OFFSET. */
+#define CY_QI_TIMER_WHEEL_SOLN_IDS                          (16u)
+
+/** Returned by Cy_QiStack_Timer_Wheel_Next when no timer is running. */
+#define CY_QI_TIMER_WHEEL_NONE                              (0xFFFFFFFFu)
+
+#if CY_QI_TIMER_LATE_EN
+/**
+ * Lateness histogram bins, counted by cy_log2_hist_add. Bin 0 counts on time
+ * expiries, bin n lateness from 2^(n-1) to 2^n - 1 time source units.
+ */
+#define CY_QI_TIMER_LATE_BINS                               (CY_QI_LOG2_HIST_BINS)
+
+/**
+ * @brief Timers with lateness instrumentation.
+ */
+typedef enum
+{
+    CY_QI_TIMER_LATE_T_NEXT = 0,                            /**< CY_QI_T_NEXT_TIME_ID */
+    CY_QI_TIMER_LATE_PID_LOOP,                              /**< CY_QI_TIMER_PID_LOOP_TIME_ID */
+    CY_QI_TIMER_LATE_PKT_TIMEOUT,                           /**< CY_QI_TIMER_PKT_TIMEOUT_TIME_ID */
+    CY_QI_TIMER_LATE_ASK_PKT_RECEPTION,                     /**< CY_QI_ASK_PKT_RECEPTION_TIME_ID */
+    CY_QI_TIMER_LATE_MAX                                    /**< Number of instrumented timers */
+} cy_en_qi_timer_late_t;
+
+/** Free running time source of the lateness instrumentation. */
+typedef uint32_t (*cy_cb_qi_timer_time_t)(void);
+
+/**
+ * @brief Structure to hold the expiry lateness of one timer.
+ */
+typedef struct
+{
+    /** log2 lateness histogram */
+    uint16_t hist[CY_QI_TIMER_LATE_BINS];
+
+    /** Largest lateness in time source units */
+    uint32_t max;
+
+} cy_stc_qi_timer_late_t;
+#endif /* CY_QI_TIMER_LATE_EN */
+
+/**
+ * @brief Structure to hold one running timer of the timing wheel.
+ */
+typedef struct
+{
+    /** Expiry callback */
+    cy_cb_timer_t cb;
+
+    /** Callback context */
+    void *callbackContext;
+
+    /** Timer ID */
+    cy_timer_id_t id;
+
+    /** Full wheel laps left before expiry */
+    uint16_t rounds;
+
+    /** Next timer in the slot or free list */
+    uint8_t next;
+
+    /** Previous timer in the slot */
+    uint8_t prev;
+
+    /** Wheel slot */
+    uint8_t slot;
+
+#if CY_QI_TIMER_LATE_EN
+    /** Lateness record, CY_QI_TIMER_LATE_MAX if not instrumented */
+    uint8_t late;
+
+    /** Scheduled expiry on the time source */
+    uint32_t due;
+
+#endif /* CY_QI_TIMER_LATE_EN */
+} cy_stc_qi_timer_node_t;
+
+/**
+ * @brief Structure to hold the timing wheel.
+ */
+typedef struct
+{
+    /** Timer pool */
+    cy_stc_qi_timer_node_t node[CY_QI_TIMER_WHEEL_NUM_TIMERS];
+
+    /** First timer of each slot */
+    uint8_t slot[CY_QI_TIMER_WHEEL_SIZE];
+
+    /** Pool index of each running timer ID */
+    uint8_t idMap[CY_QI_TIMER_WHEEL_QI_IDS + CY_QI_TIMER_WHEEL_SOLN_IDS];
+
+    /** First free timer */
+    uint8_t freeHead;
+
+    /** Current slot */
+    uint8_t cur;
+
+    /** Running timers */
+    uint8_t activeCnt;
+
+    /** Highest number of running timers */
+    uint8_t activeMax;
+
+    /** Start requests rejected with an empty pool */
+    uint16_t overflowCnt;
+
+    /** Ticks since init */
+    uint32_t tickCnt;
+
+#if CY_QI_TIMER_LATE_EN
+    /** Time source, NULL to disable the lateness instrumentation */
+    cy_cb_qi_timer_time_t getTime;
+
+    /** Time source units per tick */
+    uint32_t timePerTick;
+
+    /** Lateness of the instrumented timers */
+    cy_stc_qi_timer_late_t late[CY_QI_TIMER_LATE_MAX];
+
+#endif /* CY_QI_TIMER_LATE_EN */
+} cy_stc_qi_timer_wheel_t;
+
+/** \} group_qistack_timer_wheel */
+
+/**
+* \addtogroup group_qistack_functions
+* \{
+*/
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Timer_Wheel_Init
+****************************************************************************//**
+*
+* This function initializes the timing wheel with all timers stopped.
+*
+* \param wheel
+* Timing wheel pointer.
+*
+*******************************************************************************/
+void Cy_QiStack_Timer_Wheel_Init(
+       /* Pointer to the timing wheel. */
+       cy_stc_qi_timer_wheel_t *wheel);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Timer_Wheel_Start
+****************************************************************************//**
+*
+* This function starts or restarts a timer. Same arguments as
+* Cy_PdUtils_SwTimer_Start.
+*
+* \param wheel
+* Timing wheel pointer.
+*
+* \param callbackContext
+* Context passed to the callback.
+*
+* \param id
+* Qi or solution timer ID.
+*
+* \param period
+* Timer period in ticks.
+*
+* \param cb
+* Expiry callback.
+*
+* \return
+* True if the timer is started, false for an unknown ID or a full pool.
+*
+*******************************************************************************/
+bool Cy_QiStack_Timer_Wheel_Start(
+       cy_stc_qi_timer_wheel_t *wheel,
+       void *callbackContext,
+       cy_timer_id_t id,
+       uint16_t period,
+       cy_cb_timer_t cb);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Timer_Wheel_Stop
+****************************************************************************//**
+*
+* This function stops a timer. No effect if the timer is not running.
+*
+* \param wheel
+* Timing wheel pointer.
+*
+* \param id
+* Qi or solution timer ID.
+*
+*******************************************************************************/
+void Cy_QiStack_Timer_Wheel_Stop(
+       cy_stc_qi_timer_wheel_t *wheel,
+       cy_timer_id_t id);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Timer_Wheel_Stop_Range
+****************************************************************************//**
+*
+* This function stops all timers with IDs from start to end, inclusive.
+*
+* \param wheel
+* Timing wheel pointer.
+*
+* \param start
+* First timer ID.
+*
+* \param end
+* Last timer ID.
+*
+*******************************************************************************/
+void Cy_QiStack_Timer_Wheel_Stop_Range(
+       cy_stc_qi_timer_wheel_t *wheel,
+       cy_timer_id_t start,
+       cy_timer_id_t end);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Timer_Wheel_Is_Running
+****************************************************************************//**
+*
+* This function returns the run status of a timer.
+*
+* \param wheel
+* Timing wheel pointer.
+*
+* \param id
+* Qi or solution timer ID.
+*
+* \return
+* True if the timer is running, otherwise False.
+*
+*******************************************************************************/
+bool Cy_QiStack_Timer_Wheel_Is_Running(
+       cy_stc_qi_timer_wheel_t *wheel,
+       cy_timer_id_t id);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Timer_Wheel_Next
+****************************************************************************//**
+*
+* This function returns the number of ticks up to the next expiry. The
+* search stops at the first slot holding a timer due in the current lap.
+*
+* \param wheel
+* Timing wheel pointer.
+*
+* \return
+* Ticks to the next expiry, CY_QI_TIMER_WHEEL_NONE if no timer is running.
+*
+*******************************************************************************/
+uint32_t Cy_QiStack_Timer_Wheel_Next(
+       cy_stc_qi_timer_wheel_t *wheel);
+
+/*******************************************************************************
+* Function Name: Cy_QiStack_Timer_Wheel_Tick
+****************************************************************************//**
+*
+* This function advances the wheel and calls back all expired timers in one
+* batch. Expired timers are stopped before their callback runs, so that a
+* callback can restart its own timer. Call from the tick interrupt with
+* ticks = 1, or with the elapsed ticks after a sleep period. With
+* CY_QI_TASK_EVT_EN, each expiry posts CY_QI_EVT_TIMER after its callback.
+*
+* \param wheel
+* Timing wheel pointer.
+*
+* \param ticks
+* Elapsed ticks.
+*
+*******************************************************************************/
+void Cy_QiStack_Timer_Wheel_Tick(
+       cy_stc_qi_timer_wheel_t *wheel,
+       uint32_t ticks);
+
+#if CY_QI_TIMER_LATE_EN
+/*******************************************************************************
+* Function Name: Cy_QiStack_Timer_Late_Init
+****************************************************************************//**
+*
+* This function sets the time source of the timer lateness instrumentation
+* and clears the histograms. The lateness of an expiry is the time from the
+* scheduled expiry, start time plus period, to the call of its callback.
+* Expiries up to one tick early from the start phase count as on time.
+*
+* \param wheel
+* Timing wheel pointer.
+*
+* \param getTime
+* Free running time source, NULL to disable.
+*
+* \param timePerTick
+* Time source units per tick.
+*
+*******************************************************************************/
+void Cy_QiStack_Timer_Late_Init(
+       cy_stc_qi_timer_wheel_t *wheel,
+       cy_cb_qi_timer_time_t getTime,
+       uint32_t timePerTick);
+#endif /* CY_QI_TIMER_LATE_EN */
+
+/** \} group_qistack_functions */
+
+#endif /* CY_QI_TIMER_WHEEL_EN */
+
 #endif /* CY_QISTACK_TIMER_H */
 
 /* [] END OF FILE */
@@ -0,0 +1,483 @@
+/***************************************************************************//**
+* \file cy_qistack_timer_wheel.c
+* \version 2.0
+*
+* Source file of the timing wheel timer backend of the QiStack middleware.
+* Each running timer sits in the slot of its expiry tick; a tick only visits
+* the timers of one slot.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "cy_qistack_timer.h"
+#include "cy_syslib.h"
+#if ((CY_QI_TIMER_LATE_EN != 0) && (CCG_HPI_WLC_CMD_ENABLE != 0))
+#include "cy_qistack_debug_monitor.h"
+#endif /* CY_QI_TIMER_LATE_EN && CCG_HPI_WLC_CMD_ENABLE */
+#if CY_QI_TASK_EVT_EN
+#include "cy_qistack_pm.h"
+#endif /* CY_QI_TASK_EVT_EN */
+
+#if CY_QI_TIMER_WHEEL_EN
+
+#define CY_QI_TIMER_WHEEL_MASK                      (CY_QI_TIMER_WHEEL_SIZE - 1u)
+
+/* End of list and unused ID marker. */
+#define CY_QI_TIMER_WHEEL_NIL                       (0xFFu)
+
+#if CY_QI_TIMER_WHEEL_WRAP_EN
+/* Wheel serving the wrapped PDUtils soft timer calls. */
+static cy_stc_qi_timer_wheel_t *gl_timer_wheel = NULL;
+#endif /* CY_QI_TIMER_WHEEL_WRAP_EN */
+
+/* Returns the ID map index of a timer ID, CY_QI_TIMER_WHEEL_NIL if the wheel does not handle it. */
+static uint8_t timer_wheel_map(cy_timer_id_t id)
+{
+    uint32_t idx = CY_QI_TIMER_WHEEL_NIL;
+
+    if ((id >= CY_QI_TIMER_ID_OFFSET) && ((uint32_t)(id - CY_QI_TIMER_ID_OFFSET) < CY_QI_TIMER_WHEEL_QI_IDS))
+    {
+        idx = (uint32_t)id - CY_QI_TIMER_ID_OFFSET;
+    }
+    else if ((id >= CY_SOLN_TIMER_ID_OFFSET) && ((uint32_t)(id - CY_SOLN_TIMER_ID_OFFSET) < CY_QI_TIMER_WHEEL_SOLN_IDS))
+    {
+        idx = CY_QI_TIMER_WHEEL_QI_IDS + ((uint32_t)id - CY_SOLN_TIMER_ID_OFFSET);
+    }
+    else
+    {
+        /* Not a Qi or solution timer. */
+    }
+
+    return (uint8_t)idx;
+}
+
+#if CY_QI_TIMER_LATE_EN
+static uint8_t timer_late_index(cy_timer_id_t id)
+{
+    cy_en_qi_timer_late_t late;
+
+    switch (id)
+    {
+        case CY_QI_T_NEXT_TIME_ID:
+            late = CY_QI_TIMER_LATE_T_NEXT;
+            break;
+        case CY_QI_TIMER_PID_LOOP_TIME_ID:
+            late = CY_QI_TIMER_LATE_PID_LOOP;
+            break;
+        case CY_QI_TIMER_PKT_TIMEOUT_TIME_ID:
+            late = CY_QI_TIMER_LATE_PKT_TIMEOUT;
+            break;
+        case CY_QI_ASK_PKT_RECEPTION_TIME_ID:
+            late = CY_QI_TIMER_LATE_ASK_PKT_RECEPTION;
+            break;
+        default:
+            late = CY_QI_TIMER_LATE_MAX;
+            break;
+    }
+
+    return (uint8_t)late;
+}
+
+static void timer_late_record(cy_stc_qi_timer_wheel_t *wheel, uint8_t late, uint32_t due)
+{
+    cy_stc_qi_timer_late_t *rec = &wheel->late[late];
+    int32_t diff = (int32_t)(wheel->getTime() - due);
+    uint32_t val;
+
+    /* Up to a tick early from the start phase within the first tick. */
+    val = (diff > 0) ? (uint32_t)diff : 0u;
+    if (val > rec->max)
+    {
+        rec->max = val;
+    }
+
+    cy_log2_hist_add(rec->hist, val);
+}
+#endif /* CY_QI_TIMER_LATE_EN */
+
+static void timer_wheel_link(cy_stc_qi_timer_wheel_t *wheel, uint8_t n, uint8_t slot)
+{
+    cy_stc_qi_timer_node_t *node = &wheel->node[n];
+    uint8_t head = wheel->slot[slot];
+
+    node->next = head;
+    node->prev = CY_QI_TIMER_WHEEL_NIL;
+    node->slot = slot;
+    if (head != CY_QI_TIMER_WHEEL_NIL)
+    {
+        wheel->node[head].prev = n;
+    }
+    wheel->slot[slot] = n;
+}
+
+static void timer_wheel_unlink(cy_stc_qi_timer_wheel_t *wheel, uint8_t n)
+{
+    cy_stc_qi_timer_node_t *node = &wheel->node[n];
+
+    if (node->prev != CY_QI_TIMER_WHEEL_NIL)
+    {
+        wheel->node[node->prev].next = node->next;
+    }
+    else
+    {
+        wheel->slot[node->slot] = node->next;
+    }
+    if (node->next != CY_QI_TIMER_WHEEL_NIL)
+    {
+        wheel->node[node->next].prev = node->prev;
+    }
+}
+
+static void timer_wheel_free(cy_stc_qi_timer_wheel_t *wheel, uint8_t n)
+{
+    wheel->node[n].next = wheel->freeHead;
+    wheel->freeHead = n;
+}
+
+void Cy_QiStack_Timer_Wheel_Init(cy_stc_qi_timer_wheel_t *wheel)
+{
+    uint32_t n;
+
+    (void)memset(wheel, 0, sizeof(cy_stc_qi_timer_wheel_t));
+    (void)memset(wheel->slot, (int)CY_QI_TIMER_WHEEL_NIL, sizeof(wheel->slot));
+    (void)memset(wheel->idMap, (int)CY_QI_TIMER_WHEEL_NIL, sizeof(wheel->idMap));
+
+    wheel->freeHead = CY_QI_TIMER_WHEEL_NIL;
+    for (n = CY_QI_TIMER_WHEEL_NUM_TIMERS; n > 0u; n--)
+    {
+        timer_wheel_free(wheel, (uint8_t)(n - 1u));
+    }
+
+#if CY_QI_TIMER_WHEEL_WRAP_EN
+    gl_timer_wheel = wheel;
+#endif /* CY_QI_TIMER_WHEEL_WRAP_EN */
+}
+
+bool Cy_QiStack_Timer_Wheel_Start(cy_stc_qi_timer_wheel_t *wheel, void *callbackContext,
+        cy_timer_id_t id, uint16_t period, cy_cb_timer_t cb)
+{
+    cy_stc_qi_timer_node_t *node;
+    uint8_t map = timer_wheel_map(id);
+    uint32_t ticks = (period != 0u) ? period : 1u;
+    uint32_t intr;
+    uint8_t n;
+
+    if (map == CY_QI_TIMER_WHEEL_NIL)
+    {
+        return false;
+    }
+
+    intr = Cy_SysLib_EnterCriticalSection();
+
+    n = wheel->idMap[map];
+    if (n != CY_QI_TIMER_WHEEL_NIL)
+    {
+        /* Restart. */
+        timer_wheel_unlink(wheel, n);
+    }
+    else
+    {
+        n = wheel->freeHead;
+        if (n == CY_QI_TIMER_WHEEL_NIL)
+        {
+            wheel->overflowCnt++;
+            Cy_SysLib_ExitCriticalSection(intr);
+            return false;
+        }
+        wheel->freeHead = wheel->node[n].next;
+        wheel->idMap[map] = n;
+        wheel->activeCnt++;
+        if (wheel->activeCnt > wheel->activeMax)
+        {
+            wheel->activeMax = wheel->activeCnt;
+        }
+    }
+
+    node = &wheel->node[n];
+    node->cb = cb;
+    node->callbackContext = callbackContext;
+    node->id = id;
+    node->rounds = (uint16_t)((ticks - 1u) / CY_QI_TIMER_WHEEL_SIZE);
+#if CY_QI_TIMER_LATE_EN
+    node->late = (wheel->getTime != NULL) ? timer_late_index(id) : (uint8_t)CY_QI_TIMER_LATE_MAX;
+    if (node->late != (uint8_t)CY_QI_TIMER_LATE_MAX)
+    {
+        node->due = wheel->getTime() + (ticks * wheel->timePerTick);
+    }
+#endif /* CY_QI_TIMER_LATE_EN */
+    timer_wheel_link(wheel, n, (uint8_t)((wheel->cur + ticks) & CY_QI_TIMER_WHEEL_MASK));
+
+    Cy_SysLib_ExitCriticalSection(intr);
+
+    return true;
+}
+
+void Cy_QiStack_Timer_Wheel_Stop(cy_stc_qi_timer_wheel_t *wheel, cy_timer_id_t id)
+{
+    uint8_t map = timer_wheel_map(id);
+    uint32_t intr;
+    uint8_t n;
+
+    if (map == CY_QI_TIMER_WHEEL_NIL)
+    {
+        return;
+    }
+
+    intr = Cy_SysLib_EnterCriticalSection();
+
+    n = wheel->idMap[map];
+    if (n != CY_QI_TIMER_WHEEL_NIL)
+    {
+        timer_wheel_unlink(wheel, n);
+        timer_wheel_free(wheel, n);
+        wheel->idMap[map] = CY_QI_TIMER_WHEEL_NIL;
+        wheel->activeCnt--;
+    }
+
+    Cy_SysLib_ExitCriticalSection(intr);
+}
+
+void Cy_QiStack_Timer_Wheel_Stop_Range(cy_stc_qi_timer_wheel_t *wheel, cy_timer_id_t start,
+        cy_timer_id_t end)
+{
+    uint32_t id;
+
+    for (id = start; id <= end; id++)
+    {
+        Cy_QiStack_Timer_Wheel_Stop(wheel, (cy_timer_id_t)id);
+    }
+}
+
+bool Cy_QiStack_Timer_Wheel_Is_Running(cy_stc_qi_timer_wheel_t *wheel, cy_timer_id_t id)
+{
+    uint8_t map = timer_wheel_map(id);
+
+    return ((map != CY_QI_TIMER_WHEEL_NIL) && (wheel->idMap[map] != CY_QI_TIMER_WHEEL_NIL));
+}
+
+uint32_t Cy_QiStack_Timer_Wheel_Next(cy_stc_qi_timer_wheel_t *wheel)
+{
+    uint32_t next = CY_QI_TIMER_WHEEL_NONE;
+    uint32_t intr = Cy_SysLib_EnterCriticalSection();
+    uint32_t remain;
+    uint32_t dist;
+    uint8_t n;
+
+    for (dist = 1u; (dist <= CY_QI_TIMER_WHEEL_SIZE) && (wheel->activeCnt != 0u); dist++)
+    {
+        for (n = wheel->slot[(wheel->cur + dist) & CY_QI_TIMER_WHEEL_MASK]; n != CY_QI_TIMER_WHEEL_NIL;
+                n = wheel->node[n].next)
+        {
+            remain = dist + ((uint32_t)wheel->node[n].rounds * CY_QI_TIMER_WHEEL_SIZE);
+            if (remain < next)
+            {
+                next = remain;
+            }
+        }
+
+        /* Later slots and later laps cannot expire earlier. */
+        if (next <= CY_QI_TIMER_WHEEL_SIZE)
+        {
+            break;
+        }
+    }
+
+    Cy_SysLib_ExitCriticalSection(intr);
+
+    return next;
+}
+
+void Cy_QiStack_Timer_Wheel_Tick(cy_stc_qi_timer_wheel_t *wheel, uint32_t ticks)
+{
+    cy_stc_qi_timer_node_t *node;
+    cy_cb_timer_t cb;
+    void *callbackContext;
+    cy_timer_id_t id;
+    uint8_t expired = CY_QI_TIMER_WHEEL_NIL;
+    uint8_t next;
+    uint8_t n;
+    uint32_t intr = Cy_SysLib_EnterCriticalSection();
+
+    while (ticks != 0u)
+    {
+        if (wheel->activeCnt == 0u)
+        {
+            /* Nothing to expire: skip the remaining ticks at once. */
+            wheel->cur = (uint8_t)((wheel->cur + ticks) & CY_QI_TIMER_WHEEL_MASK);
+            wheel->tickCnt += ticks;
+            break;
+        }
+
+        wheel->cur = (uint8_t)((wheel->cur + 1u) & CY_QI_TIMER_WHEEL_MASK);
+        wheel->tickCnt++;
+        ticks--;
+
+        for (n = wheel->slot[wheel->cur]; n != CY_QI_TIMER_WHEEL_NIL; n = next)
+        {
+            node = &wheel->node[n];
+            next = node->next;
+            if (node->rounds != 0u)
+            {
+                node->rounds--;
+            }
+            else
+            {
+                /* Stopped before the callback, so that the callback can restart it. */
+                timer_wheel_unlink(wheel, n);
+                wheel->idMap[timer_wheel_map(node->id)] = CY_QI_TIMER_WHEEL_NIL;
+                wheel->activeCnt--;
+                node->next = expired;
+                expired = n;
+            }
+        }
+    }
+
+    Cy_SysLib_ExitCriticalSection(intr);
+
+    while (expired != CY_QI_TIMER_WHEEL_NIL)
+    {
+        n = expired;
+        node = &wheel->node[n];
+        expired = node->next;
+        cb = node->cb;
+        callbackContext = node->callbackContext;
+        id = node->id;
+#if CY_QI_TIMER_LATE_EN
+        if ((node->late != (uint8_t)CY_QI_TIMER_LATE_MAX) && (wheel->getTime != NULL))
+        {
+            timer_late_record(wheel, node->late, node->due);
+        }
+#endif /* CY_QI_TIMER_LATE_EN */
+
+        intr = Cy_SysLib_EnterCriticalSection();
+        timer_wheel_free(wheel, n);
+        Cy_SysLib_ExitCriticalSection(intr);
+
+        if (cb != NULL)
+        {
+            cb(id, callbackContext);
+        }
+#if CY_QI_TASK_EVT_EN
+        Cy_QiStack_Evt_Timer_Expired();
+#endif /* CY_QI_TASK_EVT_EN */
+    }
+}
+
+#if CY_QI_TIMER_LATE_EN
+void Cy_QiStack_Timer_Late_Init(cy_stc_qi_timer_wheel_t *wheel, cy_cb_qi_timer_time_t getTime,
+        uint32_t timePerTick)
+{
+    uint32_t intr = Cy_SysLib_EnterCriticalSection();
+
+    wheel->getTime = getTime;
+    wheel->timePerTick = timePerTick;
+    (void)memset(wheel->late, 0, sizeof(wheel->late));
+
+    Cy_SysLib_ExitCriticalSection(intr);
+}
+
+#if (CCG_HPI_WLC_CMD_ENABLE != 0)
+void Cy_QiStack_Get_Timer_Late_Stats(cy_stc_qi_timer_wheel_t *wheel, uint8_t *buffer)
+{
+    (void)memcpy(buffer, wheel->late, sizeof(wheel->late));
+}
+
+void Cy_QiStack_Clear_Timer_Late_Stats(cy_stc_qi_timer_wheel_t *wheel)
+{
+    (void)memset(wheel->late, 0, sizeof(wheel->late));
+}
+#endif /* CCG_HPI_WLC_CMD_ENABLE */
+#endif /* CY_QI_TIMER_LATE_EN */
+
+#if CY_QI_TIMER_WHEEL_WRAP_EN
+bool __real_Cy_PdUtils_SwTimer_Start(cy_stc_pdutils_sw_timer_t *context, void *callbackContext,
+        cy_timer_id_t id, uint16_t period, cy_cb_timer_t cb);
+void __real_Cy_PdUtils_SwTimer_Stop(cy_stc_pdutils_sw_timer_t *context, cy_timer_id_t id);
+void __real_Cy_PdUtils_SwTimer_StopRange(cy_stc_pdutils_sw_timer_t *context, cy_timer_id_t start,
+        cy_timer_id_t end);
+bool __real_Cy_PdUtils_SwTimer_IsRunning(cy_stc_pdutils_sw_timer_t *context, cy_timer_id_t id);
+
+#if CY_QI_TASK_EVT_EN
+/* Callbacks of the Qi and solution timers left on the soft timer. */
+static cy_cb_timer_t gl_timer_evt_cb[CY_QI_TIMER_WHEEL_QI_IDS + CY_QI_TIMER_WHEEL_SOLN_IDS];
+
+/* Soft timer callback of the Qi and solution timers: posts the expiry as a stack event. */
+static void timer_evt_cb(cy_timer_id_t id, void *callbackContext)
+{
+    cy_cb_timer_t cb = gl_timer_evt_cb[timer_wheel_map(id)];
+
+    if (cb != NULL)
+    {
+        cb(id, callbackContext);
+    }
+    Cy_QiStack_Evt_Timer_Expired();
+}
+#endif /* CY_QI_TASK_EVT_EN */
+
+bool __wrap_Cy_PdUtils_SwTimer_Start(cy_stc_pdutils_sw_timer_t *context, void *callbackContext,
+        cy_timer_id_t id, uint16_t period, cy_cb_timer_t cb)
+{
+    uint8_t map = timer_wheel_map(id);
+
+    if ((gl_timer_wheel != NULL) && (map != CY_QI_TIMER_WHEEL_NIL))
+    {
+        return Cy_QiStack_Timer_Wheel_Start(gl_timer_wheel, callbackContext, id, period, cb);
+    }
+
+#if CY_QI_TASK_EVT_EN
+    /* Timers started before Cy_QiStack_Timer_Wheel_Init run on the soft timer. */
+    if (map != CY_QI_TIMER_WHEEL_NIL)
+    {
+        gl_timer_evt_cb[map] = cb;
+        cb = timer_evt_cb;
+    }
+#endif /* CY_QI_TASK_EVT_EN */
+
+    return __real_Cy_PdUtils_SwTimer_Start(context, callbackContext, id, period, cb);
+}
+
+void __wrap_Cy_PdUtils_SwTimer_Stop(cy_stc_pdutils_sw_timer_t *context, cy_timer_id_t id)
+{
+    if ((gl_timer_wheel != NULL) && (timer_wheel_map(id) != CY_QI_TIMER_WHEEL_NIL))
+    {
+        Cy_QiStack_Timer_Wheel_Stop(gl_timer_wheel, id);
+    }
+    else
+    {
+        __real_Cy_PdUtils_SwTimer_Stop(context, id);
+    }
+}
+
+void __wrap_Cy_PdUtils_SwTimer_StopRange(cy_stc_pdutils_sw_timer_t *context, cy_timer_id_t start,
+        cy_timer_id_t end)
+{
+    if (gl_timer_wheel != NULL)
+    {
+        Cy_QiStack_Timer_Wheel_Stop_Range(gl_timer_wheel, start, end);
+    }
+
+    /* The range may also cover IDs left on the soft timer. */
+    __real_Cy_PdUtils_SwTimer_StopRange(context, start, end);
+}
+
+bool __wrap_Cy_PdUtils_SwTimer_IsRunning(cy_stc_pdutils_sw_timer_t *context, cy_timer_id_t id)
+{
+    if ((gl_timer_wheel != NULL) && (timer_wheel_map(id) != CY_QI_TIMER_WHEEL_NIL))
+    {
+        return Cy_QiStack_Timer_Wheel_Is_Running(gl_timer_wheel, id);
+    }
+
+    return __real_Cy_PdUtils_SwTimer_IsRunning(context, id);
+}
+#endif /* CY_QI_TIMER_WHEEL_WRAP_EN */
+
+#endif /* CY_QI_TIMER_WHEEL_EN */
+
+/* [] END OF FILE */
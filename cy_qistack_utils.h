@@ -56,6 +56,13 @@
 /**< Make 16 bit from two 8 bit data */
 #define MAKE_WORD(hi,lo)                    (((uint16_t)(hi) << 8) | ((uint16_t)(lo)))
 
+/**< Odd parity nibble table: bit n is set when n has an even number of ones */
+#define CY_QI_ODD_PARITY_TBL                (0x9669u)
+
+/**< Odd parity bit of a byte, same result as cy_get_odd_parity(). Evaluates x twice. */
+#define CY_QI_ODD_PARITY(x)                 \
+    (((CY_QI_ODD_PARITY_TBL >> (((uint8_t)(x) ^ ((uint8_t)(x) >> 4u)) & 0x0Fu)) & 1u) != 0u)
+
 /**
  * @brief Combine four bytes to create one 32-bit DWORD.
  */
@@ -63,6 +70,9 @@
     (((uint32_t)(b3) << 24) | ((uint32_t)(b2) << 16) |  \
      ((uint32_t)(b1) << 8) | ((uint32_t)(b0)))
 
+/**< Bins of a log2 histogram: bin 0 counts 0, bin n values from 2^(n-1) to 2^n - 1; the last bin takes the rest. */
+#define CY_QI_LOG2_HIST_BINS              (20u)
+
 /* Maximum value of 32 bit */
 #define CY_QI_VAL_INVALID                 (0xFFFFFFFFu)
 
@@ -418,6 +428,25 @@ uint8_t Cy_RingBuf_GetMin_Uint8(cy_stc_ring_buf_t* ptrRingBuf);
 *******************************************************************************/
 uint8_t Cy_RingBuf_GetMax_Uint8(cy_stc_ring_buf_t* ptrRingBuf);
 
+/*******************************************************************************
+* Function Name: cy_log2_hist_add
+********************************************************************************
+*
+* This function counts a value in a log2 histogram of CY_QI_LOG2_HIST_BINS
+* bins. A bin stops counting at 0xFFFF.
+*
+* \param hist
+* Histogram of CY_QI_LOG2_HIST_BINS bins
+*
+* \param val
+* Value to count
+*
+* \return
+* None
+*
+*******************************************************************************/
+void cy_log2_hist_add(uint16_t *hist, uint32_t val);
+
 /** \} group_qistack_utils_functions */
 
 #endif /* CY_QISTACK_UTILS_H */
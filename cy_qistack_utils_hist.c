@@ -0,0 +1,71 @@
+/***************************************************************************//**
+* \file cy_qistack_utils_hist.c
+* \version 2.0
+*
+* Source file of the log2 histogram shared by the timer lateness and the
+* authentication request latency instrumentation of the QiStack middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_utils.h"
+
+#if ((CY_QI_TIMER_LATE_EN != 0) || (CY_QI_AUTH_REQ_HIST_EN != 0))
+
+void cy_log2_hist_add(uint16_t *hist, uint32_t val)
+{
+    uint32_t bin = 0u;
+
+    /* Bin = floor(log2(val)) + 1 without a count leading zeros instruction. */
+    if (val >= (1UL << (CY_QI_LOG2_HIST_BINS - 1u)))
+    {
+        bin = CY_QI_LOG2_HIST_BINS - 1u;
+    }
+    else if (val != 0u)
+    {
+        bin = 1u;
+        if (val >= 0x10000u)
+        {
+            val >>= 16u;
+            bin += 16u;
+        }
+        if (val >= 0x100u)
+        {
+            val >>= 8u;
+            bin += 8u;
+        }
+        if (val >= 0x10u)
+        {
+            val >>= 4u;
+            bin += 4u;
+        }
+        if (val >= 0x4u)
+        {
+            val >>= 2u;
+            bin += 2u;
+        }
+        if (val >= 0x2u)
+        {
+            bin += 1u;
+        }
+    }
+    else
+    {
+        /* Zero. */
+    }
+
+    if (hist[bin] != 0xFFFFu)
+    {
+        hist[bin]++;
+    }
+}
+
+#endif /* CY_QI_TIMER_LATE_EN || CY_QI_AUTH_REQ_HIST_EN */
+
+/* [] END OF FILE */
@@ -0,0 +1,248 @@
+/***************************************************************************//**
+* \file bench_adt_rx.c
+* \version 2.0
+*
+* Host benchmark of the PRx data stream reassembler: a 2048-byte ADC/ADT
+* sequence, with a repeat after a missed ACK every ninth packet, through
+* Cy_QiStack_Adt_Rx_Pkt against a per-packet staging buffer copied out to
+* the application buffer. Also checks the overflow, incomplete and out of
+* sequence results. The last packet is repeated after the transfer completes.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_manager.h"
+#include "host_clock.h"
+
+#define BENCH_XFER_LEN                              (2048u)
+#define BENCH_PKT_MAX                               (7u)
+#define BENCH_PKT_COUNT                             ((BENCH_XFER_LEN + BENCH_PKT_MAX - 1u) / BENCH_PKT_MAX)
+#define BENCH_REPEAT_PERIOD                         (9u)
+#define BENCH_REPEAT_PHASE                          (4u)
+#define BENCH_REPS                                  (2000u)
+#define BENCH_STAGE_SIZE                            (128u)
+#define BENCH_OVERFLOW_SIZE                         (100u)
+#define BENCH_SHORT_LEN                             (50u)
+
+/* ADT packet headers, even and odd toggle. */
+#define BENCH_ADT_EVEN                              (0x06u)
+#define BENCH_ADT_ODD                               (0x07u)
+
+static cy_stc_qi_context_t gl_ctx;
+static cy_stc_qi_ask_pkt_t gl_pkt[BENCH_PKT_COUNT];
+static uint8_t gl_src[BENCH_XFER_LEN];
+static uint8_t gl_buf[2u * BENCH_XFER_LEN];
+static uint32_t gl_cbCnt;
+static uint16_t gl_cbLen;
+static cy_en_qi_adt_rx_status_t gl_cbStatus;
+
+/* Staging buffer model: stage per packet, copy out on each full stage. */
+static uint8_t gl_stage[BENCH_STAGE_SIZE];
+static uint32_t gl_stageLen;
+static uint32_t gl_appLen;
+static bool gl_stageOdd;
+static bool gl_stageStarted;
+
+static void adt_rx_done(struct cy_stc_qi_context *qiCtx, uint8_t *buf, uint16_t len,
+        cy_en_qi_adt_rx_status_t status)
+{
+    (void)qiCtx;
+    (void)buf;
+
+    gl_cbCnt++;
+    gl_cbLen = len;
+    gl_cbStatus = status;
+}
+
+static bool stage_pkt(const cy_stc_qi_ask_pkt_t *pkt)
+{
+    uint32_t size = (uint32_t)pkt->header >> 4u;
+    bool odd = ((pkt->header & 0x0Fu) == BENCH_ADT_ODD);
+    uint32_t idx;
+
+    /* Same toggle check as the reassembler: a repeat is dropped. */
+    if ((gl_stageStarted && (odd == gl_stageOdd)) || ((!gl_stageStarted) && odd))
+    {
+        return false;
+    }
+    gl_stageStarted = true;
+    gl_stageOdd = odd;
+
+    for (idx = 0u; idx < size; idx++)
+    {
+        gl_stage[gl_stageLen++] = pkt->msg[idx];
+        if (gl_stageLen == BENCH_STAGE_SIZE)
+        {
+            memcpy(&gl_buf[gl_appLen], gl_stage, BENCH_STAGE_SIZE);
+            gl_appLen += BENCH_STAGE_SIZE;
+            gl_stageLen = 0u;
+        }
+    }
+
+    return true;
+}
+
+static void build_pkts(void)
+{
+    uint32_t seed = 22u;
+    uint32_t off = 0u;
+    uint32_t num = 0u;
+    uint32_t size;
+
+    for (off = 0u; off < BENCH_XFER_LEN; off++)
+    {
+        gl_src[off] = (uint8_t)host_rand(&seed);
+    }
+
+    for (off = 0u; off < BENCH_XFER_LEN; off += size)
+    {
+        size = BENCH_XFER_LEN - off;
+        if (size > BENCH_PKT_MAX)
+        {
+            size = BENCH_PKT_MAX;
+        }
+        gl_pkt[num].header = (uint8_t)((size << 4u) | (((num & 1u) != 0u) ? BENCH_ADT_ODD : BENCH_ADT_EVEN));
+        gl_pkt[num].dataSize = (uint8_t)size;
+        memcpy(gl_pkt[num].msg, &gl_src[off], size);
+        num++;
+    }
+}
+
+/* The full sequence through both, and their cost per byte. */
+static int run_xfer(void)
+{
+    const cy_stc_qi_adt_rx_stats_t *stats = &gl_ctx.adtRx.stats;
+    uint64_t start;
+    uint64_t rxTime = 0u;
+    uint64_t stageTime = 0u;
+    uint32_t rep;
+    uint32_t idx;
+    uint32_t nakCnt = 0u;
+    int result = 0;
+
+    (void)Cy_QiStack_Adt_Rx_Register(&gl_ctx, gl_buf, (uint16_t)sizeof(gl_buf), adt_rx_done);
+
+    for (rep = 0u; rep < BENCH_REPS; rep++)
+    {
+        (void)Cy_QiStack_Adt_Rx_Start(&gl_ctx, BENCH_XFER_LEN);
+        start = host_cycles();
+        for (idx = 0u; idx < BENCH_PKT_COUNT; idx++)
+        {
+            if (Cy_QiStack_Adt_Rx_Pkt(&gl_ctx, &gl_pkt[idx]) != CY_QISTACK_STAT_SUCCESS)
+            {
+                nakCnt++;
+            }
+            if ((idx % BENCH_REPEAT_PERIOD) == BENCH_REPEAT_PHASE)
+            {
+                if (Cy_QiStack_Adt_Rx_Pkt(&gl_ctx, &gl_pkt[idx]) != CY_QISTACK_STAT_SUCCESS)
+                {
+                    nakCnt++;
+                }
+            }
+        }
+        rxTime += host_cycles() - start;
+    }
+
+    if ((gl_cbCnt != BENCH_REPS) || (gl_cbLen != BENCH_XFER_LEN) || (gl_cbStatus != CY_QI_ADT_RX_OK) ||
+        (memcmp(gl_buf, gl_src, BENCH_XFER_LEN) != 0) || (nakCnt != 0u) ||
+        (stats->dupCnt != (BENCH_REPS * (((BENCH_PKT_COUNT - BENCH_REPEAT_PHASE - 1u) / BENCH_REPEAT_PERIOD) + 1u))) ||
+        (stats->seqErrCnt != 0u) || (stats->overflowCnt != 0u))
+    {
+        printf("xfer: %u callbacks, len %u, status %u, %u NAKs, %u repeats, %u sequence errors\n",
+               (unsigned)gl_cbCnt, (unsigned)gl_cbLen, (unsigned)gl_cbStatus, (unsigned)nakCnt,
+               (unsigned)stats->dupCnt, (unsigned)stats->seqErrCnt);
+        result = 1;
+    }
+
+    for (rep = 0u; rep < BENCH_REPS; rep++)
+    {
+        gl_stageLen = 0u;
+        gl_appLen = 0u;
+        gl_stageStarted = false;
+        start = host_cycles();
+        for (idx = 0u; idx < BENCH_PKT_COUNT; idx++)
+        {
+            (void)stage_pkt(&gl_pkt[idx]);
+            if ((idx % BENCH_REPEAT_PERIOD) == BENCH_REPEAT_PHASE)
+            {
+                (void)stage_pkt(&gl_pkt[idx]);
+            }
+        }
+        stageTime += host_cycles() - start;
+    }
+
+    printf("xfer: %u packets, %u repeats per transfer, %s per byte: reassembler %.2f, staged copy %.2f\n",
+           (unsigned)BENCH_PKT_COUNT, (unsigned)(stats->dupCnt / BENCH_REPS), HOST_CYCLES_UNIT,
+           (double)rxTime / ((double)BENCH_REPS * BENCH_XFER_LEN),
+           (double)stageTime / ((double)BENCH_REPS * BENCH_XFER_LEN));
+
+    return result;
+}
+
+/* Overflow, incomplete transfer and odd first packet. */
+static int run_errors(void)
+{
+    uint32_t idx;
+    int result = 0;
+
+    (void)Cy_QiStack_Adt_Rx_Register(&gl_ctx, gl_buf, BENCH_OVERFLOW_SIZE, adt_rx_done);
+    (void)Cy_QiStack_Adt_Rx_Start(&gl_ctx, 0u);
+    for (idx = 0u; idx < 20u; idx++)
+    {
+        (void)Cy_QiStack_Adt_Rx_Pkt(&gl_ctx, &gl_pkt[idx]);
+    }
+    Cy_QiStack_Adt_Rx_End(&gl_ctx);
+    if ((gl_cbStatus != CY_QI_ADT_RX_OVERFLOW) || (gl_cbLen > BENCH_OVERFLOW_SIZE))
+    {
+        printf("overflow: len %u, status %u\n", (unsigned)gl_cbLen, (unsigned)gl_cbStatus);
+        result = 1;
+    }
+
+    (void)Cy_QiStack_Adt_Rx_Start(&gl_ctx, BENCH_SHORT_LEN);
+    for (idx = 0u; idx < 3u; idx++)
+    {
+        (void)Cy_QiStack_Adt_Rx_Pkt(&gl_ctx, &gl_pkt[idx]);
+    }
+    Cy_QiStack_Adt_Rx_End(&gl_ctx);
+    if ((gl_cbStatus != CY_QI_ADT_RX_INCOMPLETE) || (gl_cbLen != (3u * BENCH_PKT_MAX)))
+    {
+        printf("incomplete: len %u, status %u\n", (unsigned)gl_cbLen, (unsigned)gl_cbStatus);
+        result = 1;
+    }
+
+    (void)Cy_QiStack_Adt_Rx_Start(&gl_ctx, 0u);
+    if (Cy_QiStack_Adt_Rx_Pkt(&gl_ctx, &gl_pkt[1]) != CY_QISTACK_STAT_FAILURE)
+    {
+        printf("odd first packet not rejected\n");
+        result = 1;
+    }
+
+    if (result == 0)
+    {
+        printf("errors: overflow, incomplete and out of sequence results match\n");
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    int result;
+
+    build_pkts();
+    result = run_xfer();
+    result |= run_errors();
+
+    return result;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,234 @@
+/***************************************************************************//**
+* \file bench_adt_tx.c
+* \version 2.0
+*
+* Host check and microbenchmark of the PTx data stream. A 700-byte transfer
+* is sent through the edge counter model to a PRx model that NAKs one packet
+* in ten: every poll is answered with the packet at the acknowledged offset,
+* headers alternate, a NAK sends the same packet again, data is read from the
+* caller buffer in place and the delivery counters match the transfer. Then
+* the cost of answering a poll and of an acknowledgement.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_manager.h"
+#include "cy_qistack_debug_monitor.h"
+#include "host_clock.h"
+#include "host_tcpwm.h"
+
+#if ((CY_QI_ADT_TX_EN == 0) || (CCG_HPI_WLC_CMD_ENABLE == 0))
+#error "bench_adt_tx needs CY_QI_ADT_TX_EN and CCG_HPI_WLC_CMD_ENABLE"
+#endif /* CY_QI_ADT_TX_EN, CCG_HPI_WLC_CMD_ENABLE */
+
+/* Transfer size, about a certificate chain. */
+#define BENCH_XFER_SIZE                             (700u)
+
+/* Packets the PRx model NAKs, per thousand. */
+#define BENCH_NAK_PERMILLE                          (100u)
+
+/* Inverter edges per half bit. */
+#define BENCH_HALF_EDGES                            (1u << CY_QI_FSK_HALF_BIT_SHIFT)
+
+/* Operating frequency inverter period, in PWM clocks. */
+#define BENCH_OP_PERIOD                             (100u)
+
+/* Edges after which a frame that never ends is given up. */
+#define BENCH_EDGE_MAX                              ((CY_QI_FSK_SCHED_SIZE + 1u) * 2u * BENCH_HALF_EDGES)
+
+#define BENCH_TIMING_LOOPS                          (200000u)
+
+static cy_stc_qi_context_t gl_ctx;
+static cy_stc_qi_app_cbk_t gl_app;
+static uint8_t gl_data[BENCH_XFER_SIZE];
+static uint32_t gl_now;
+static uint32_t gl_failCnt;
+
+static void app_fsk_pwm_configure(struct cy_stc_qi_context *qiCtx, bool isMod)
+{
+    (void)qiCtx;
+    host_tcpwm.pwmPeriod = isMod ? gl_ctx.qiCommStat.fskOper.periodModPwmCnt : BENCH_OP_PERIOD;
+}
+
+static uint32_t app_get_timestamp(struct cy_stc_qi_context *qiCtx)
+{
+    (void)qiCtx;
+    return gl_now;
+}
+
+static void check(bool cond, const char *what)
+{
+    if (!cond)
+    {
+        if (gl_failCnt < 10u)
+        {
+            printf("  failed: %s\n", what);
+        }
+        gl_failCnt++;
+    }
+}
+
+/* True if the loaded schedule is the ADT packet at off: header, data in the buffer now, checksum. */
+static bool sched_is_pkt(uint16_t off, bool odd)
+{
+    cy_stc_qi_fsk_sched_t ref;
+    uint8_t frame[CY_QI_FSK_ADT_MAX_MSG_SIZE];
+    uint8_t size = (uint8_t)GET_MIN(BENCH_XFER_SIZE - off, CY_QI_FSK_ADT_MAX_DATA_SIZE);
+    uint8_t idx;
+
+    frame[0] = (uint8_t)((size << 4u) | (odd ? CY_QI_ADT_ODD_MASK : CY_QI_ADT_EVEN_MASK));
+    frame[size + 1u] = frame[0];
+    for (idx = 0u; idx < size; idx++)
+    {
+        frame[idx + 1u] = gl_data[off + idx];
+        frame[size + 1u] ^= gl_data[off + idx];
+    }
+    (void)Cy_QiStack_Fsk_Sched_Build(&ref, frame, (uint8_t)(size + 2u), true);
+
+    return (gl_ctx.fskSched.len == ref.len) && (gl_ctx.fskSched.halfTotal == ref.halfTotal) &&
+           (memcmp(gl_ctx.fskSched.halfCnt, ref.halfCnt, ref.len) == 0);
+}
+
+/* Clocks inverter edges until the running frame ends, one time unit per edge. */
+static void send_frame(void)
+{
+    uint32_t frames = gl_ctx.fskSched.stats.frameCnt;
+    uint32_t edge = 0u;
+
+    while ((gl_ctx.fskSched.stats.frameCnt == frames) && (edge < BENCH_EDGE_MAX))
+    {
+        edge++;
+        gl_now++;
+        if (host_tcpwm_edge())
+        {
+            Cy_QiStack_Fsk_Sched_Edge_Handler(&gl_ctx);
+        }
+    }
+}
+
+static void run_transfer(void)
+{
+    cy_stc_qi_adt_tx_stats_t *stats = &gl_ctx.adtTx.stats;
+    cy_stc_qi_adt_tx_stats_t copy;
+    uint32_t seed = 0x2020u;
+    uint32_t pollCnt = 0u;
+    uint32_t nakCnt = 0u;
+    uint32_t startTime;
+    uint16_t off = 0u;
+    bool odd = false;
+    bool done = false;
+    uint32_t idx;
+
+    for (idx = 0u; idx < BENCH_XFER_SIZE; idx++)
+    {
+        gl_data[idx] = (uint8_t)host_rand(&seed);
+    }
+
+    check(Cy_QiStack_Adt_Tx_Start(&gl_ctx, NULL, 10u) == CY_QISTACK_STAT_BAD_PARAM, "no data");
+    check(Cy_QiStack_Adt_Tx_Start(&gl_ctx, gl_data, 0u) == CY_QISTACK_STAT_BAD_PARAM, "no length");
+    check(Cy_QiStack_Adt_Tx_Send(&gl_ctx) == CY_QISTACK_STAT_FAILURE, "send without a transfer");
+
+    gl_now = 5000u;
+    startTime = gl_now;
+    check(Cy_QiStack_Adt_Tx_Start(&gl_ctx, gl_data, BENCH_XFER_SIZE) == CY_QISTACK_STAT_SUCCESS, "start");
+    check(!Cy_QiStack_Adt_Tx_Ack(&gl_ctx), "ack before the first send");
+
+    /* Sent by reference: a change beyond any staged packet is sent as changed. */
+    gl_data[BENCH_XFER_SIZE - 1u] ^= 0xFFu;
+
+    while ((!done) && (pollCnt < (4u * BENCH_XFER_SIZE)))
+    {
+        /* DSR poll. */
+        gl_now += 100u;
+        pollCnt++;
+        check(Cy_QiStack_Adt_Tx_Send(&gl_ctx) == CY_QISTACK_STAT_SUCCESS, "poll answered");
+        check(sched_is_pkt(off, odd), "packet at the acknowledged offset");
+        check(Cy_QiStack_Adt_Tx_Send(&gl_ctx) == CY_QISTACK_STAT_FAILURE, "one packet in flight");
+        send_frame();
+
+        if ((host_rand(&seed) % 1000u) < BENCH_NAK_PERMILLE)
+        {
+            nakCnt++;
+            continue;
+        }
+
+        done = Cy_QiStack_Adt_Tx_Ack(&gl_ctx);
+        off = (uint16_t)(off + GET_MIN(BENCH_XFER_SIZE - off, CY_QI_FSK_ADT_MAX_DATA_SIZE));
+        odd = !odd;
+        check(done == (off == BENCH_XFER_SIZE), "transfer ends on the last ACK");
+    }
+
+    check(done && (!gl_ctx.adtTx.active), "transfer completed");
+    check(Cy_QiStack_Adt_Tx_Send(&gl_ctx) == CY_QISTACK_STAT_FAILURE, "no poll answer after the transfer");
+    check((stats->xferCnt == 1u) && (stats->pktCnt == (pollCnt - nakCnt)) && (stats->retryCnt == nakCnt) &&
+          (stats->stallCnt == 0u) && (stats->lastBytes == BENCH_XFER_SIZE), "delivery counters");
+    check((stats->lastTime == (gl_now - startTime)) &&
+          (stats->lastBytesPerSec == ((BENCH_XFER_SIZE * 1000u * CY_QI_TIMESTAMP_FREQ_KHZ) / stats->lastTime)),
+          "transfer time and throughput");
+
+    Cy_QiStack_Get_ADT_Tx_Stats(&gl_ctx, (uint8_t *)&copy);
+    check(memcmp(&copy, stats, sizeof(copy)) == 0, "HPI copy");
+    Cy_QiStack_Clear_ADT_Tx_Stats(&gl_ctx);
+    check(stats->xferCnt == 0u, "HPI clear");
+
+    printf("transfer: %u bytes in %u packets, %u polls, %u NAKs, %u bytes of transfer state, %u errors\n",
+           (unsigned)BENCH_XFER_SIZE, (unsigned)(pollCnt - nakCnt), (unsigned)pollCnt, (unsigned)nakCnt,
+           (unsigned)offsetof(cy_stc_qi_adt_tx_t, stats), (unsigned)gl_failCnt);
+}
+
+static void run_timing(void)
+{
+    uint64_t sendCycles = 0u;
+    uint64_t ackCycles = 0u;
+    uint64_t start;
+    uint32_t loops;
+
+    (void)Cy_QiStack_Adt_Tx_Start(&gl_ctx, gl_data, BENCH_XFER_SIZE);
+    for (loops = 0u; loops < BENCH_TIMING_LOOPS; loops++)
+    {
+        start = host_cycles();
+        (void)Cy_QiStack_Adt_Tx_Send(&gl_ctx);
+        sendCycles += host_cycles() - start;
+
+        /* The frame is not clocked out here. */
+        gl_ctx.fskSched.len = 0u;
+
+        start = host_cycles();
+        if (Cy_QiStack_Adt_Tx_Ack(&gl_ctx))
+        {
+            (void)Cy_QiStack_Adt_Tx_Start(&gl_ctx, gl_data, BENCH_XFER_SIZE);
+        }
+        ackCycles += host_cycles() - start;
+    }
+
+    printf("window %u: poll answer %5.1f, ACK %5.1f %s\n", (unsigned)CY_QI_ADT_TX_WINDOW,
+           (double)sendCycles / BENCH_TIMING_LOOPS, (double)ackCycles / BENCH_TIMING_LOOPS, HOST_CYCLES_UNIT);
+}
+
+int main(void)
+{
+    gl_ctx.ptrAppCbk = &gl_app;
+    gl_app.fsk_pwm_configure = app_fsk_pwm_configure;
+    gl_app.get_timestamp = app_get_timestamp;
+    gl_ctx.qiCommStat.fskOper.periodOpPwmCnt = BENCH_OP_PERIOD;
+    gl_ctx.qiCommStat.fskOper.periodModPwmCnt = BENCH_OP_PERIOD + CY_QI_FSK_RESOLUTION_DEPTH_1;
+    host_tcpwm.pwmPeriod = BENCH_OP_PERIOD;
+    host_tcpwm.pwmPeriodBuf = BENCH_OP_PERIOD;
+
+    run_transfer();
+    run_timing();
+
+    return (gl_failCnt == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,181 @@
+/***************************************************************************//**
+* \file bench_ask_hdr.c
+* \version 2.0
+*
+* Host check and microbenchmark of the ASK header table: every defined entry
+* has the message size of its header, validation rejects reserved headers,
+* packets out of phase and size mismatches, dispatch reaches the handler of
+* the header's class, and the cost of one dispatch per header class.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_manager.h"
+#include "host_clock.h"
+
+#if (CY_QI_ASK_HDR_TABLE_EN == 0)
+#error "bench_ask_hdr needs CY_QI_ASK_HDR_TABLE_EN"
+#endif /* CY_QI_ASK_HDR_TABLE_EN */
+
+#define BENCH_TIMING_LOOPS                          (1000000u)
+
+typedef struct
+{
+    const char *name;
+    uint8_t header;
+} bench_hdr_t;
+
+/* Headers timed in the power transfer phase, the first one reserved. */
+static const bench_hdr_t gl_timed[] =
+{
+    {"reserved", 0x10u},
+    {"CE", CY_QI_ASK_CONTROL_ERROR},
+    {"RP8", CY_QI_ASK_RECEIVED_POWER_RP8},
+    {"RP", CY_QI_ASK_RECEIVED_POWER_RP},
+    {"CHS", CY_QI_ASK_CHARGE_STATUS},
+    {"ADT", CY_QI_ASK_DATA_AUX_DATA_EVEN_1},
+    {"PROP", CY_QI_ASK_CONFIG_PROP_4},
+};
+
+static cy_stc_qi_context_t gl_ctx;
+static cy_cb_ask_hdl_t gl_handlers[CY_QI_ASK_HDL_MAX];
+static uint32_t gl_hdlCnt[CY_QI_ASK_HDL_MAX];
+static uint8_t gl_lastHdr;
+
+static cy_en_qi_status_t count_hdl(struct cy_stc_qi_context *qiCtx, const cy_stc_qi_ask_pkt_t *pkt)
+{
+    (void)qiCtx;
+    gl_lastHdr = pkt->header;
+    gl_hdlCnt[Cy_QiStack_Ask_Hdr_Info(pkt->header)->handler]++;
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+static int run_table(void)
+{
+    const cy_stc_qi_ask_hdr_info_t *info;
+    cy_stc_qi_ask_pkt_t pkt;
+    uint32_t definedCnt = 0u;
+    uint32_t failCnt = 0u;
+    uint32_t hdr;
+    uint8_t phase;
+    cy_en_qi_status_t status;
+    cy_en_qi_status_t expect;
+
+    (void)memset(&pkt, 0, sizeof(pkt));
+    for (hdr = 0u; hdr < 256u; hdr++)
+    {
+        info = Cy_QiStack_Ask_Hdr_Info((uint8_t)hdr);
+        if (info->phaseMask != 0u)
+        {
+            definedCnt++;
+            if ((info->dataSize != CY_QI_ASK_HDR_SIZE(hdr)) || (info->handler == CY_QI_ASK_HDL_NONE))
+            {
+                printf("  header 0x%02x: size %u, handler %u\n", (unsigned)hdr, (unsigned)info->dataSize,
+                       (unsigned)info->handler);
+                failCnt++;
+            }
+        }
+        else if ((info->dataSize != 0u) || (info->handler != CY_QI_ASK_HDL_NONE))
+        {
+            failCnt++;
+        }
+
+        pkt.header = (uint8_t)hdr;
+        for (phase = CY_QI_PHASE_IDLE; phase < CY_QI_PHASE_MAX; phase++)
+        {
+            gl_ctx.qiStat.phase = (cy_en_qi_phase_t)phase;
+
+            /* Right size: accepted exactly in the phases of the entry. */
+            pkt.dataSize = (uint8_t)CY_QI_ASK_HDR_SIZE(hdr);
+            expect = ((info->phaseMask & CY_QI_PHASE_MASK(phase)) != 0u) ?
+                CY_QISTACK_STAT_SUCCESS : CY_QISTACK_STAT_FAILURE;
+            gl_lastHdr = (uint8_t)(hdr + 1u);
+            status = Cy_QiStack_Ask_Pkt_Dispatch(&gl_ctx, &pkt, gl_handlers);
+            if ((status != expect) || ((status == CY_QISTACK_STAT_SUCCESS) && (gl_lastHdr != hdr)))
+            {
+                printf("  header 0x%02x, phase %u: status %d\n", (unsigned)hdr, (unsigned)phase, (int)status);
+                failCnt++;
+            }
+
+            /* Wrong size: never accepted, the handler is not called. */
+            pkt.dataSize = (uint8_t)(CY_QI_ASK_HDR_SIZE(hdr) + 1u);
+            gl_lastHdr = (uint8_t)(hdr + 1u);
+            if ((Cy_QiStack_Ask_Pkt_Validate(&gl_ctx, &pkt) != CY_QISTACK_STAT_FAILURE) ||
+                (Cy_QiStack_Ask_Pkt_Dispatch(&gl_ctx, &pkt, gl_handlers) != CY_QISTACK_STAT_FAILURE) ||
+                (gl_lastHdr != (uint8_t)(hdr + 1u)))
+            {
+                failCnt++;
+            }
+        }
+    }
+
+    /* Without a handler for the class a valid packet is not answered. */
+    gl_ctx.qiStat.phase = CY_QI_PHASE_PWR;
+    pkt.header = CY_QI_ASK_CONTROL_ERROR;
+    pkt.dataSize = 1u;
+    gl_handlers[CY_QI_ASK_HDL_CE] = NULL;
+    if (Cy_QiStack_Ask_Pkt_Dispatch(&gl_ctx, &pkt, gl_handlers) != CY_QISTACK_STAT_NO_RESPONSE)
+    {
+        failCnt++;
+    }
+    gl_handlers[CY_QI_ASK_HDL_CE] = count_hdl;
+
+    printf("table: %u defined headers, %u errors\n", (unsigned)definedCnt, (unsigned)failCnt);
+
+    return (failCnt == 0u) ? 0 : 1;
+}
+
+static void run_timing(void)
+{
+    cy_stc_qi_ask_pkt_t pkt;
+    uint64_t start;
+    uint64_t cycles;
+    uint32_t loops;
+    uint32_t idx;
+
+    (void)memset(&pkt, 0, sizeof(pkt));
+    gl_ctx.qiStat.phase = CY_QI_PHASE_PWR;
+    for (idx = 0u; idx < (sizeof(gl_timed) / sizeof(gl_timed[0])); idx++)
+    {
+        pkt.header = gl_timed[idx].header;
+        pkt.dataSize = (uint8_t)CY_QI_ASK_HDR_SIZE(pkt.header);
+
+        start = host_cycles();
+        for (loops = 0u; loops < BENCH_TIMING_LOOPS; loops++)
+        {
+            (void)Cy_QiStack_Ask_Pkt_Dispatch(&gl_ctx, &pkt, gl_handlers);
+        }
+        cycles = host_cycles() - start;
+
+        printf("  %-8s 0x%02x: %5.1f %s/pkt\n", gl_timed[idx].name, (unsigned)pkt.header,
+               (double)cycles / BENCH_TIMING_LOOPS, HOST_CYCLES_UNIT);
+    }
+}
+
+int main(void)
+{
+    int result;
+    uint32_t idx;
+
+    for (idx = 1u; idx < CY_QI_ASK_HDL_MAX; idx++)
+    {
+        gl_handlers[idx] = count_hdl;
+    }
+
+    result = run_table();
+    run_timing();
+
+    return result;
+}
+
+/* [] END OF FILE */
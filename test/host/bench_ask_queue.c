@@ -0,0 +1,209 @@
+/***************************************************************************//**
+* \file bench_ask_queue.c
+* \version 2.0
+*
+* Host check of the ASK packet queue: packets decoded by the SCB FIFO handler
+* are queued in order with their receive times, packets beyond the queue depth
+* are dropped and counted in overflowCnt while nothing pops the queue, and the
+* free running indexes keep the order across their wrap.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_bmc.h"
+#include "cy_qistack_comm_manager.h"
+#include "bmc_enc.h"
+#include "host_clock.h"
+
+#if (CY_QI_ASK_PKT_QUEUE_DEPTH == 0)
+#error "bench_ask_queue needs CY_QI_ASK_PKT_QUEUE_DEPTH"
+#endif /* CY_QI_ASK_PKT_QUEUE_DEPTH */
+
+/* Packets received while the application does not pop the queue. */
+#define BENCH_RX_COUNT                              (CY_QI_ASK_PKT_QUEUE_DEPTH + 5u)
+
+/* Push and pop rounds, enough to wrap the 8-bit indexes. */
+#define BENCH_WRAP_COUNT                            (600u)
+
+static cy_stc_qi_context_t gl_ctx;
+static cy_stc_qi_app_cbk_t gl_app;
+static const bmc_enc_t *gl_enc;
+static uint32_t gl_encPos;
+static uint32_t gl_now;
+
+uint32_t Cy_SCB_SPI_GetNumInRxFifo(CySCB_Type const *base)
+{
+    uint32_t left = (gl_enc->bitCount - gl_encPos) / CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE;
+
+    (void)base;
+    return (left > CY_QI_BMC_RX_SPI_FIFO_SIZE) ? CY_QI_BMC_RX_SPI_FIFO_SIZE : left;
+}
+
+uint32_t Cy_SCB_SPI_Read(CySCB_Type const *base)
+{
+    uint32_t word = gl_enc->buf[gl_encPos >> 3u];
+
+#if (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE > 8u)
+    word |= (uint32_t)gl_enc->buf[(gl_encPos >> 3u) + 1u] << 8u;
+#endif /* (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE > 8u) */
+    (void)base;
+    gl_encPos += CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE;
+
+    return word;
+}
+
+static uint32_t app_get_timestamp(struct cy_stc_qi_context *qiCtx)
+{
+    (void)qiCtx;
+    return gl_now;
+}
+
+/* Receives one packet through the SCB FIFO handler, as the receive interrupt would. */
+static void rx_pkt(const uint8_t *pkt, uint8_t len)
+{
+    static bmc_enc_t enc;
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &gl_ctx.qiCommStat.askBmc;
+
+    bmc_enc_init(&enc, 0.0, 0.0, 1u);
+    bmc_enc_frame(&enc, pkt, len, 12u);
+    gl_enc = &enc;
+    gl_encPos = 0u;
+
+    bmc_rx_lut_rx_start(&gl_ctx);
+    while (Cy_SCB_SPI_GetNumInRxFifo(askBmc->scb) != 0u)
+    {
+        bmc_rx_lut_scb_fifo_handler(&gl_ctx);
+    }
+}
+
+static int run_overflow(void)
+{
+    cy_stc_qi_ask_pkt_queue_t *queue = &gl_ctx.askPktQueue;
+    uint8_t pkt[CY_QI_ASK_DATA_SIZE + 2u];
+    cy_stc_qi_ask_pkt_t out;
+    uint32_t seed = 0x8008u;
+    uint32_t timestamp;
+    uint32_t failCnt = 0u;
+    uint32_t idx;
+    uint8_t len;
+
+    Cy_QiStack_Ask_Pkt_Queue_Reset(&gl_ctx);
+    for (idx = 0u; idx < BENCH_RX_COUNT; idx++)
+    {
+        /* Control error packets, the message byte numbers them. */
+        len = bmc_enc_make_pkt(pkt, 0x03u, &seed);
+        pkt[1] = (uint8_t)idx;
+        pkt[2] = (uint8_t)(pkt[0] ^ pkt[1]);
+        gl_now = 1000u * idx;
+        rx_pkt(pkt, len);
+    }
+
+    printf("overflow: %u packets into %u slots, %u queued, %u dropped, high water %u\n",
+           (unsigned)BENCH_RX_COUNT, (unsigned)CY_QI_ASK_PKT_QUEUE_DEPTH,
+           (unsigned)Cy_QiStack_Ask_Pkt_Queue_Count(&gl_ctx), (unsigned)queue->overflowCnt,
+           (unsigned)queue->highWater);
+    if ((Cy_QiStack_Ask_Pkt_Queue_Count(&gl_ctx) != CY_QI_ASK_PKT_QUEUE_DEPTH) ||
+        (queue->overflowCnt != (BENCH_RX_COUNT - CY_QI_ASK_PKT_QUEUE_DEPTH)) ||
+        (queue->highWater != CY_QI_ASK_PKT_QUEUE_DEPTH) ||
+        (gl_ctx.bmcLut.askStats.pktOkCnt != BENCH_RX_COUNT))
+    {
+        failCnt++;
+    }
+
+    /* The oldest packets are kept, in order, with their receive times. */
+    for (idx = 0u; Cy_QiStack_Ask_Pkt_Queue_Pop(&gl_ctx, &out, &timestamp); idx++)
+    {
+        if ((out.header != 0x03u) || (out.msg[0] != (uint8_t)idx) || (timestamp != (1000u * idx)))
+        {
+            printf("  slot %u: packet %u at %u\n", (unsigned)idx, (unsigned)out.msg[0], (unsigned)timestamp);
+            failCnt++;
+        }
+    }
+    if (idx != CY_QI_ASK_PKT_QUEUE_DEPTH)
+    {
+        failCnt++;
+    }
+
+    /* A drained queue takes packets again; the drop count stays until reset. */
+    rx_pkt(pkt, len);
+    if ((Cy_QiStack_Ask_Pkt_Queue_Count(&gl_ctx) != 1u) ||
+        (queue->overflowCnt != (BENCH_RX_COUNT - CY_QI_ASK_PKT_QUEUE_DEPTH)))
+    {
+        failCnt++;
+    }
+    Cy_QiStack_Ask_Pkt_Queue_Reset(&gl_ctx);
+    if ((Cy_QiStack_Ask_Pkt_Queue_Count(&gl_ctx) != 0u) || (queue->overflowCnt != 0u))
+    {
+        failCnt++;
+    }
+
+    return (failCnt == 0u) ? 0 : 1;
+}
+
+static int run_wrap(void)
+{
+    cy_stc_qi_ask_pkt_t pkt;
+    cy_stc_qi_ask_pkt_t out;
+    uint32_t failCnt = 0u;
+    uint32_t next = 0u;
+    uint32_t idx;
+
+    (void)memset(&pkt, 0, sizeof(pkt));
+    Cy_QiStack_Ask_Pkt_Queue_Reset(&gl_ctx);
+    for (idx = 0u; idx < BENCH_WRAP_COUNT; idx++)
+    {
+        /* Leave zero to three packets pending, so the queue runs full at times. */
+        while (Cy_QiStack_Ask_Pkt_Queue_Count(&gl_ctx) > (idx % 4u))
+        {
+            if ((!Cy_QiStack_Ask_Pkt_Queue_Pop(&gl_ctx, &out, NULL)) || (out.msg[0] != (uint8_t)next))
+            {
+                failCnt++;
+            }
+            next++;
+        }
+
+        pkt.msg[0] = (uint8_t)idx;
+        if (!Cy_QiStack_Ask_Pkt_Queue_Push(&gl_ctx, &pkt, idx))
+        {
+            failCnt++;
+        }
+    }
+
+    while (Cy_QiStack_Ask_Pkt_Queue_Pop(&gl_ctx, &out, NULL))
+    {
+        if (out.msg[0] != (uint8_t)next)
+        {
+            failCnt++;
+        }
+        next++;
+    }
+
+    printf("wrap: %u packets, %u popped in order, %u errors, %u dropped\n", (unsigned)BENCH_WRAP_COUNT,
+           (unsigned)next, (unsigned)failCnt, (unsigned)gl_ctx.askPktQueue.overflowCnt);
+
+    return ((failCnt == 0u) && (next == BENCH_WRAP_COUNT) && (gl_ctx.askPktQueue.overflowCnt == 0u)) ? 0 : 1;
+}
+
+int main(void)
+{
+    int result;
+
+    gl_app.get_timestamp = app_get_timestamp;
+    gl_ctx.ptrAppCbk = &gl_app;
+
+    result = run_overflow();
+    result |= run_wrap();
+
+    return result;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,259 @@
+/***************************************************************************//**
+* \file bench_ask_time.c
+* \version 2.0
+*
+* Host check of the ASK packet timestamps. Packets are received with a
+* random receive interrupt latency and their stamp is compared with the true
+* time of the checksum edge. With SPI sampling the stamp must stay within one
+* SPI word of the edge at any latency the FIFO holds; with edge capture it
+* must be the time of the interrupt of the checksum edge. The queue entry
+* time, Cy_QiStack_Ask_Pkt_Age and Cy_QiStack_Ask_Pkt_Timer_Start are checked
+* on the same packets.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_bmc.h"
+#include "cy_qistack_comm_manager.h"
+#include "bmc_enc.h"
+#include "host_clock.h"
+
+#if ((CY_QI_ASK_PKT_TIMESTAMP_EN == 0) || (CY_QI_ASK_PKT_QUEUE_DEPTH == 0) || (CY_QI_TIMER_WHEEL_EN == 0))
+#error "bench_ask_time needs CY_QI_ASK_PKT_TIMESTAMP_EN, CY_QI_ASK_PKT_QUEUE_DEPTH and CY_QI_TIMER_WHEEL_EN"
+#endif /* CY_QI_ASK_PKT_TIMESTAMP_EN, CY_QI_ASK_PKT_QUEUE_DEPTH, CY_QI_TIMER_WHEEL_EN */
+
+#define BENCH_PKT_COUNT                             (5000u)
+
+/* Raw samples per millisecond and the get_timestamp time of a sample count, in microseconds. */
+#define BENCH_SAMPLES_PER_MS                        ((CY_QI_BMC_RX_FREQ * CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE) / 1000u)
+#define BENCH_SAMPLE_TIME(n)                        (((uint32_t)(n) * CY_QI_TIMESTAMP_FREQ_KHZ) / BENCH_SAMPLES_PER_MS)
+
+/* One SPI word, in samples. */
+#define BENCH_WORD_SAMPLES                          (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE)
+
+/* Longest edge interrupt latency of the edge capture run, in microseconds. */
+#define BENCH_EDGE_LAT_MAX                          (200u)
+
+/* Period of the timer started from the checksum edge, in ticks of 1 ms. */
+#define BENCH_TIMER_PERIOD                          (10u)
+
+static cy_stc_qi_context_t gl_ctx;
+static cy_stc_qi_app_cbk_t gl_app;
+static cy_stc_qi_timer_wheel_t gl_wheel;
+static uint32_t gl_now;
+static uint32_t gl_seed = 0x1019u;
+static uint32_t gl_failCnt;
+
+/* Time of the first sample of the frame in reception. */
+static uint32_t gl_start;
+
+#if (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0)
+static const bmc_enc_t *gl_enc;
+static uint32_t gl_readWords;
+
+/* Words the SPI block has completed by now and the handler has not read, up to the FIFO size. */
+uint32_t Cy_SCB_SPI_GetNumInRxFifo(CySCB_Type const *base)
+{
+    uint32_t done = ((gl_now - gl_start) * BENCH_SAMPLES_PER_MS) / (CY_QI_TIMESTAMP_FREQ_KHZ * BENCH_WORD_SAMPLES);
+    uint32_t total = gl_enc->bitCount / BENCH_WORD_SAMPLES;
+
+    (void)base;
+    done = (done > total) ? total : done;
+    done -= gl_readWords;
+
+    return (done > CY_QI_BMC_RX_SPI_FIFO_SIZE) ? CY_QI_BMC_RX_SPI_FIFO_SIZE : done;
+}
+
+uint32_t Cy_SCB_SPI_Read(CySCB_Type const *base)
+{
+    uint32_t pos = gl_readWords * BENCH_WORD_SAMPLES;
+    uint32_t word = gl_enc->buf[pos >> 3u];
+
+#if (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE > 8u)
+    word |= (uint32_t)gl_enc->buf[(pos >> 3u) + 1u] << 8u;
+#endif /* (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE > 8u) */
+    (void)base;
+    gl_readWords++;
+
+    return word;
+}
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+
+static uint32_t app_get_timestamp(struct cy_stc_qi_context *qiCtx)
+{
+    (void)qiCtx;
+    return gl_now;
+}
+
+static void check(bool cond, const char *what)
+{
+    if (!cond)
+    {
+        if (gl_failCnt < 10u)
+        {
+            printf("  failed: %s\n", what);
+        }
+        gl_failCnt++;
+    }
+}
+
+/*
+ * Random packet waveform; returns the sample of the edge that completes the
+ * checksum character, the middle of its stop bit. The idle tail outlasts the
+ * longest interrupt gap, so the SPI model never runs out of samples.
+ */
+static uint32_t make_frame(bmc_enc_t *enc)
+{
+    uint8_t pkt[CY_QI_ASK_DATA_SIZE + 2u];
+    uint8_t len = bmc_enc_make_pkt(pkt, (uint8_t)host_rand(&gl_seed), &gl_seed);
+    uint32_t edge;
+
+    bmc_enc_init(enc, 0.0, 0.0, 1u);
+    bmc_enc_idle(enc, 3.0);
+    bmc_enc_pkt(enc, pkt, len, (uint8_t)(11u + (host_rand(&gl_seed) % 10u)));
+    edge = (uint32_t)((enc->time - (enc->bitLen / 2.0)) + 0.5);
+    bmc_enc_end(enc, (double)(CY_QI_BMC_RX_SPI_FIFO_SIZE + 4u));
+
+    return edge;
+}
+
+#if (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0)
+/*
+ * Receives a frame through the SCB FIFO handler. The interrupt runs from one
+ * word to a full FIFO after the previous one. Returns the stamp error, sets
+ * *isrErr to the error of a stamp taken when the handler completes the packet.
+ */
+static int32_t rx_frame(const bmc_enc_t *enc, uint32_t edgeTime, int32_t *isrErr)
+{
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &gl_ctx.qiCommStat.askBmc;
+    uint32_t wordTime = BENCH_SAMPLE_TIME(BENCH_WORD_SAMPLES);
+    uint32_t total = enc->bitCount / BENCH_WORD_SAMPLES;
+
+    gl_enc = enc;
+    gl_readWords = 0u;
+    bmc_rx_lut_rx_start(&gl_ctx);
+    while ((!askBmc->isDataReady) && (gl_readWords < total))
+    {
+        gl_now += wordTime + (host_rand(&gl_seed) % ((CY_QI_BMC_RX_SPI_FIFO_SIZE - 1u) * wordTime));
+        while ((Cy_SCB_SPI_GetNumInRxFifo(askBmc->scb) != 0u) && (!askBmc->isDataReady))
+        {
+            bmc_rx_lut_scb_fifo_handler(&gl_ctx);
+        }
+    }
+
+    *isrErr = (int32_t)(gl_now - edgeTime);
+    return (int32_t)(gl_ctx.bmcLut.pktTime - edgeTime);
+}
+#else
+/*
+ * Receives a frame through the edge capture interrupt, each edge handled up
+ * to BENCH_EDGE_LAT_MAX after it. Returns the stamp error, sets *isrErr to
+ * the latency of the interrupt that completed the packet.
+ */
+static int32_t rx_frame(const bmc_enc_t *enc, uint32_t edgeTime, int32_t *isrErr)
+{
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &gl_ctx.qiCommStat.askBmc;
+    uint32_t pos;
+    uint8_t level = enc->buf[0] & 0x01u;
+    uint8_t bit;
+
+    *isrErr = -1;
+    bmc_rx_lut_rx_start(&gl_ctx);
+    for (pos = 1u; (pos < enc->bitCount) && (!askBmc->isDataReady); pos++)
+    {
+        bit = (uint8_t)((enc->buf[pos >> 3u] >> (pos & 7u)) & 0x01u);
+        if (bit != level)
+        {
+            level = bit;
+            gl_now = gl_start + BENCH_SAMPLE_TIME(pos) + (host_rand(&gl_seed) % (BENCH_EDGE_LAT_MAX + 1u));
+            bmc_rx_lut_rx_edge(&gl_ctx, (uint16_t)pos);
+            *isrErr = (int32_t)(gl_now - edgeTime);
+        }
+    }
+
+    return (int32_t)(gl_ctx.bmcLut.pktTime - edgeTime);
+}
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+
+static void count_cb(cy_timer_id_t id, void *callbackContext)
+{
+    (void)id;
+    (void)callbackContext;
+}
+
+int main(void)
+{
+    static bmc_enc_t enc;
+    cy_stc_qi_ask_pkt_t out;
+    uint32_t edgeSample;
+    uint32_t edgeTime;
+    uint32_t queued;
+    uint32_t age;
+    uint32_t ticks;
+    uint32_t idx;
+    int32_t err;
+    int32_t isrErr;
+    int32_t errMin = INT32_MAX;
+    int32_t errMax = INT32_MIN;
+    int32_t isrMax = INT32_MIN;
+
+    gl_app.get_timestamp = app_get_timestamp;
+    gl_ctx.ptrAppCbk = &gl_app;
+    Cy_QiStack_Timer_Wheel_Init(&gl_wheel);
+
+    /* Start close to the wrap of the time counter. */
+    gl_now = 0xFFFF0000u;
+    for (idx = 0u; idx < BENCH_PKT_COUNT; idx++)
+    {
+        edgeSample = make_frame(&enc);
+        gl_now += 1000u + (host_rand(&gl_seed) % 1000u);
+        gl_start = gl_now;
+        edgeTime = gl_start + BENCH_SAMPLE_TIME(edgeSample);
+
+        Cy_QiStack_Ask_Pkt_Queue_Reset(&gl_ctx);
+        err = rx_frame(&enc, edgeTime, &isrErr);
+        check(gl_ctx.bmcLut.askStats.pktOkCnt == (idx + 1u), "packet received");
+        errMin = (err < errMin) ? err : errMin;
+        errMax = (err > errMax) ? err : errMax;
+        isrMax = (isrErr > isrMax) ? isrErr : isrMax;
+#if (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0)
+        /* Late by less than one SPI word, whatever the interrupt latency. */
+        check((err >= 0) && (err < (int32_t)BENCH_SAMPLE_TIME(BENCH_WORD_SAMPLES)), "stamp within one SPI word");
+#else
+        /* Stamped at the interrupt of the checksum edge, not later. */
+        check(err == isrErr, "stamp at the checksum edge interrupt");
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+
+        /* The queue entry carries the same time. */
+        check(Cy_QiStack_Ask_Pkt_Queue_Pop(&gl_ctx, &out, &queued) && (queued == gl_ctx.bmcLut.pktTime),
+              "queue entry time");
+
+        /* Processed a few ms later: the age and the timer count from the edge. */
+        gl_now += host_rand(&gl_seed) % ((BENCH_TIMER_PERIOD + 2u) * CY_QI_TIMESTAMP_FREQ_KHZ);
+        age = Cy_QiStack_Ask_Pkt_Age(&gl_ctx, gl_ctx.bmcLut.pktTime);
+        check(age == (gl_now - gl_ctx.bmcLut.pktTime), "packet age");
+        (void)Cy_QiStack_Ask_Pkt_Timer_Start(&gl_ctx, &gl_wheel, gl_ctx.bmcLut.pktTime,
+                                             CY_QI_T_NEXT_TIME_ID, BENCH_TIMER_PERIOD, count_cb);
+        ticks = age / CY_QI_TIMESTAMP_FREQ_KHZ;
+        check(Cy_QiStack_Timer_Wheel_Next(&gl_wheel) ==
+              ((ticks < BENCH_TIMER_PERIOD) ? (BENCH_TIMER_PERIOD - ticks) : 1u), "timer from the edge");
+        Cy_QiStack_Timer_Wheel_Stop(&gl_wheel, CY_QI_T_NEXT_TIME_ID);
+    }
+
+    printf("%s: %u packets, stamp error %d to %d us, completing interrupt up to %d us after the edge, %u errors\n",
+           (CY_QI_BMC_RX_EDGE_CAPTURE_EN != 0) ? "edge capture" : "SPI sampling", (unsigned)BENCH_PKT_COUNT,
+           (int)errMin, (int)errMax, (int)isrMax, (unsigned)gl_failCnt);
+
+    return (gl_failCnt == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
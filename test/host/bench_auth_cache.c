@@ -0,0 +1,279 @@
+/***************************************************************************//**
+* \file bench_auth_cache.c
+* \version 2.0
+*
+* Host check and microbenchmark of the certificate chain cache: filled slots
+* answer digest and certificate reads with clamped lengths, empty and
+* invalidated slots miss, and a flash copy saved from a slot restores it
+* only while its hash matches. A blank or foreign record is refused without
+* a verify error, a corrupted one with it. The get_sha256_data model is a
+* 32-byte FNV-1a, which any single byte change changes; it counts the
+* record bytes each chunk carries after the running hash. Then the cost of
+* a cached GET_DIGEST plus GET_CERTIFICATE lookup and of a flash copy
+* restore.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_debug_monitor.h"
+#include "cy_qistack_auth_optiga.h"
+#include "host_clock.h"
+
+#if ((CY_QI_AUTH_CACHE_FLASH_EN == 0) || (CY_QI_AUTH_CACHE_SLOTS < 2) || (CCG_HPI_WLC_CMD_ENABLE == 0))
+#error "bench_auth_cache needs CY_QI_AUTH_CACHE_FLASH_EN, two cache slots and CCG_HPI_WLC_CMD_ENABLE"
+#endif /* CY_QI_AUTH_CACHE_FLASH_EN, CY_QI_AUTH_CACHE_SLOTS, CCG_HPI_WLC_CMD_ENABLE */
+
+/* Bytes per GET_CERTIFICATE response. */
+#define BENCH_CERT_READ                             (256u)
+
+/* Record bytes covered by the hash. */
+#define BENCH_REC_HASHED                            ((uint32_t)offsetof(cy_stc_qi_auth_cache_rec_t, hash))
+
+/* get_sha256_data calls per record: 96 record bytes each. */
+#define BENCH_HASH_CALLS                            ((BENCH_REC_HASHED + 95u) / 96u)
+
+#define BENCH_TIMING_LOOPS                          (1000000u)
+#define BENCH_LOAD_LOOPS                            (20000u)
+
+static cy_stc_qi_context_t gl_ctx;
+static cy_stc_qi_app_cbk_t gl_app;
+static cy_stc_qi_auth_cache_rec_t gl_rec;
+static uint8_t gl_chain[2][WPC_CERTIFICATE_CHAIN_LENGTH];
+static uint8_t gl_digest[2][WPC_CERTIFICATE_CHAIN_DIGEST_LENGTH];
+static uint32_t gl_hashCallCnt;
+static uint32_t gl_hashBytes;
+static uint32_t gl_failCnt;
+
+/* Eight FNV-1a lanes with different offsets, 32 bytes out. */
+static void app_get_sha256_data(struct cy_stc_qi_context *qiCtx, uint8_t *in_buf, uint8_t buf_size,
+        uint8_t *out_buf)
+{
+    uint32_t lane[8];
+    uint32_t idx;
+    uint32_t byte;
+
+    (void)qiCtx;
+    gl_hashCallCnt++;
+    gl_hashBytes += (uint32_t)buf_size - AUTH_CACHE_HASH_LENGTH;
+
+    for (idx = 0u; idx < 8u; idx++)
+    {
+        lane[idx] = 2166136261u + (idx * 0x9E3779B9u);
+        for (byte = 0u; byte < buf_size; byte++)
+        {
+            lane[idx] = (lane[idx] ^ in_buf[byte]) * 16777619u;
+        }
+    }
+    (void)memcpy(out_buf, lane, AUTH_CACHE_HASH_LENGTH);
+}
+
+static void check(bool cond, const char *what)
+{
+    if (!cond)
+    {
+        printf("  failed: %s\n", what);
+        gl_failCnt++;
+    }
+}
+
+static cy_stc_qi_auth_cache_stats_t read_stats(void)
+{
+    cy_stc_qi_auth_cache_stats_t stats;
+
+    Cy_QiStack_Get_Auth_Cache_Stats(&gl_ctx, (uint8_t *)&stats);
+
+    return stats;
+}
+
+/* True if the slot answers with this digest and chain. */
+static bool slot_is(uint8_t slot, const uint8_t *digest, const uint8_t *chain, uint16_t len)
+{
+    const uint8_t *data = Cy_QiStack_Auth_Cache_Digest(slot);
+    uint16_t off;
+    uint16_t size;
+
+    if ((data == NULL) || (memcmp(data, digest, WPC_CERTIFICATE_CHAIN_DIGEST_LENGTH) != 0))
+    {
+        return false;
+    }
+
+    for (off = 0u; off < len; off += size)
+    {
+        size = BENCH_CERT_READ;
+        data = Cy_QiStack_Auth_Cache_Cert(slot, off, &size);
+        if ((data == NULL) || (size != GET_MIN(BENCH_CERT_READ, (uint16_t)(len - off))) ||
+                (memcmp(data, &chain[off], size) != 0))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void run_ram(void)
+{
+    cy_stc_qi_auth_cache_stats_t stats;
+    uint16_t size = BENCH_CERT_READ;
+
+    check(Cy_QiStack_Auth_Cache_Fill(CY_QI_AUTH_CACHE_SLOTS, gl_digest[0], gl_chain[0], 100u) ==
+          CY_QISTACK_STAT_BAD_PARAM, "slot out of range");
+    check(Cy_QiStack_Auth_Cache_Fill(0u, NULL, gl_chain[0], 100u) == CY_QISTACK_STAT_BAD_PARAM, "no digest");
+    check(Cy_QiStack_Auth_Cache_Fill(0u, gl_digest[0], NULL, 100u) == CY_QISTACK_STAT_BAD_PARAM, "no chain");
+    check(Cy_QiStack_Auth_Cache_Fill(0u, gl_digest[0], gl_chain[0], 0u) == CY_QISTACK_STAT_BAD_PARAM, "empty chain");
+    check(Cy_QiStack_Auth_Cache_Fill(0u, gl_digest[0], gl_chain[0], WPC_CERTIFICATE_CHAIN_LENGTH + 1u) ==
+          CY_QISTACK_STAT_BAD_PARAM, "chain too long");
+    check((Cy_QiStack_Auth_Cache_Digest(0u) == NULL) && (Cy_QiStack_Auth_Cache_Cert(0u, 0u, &size) == NULL),
+          "empty slot misses");
+
+    check(Cy_QiStack_Auth_Cache_Fill(0u, gl_digest[0], gl_chain[0], WPC_CERTIFICATE_CHAIN_LENGTH) ==
+          CY_QISTACK_STAT_SUCCESS, "fill slot 0");
+    check(Cy_QiStack_Auth_Cache_Fill(1u, gl_digest[1], gl_chain[1], 500u) == CY_QISTACK_STAT_SUCCESS, "fill slot 1");
+    check(slot_is(0u, gl_digest[0], gl_chain[0], WPC_CERTIFICATE_CHAIN_LENGTH), "slot 0 contents, last read clamped");
+    check(slot_is(1u, gl_digest[1], gl_chain[1], 500u), "slot 1 contents, last read clamped");
+    size = BENCH_CERT_READ;
+    check(Cy_QiStack_Auth_Cache_Cert(1u, 500u, &size) == NULL, "read past the chain misses");
+    check(Cy_QiStack_Auth_Cache_Cert(1u, 0u, NULL) == NULL, "read without a length misses");
+
+    Cy_QiStack_Auth_Cache_Invalidate(1u);
+    check(Cy_QiStack_Auth_Cache_Digest(1u) == NULL, "invalidated slot misses");
+    check(slot_is(0u, gl_digest[0], gl_chain[0], WPC_CERTIFICATE_CHAIN_LENGTH), "other slot kept");
+
+    /* Three slot reads of 4, 3 and 4 hits; 2 + 2 + 1 misses. */
+    stats = read_stats();
+    check((stats.fillCnt == 2u) && (stats.hitCnt == 11u) && (stats.missCnt == 5u), "hit and miss counters");
+
+    printf("ram: %u fills, %u hits, %u misses\n", (unsigned)stats.fillCnt, (unsigned)stats.hitCnt,
+           (unsigned)stats.missCnt);
+}
+
+static void run_flash(void)
+{
+    cy_stc_qi_auth_cache_stats_t stats;
+
+    check(Cy_QiStack_Auth_Cache_Save(&gl_ctx, 1u, &gl_rec) == CY_QISTACK_STAT_FAILURE, "save of an empty slot");
+    check(Cy_QiStack_Auth_Cache_Save(&gl_ctx, CY_QI_AUTH_CACHE_SLOTS, &gl_rec) == CY_QISTACK_STAT_BAD_PARAM,
+          "save of a slot out of range");
+    check(Cy_QiStack_Auth_Cache_Load(&gl_ctx, NULL) == CY_QISTACK_STAT_BAD_PARAM, "load without a record");
+
+    gl_app.get_sha256_data = NULL;
+    check(Cy_QiStack_Auth_Cache_Save(&gl_ctx, 0u, &gl_rec) == CY_QISTACK_STAT_FAILURE, "save without a hash");
+    gl_app.get_sha256_data = app_get_sha256_data;
+
+    gl_hashCallCnt = 0u;
+    gl_hashBytes = 0u;
+    check(Cy_QiStack_Auth_Cache_Save(&gl_ctx, 0u, &gl_rec) == CY_QISTACK_STAT_SUCCESS, "save slot 0");
+    check((gl_hashCallCnt == BENCH_HASH_CALLS) && (gl_hashBytes == BENCH_REC_HASHED),
+          "record hashed in chunks after the running hash");
+
+    /* Restored at boot from the flash copy. */
+    Cy_QiStack_Auth_Cache_Invalidate(0u);
+    check(Cy_QiStack_Auth_Cache_Load(&gl_ctx, &gl_rec) == CY_QISTACK_STAT_SUCCESS, "load slot 0");
+    check(slot_is(0u, gl_digest[0], gl_chain[0], WPC_CERTIFICATE_CHAIN_LENGTH), "restored contents");
+
+    /* A corrupted chain byte or hash byte is a verify error and restores nothing. */
+    Cy_QiStack_Auth_Cache_Invalidate(0u);
+    gl_rec.chain[WPC_CERTIFICATE_CHAIN_LENGTH / 2u] ^= 0x01u;
+    check(Cy_QiStack_Auth_Cache_Load(&gl_ctx, &gl_rec) == CY_QISTACK_STAT_FAILURE, "corrupted chain refused");
+    gl_rec.chain[WPC_CERTIFICATE_CHAIN_LENGTH / 2u] ^= 0x01u;
+    gl_rec.hash[0] ^= 0x80u;
+    check(Cy_QiStack_Auth_Cache_Load(&gl_ctx, &gl_rec) == CY_QISTACK_STAT_FAILURE, "corrupted hash refused");
+    gl_rec.hash[0] ^= 0x80u;
+    check(Cy_QiStack_Auth_Cache_Digest(0u) == NULL, "nothing restored from a corrupted copy");
+
+    /* A foreign slot or a blank record is refused without a verify error. */
+    gl_rec.slot = CY_QI_AUTH_CACHE_SLOTS;
+    check(Cy_QiStack_Auth_Cache_Load(&gl_ctx, &gl_rec) == CY_QISTACK_STAT_FAILURE, "foreign slot refused");
+    gl_rec.slot = 0u;
+    (void)memset(&gl_rec, 0xFF, sizeof(gl_rec));
+    check(Cy_QiStack_Auth_Cache_Load(&gl_ctx, &gl_rec) == CY_QISTACK_STAT_FAILURE, "blank record refused");
+
+    stats = read_stats();
+    check((stats.loadCnt == 1u) && (stats.verifyErrCnt == 2u), "load and verify error counters");
+
+    /* The same record restored into the other slot it names. */
+    check(Cy_QiStack_Auth_Cache_Fill(1u, gl_digest[1], gl_chain[1], 500u) == CY_QISTACK_STAT_SUCCESS, "refill slot 1");
+    check(Cy_QiStack_Auth_Cache_Save(&gl_ctx, 1u, &gl_rec) == CY_QISTACK_STAT_SUCCESS, "save slot 1");
+    Cy_QiStack_Auth_Cache_Invalidate(1u);
+    check((Cy_QiStack_Auth_Cache_Load(&gl_ctx, &gl_rec) == CY_QISTACK_STAT_SUCCESS) &&
+          slot_is(1u, gl_digest[1], gl_chain[1], 500u) && (Cy_QiStack_Auth_Cache_Digest(0u) == NULL),
+          "slot 1 restored, slot 0 untouched");
+
+    Cy_QiStack_Clear_Auth_Cache_Stats(&gl_ctx);
+    stats = read_stats();
+    check((stats.fillCnt == 0u) && (stats.loadCnt == 0u) && (stats.hitCnt == 0u), "HPI clear");
+
+    printf("flash: %u-byte record hashed in %u calls, 1 restore, 2 verify errors\n",
+           (unsigned)BENCH_REC_HASHED, (unsigned)BENCH_HASH_CALLS);
+}
+
+static void run_timing(void)
+{
+    uint64_t lookupCycles = 0u;
+    uint64_t loadCycles = 0u;
+    uint64_t start;
+    const uint8_t *digest;
+    const uint8_t *cert;
+    uint16_t size;
+    uint32_t loops;
+
+    (void)Cy_QiStack_Auth_Cache_Fill(0u, gl_digest[0], gl_chain[0], WPC_CERTIFICATE_CHAIN_LENGTH);
+    for (loops = 0u; loops < BENCH_TIMING_LOOPS; loops++)
+    {
+        size = BENCH_CERT_READ;
+        start = host_cycles();
+        digest = Cy_QiStack_Auth_Cache_Digest(0u);
+        cert = Cy_QiStack_Auth_Cache_Cert(0u, (uint16_t)((loops % 3u) * BENCH_CERT_READ), &size);
+        lookupCycles += host_cycles() - start;
+        __asm__ volatile("" : : "r"(digest), "r"(cert) : "memory");
+    }
+
+    (void)Cy_QiStack_Auth_Cache_Save(&gl_ctx, 0u, &gl_rec);
+    for (loops = 0u; loops < BENCH_LOAD_LOOPS; loops++)
+    {
+        start = host_cycles();
+        (void)Cy_QiStack_Auth_Cache_Load(&gl_ctx, &gl_rec);
+        loadCycles += host_cycles() - start;
+    }
+
+    printf("cached digest + certificate lookup %5.1f %s, flash copy restore %7.1f %s\n",
+           (double)lookupCycles / BENCH_TIMING_LOOPS, HOST_CYCLES_UNIT,
+           (double)loadCycles / BENCH_LOAD_LOOPS, HOST_CYCLES_UNIT);
+}
+
+int main(void)
+{
+    uint32_t seed = 0x2023u;
+    uint32_t idx;
+
+    gl_ctx.ptrAppCbk = &gl_app;
+    gl_app.get_sha256_data = app_get_sha256_data;
+    for (idx = 0u; idx < WPC_CERTIFICATE_CHAIN_LENGTH; idx++)
+    {
+        gl_chain[0][idx] = (uint8_t)host_rand(&seed);
+        gl_chain[1][idx] = (uint8_t)host_rand(&seed);
+    }
+    for (idx = 0u; idx < WPC_CERTIFICATE_CHAIN_DIGEST_LENGTH; idx++)
+    {
+        gl_digest[0][idx] = (uint8_t)host_rand(&seed);
+        gl_digest[1][idx] = (uint8_t)host_rand(&seed);
+    }
+
+    run_ram();
+    run_flash();
+    run_timing();
+
+    return (gl_failCnt == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
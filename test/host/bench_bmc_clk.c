@@ -0,0 +1,130 @@
+/***************************************************************************//**
+* \file bench_bmc_clk.c
+* \version 2.0
+*
+* Host benchmark of the BMC bit clock recovery: packet error rate of the
+* tracking table driven decoder and of the fixed threshold reference decoder
+* over waveforms with bit rate error and edge jitter.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_bmc.h"
+#include "bmc_enc.h"
+#include "bmc_ref.h"
+
+#if (CY_QI_BMC_RX_CLK_RECOVERY_EN == 0)
+#error "bench_bmc_clk needs CY_QI_BMC_RX_CLK_RECOVERY_EN"
+#endif /* CY_QI_BMC_RX_CLK_RECOVERY_EN */
+
+#define BENCH_PKT_COUNT                             (3000u)
+
+/* Largest packet error rate of the tracking decoder in any cell, percent. */
+#define BENCH_TRACK_PER_MAX                         (1.0)
+
+static const double gl_rates[] = {-0.10, -0.07, -0.04, 0.0, 0.04, 0.07, 0.10};
+static const double gl_jitters[] = {0.0, 0.03, 0.06};
+static const uint8_t gl_headers[] = {0x03u, 0x51u, 0x84u, 0xE2u};
+
+/* True if the packet was decoded as sent. */
+static bool pkt_ok(cy_en_qi_ask_pkt_evt_t evt, const cy_stc_qi_ask_pkt_t *out,
+        const uint8_t *pkt, uint8_t len)
+{
+    return (evt == CY_QI_ASK_EVT_PKT_READY) && (out->header == pkt[0]) &&
+           (out->dataSize == (uint8_t)(len - 2u)) &&
+           (memcmp(out->msg, &pkt[1], out->dataSize) == 0);
+}
+
+/* Runs one rate and jitter cell. Error counts are returned per decoder. */
+static void run_cell(double rate, double jitter, uint32_t *fixedErr, uint32_t *trackErr)
+{
+    static bmc_enc_t enc;
+    uint8_t pkt[CY_QI_ASK_DATA_SIZE + 2u];
+    cy_stc_qi_bmc_lut_dec_t dec;
+    cy_stc_qi_ask_pkt_t out;
+    cy_en_qi_ask_pkt_evt_t evt;
+    uint32_t seed = 0x5EEDu;
+    uint32_t idx;
+    uint8_t len;
+
+    *fixedErr = 0u;
+    *trackErr = 0u;
+
+    for (idx = 0u; idx < BENCH_PKT_COUNT; idx++)
+    {
+        len = bmc_enc_make_pkt(pkt, gl_headers[idx & 3u], &seed);
+        bmc_enc_init(&enc, rate, jitter, host_rand(&seed));
+        bmc_enc_frame(&enc, pkt, len, (uint8_t)(11u + (host_rand(&seed) % 15u)));
+
+        (void)memset(&out, 0, sizeof(out));
+        evt = bmc_ref_decode(enc.buf, (uint16_t)enc.bitCount, &out);
+        if (!pkt_ok(evt, &out, pkt, len))
+        {
+            (*fixedErr)++;
+        }
+
+        (void)memset(&out, 0, sizeof(out));
+        bmc_rx_lut_init(&dec, &out);
+        evt = bmc_rx_lut_decode(&dec, enc.buf, (uint16_t)enc.bitCount);
+        if (!pkt_ok(evt, &out, pkt, len))
+        {
+            (*trackErr)++;
+        }
+    }
+}
+
+int main(void)
+{
+    uint32_t fixedErr;
+    uint32_t trackErr;
+    double fixedPer;
+    double trackPer;
+    uint8_t jit;
+    uint8_t rate;
+    int result = 0;
+
+    printf("packet error rate in %%, %uX, %u packets per cell, fixed / tracking:\n",
+           (unsigned)CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE, (unsigned)BENCH_PKT_COUNT);
+    printf("  rate   ");
+    for (rate = 0u; rate < (uint8_t)(sizeof(gl_rates) / sizeof(gl_rates[0])); rate++)
+    {
+        printf("  %+12.0f%%", gl_rates[rate] * 100.0);
+    }
+    printf("\n");
+
+    for (jit = 0u; jit < (uint8_t)(sizeof(gl_jitters) / sizeof(gl_jitters[0])); jit++)
+    {
+        printf("  jit %2.0f%%", gl_jitters[jit] * 100.0);
+        for (rate = 0u; rate < (uint8_t)(sizeof(gl_rates) / sizeof(gl_rates[0])); rate++)
+        {
+            run_cell(gl_rates[rate], gl_jitters[jit], &fixedErr, &trackErr);
+            fixedPer = (100.0 * fixedErr) / BENCH_PKT_COUNT;
+            trackPer = (100.0 * trackErr) / BENCH_PKT_COUNT;
+            printf("  %6.2f /%5.2f", fixedPer, trackPer);
+
+            if (trackPer > BENCH_TRACK_PER_MAX)
+            {
+                result = 1;
+            }
+        }
+        printf("\n");
+    }
+
+    if (result != 0)
+    {
+        printf("tracking decoder above %.1f%% packet error rate\n", BENCH_TRACK_PER_MAX);
+    }
+
+    return result;
+}
+
+/* [] END OF FILE */
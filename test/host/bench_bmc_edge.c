@@ -0,0 +1,185 @@
+/***************************************************************************//**
+* \file bench_bmc_edge.c
+* \version 2.0
+*
+* Host check of the BMC edge capture mode: packets decoded from edge
+* timestamps through the single path receiver agree with the same decoder fed
+* with SPI samples, the edge log is kept in askBmc.rawData and the SPI FIFO
+* handler no longer writes it.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_bmc.h"
+#include "bmc_enc.h"
+#include "host_clock.h"
+
+#if (CY_QI_BMC_RX_EDGE_CAPTURE_EN == 0)
+#error "bench_bmc_edge needs CY_QI_BMC_RX_EDGE_CAPTURE_EN"
+#endif /* CY_QI_BMC_RX_EDGE_CAPTURE_EN */
+
+#define BENCH_PKT_COUNT                             (20000u)
+
+/* SPI words returned by the FIFO stub, see Cy_SCB_SPI_Read. */
+#define BENCH_SPI_WORDS                             (8u)
+
+static cy_stc_qi_context_t gl_ctx;
+static uint32_t gl_spiWords;
+
+uint32_t Cy_SCB_SPI_GetNumInRxFifo(CySCB_Type const *base)
+{
+    (void)base;
+    return gl_spiWords;
+}
+
+uint32_t Cy_SCB_SPI_Read(CySCB_Type const *base)
+{
+    (void)base;
+    gl_spiWords--;
+    return 0xA5A5u;
+}
+
+/*
+ * Feeds a waveform to the receiver as edge timestamps, starting at a counter
+ * value close to the wrap, and ends the reception. Returns the final event.
+ */
+static cy_en_qi_ask_pkt_evt_t edge_decode(const bmc_enc_t *enc, uint16_t start, uint16_t *lastRun)
+{
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &gl_ctx.qiCommStat.askBmc;
+    uint16_t prev = 0u;
+    uint32_t pos;
+    uint8_t level = enc->buf[0] & 0x01u;
+    uint8_t bit;
+
+    bmc_rx_lut_rx_start(&gl_ctx);
+    for (pos = 1u; pos < enc->bitCount; pos++)
+    {
+        bit = (uint8_t)((enc->buf[pos >> 3u] >> (pos & 7u)) & 0x01u);
+        if (bit != level)
+        {
+            if (!askBmc->isDataReady)
+            {
+                *lastRun = (uint16_t)(pos - prev);
+            }
+            prev = (uint16_t)pos;
+            level = bit;
+            bmc_rx_lut_rx_edge(&gl_ctx, (uint16_t)(start + pos));
+        }
+    }
+
+    askBmc->isRcvDone = true;
+    bmc_rx_lut_task(&gl_ctx);
+
+    return (gl_ctx.bmcLut.lutDec.state == CY_QI_BMC_LUT_ST_DONE) ?
+        CY_QI_ASK_EVT_PKT_READY : CY_QI_ASK_EVT_PKT_ERR;
+}
+
+static int run_agreement(void)
+{
+    static bmc_enc_t enc;
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &gl_ctx.qiCommStat.askBmc;
+    cy_stc_qi_bmc_lut_dec_t *lutDec = &gl_ctx.bmcLut.lutDec;
+    uint8_t pkt[CY_QI_ASK_DATA_SIZE + 2u];
+    cy_stc_qi_bmc_lut_dec_t dec;
+    cy_stc_qi_ask_pkt_t ref;
+    cy_en_qi_ask_pkt_evt_t refEvt;
+    cy_en_qi_ask_pkt_evt_t evt;
+    uint32_t seed = 0x3003u;
+    uint32_t readyCnt = 0u;
+    uint32_t failCnt = 0u;
+    uint32_t logCnt = 0u;
+    uint32_t idx;
+    uint16_t lastRun = 0u;
+    uint8_t len;
+    uint8_t logged;
+
+    for (idx = 0u; idx < BENCH_PKT_COUNT; idx++)
+    {
+        len = bmc_enc_make_pkt(pkt, (uint8_t)host_rand(&seed), &seed);
+        bmc_enc_init(&enc, ((double)(host_rand(&seed) % 81u) - 40.0) / 1000.0,
+                     (double)(host_rand(&seed) % 9u) / 100.0, host_rand(&seed));
+        bmc_enc_frame(&enc, pkt, len, (uint8_t)(4u + (host_rand(&seed) % 22u)));
+
+        bmc_rx_lut_init(&dec, &ref);
+        refEvt = bmc_rx_lut_decode(&dec, enc.buf, (uint16_t)enc.bitCount);
+        if (refEvt != CY_QI_ASK_EVT_PKT_READY)
+        {
+            refEvt = CY_QI_ASK_EVT_PKT_ERR;
+        }
+
+        evt = edge_decode(&enc, (uint16_t)(UINT16_MAX - (host_rand(&seed) % 512u)), &lastRun);
+        if (evt == CY_QI_ASK_EVT_PKT_READY)
+        {
+            readyCnt++;
+        }
+
+        /* The packet ends on the checksum stop bit edge, the last one logged. */
+        logged = askBmc->rawData[(lutDec->edgeLogIdx - 1u) & (CY_QI_BMC_RX_EDGE_LOG_SIZE - 1u)];
+        if ((evt == CY_QI_ASK_EVT_PKT_READY) && (logged == ((lastRun > UINT8_MAX) ? UINT8_MAX : lastRun)))
+        {
+            logCnt++;
+        }
+
+        if ((evt != refEvt) || (askBmc->rawDataCount != 0u) || (askBmc->rawBitCount != 0u) ||
+            ((evt == CY_QI_ASK_EVT_PKT_READY) &&
+             ((askBmc->pkt.header != ref.header) || (askBmc->pkt.checksum != ref.checksum) ||
+              (memcmp(askBmc->pkt.msg, ref.msg, ref.dataSize) != 0))))
+        {
+            if (failCnt < 5u)
+            {
+                printf("  mismatch at waveform %u: edge %d, samples %d\n", (unsigned)idx, (int)evt, (int)refEvt);
+            }
+            failCnt++;
+        }
+    }
+
+    printf("agreement: %u waveforms, %u decoded from edges, %u mismatches, %u edge logs in rawData\n",
+           (unsigned)BENCH_PKT_COUNT, (unsigned)readyCnt, (unsigned)failCnt, (unsigned)logCnt);
+
+    return ((failCnt == 0u) && (logCnt == readyCnt)) ? 0 : 1;
+}
+
+/* SPI words drained by the FIFO handler change neither rawData nor the decoder. */
+static int run_spi_drain(void)
+{
+    static uint8_t raw[CY_QI_BMC_RX_SPI_RAW_DATA_SIZE];
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &gl_ctx.qiCommStat.askBmc;
+    cy_stc_qi_bmc_lut_dec_t dec;
+
+    bmc_rx_lut_rx_start(&gl_ctx);
+    bmc_rx_lut_rx_edge(&gl_ctx, 100u);
+    bmc_rx_lut_rx_edge(&gl_ctx, 104u);
+    (void)memcpy(raw, askBmc->rawData, sizeof(raw));
+    dec = gl_ctx.bmcLut.lutDec;
+
+    gl_spiWords = BENCH_SPI_WORDS;
+    bmc_rx_lut_scb_fifo_handler(&gl_ctx);
+
+    printf("spi drain: %u words left, rawData %s, decoder %s\n", (unsigned)gl_spiWords,
+           (memcmp(raw, askBmc->rawData, sizeof(raw)) == 0) ? "kept" : "written",
+           (memcmp(&dec, &gl_ctx.bmcLut.lutDec, sizeof(dec)) == 0) ? "kept" : "fed");
+
+    return ((gl_spiWords == 0u) && (memcmp(raw, askBmc->rawData, sizeof(raw)) == 0) &&
+            (memcmp(&dec, &gl_ctx.bmcLut.lutDec, sizeof(dec)) == 0) && (askBmc->rawDataCount == 0u)) ? 0 : 1;
+}
+
+int main(void)
+{
+    int result;
+
+    result = run_agreement();
+    result |= run_spi_drain();
+
+    return result;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,259 @@
+/***************************************************************************//**
+* \file bench_bmc_lut.c
+* \version 2.0
+*
+* Host benchmark of the table driven BMC decoder against a per sample
+* reference decoder: bit exact agreement on clean, jittered and corrupted
+* waveforms, and decode cost per packet.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_bmc.h"
+#include "bmc_enc.h"
+#include "bmc_ref.h"
+#include "host_clock.h"
+
+#define BENCH_PKT_COUNT                             (20000u)
+#define BENCH_TIMING_LOOPS                          (2000u)
+
+/* Compares both decoders on one waveform. Returns false on any difference. */
+static bool check_one(const bmc_enc_t *enc, uint32_t *readyCnt)
+{
+    cy_stc_qi_bmc_lut_dec_t dec;
+    cy_stc_qi_ask_pkt_t lutPkt;
+    cy_stc_qi_ask_pkt_t refPkt;
+    cy_en_qi_ask_pkt_evt_t lutEvt;
+    cy_en_qi_ask_pkt_evt_t refEvt;
+
+    (void)memset(&lutPkt, 0, sizeof(lutPkt));
+    (void)memset(&refPkt, 0, sizeof(refPkt));
+
+    bmc_rx_lut_init(&dec, &lutPkt);
+    lutEvt = bmc_rx_lut_decode(&dec, enc->buf, (uint16_t)enc->bitCount);
+    refEvt = bmc_ref_decode(enc->buf, (uint16_t)enc->bitCount, &refPkt);
+
+    if (lutEvt != refEvt)
+    {
+        return false;
+    }
+
+    if (lutEvt == CY_QI_ASK_EVT_PKT_READY)
+    {
+        (*readyCnt)++;
+        if ((lutPkt.header != refPkt.header) || (lutPkt.dataSize != refPkt.dataSize) ||
+            (lutPkt.checksum != refPkt.checksum) ||
+            (memcmp(lutPkt.msg, refPkt.msg, lutPkt.dataSize) != 0))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Agreement over random packets with jitter, rate error and sample flips. */
+static int run_agreement(void)
+{
+    static bmc_enc_t enc;
+    uint8_t pkt[CY_QI_ASK_DATA_SIZE + 2u];
+    uint32_t seed = 0x2023u;
+    uint32_t readyCnt = 0u;
+    uint32_t failCnt = 0u;
+    uint32_t idx;
+    uint32_t flip;
+    uint32_t pos;
+    uint8_t len;
+    double rate;
+    double jitter;
+
+    for (idx = 0u; idx < BENCH_PKT_COUNT; idx++)
+    {
+        len = bmc_enc_make_pkt(pkt, (uint8_t)host_rand(&seed), &seed);
+        rate = ((double)(host_rand(&seed) % 201u) - 100.0) / 1000.0;
+        jitter = (double)(host_rand(&seed) % 13u) / 100.0;
+        bmc_enc_init(&enc, rate, jitter, host_rand(&seed));
+        bmc_enc_frame(&enc, pkt, len, (uint8_t)(4u + (host_rand(&seed) % 22u)));
+
+        /* A quarter of the waveforms get up to four flipped samples. */
+        if ((idx & 3u) == 0u)
+        {
+            for (flip = host_rand(&seed) % 5u; flip != 0u; flip--)
+            {
+                pos = host_rand(&seed) % enc.bitCount;
+                enc.buf[pos >> 3u] ^= (uint8_t)(1u << (pos & 7u));
+            }
+        }
+
+        if (!check_one(&enc, &readyCnt))
+        {
+            if (failCnt < 5u)
+            {
+                printf("  mismatch at waveform %u\n", (unsigned)idx);
+            }
+            failCnt++;
+        }
+    }
+
+    printf("agreement: %u waveforms, %u decoded by both, %u mismatches\n",
+           (unsigned)BENCH_PKT_COUNT, (unsigned)readyCnt, (unsigned)failCnt);
+
+    return (failCnt == 0u) ? 0 : 1;
+}
+
+/*
+ * A stalled line inside a packet must fail it, however long the stall. The
+ * stall is chosen so that a wrapping 16-bit run length would read as a full
+ * bit again and let the rest of the packet decode.
+ */
+static int run_long_idle(void)
+{
+    static bmc_enc_t enc;
+    static uint8_t idle[1024];
+    cy_stc_qi_bmc_lut_dec_t dec;
+    cy_stc_qi_ask_pkt_t pkt;
+    cy_en_qi_ask_pkt_evt_t evt;
+    uint8_t data[4] = {0x51u, 0x12u, 0x34u, 0x00u};
+    uint32_t idleCnt = 0u;
+    uint32_t split;
+
+    data[3] = (uint8_t)(data[0] ^ data[1] ^ data[2]);
+    bmc_enc_init(&enc, 0.0, 0.0, 1u);
+    bmc_enc_frame(&enc, data, 4u, 12u);
+
+    /* Split after the start bit and the first data bit, both full bits. */
+    split = (3u + 12u + 11u + 2u) * CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE;
+    (void)memset(idle, (BMC_REF_RAW_BIT(enc.buf, split - 1u) != 0u) ? 0xFF : 0x00,
+                 sizeof(idle));
+
+    bmc_rx_lut_init(&dec, &pkt);
+    evt = bmc_rx_lut_feed(&dec, enc.buf, (uint16_t)split);
+    if (evt != CY_QI_ASK_EVT_START_BIT)
+    {
+        printf("long idle: no packet start, evt %d\n", (int)evt);
+        return 1;
+    }
+
+    evt = CY_QI_ASK_EVT_PKT_NONE;
+    while ((evt == CY_QI_ASK_EVT_PKT_NONE) && (idleCnt < (UINT16_MAX + 1u)))
+    {
+        evt = bmc_rx_lut_feed(&dec, idle, (uint16_t)(sizeof(idle) * 8u));
+        idleCnt += (uint32_t)sizeof(idle) * 8u;
+    }
+
+    if (evt == CY_QI_ASK_EVT_PKT_NONE)
+    {
+        evt = bmc_rx_lut_feed(&dec, &enc.buf[split >> 3u], (uint16_t)(enc.bitCount - split));
+    }
+
+    printf("long idle: %u samples inside a packet, evt %d\n", (unsigned)idleCnt, (int)evt);
+
+    return (evt == CY_QI_ASK_EVT_PKT_ERR) ? 0 : 1;
+}
+
+/*
+ * A preamble broken by a glitch, then an idle line until the receive window
+ * ends: one failed reception, counted once as a bad preamble.
+ */
+static int run_bad_preamble(void)
+{
+    static cy_stc_qi_context_t ctx;
+    uint8_t raw[16];
+    uint32_t *failRsCnt = ctx.bmcLut.askStats.failRsCnt;
+    uint16_t pos = 0u;
+    uint16_t cnt;
+    uint8_t level = 0u;
+    uint8_t half;
+
+    (void)memset(raw, 0, sizeof(raw));
+    for (half = 0u; half < 13u; half++)
+    {
+        /* Twelve half bits of preamble, then a one sample glitch. */
+        cnt = (half < 12u) ? (uint16_t)(CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE >> 1u) : 1u;
+        for (; cnt != 0u; cnt--, pos++)
+        {
+            raw[pos >> 3u] |= (uint8_t)(level << (pos & 7u));
+        }
+        level ^= 1u;
+    }
+
+    bmc_rx_lut_rx_start(&ctx);
+    (void)bmc_rx_lut_feed(&ctx.bmcLut.lutDec, raw, (uint16_t)(sizeof(raw) * 8u));
+    ctx.qiCommStat.askBmc.isRcvDone = true;
+    bmc_rx_lut_task(&ctx);
+
+    printf("bad preamble: %u bad preamble, %u no packet start\n",
+           (unsigned)failRsCnt[CY_QI_ASK_FAIL_RS_BAD_PREAMBLE],
+           (unsigned)failRsCnt[CY_QI_ASK_FAIL_RS_NO_PKT_START]);
+
+    return ((failRsCnt[CY_QI_ASK_FAIL_RS_BAD_PREAMBLE] == 1u) &&
+            (failRsCnt[CY_QI_ASK_FAIL_RS_NO_PKT_START] == 0u)) ? 0 : 1;
+}
+
+/* Decode cost per packet of both decoders for a few packet sizes. */
+static void run_timing(void)
+{
+    static bmc_enc_t enc;
+    static const uint8_t headers[] = {0x03u, 0x51u, 0x84u, 0xE2u};
+    uint8_t pkt[CY_QI_ASK_DATA_SIZE + 2u];
+    cy_stc_qi_bmc_lut_dec_t dec;
+    cy_stc_qi_ask_pkt_t out;
+    uint32_t seed = 7u;
+    volatile uint32_t sink = 0u;
+    uint64_t start;
+    uint64_t lutTime;
+    uint64_t refTime;
+    uint32_t loop;
+    uint8_t idx;
+    uint8_t len;
+
+    printf("cost per packet, %uX, %s:\n", (unsigned)CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE, HOST_CYCLES_UNIT);
+    for (idx = 0u; idx < (uint8_t)sizeof(headers); idx++)
+    {
+        len = bmc_enc_make_pkt(pkt, headers[idx], &seed);
+        bmc_enc_init(&enc, 0.0, 0.04, 5u);
+        bmc_enc_frame(&enc, pkt, len, 12u);
+
+        start = host_cycles();
+        for (loop = 0u; loop < BENCH_TIMING_LOOPS; loop++)
+        {
+            sink += (uint32_t)bmc_ref_decode(enc.buf, (uint16_t)enc.bitCount, &out);
+        }
+        refTime = host_cycles() - start;
+
+        start = host_cycles();
+        for (loop = 0u; loop < BENCH_TIMING_LOOPS; loop++)
+        {
+            bmc_rx_lut_init(&dec, &out);
+            sink += (uint32_t)bmc_rx_lut_decode(&dec, enc.buf, (uint16_t)enc.bitCount);
+        }
+        lutTime = host_cycles() - start;
+
+        printf("  %2u byte message: per sample %7.0f, table %6.0f\n", (unsigned)(len - 2u),
+               (double)refTime / BENCH_TIMING_LOOPS, (double)lutTime / BENCH_TIMING_LOOPS);
+    }
+    (void)sink;
+}
+
+int main(void)
+{
+    int result;
+
+    result = run_agreement();
+    result |= run_long_idle();
+    result |= run_bad_preamble();
+    run_timing();
+
+    return result;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,324 @@
+/***************************************************************************//**
+* \file bench_fsk_model.c
+* \version 2.0
+*
+* Host throughput driver of the FSK waveform model: self check of the model
+* against rendered and mutated waveforms, the response window check, and the
+* waveform of the edge schedule and its interrupt handler on a model of the
+* inverter checked frame by frame against the Qi FSK timing rules.
+*
+*   bench_fsk_model [frames]
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_manager.h"
+#include "host_clock.h"
+#include "host_tcpwm.h"
+
+#if ((CY_QI_FSK_MODEL_EN == 0) || (CY_QI_FSK_SCHED_EN == 0))
+#error "bench_fsk_model needs CY_QI_FSK_MODEL_EN and CY_QI_FSK_SCHED_EN"
+#endif /* CY_QI_FSK_MODEL_EN, CY_QI_FSK_SCHED_EN */
+
+/* Frames sent through the schedule when no count is given. */
+#define BENCH_FRAMES_DEFAULT                        (20000u)
+
+/* Above this many frames, only every 16th frame is checked. */
+#define BENCH_FRAMES_CHECK_ALL                      (100000u)
+
+/* Waveforms per depth and polarity in the model self check. */
+#define BENCH_SELF_COUNT                            (200u)
+
+/* PWM clock of the inverter, in kHz. */
+#define BENCH_PWM_CLK_KHZ                           (48000u)
+
+/* Operating cycles before the schedule starts, 5.3 to 7 ms at the bench periods. */
+#define BENCH_LEAD_CYCLES                           (800u)
+
+/* Operating cycles recorded after the schedule stopped. */
+#define BENCH_TAIL_CYCLES                           (256u)
+
+/* Longest waveform, in inverter cycles. */
+#define BENCH_MAX_CYCLES                            (70000u)
+
+static cy_stc_qi_context_t gl_ctx;
+static cy_stc_qi_app_cbk_t gl_app;
+
+static uint16_t gl_wave[BENCH_MAX_CYCLES];
+
+static const char * const gl_errName[] =
+{
+    "ok", "no_mod", "resp_early", "resp_late", "period",
+    "cell", "half", "data", "tail", "short"
+};
+
+static void app_fsk_pwm_configure(struct cy_stc_qi_context *qiCtx, bool isMod)
+{
+    const cy_stc_qi_comm_fsk_oper_t *oper = &qiCtx->qiCommStat.fskOper;
+
+    host_tcpwm.pwmPeriod = isMod ? oper->periodModPwmCnt : oper->periodOpPwmCnt;
+}
+
+/* Lead cycles at the operating period for a response delay in us. */
+static uint32_t lead_cycles(const cy_stc_qi_comm_fsk_oper_t *oper, uint32_t delayUs)
+{
+    return (delayUs * (BENCH_PWM_CLK_KHZ / 1000u)) / oper->periodOpPwmCnt;
+}
+
+/* Random frame or pattern at a random operating period. */
+static void make_oper(cy_stc_qi_comm_fsk_oper_t *oper, uint8_t depth, uint8_t polarity,
+        bool frame, uint32_t *seed)
+{
+    uint8_t idx;
+
+    oper->periodOpPwmCnt = 320u + (host_rand(seed) % 100u);
+    oper->periodModPwmCnt = Cy_QiStack_Fsk_Model_Mod_Period(oper->periodOpPwmCnt, depth, polarity);
+    oper->frame = frame;
+    oper->dataLen = frame ? (uint8_t)(1u + (host_rand(seed) % 10u)) : 1u;
+    for (idx = 0u; idx < oper->dataLen; idx++)
+    {
+        oper->data[idx] = (uint8_t)host_rand(seed);
+    }
+}
+
+/*
+ * Rendered waveforms must pass at all depths and polarities. A transition
+ * moved by one cycle or a corrupted period must fail.
+ */
+static int run_self_check(void)
+{
+    cy_stc_qi_comm_fsk_oper_t oper;
+    cy_stc_qi_fsk_model_result_t result;
+    uint32_t errCnt[sizeof(gl_errName) / sizeof(gl_errName[0])] = {0u};
+    uint32_t seed = 11u;
+    uint32_t failCnt = 0u;
+    uint32_t okCnt = 0u;
+    uint32_t lead;
+    uint32_t cycles;
+    uint32_t pos;
+    uint32_t idx;
+    uint8_t depth;
+    uint8_t polarity;
+
+    (void)memset(&oper, 0, sizeof(oper));
+
+    for (depth = 0u; depth < 4u; depth++)
+    {
+        for (polarity = 0u; polarity < 2u; polarity++)
+        {
+            for (idx = 0u; idx < BENCH_SELF_COUNT; idx++)
+            {
+                make_oper(&oper, depth, polarity, ((idx & 1u) != 0u), &seed);
+                lead = lead_cycles(&oper, 5000u);
+                cycles = Cy_QiStack_Fsk_Model_Render(&oper, lead, gl_wave, BENCH_MAX_CYCLES);
+
+                if (Cy_QiStack_Fsk_Model_Check(&oper, gl_wave, cycles, BENCH_PWM_CLK_KHZ, &result) ==
+                        CY_QISTACK_STAT_SUCCESS)
+                {
+                    okCnt++;
+                }
+                else
+                {
+                    failCnt++;
+                }
+
+                if ((idx & 2u) != 0u)
+                {
+                    /* Move a transition one cycle later. */
+                    do
+                    {
+                        pos = lead + 1u + (host_rand(&seed) % (cycles - lead - 2u));
+                    } while (gl_wave[pos] == gl_wave[pos - 1u]);
+                    gl_wave[pos] = gl_wave[pos - 1u];
+                }
+                else
+                {
+                    pos = lead + (host_rand(&seed) % (cycles - lead));
+                    gl_wave[pos] ^= 1u;
+                }
+
+                if (Cy_QiStack_Fsk_Model_Check(&oper, gl_wave, cycles, BENCH_PWM_CLK_KHZ, &result) ==
+                        CY_QISTACK_STAT_SUCCESS)
+                {
+                    failCnt++;
+                }
+                else
+                {
+                    errCnt[result.err]++;
+                }
+            }
+        }
+    }
+
+    printf("model self check: %u rendered waveforms pass, %u wrong verdicts; mutations caught as:",
+           (unsigned)okCnt, (unsigned)failCnt);
+    for (idx = 1u; idx < (uint32_t)(sizeof(gl_errName) / sizeof(gl_errName[0])); idx++)
+    {
+        if (errCnt[idx] != 0u)
+        {
+            printf(" %s %u", gl_errName[idx], (unsigned)errCnt[idx]);
+        }
+    }
+    printf("\n");
+
+    return (failCnt == 0u) ? 0 : 1;
+}
+
+/* Responses before CY_QI_TIMER_FSK_RESP_TIME or after CY_QI_TIMER_FSK_RESP_MAX_TIME fail. */
+static int run_window(void)
+{
+    static const struct
+    {
+        uint32_t delayUs;
+        cy_en_qi_fsk_model_err_t err;
+    } window[] =
+    {
+        {100u, CY_QI_FSK_MODEL_ERR_RESP_EARLY},
+        {(CY_QI_TIMER_FSK_RESP_TIME * 1000u) + 200u, CY_QI_FSK_MODEL_OK},
+        {5000u, CY_QI_FSK_MODEL_OK},
+        {(CY_QI_TIMER_FSK_RESP_MAX_TIME * 1000u) - 200u, CY_QI_FSK_MODEL_OK},
+        {(CY_QI_TIMER_FSK_RESP_MAX_TIME * 1000u) + 200u, CY_QI_FSK_MODEL_ERR_RESP_LATE}
+    };
+    cy_stc_qi_comm_fsk_oper_t oper;
+    cy_stc_qi_fsk_model_result_t result;
+    uint32_t seed = 7u;
+    uint32_t failCnt = 0u;
+    uint32_t cycles;
+    uint32_t idx;
+
+    (void)memset(&oper, 0, sizeof(oper));
+    make_oper(&oper, 1u, 0u, true, &seed);
+
+    for (idx = 0u; idx < (uint32_t)(sizeof(window) / sizeof(window[0])); idx++)
+    {
+        cycles = Cy_QiStack_Fsk_Model_Render(&oper, lead_cycles(&oper, window[idx].delayUs),
+                gl_wave, BENCH_MAX_CYCLES);
+        (void)Cy_QiStack_Fsk_Model_Check(&oper, gl_wave, cycles, BENCH_PWM_CLK_KHZ, &result);
+
+        printf("response after %5u us: %s (%u us)\n", (unsigned)window[idx].delayUs,
+               gl_errName[result.err], (unsigned)result.respDelayUs);
+        if (result.err != window[idx].err)
+        {
+            failCnt++;
+        }
+    }
+
+    return (failCnt == 0u) ? 0 : 1;
+}
+
+/*
+ * Sends the transmission in fskOper through the edge schedule and its
+ * interrupt handler, and records the inverter period of every cycle.
+ */
+static uint32_t isr_wave(void)
+{
+    cy_stc_qi_comm_fsk_oper_t *oper = &gl_ctx.qiCommStat.fskOper;
+    uint32_t cycles = 0u;
+    uint32_t idx;
+
+    host_tcpwm.pwmPeriod = oper->periodOpPwmCnt;
+    host_tcpwm.pwmPeriodBuf = oper->periodOpPwmCnt;
+    while (cycles < BENCH_LEAD_CYCLES)
+    {
+        gl_wave[cycles++] = (uint16_t)host_tcpwm.pwmPeriod;
+    }
+
+    (void)Cy_QiStack_Fsk_Sched_Build(&gl_ctx.fskSched, oper->data, oper->dataLen, oper->frame);
+    (void)Cy_QiStack_Fsk_Sched_Start(&gl_ctx);
+
+    while (host_tcpwm.cntRunning && (cycles < (BENCH_MAX_CYCLES - BENCH_TAIL_CYCLES)))
+    {
+        gl_wave[cycles++] = (uint16_t)host_tcpwm.pwmPeriod;
+        if (host_tcpwm_edge())
+        {
+            Cy_QiStack_Fsk_Sched_Edge_Handler(&gl_ctx);
+        }
+    }
+
+    for (idx = 0u; idx < BENCH_TAIL_CYCLES; idx++)
+    {
+        gl_wave[cycles++] = (uint16_t)host_tcpwm.pwmPeriod;
+    }
+
+    return cycles;
+}
+
+/* Frames and patterns from the schedule checked against the model. */
+static int run_isr(uint32_t frames)
+{
+    cy_stc_qi_comm_fsk_oper_t *oper = &gl_ctx.qiCommStat.fskOper;
+    cy_stc_qi_fsk_model_result_t result;
+    uint32_t seed = 13u;
+    uint32_t failCnt = 0u;
+    uint32_t checkCnt = 0u;
+    uint64_t isrTime = 0u;
+    uint64_t chkTime = 0u;
+    uint64_t start;
+    uint32_t cycles;
+    uint32_t idx;
+
+    gl_ctx.ptrAppCbk = &gl_app;
+    gl_app.fsk_pwm_configure = app_fsk_pwm_configure;
+    host_tcpwm.swapOnTc = (CY_QI_FSK_HW_SWAP_EN != 0);
+
+    for (idx = 0u; idx < frames; idx++)
+    {
+        make_oper(oper, (uint8_t)(idx & 3u), (uint8_t)((idx >> 2u) & 1u), ((idx % 5u) != 0u), &seed);
+
+        start = host_cycles();
+        cycles = isr_wave();
+        isrTime += host_cycles() - start;
+
+        if ((frames <= BENCH_FRAMES_CHECK_ALL) || ((idx & 15u) == 0u))
+        {
+            start = host_cycles();
+            if (Cy_QiStack_Fsk_Model_Check(oper, gl_wave, cycles, BENCH_PWM_CLK_KHZ, &result) !=
+                    CY_QISTACK_STAT_SUCCESS)
+            {
+                if (failCnt < 3u)
+                {
+                    printf("  frame %u: %s at cycle %u\n", (unsigned)idx,
+                           gl_errName[result.err], (unsigned)result.errCycle);
+                }
+                failCnt++;
+            }
+            chkTime += host_cycles() - start;
+            checkCnt++;
+        }
+    }
+
+    printf("schedule: %u frames, %u checked, %u failed; %s per frame: inverter and ISR %.0f, check %.0f\n",
+           (unsigned)frames, (unsigned)checkCnt, (unsigned)failCnt, HOST_CYCLES_UNIT,
+           (double)isrTime / frames, (double)chkTime / ((checkCnt != 0u) ? checkCnt : 1u));
+
+    return (failCnt == 0u) ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t frames = BENCH_FRAMES_DEFAULT;
+    int result;
+
+    if (argc > 1)
+    {
+        frames = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+    result = run_self_check();
+    result |= run_window();
+    result |= run_isr(frames);
+
+    return result;
+}
+
+/* [] END OF FILE */
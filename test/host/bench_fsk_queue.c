@@ -0,0 +1,204 @@
+/***************************************************************************//**
+* \file bench_fsk_queue.c
+* \version 2.0
+*
+* Host check of the FSK transmit queue on the edge counter model: a response
+* queued after a data frame is sent first, an entry waiting for the next
+* response window starts on the edge the previous frame ends, and the
+* overflow, missed window and wait counters match the injected cases.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_manager.h"
+#include "host_tcpwm.h"
+
+#if (CY_QI_FSK_TX_QUEUE_DEPTH == 0)
+#error "bench_fsk_queue needs CY_QI_FSK_TX_QUEUE_DEPTH"
+#endif /* CY_QI_FSK_TX_QUEUE_DEPTH */
+
+/* Inverter edges per half bit. */
+#define BENCH_HALF_EDGES                            (1u << CY_QI_FSK_HALF_BIT_SHIFT)
+
+/* Operating frequency inverter period, in PWM clocks. */
+#define BENCH_OP_PERIOD                             (100u)
+
+/* Edges after which a frame that never ends is given up. */
+#define BENCH_EDGE_MAX                              ((CY_QI_FSK_SCHED_SIZE + 1u) * 2u * BENCH_HALF_EDGES)
+
+static cy_stc_qi_context_t gl_ctx;
+static cy_stc_qi_app_cbk_t gl_app;
+static uint32_t gl_now;
+static uint32_t gl_failCnt;
+
+/* ADT frame: header, five message bytes, checksum. */
+static const uint8_t gl_adt[] = {0x26u, 0x11u, 0x22u, 0x33u, 0x44u, 0x55u, 0x26u ^ 0x11u ^ 0x22u ^ 0x33u ^ 0x44u ^ 0x55u};
+static const uint8_t gl_ack = CY_QI_FSK_PATTERN_ACK;
+
+static void app_fsk_pwm_configure(struct cy_stc_qi_context *qiCtx, bool isMod)
+{
+    (void)qiCtx;
+    host_tcpwm.pwmPeriod = isMod ? gl_ctx.qiCommStat.fskOper.periodModPwmCnt : BENCH_OP_PERIOD;
+}
+
+static uint32_t app_get_timestamp(struct cy_stc_qi_context *qiCtx)
+{
+    (void)qiCtx;
+    return gl_now;
+}
+
+static void check(bool cond, const char *what)
+{
+    if (!cond)
+    {
+        printf("  failed: %s\n", what);
+        gl_failCnt++;
+    }
+}
+
+/* True if the loaded schedule is the one of these bytes. */
+static bool sched_is(const uint8_t *data, uint8_t len, bool frame)
+{
+    cy_stc_qi_fsk_sched_t ref;
+
+    (void)Cy_QiStack_Fsk_Sched_Build(&ref, data, len, frame);
+
+    return (gl_ctx.fskSched.len == ref.len) && (gl_ctx.fskSched.halfTotal == ref.halfTotal) &&
+           (memcmp(gl_ctx.fskSched.halfCnt, ref.halfCnt, ref.len) == 0);
+}
+
+/* Clocks inverter edges until the running frame ends. Returns the edges taken. */
+static uint32_t send_frame(void)
+{
+    uint32_t frames = gl_ctx.fskSched.stats.frameCnt;
+    uint32_t edge = 0u;
+
+    while ((gl_ctx.fskSched.stats.frameCnt == frames) && (edge < BENCH_EDGE_MAX))
+    {
+        edge++;
+        gl_now++;
+        if (host_tcpwm_edge())
+        {
+            Cy_QiStack_Fsk_Sched_Edge_Handler(&gl_ctx);
+        }
+    }
+
+    return edge;
+}
+
+/* An ACK queued after an ADT frame goes first; the ADT follows on the ACK's last edge. */
+static void run_priority(void)
+{
+    cy_stc_qi_fsk_tx_queue_t *queue = &gl_ctx.fskTxQueue;
+    uint16_t ackHalves;
+    uint16_t adtHalves;
+    uint32_t ackEdges;
+    uint32_t edges;
+
+    Cy_QiStack_Fsk_Tx_Queue_Reset(&gl_ctx);
+    gl_now = 1000u;
+    check(Cy_QiStack_Fsk_Tx_Queue_Push(&gl_ctx, gl_adt, (uint8_t)sizeof(gl_adt), true,
+                                       CY_QI_FSK_TX_PRIO_DATA) == CY_QISTACK_STAT_SUCCESS, "push ADT");
+    gl_now = 1100u;
+    check(Cy_QiStack_Fsk_Tx_Queue_Push(&gl_ctx, &gl_ack, 1u, false,
+                                       CY_QI_FSK_TX_PRIO_RESP) == CY_QISTACK_STAT_SUCCESS, "push ACK");
+    check((gl_ctx.fskSched.len == 0u) && (queue->startCnt == 0u), "nothing starts while the window is closed");
+
+    gl_now = 1200u;
+    Cy_QiStack_Fsk_Tx_Slot_Open(&gl_ctx);
+    check(sched_is(&gl_ack, 1u, false) && host_tcpwm.cntRunning, "ACK starts first");
+    ackHalves = gl_ctx.fskSched.halfTotal;
+
+    /* The next window opens during the ACK: the ADT must wait for its end. */
+    Cy_QiStack_Fsk_Tx_Slot_Open(&gl_ctx);
+    check(sched_is(&gl_ack, 1u, false), "one entry per busy transmitter");
+
+    ackEdges = send_frame();
+    check(ackEdges == ((uint32_t)ackHalves * BENCH_HALF_EDGES), "ACK length");
+    check(sched_is(gl_adt, (uint8_t)sizeof(gl_adt), true) && host_tcpwm.cntRunning &&
+          (!gl_ctx.qiCommStat.fskCfg.pktDone), "ADT starts on the last ACK edge");
+    adtHalves = gl_ctx.fskSched.halfTotal;
+
+    edges = send_frame();
+    check(edges == ((uint32_t)adtHalves * BENCH_HALF_EDGES), "ADT length");
+    check((gl_ctx.fskSched.len == 0u) && gl_ctx.qiCommStat.fskCfg.pktDone, "pktDone after the last entry");
+    /* The ACK waited from 1100 to 1200, the ADT from 1000 to the last ACK edge. */
+    check((queue->startCnt == 2u) && (queue->waitSum == (100u + 200u + ackEdges)) &&
+          (queue->waitMax == (200u + ackEdges)), "wait times");
+
+    printf("priority: ACK %u edges, then ADT %u edges from the ACK's last edge, %u started, wait sum %u max %u\n",
+           (unsigned)ackEdges, (unsigned)edges, (unsigned)queue->startCnt,
+           (unsigned)queue->waitSum, (unsigned)queue->waitMax);
+}
+
+/* A window that closes with entries waiting is missed; a full priority drops entries. */
+static void run_counters(void)
+{
+    cy_stc_qi_fsk_tx_queue_t *queue = &gl_ctx.fskTxQueue;
+    uint32_t idx;
+    cy_en_qi_status_t status;
+
+    Cy_QiStack_Fsk_Tx_Queue_Reset(&gl_ctx);
+
+    /* A window that closes with nothing queued is not missed. */
+    Cy_QiStack_Fsk_Tx_Slot_Open(&gl_ctx);
+    Cy_QiStack_Fsk_Tx_Slot_Close(&gl_ctx);
+    (void)Cy_QiStack_Fsk_Tx_Queue_Push(&gl_ctx, &gl_ack, 1u, false, CY_QI_FSK_TX_PRIO_RESP);
+    (void)Cy_QiStack_Fsk_Tx_Queue_Push(&gl_ctx, gl_adt, (uint8_t)sizeof(gl_adt), true, CY_QI_FSK_TX_PRIO_DATA);
+
+    /* The ACK starts in the next window; the ADT misses the one opened and closed during the ACK. */
+    Cy_QiStack_Fsk_Tx_Slot_Open(&gl_ctx);
+    Cy_QiStack_Fsk_Tx_Slot_Close(&gl_ctx);
+    Cy_QiStack_Fsk_Tx_Slot_Open(&gl_ctx);
+    Cy_QiStack_Fsk_Tx_Slot_Close(&gl_ctx);
+    (void)send_frame();
+    check((gl_ctx.fskSched.len == 0u) && (queue->startCnt == 1u), "ADT not started after a missed window");
+    check(queue->missedCnt == 1u, "missed windows");
+    Cy_QiStack_Fsk_Tx_Slot_Open(&gl_ctx);
+    (void)send_frame();
+    check((queue->startCnt == 2u) && gl_ctx.qiCommStat.fskCfg.pktDone, "ADT sent in the next window");
+
+    /* Fill the data priority; responses still have room. */
+    for (idx = 0u; idx <= CY_QI_FSK_TX_QUEUE_DEPTH; idx++)
+    {
+        status = Cy_QiStack_Fsk_Tx_Queue_Push(&gl_ctx, gl_adt, (uint8_t)sizeof(gl_adt), true,
+                                              CY_QI_FSK_TX_PRIO_DATA);
+        check(status == ((idx < CY_QI_FSK_TX_QUEUE_DEPTH) ? CY_QISTACK_STAT_SUCCESS : CY_QISTACK_STAT_FAILURE),
+              "data priority fills up");
+    }
+    check(Cy_QiStack_Fsk_Tx_Queue_Push(&gl_ctx, &gl_ack, 1u, false, CY_QI_FSK_TX_PRIO_RESP) ==
+          CY_QISTACK_STAT_SUCCESS, "response priority has room");
+    check(Cy_QiStack_Fsk_Tx_Queue_Push(&gl_ctx, gl_adt, 0u, true, CY_QI_FSK_TX_PRIO_DATA) ==
+          CY_QISTACK_STAT_BAD_PARAM, "empty entry rejected");
+    check(queue->overflowCnt == 1u, "overflow count");
+
+    printf("counters: %u missed windows, %u dropped entries, %u started\n", (unsigned)queue->missedCnt,
+           (unsigned)queue->overflowCnt, (unsigned)queue->startCnt);
+}
+
+int main(void)
+{
+    gl_ctx.ptrAppCbk = &gl_app;
+    gl_app.fsk_pwm_configure = app_fsk_pwm_configure;
+    gl_app.get_timestamp = app_get_timestamp;
+    gl_ctx.qiCommStat.fskOper.periodOpPwmCnt = BENCH_OP_PERIOD;
+    gl_ctx.qiCommStat.fskOper.periodModPwmCnt = BENCH_OP_PERIOD + CY_QI_FSK_RESOLUTION_DEPTH_1;
+    host_tcpwm.pwmPeriod = BENCH_OP_PERIOD;
+    host_tcpwm.pwmPeriodBuf = BENCH_OP_PERIOD;
+
+    run_priority();
+    run_counters();
+
+    return (gl_failCnt == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
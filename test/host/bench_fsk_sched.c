@@ -0,0 +1,449 @@
+/***************************************************************************//**
+* \file bench_fsk_sched.c
+* \version 2.0
+*
+* Host benchmark of the precompiled FSK edge schedule: bit exact timing of
+* patterns and frames on a model of the edge counter, and edge interrupt cost
+* of the schedule handler against a model of the per half bit library ISR at
+* all four CY_QI_FSK_RESOLUTION_DEPTH settings. Also checks that the edge
+* handler reads get_timestamp twice per interrupt with
+* CY_QI_FSK_SCHED_ISR_TIME_EN and not at all without.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_manager.h"
+#include "cy_qistack_utils.h"
+#include "host_clock.h"
+#include "host_tcpwm.h"
+
+#if (CY_QI_FSK_SCHED_EN == 0)
+#error "bench_fsk_sched needs CY_QI_FSK_SCHED_EN"
+#endif /* CY_QI_FSK_SCHED_EN */
+
+#define BENCH_CHECK_COUNT                           (2000u)
+#define BENCH_TIMING_FRAMES                         (2000u)
+
+/* Inverter edges per half bit. */
+#define BENCH_HALF_EDGES                            (1u << CY_QI_FSK_HALF_BIT_SHIFT)
+
+/* Operating frequency inverter period, in PWM clocks. */
+#define BENCH_OP_PERIOD                             (100u)
+
+/* Largest number of frequency changes in a frame, start included. */
+#define BENCH_CHANGE_MAX                            (CY_QI_FSK_SCHED_SIZE + 1u)
+
+/* Largest number of edge interrupts timed per depth. */
+#define BENCH_SAMPLE_MAX                            (BENCH_TIMING_FRAMES * CY_QI_FSK_DATA_SIZE * 22u)
+
+static cy_stc_qi_context_t gl_ctx;
+static cy_stc_qi_app_cbk_t gl_app;
+
+/* Inverter at the modulated frequency, as set through fsk_pwm_configure. */
+static bool gl_isMod;
+
+/* Frequency changes of the current frame: edge count and new state. */
+static uint32_t gl_chgEdge[BENCH_CHANGE_MAX];
+static bool gl_chgMod[BENCH_CHANGE_MAX];
+static uint32_t gl_chgCnt;
+
+static uint32_t gl_samples[BENCH_SAMPLE_MAX];
+
+/* get_timestamp calls, each one a tick later than the previous. */
+static uint32_t gl_tsCnt;
+
+static void app_fsk_pwm_configure(struct cy_stc_qi_context *qiCtx, bool isMod)
+{
+    (void)qiCtx;
+    gl_isMod = isMod;
+    host_tcpwm.pwmPeriod = isMod ? gl_ctx.qiCommStat.fskOper.periodModPwmCnt : BENCH_OP_PERIOD;
+}
+
+/* Frequency state as seen on the coil. */
+static bool inv_is_mod(void)
+{
+#if CY_QI_FSK_HW_SWAP_EN
+    return (host_tcpwm.pwmPeriod == gl_ctx.qiCommStat.fskOper.periodModPwmCnt);
+#else
+    return gl_isMod;
+#endif /* CY_QI_FSK_HW_SWAP_EN */
+}
+
+static void inv_record(uint32_t edge)
+{
+    bool isMod = inv_is_mod();
+
+    if ((gl_chgCnt == 0u) || (gl_chgMod[gl_chgCnt - 1u] != isMod))
+    {
+        if (gl_chgCnt < BENCH_CHANGE_MAX)
+        {
+            gl_chgEdge[gl_chgCnt] = edge;
+            gl_chgMod[gl_chgCnt] = isMod;
+        }
+        gl_chgCnt++;
+    }
+}
+
+static uint32_t app_get_timestamp(struct cy_stc_qi_context *qiCtx)
+{
+    (void)qiCtx;
+    gl_tsCnt++;
+
+    return gl_tsCnt;
+}
+
+/* Sends the built schedule edge by edge. Returns the edge that ended it. */
+static uint32_t send_frame(void)
+{
+    uint32_t edge = 0u;
+
+    gl_chgCnt = 0u;
+    (void)Cy_QiStack_Fsk_Sched_Start(&gl_ctx);
+    inv_record(0u);
+
+    while (host_tcpwm.cntRunning && (edge < (BENCH_CHANGE_MAX * 2u * BENCH_HALF_EDGES)))
+    {
+        edge++;
+        if (host_tcpwm_edge())
+        {
+            Cy_QiStack_Fsk_Sched_Edge_Handler(&gl_ctx);
+        }
+        inv_record(edge);
+    }
+
+    return edge;
+}
+
+/* Reads the bits back from the frequency changes, one sample per half bit. */
+static uint32_t read_bits(uint32_t end, uint8_t *bits, uint32_t size)
+{
+    uint32_t count = 0u;
+    uint32_t chg = 0u;
+    uint32_t half;
+    bool state = false;
+    bool prev = false;
+
+    for (half = 0u; (half * BENCH_HALF_EDGES) < end; half++)
+    {
+        while ((chg < gl_chgCnt) && (gl_chgEdge[chg] <= (half * BENCH_HALF_EDGES)))
+        {
+            state = gl_chgMod[chg];
+            chg++;
+        }
+
+        if ((half & 1u) != 0u)
+        {
+            if (count < size)
+            {
+                bits[count] = (state != prev) ? 1u : 0u;
+            }
+            count++;
+        }
+        else if ((half != 0u) && (state == prev))
+        {
+            /* Every bit starts with a change. */
+            return 0u;
+        }
+        else
+        {
+            /* Bit start. */
+        }
+        prev = state;
+    }
+
+    return count;
+}
+
+/* Expected bits: frames as 11-bit characters, patterns MSB first. */
+static uint32_t expect_bits(const uint8_t *data, uint8_t len, bool frame, uint8_t *bits)
+{
+    uint32_t count = 0u;
+    uint8_t idx;
+    uint8_t bit;
+
+    for (idx = 0u; idx < len; idx++)
+    {
+        if (frame)
+        {
+            bits[count++] = 0u;
+            for (bit = 0u; bit < 8u; bit++)
+            {
+                bits[count++] = (uint8_t)((data[idx] >> bit) & 0x01u);
+            }
+            bits[count++] = cy_get_odd_parity(data[idx]) ? 1u : 0u;
+            bits[count++] = 1u;
+        }
+        else
+        {
+            for (bit = 8u; bit != 0u; bit--)
+            {
+                bits[count++] = (uint8_t)((data[idx] >> (bit - 1u)) & 0x01u);
+            }
+        }
+    }
+
+    return count;
+}
+
+/*
+ * Random patterns and frames sent on the edge counter model. Every bit must
+ * read back, every bit must last exactly two half bits and the frame must end
+ * on the operating frequency.
+ */
+static int run_check(void)
+{
+    const cy_stc_qi_fsk_isr_stats_t *stats;
+    uint8_t data[CY_QI_FSK_DATA_SIZE];
+    uint8_t expBits[CY_QI_FSK_SCHED_SIZE];
+    uint8_t gotBits[CY_QI_FSK_SCHED_SIZE];
+    uint32_t seed = 11u;
+    uint32_t failCnt = 0u;
+    uint32_t expCnt;
+    uint32_t gotCnt;
+    uint32_t end;
+    uint32_t idx;
+    uint8_t len;
+    uint8_t pos;
+    bool frame;
+
+    for (idx = 0u; idx < BENCH_CHECK_COUNT; idx++)
+    {
+        frame = ((idx & 1u) != 0u);
+        len = frame ? (uint8_t)(1u + (host_rand(&seed) % CY_QI_FSK_DATA_SIZE)) : 1u;
+        for (pos = 0u; pos < len; pos++)
+        {
+            data[pos] = (uint8_t)host_rand(&seed);
+        }
+
+        if (Cy_QiStack_Fsk_Sched_Build(&gl_ctx.fskSched, data, len, frame) != CY_QISTACK_STAT_SUCCESS)
+        {
+            failCnt++;
+            continue;
+        }
+
+        end = send_frame();
+        expCnt = expect_bits(data, len, frame, expBits);
+        gotCnt = read_bits(end, gotBits, (uint32_t)sizeof(gotBits));
+
+        if ((gotCnt != expCnt) || (memcmp(gotBits, expBits, expCnt) != 0) ||
+            (end != (expCnt * 2u * BENCH_HALF_EDGES)) || inv_is_mod() ||
+            (!gl_ctx.qiCommStat.fskCfg.pktDone))
+        {
+            if (failCnt < 5u)
+            {
+                printf("  %s %u: %u of %u bits, end at edge %u\n", frame ? "frame" : "pattern",
+                       (unsigned)idx, (unsigned)gotCnt, (unsigned)expCnt, (unsigned)end);
+            }
+            failCnt++;
+        }
+    }
+
+    printf("edge timing: %u patterns and frames, %u failed\n",
+           (unsigned)BENCH_CHECK_COUNT, (unsigned)failCnt);
+
+    /* Handler run time: one tick between the two reads of every interrupt. */
+    stats = &gl_ctx.fskSched.stats;
+    printf("edge handler: %u interrupts, %u timestamp reads, run time sum %u, max %u\n",
+           (unsigned)stats->irqCnt, (unsigned)gl_tsCnt, (unsigned)stats->isrTimeSum, (unsigned)stats->isrTimeMax);
+    if ((stats->irqCnt == 0u) ||
+        (gl_tsCnt != ((CY_QI_FSK_SCHED_ISR_TIME_EN != 0) ? (2u * stats->irqCnt) : 0u)) ||
+        (stats->isrTimeSum != ((CY_QI_FSK_SCHED_ISR_TIME_EN != 0) ? stats->irqCnt : 0u)) ||
+        (stats->isrTimeMax != ((CY_QI_FSK_SCHED_ISR_TIME_EN != 0) ? 1u : 0u)))
+    {
+        failCnt++;
+    }
+
+    return (failCnt == 0u) ? 0 : 1;
+}
+
+/*
+ * Model of the library edge ISR: one interrupt per half bit, the bit derived
+ * again from dataIndex and bitIndex every time.
+ */
+static __attribute__((noinline)) void legacy_isr(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_comm_fsk_oper_t *oper = &qiCtx->qiCommStat.fskOper;
+    uint8_t data = oper->data[oper->dataIndex];
+    bool bit;
+
+    if (!oper->frame)
+    {
+        bit = (((data >> (7u - oper->bitIndex)) & 0x01u) != 0u);
+    }
+    else if (oper->bitIndex == 0u)
+    {
+        bit = false;
+    }
+    else if (oper->bitIndex < 9u)
+    {
+        bit = (((data >> (oper->bitIndex - 1u)) & 0x01u) != 0u);
+    }
+    else if (oper->bitIndex == 9u)
+    {
+        bit = cy_get_odd_parity(data);
+    }
+    else
+    {
+        bit = true;
+    }
+
+    oper->changeFreq = (!oper->halfBit) || bit;
+    if (oper->changeFreq)
+    {
+        oper->isFreqMod = !oper->isFreqMod;
+        qiCtx->ptrAppCbk->fsk_pwm_configure(qiCtx, oper->isFreqMod);
+    }
+
+    if (!oper->halfBit)
+    {
+        oper->halfBit = true;
+        return;
+    }
+
+    oper->halfBit = false;
+    oper->bitIndex++;
+    if (oper->bitIndex >= (oper->frame ? 11u : 8u))
+    {
+        oper->bitIndex = 0u;
+        oper->dataIndex++;
+        if (oper->dataIndex >= oper->dataLen)
+        {
+            if (oper->isFreqMod)
+            {
+                oper->isFreqMod = false;
+                qiCtx->ptrAppCbk->fsk_pwm_configure(qiCtx, false);
+            }
+            oper->halfBitDone = true;
+            qiCtx->qiCommStat.fskCfg.pktDone = true;
+        }
+    }
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x < y) ? -1 : ((x > y) ? 1 : 0);
+}
+
+/* Per interrupt cost: mean and percentiles, spread as p99 - p1. */
+static void report(const char *name, uint32_t count, uint64_t total)
+{
+    uint32_t p1;
+    uint32_t p50;
+    uint32_t p99;
+
+    qsort(gl_samples, count, sizeof(gl_samples[0]), cmp_u32);
+    p1 = gl_samples[count / 100u];
+    p50 = gl_samples[count / 2u];
+    p99 = gl_samples[(count * 99u) / 100u];
+
+    printf("  %-9s irq/frame %3u  frame %6.0f  per irq: mean %5.1f  p50 %4u  p99 %4u  spread %4u\n",
+           name, (unsigned)(count / BENCH_TIMING_FRAMES), (double)total / BENCH_TIMING_FRAMES,
+           (double)total / count, (unsigned)p50, (unsigned)p99, (unsigned)(p99 - p1));
+}
+
+/* Edge interrupt cost of both handlers for a 10-byte frame. */
+static void run_timing(uint32_t depth)
+{
+    cy_stc_qi_comm_fsk_oper_t *oper = &gl_ctx.qiCommStat.fskOper;
+    uint8_t data[CY_QI_FSK_DATA_SIZE];
+    uint32_t seed = 5u;
+    uint32_t count;
+    uint32_t frame;
+    uint64_t total;
+    uint64_t start;
+    uint8_t idx;
+
+    for (idx = 0u; idx < CY_QI_FSK_DATA_SIZE; idx++)
+    {
+        data[idx] = (uint8_t)host_rand(&seed);
+    }
+    oper->periodModPwmCnt = BENCH_OP_PERIOD + depth;
+
+    count = 0u;
+    total = 0u;
+    for (frame = 0u; frame < BENCH_TIMING_FRAMES; frame++)
+    {
+        (void)memcpy(oper->data, data, sizeof(data));
+        oper->dataLen = CY_QI_FSK_DATA_SIZE;
+        oper->frame = true;
+        oper->dataIndex = 0u;
+        oper->bitIndex = 0u;
+        oper->halfBit = false;
+        oper->isFreqMod = false;
+        gl_ctx.qiCommStat.fskCfg.pktDone = false;
+
+        while ((!gl_ctx.qiCommStat.fskCfg.pktDone) && (count < BENCH_SAMPLE_MAX))
+        {
+            start = host_cycles();
+            legacy_isr(&gl_ctx);
+            gl_samples[count] = (uint32_t)(host_cycles() - start);
+            total += gl_samples[count];
+            count++;
+        }
+    }
+    report("per edge", count, total);
+
+    count = 0u;
+    total = 0u;
+    for (frame = 0u; frame < BENCH_TIMING_FRAMES; frame++)
+    {
+        (void)Cy_QiStack_Fsk_Sched_Build(&gl_ctx.fskSched, data, CY_QI_FSK_DATA_SIZE, true);
+        (void)Cy_QiStack_Fsk_Sched_Start(&gl_ctx);
+
+        while ((!gl_ctx.qiCommStat.fskCfg.pktDone) && (count < BENCH_SAMPLE_MAX))
+        {
+            start = host_cycles();
+            Cy_QiStack_Fsk_Sched_Edge_Handler(&gl_ctx);
+            gl_samples[count] = (uint32_t)(host_cycles() - start);
+            total += gl_samples[count];
+            count++;
+        }
+    }
+    report("schedule", count, total);
+}
+
+int main(void)
+{
+    static const uint32_t depths[] =
+    {
+        CY_QI_FSK_RESOLUTION_DEPTH_0, CY_QI_FSK_RESOLUTION_DEPTH_1,
+        CY_QI_FSK_RESOLUTION_DEPTH_2, CY_QI_FSK_RESOLUTION_DEPTH_3
+    };
+    uint8_t idx;
+    int result;
+
+    gl_ctx.ptrAppCbk = &gl_app;
+    gl_app.fsk_pwm_configure = app_fsk_pwm_configure;
+    gl_app.get_timestamp = app_get_timestamp;
+    gl_ctx.qiCommStat.fskOper.periodOpPwmCnt = BENCH_OP_PERIOD;
+    gl_ctx.qiCommStat.fskOper.periodModPwmCnt = BENCH_OP_PERIOD + CY_QI_FSK_RESOLUTION_DEPTH_1;
+    host_tcpwm.pwmPeriod = BENCH_OP_PERIOD;
+    host_tcpwm.pwmPeriodBuf = BENCH_OP_PERIOD;
+    host_tcpwm.swapOnTc = (CY_QI_FSK_HW_SWAP_EN != 0);
+
+    result = run_check();
+
+    printf("edge interrupt cost, 10 byte frame, %s:\n", HOST_CYCLES_UNIT);
+    for (idx = 0u; idx < (uint8_t)(sizeof(depths) / sizeof(depths[0])); idx++)
+    {
+        printf(" depth %u, modulated period +%u:\n", (unsigned)idx, (unsigned)depths[idx]);
+        run_timing(depths[idx]);
+    }
+
+    return result;
+}
+
+/* [] END OF FILE */
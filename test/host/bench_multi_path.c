@@ -0,0 +1,198 @@
+/***************************************************************************//**
+* \file bench_multi_path.c
+* \version 2.0
+*
+* Host check of the multi-path ASK demodulation: the same packet is received
+* on three paths with independent sample errors and the path decoders are fed
+* interleaved, as the SPI batches of concurrent paths would arrive. Checks the
+* checksum arbitration against each path decoded on its own and reports the
+* packet success rate per path and with all paths.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_bmc.h"
+#include "bmc_enc.h"
+#include "host_clock.h"
+
+#if (CY_QI_BMC_RX_MULTI_PATH_EN == 0)
+#error "bench_multi_path needs CY_QI_BMC_RX_MULTI_PATH_EN"
+#endif /* CY_QI_BMC_RX_MULTI_PATH_EN */
+
+#define BENCH_PKT_COUNT                             (20000u)
+
+/* Raw bytes fed to one path before the next path gets its turn. */
+#define BENCH_CHUNK_BYTES                           (2u)
+
+/* Percentage of waveforms with flipped samples, per path. */
+static const uint8_t gl_noisePct[CY_QI_MAX_NUM_ASK_SWITCH_OVER] = {60u, 40u, 50u};
+
+static const cy_en_qi_ask_path_t gl_pathSeq[CY_QI_MAX_NUM_ASK_SWITCH_OVER] =
+{
+    CY_QI_ASK_PATH_VOLT_H, CY_QI_ASK_PATH_CUR_H, CY_QI_ASK_PATH_VOLT_L
+};
+
+static cy_stc_qi_context_t gl_ctx;
+static uint32_t gl_evtCnt[CY_QI_ASK_EVT_PKT_READY + 1u];
+
+static cy_en_qi_status_t ask_pkt_evt(void *callbackContext, cy_en_qi_ask_pkt_evt_t pktEvt)
+{
+    (void)callbackContext;
+    if ((uint32_t)pktEvt < (sizeof(gl_evtCnt) / sizeof(gl_evtCnt[0])))
+    {
+        gl_evtCnt[pktEvt]++;
+    }
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+static bool pkt_ok(const cy_stc_qi_ask_pkt_t *out, const uint8_t *pkt, uint8_t len)
+{
+    return (out->header == pkt[0]) && (out->dataSize == (uint8_t)(len - 2u)) &&
+           (memcmp(out->msg, &pkt[1], out->dataSize) == 0);
+}
+
+/* Message bytes past dataSize are left over from earlier packets. */
+static bool pkt_same(const cy_stc_qi_ask_pkt_t *a, const cy_stc_qi_ask_pkt_t *b)
+{
+    return (a->header == b->header) && (a->checksum == b->checksum) && (a->dataSize == b->dataSize) &&
+           (memcmp(a->msg, b->msg, a->dataSize) == 0);
+}
+
+int main(void)
+{
+    static bmc_enc_t enc[CY_QI_MAX_NUM_ASK_SWITCH_OVER];
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &gl_ctx.qiCommStat.askBmc;
+    cy_stc_qi_ask_stats_t *stats = &gl_ctx.bmcLut.askStats;
+    uint8_t pkt[CY_QI_ASK_DATA_SIZE + 2u];
+    cy_stc_qi_bmc_lut_dec_t dec;
+    cy_stc_qi_ask_pkt_t solo[CY_QI_MAX_NUM_ASK_SWITCH_OVER];
+    bool soloReady[CY_QI_MAX_NUM_ASK_SWITCH_OVER];
+    uint32_t soloOkCnt[CY_QI_MAX_NUM_ASK_SWITCH_OVER] = {0u};
+    uint32_t winCnt[CY_QI_MAX_NUM_ASK_SWITCH_OVER] = {0u};
+    uint32_t evtCnt[CY_QI_ASK_EVT_PKT_READY + 1u];
+    uint32_t seed = 0x4004u;
+    uint32_t multiOkCnt = 0u;
+    uint32_t failCnt = 0u;
+    uint32_t flip;
+    uint32_t pos;
+    uint32_t off;
+    uint32_t pkts;
+    uint32_t bytes;
+    uint8_t path;
+    uint8_t len;
+    bool anyReady;
+    bool fed;
+
+    for (path = 0u; path < CY_QI_MAX_NUM_ASK_SWITCH_OVER; path++)
+    {
+        gl_ctx.qiCommStat.askCfg.askPathSeq[path] = gl_pathSeq[path];
+    }
+    askBmc->cy_cb_ask_pkt_evt = ask_pkt_evt;
+
+    for (pkts = 0u; pkts < BENCH_PKT_COUNT; pkts++)
+    {
+        len = bmc_enc_make_pkt(pkt, (uint8_t)host_rand(&seed), &seed);
+        anyReady = false;
+
+        for (path = 0u; path < CY_QI_MAX_NUM_ASK_SWITCH_OVER; path++)
+        {
+            bmc_enc_init(&enc[path], ((double)(host_rand(&seed) % 41u) - 20.0) / 1000.0,
+                         (double)(host_rand(&seed) % 7u) / 100.0, host_rand(&seed));
+            bmc_enc_frame(&enc[path], pkt, len, 12u);
+            if ((host_rand(&seed) % 100u) < gl_noisePct[path])
+            {
+                for (flip = 1u + (host_rand(&seed) % 3u); flip != 0u; flip--)
+                {
+                    pos = host_rand(&seed) % enc[path].bitCount;
+                    enc[path].buf[pos >> 3u] ^= (uint8_t)(1u << (pos & 7u));
+                }
+            }
+
+            bmc_rx_lut_init(&dec, &solo[path]);
+            soloReady[path] = (bmc_rx_lut_decode(&dec, enc[path].buf, (uint16_t)enc[path].bitCount) ==
+                               CY_QI_ASK_EVT_PKT_READY);
+            anyReady = anyReady || soloReady[path];
+            if (soloReady[path] && pkt_ok(&solo[path], pkt, len))
+            {
+                soloOkCnt[path]++;
+            }
+        }
+
+        (void)memset(gl_evtCnt, 0, sizeof(gl_evtCnt));
+        bmc_rx_lut_multi_rx_start(&gl_ctx);
+        fed = true;
+        for (off = 0u; fed && (!askBmc->isDataReady); off += BENCH_CHUNK_BYTES)
+        {
+            fed = false;
+            for (path = 0u; (path < CY_QI_MAX_NUM_ASK_SWITCH_OVER) && (!askBmc->isDataReady); path++)
+            {
+                bytes = (enc[path].bitCount + 7u) >> 3u;
+                if (off < bytes)
+                {
+                    pos = enc[path].bitCount - (off << 3u);
+                    bmc_rx_lut_multi_feed(&gl_ctx, path, &enc[path].buf[off],
+                                          (uint16_t)((pos < (BENCH_CHUNK_BYTES << 3u)) ? pos : (BENCH_CHUNK_BYTES << 3u)));
+                    fed = true;
+                }
+            }
+        }
+        if (!askBmc->isDataReady)
+        {
+            bmc_rx_lut_multi_flush(&gl_ctx);
+        }
+        (void)memcpy(evtCnt, gl_evtCnt, sizeof(evtCnt));
+
+        /* One final event, a packet if any path alone decodes one, from a path that does. */
+        if (((evtCnt[CY_QI_ASK_EVT_PKT_READY] + evtCnt[CY_QI_ASK_EVT_PKT_ERR]) != 1u) ||
+            (evtCnt[CY_QI_ASK_EVT_START_BIT] > 1u) ||
+            ((evtCnt[CY_QI_ASK_EVT_PKT_READY] != 0u) != anyReady) ||
+            (anyReady && ((gl_ctx.bmcLut.pathWinIdx >= CY_QI_MAX_NUM_ASK_SWITCH_OVER) ||
+                          (!soloReady[gl_ctx.bmcLut.pathWinIdx]) ||
+                          (!pkt_same(&askBmc->pkt, &solo[gl_ctx.bmcLut.pathWinIdx])))))
+        {
+            if (failCnt < 5u)
+            {
+                printf("  arbitration error at packet %u: %u ready, %u errors, winner %u\n", (unsigned)pkts,
+                       (unsigned)evtCnt[CY_QI_ASK_EVT_PKT_READY], (unsigned)evtCnt[CY_QI_ASK_EVT_PKT_ERR],
+                       (unsigned)gl_ctx.bmcLut.pathWinIdx);
+            }
+            failCnt++;
+        }
+
+        if (anyReady && (gl_ctx.bmcLut.pathWinIdx < CY_QI_MAX_NUM_ASK_SWITCH_OVER))
+        {
+            winCnt[gl_ctx.bmcLut.pathWinIdx]++;
+            if (pkt_ok(&askBmc->pkt, pkt, len))
+            {
+                multiOkCnt++;
+            }
+        }
+    }
+
+    printf("multi-path: %u packets, %u arbitration errors\n", (unsigned)BENCH_PKT_COUNT, (unsigned)failCnt);
+    for (path = 0u; path < CY_QI_MAX_NUM_ASK_SWITCH_OVER; path++)
+    {
+        printf("  path %u, %2u%% noisy: %5.1f%% decoded alone, %5u wins\n", (unsigned)path,
+               (unsigned)gl_noisePct[path], (100.0 * soloOkCnt[path]) / BENCH_PKT_COUNT, (unsigned)winCnt[path]);
+        if (stats->pathOkCnt[gl_pathSeq[path]] != winCnt[path])
+        {
+            printf("  path %u: pathOkCnt %u\n", (unsigned)path, (unsigned)stats->pathOkCnt[gl_pathSeq[path]]);
+            failCnt++;
+        }
+    }
+    printf("  all paths: %5.1f%% decoded\n", (100.0 * multiOkCnt) / BENCH_PKT_COUNT);
+
+    return (failCnt == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
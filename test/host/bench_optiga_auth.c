@@ -0,0 +1,577 @@
+/***************************************************************************//**
+* \file bench_optiga_auth.c
+* \version 2.0
+*
+* Host benchmark of the Qi authentication requests on the OPTIGA link: the
+* host IFX I2C master and pal on the OPTIGA model, in simulated time. Each
+* authentication is a GET_DIGEST, three GET_CERTIFICATE and a CHALLENGE,
+* answered with GetDataObject and CalcSign, or from the certificate cache.
+* A request the link fails is repeated, as the PRx does on a timeout. The
+* latency distribution comes from the CY_QI_AUTH_REQ_HIST_EN histograms, the
+* overhead and retries from the link counters.
+*
+* The number of authentications per run is taken from the command line.
+*
+* With CY_QI_AUTH_WARM_EN the warm session runs on the same device model,
+* through the host optiga_util and optiga_crypt: CHALLENGE latency on a warm
+* session, restored during the certificate exchange, restored at wake,
+* opened cold, and after a restore the device refuses, which must drop the
+* context and open clean.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_debug_monitor.h"
+#include "cy_qistack_auth_optiga.h"
+#include "pal_ifx_i2c_config.h"
+#include "host_clock.h"
+#include "host_ifx_i2c.h"
+#include "host_optiga.h"
+#include "host_optiga_util.h"
+#include "host_pal.h"
+
+#if ((CY_QI_AUTH_WARM_EN == 0) || (CCG_HPI_WLC_CMD_ENABLE == 0))
+#error "bench_optiga_auth needs CY_QI_AUTH_WARM_EN and CCG_HPI_WLC_CMD_ENABLE"
+#endif /* CY_QI_AUTH_WARM_EN, CCG_HPI_WLC_CMD_ENABLE */
+
+#define BENCH_AUTH_COUNT                            (2000u)
+#define BENCH_CHAIN_LEN                             (600u)
+#define BENCH_CERT_READS                            (3u)
+#define BENCH_CERT_LEN                              (BENCH_CHAIN_LEN / BENCH_CERT_READS)
+#define BENCH_DIGEST_LEN                            (32u)
+#define BENCH_OID_CHAIN                             (0xE0E0u)
+#define BENCH_OID_DIGEST                            (0xF1D0u)
+#define BENCH_SIGN_KEY_OID                          (0xE0F0u)
+#define BENCH_PRX_TRIES                             (4u)
+#define BENCH_SLOT                                  (0u)
+
+/* Session model: main loop period in us, and the digest and certificate exchange in ms. */
+#define BENCH_LOOP_US                               (1000u)
+#define BENCH_EXCHANGE_MS                           (200u)
+#define BENCH_SIGN_TIMEOUT_US                       (1000000u)
+
+typedef struct
+{
+    const char *name;
+    uint32_t berPpm;
+    bool cache;
+} bench_run_t;
+
+static const bench_run_t gl_run[] =
+{
+    { "no bit errors",             0u, false },
+    { "1e-4 bit errors",         100u, false },
+    { "1e-4 bit errors, cached", 100u, true  }
+};
+
+static const char *const gl_reqName[CY_QI_AUTH_REQ_HIST_MAX] =
+{
+    "GET_DIGEST", "GET_CERTIFICATE", "CHALLENGE"
+};
+
+/* Instances named by pal_ifx_i2c_config.h and ifx_i2c_config.h. */
+static host_pal_gpio_t gl_vddHw = { true, NULL, NULL };
+static host_pal_gpio_t gl_resetHw = { true, host_optiga_reset_pin, NULL };
+pal_i2c_t optiga_pal_i2c_context_0 = { NULL, IFX_I2C_BASE_ADDR, NULL, NULL };
+pal_gpio_t optiga_vdd_0 = { &gl_vddHw };
+pal_gpio_t optiga_reset_0 = { &gl_resetHw };
+ifx_i2c_context_t ifx_i2c_context_0;
+
+static cy_stc_qi_context_t gl_ctx;
+static cy_stc_qi_app_cbk_t gl_app;
+static uint8_t gl_chain[BENCH_CHAIN_LEN];
+static uint8_t gl_digest[WPC_CERTIFICATE_CHAIN_DIGEST_LENGTH];
+static uint8_t gl_rsp[HOST_OPTIGA_APDU_MAX];
+static uint16_t gl_rspLen;
+static volatile bool gl_xferDone;
+static optiga_lib_status_t gl_xferEvent;
+static uint32_t gl_prxRetryCnt;
+static bool gl_signDone;
+static bool gl_signOk;
+static uint16_t gl_sigLen;
+static uint32_t gl_signAt;
+
+static uint32_t app_get_timestamp(struct cy_stc_qi_context *qiCtx)
+{
+    (void)qiCtx;
+    return pal_os_timer_get_time_in_microseconds();
+}
+
+static void tl_event(struct ifx_i2c_context *p_ctx, optiga_lib_status_t event, const uint8_t *data,
+                     uint16_t data_len)
+{
+    (void)p_ctx;
+    (void)data;
+    (void)data_len;
+    gl_xferEvent = event;
+    gl_xferDone = true;
+}
+
+/* One command, with its response data in gl_rsp after the header. */
+static bool optiga_command(uint8_t *apdu, uint16_t len)
+{
+    gl_xferDone = false;
+    gl_rspLen = sizeof(gl_rsp);
+    if (ifx_i2c_tl_transceive(&ifx_i2c_context_0, apdu, len, gl_rsp, &gl_rspLen) != IFX_I2C_STACK_SUCCESS)
+    {
+        return false;
+    }
+    host_pal_run(&gl_xferDone);
+
+    return (gl_xferEvent == IFX_I2C_STACK_SUCCESS) && (gl_rspLen >= HOST_OPTIGA_APDU_HDR) &&
+           (gl_rsp[0] == HOST_OPTIGA_STA_SUCCESS);
+}
+
+static bool optiga_read(uint16_t oid, uint16_t off, uint16_t len)
+{
+    uint8_t apdu[HOST_OPTIGA_APDU_HDR + 6u] =
+    {
+        HOST_OPTIGA_CMD_GET_DATA_OBJECT, 0x00u, 0x00u, 0x06u,
+        (uint8_t)(oid >> 8u), (uint8_t)oid, (uint8_t)(off >> 8u), (uint8_t)off, (uint8_t)(len >> 8u), (uint8_t)len
+    };
+
+    return optiga_command(apdu, sizeof(apdu)) && (gl_rspLen == (HOST_OPTIGA_APDU_HDR + len));
+}
+
+static bool optiga_sign(const uint8_t *digest)
+{
+    uint8_t apdu[HOST_OPTIGA_APDU_HDR + 3u + BENCH_DIGEST_LEN + 5u] =
+    {
+        HOST_OPTIGA_CMD_CALC_SIGN, 0x11u, 0x00u, 3u + BENCH_DIGEST_LEN + 5u,
+        0x01u, 0x00u, BENCH_DIGEST_LEN
+    };
+    uint8_t *key = &apdu[HOST_OPTIGA_APDU_HDR + 3u + BENCH_DIGEST_LEN];
+
+    memcpy(&apdu[HOST_OPTIGA_APDU_HDR + 3u], digest, BENCH_DIGEST_LEN);
+    key[0] = 0x03u;
+    key[1] = 0x00u;
+    key[2] = 0x02u;
+    key[3] = (uint8_t)(BENCH_SIGN_KEY_OID >> 8u);
+    key[4] = (uint8_t)BENCH_SIGN_KEY_OID;
+
+    return optiga_command(apdu, sizeof(apdu)) && (gl_rspLen == (HOST_OPTIGA_APDU_HDR + HOST_OPTIGA_SIGN_LEN));
+}
+
+/* One request, repeated by the PRx until answered. Returns false if never. */
+static bool auth_request(uint8_t request, uint8_t idx, uint32_t auth, bool cache)
+{
+    uint8_t digest[BENCH_DIGEST_LEN];
+    uint8_t sig[HOST_OPTIGA_SIGN_LEN];
+    const uint8_t *data = NULL;
+    uint16_t len = BENCH_CERT_LEN;
+    uint8_t tries;
+    uint8_t pos;
+    bool ok = false;
+
+    for (pos = 0u; pos < BENCH_DIGEST_LEN; pos++)
+    {
+        digest[pos] = (uint8_t)(auth * 131u + pos);
+    }
+    host_optiga_sign(digest, BENCH_DIGEST_LEN, sig);
+
+    for (tries = 0u; (tries < BENCH_PRX_TRIES) && (!ok); tries++)
+    {
+        if (tries != 0u)
+        {
+            gl_prxRetryCnt++;
+        }
+        Cy_QiStack_Auth_Cache_Req_Start(&gl_ctx, request);
+
+        switch (request)
+        {
+            case GET_DIGEST:
+                if (cache)
+                {
+                    data = Cy_QiStack_Auth_Cache_Digest(BENCH_SLOT);
+                }
+                else if (optiga_read(BENCH_OID_DIGEST, 0u, WPC_CERTIFICATE_CHAIN_DIGEST_LENGTH))
+                {
+                    data = &gl_rsp[HOST_OPTIGA_APDU_HDR];
+                }
+                ok = (data != NULL) && (memcmp(data, gl_digest, WPC_CERTIFICATE_CHAIN_DIGEST_LENGTH) == 0);
+                break;
+            case GET_CERTIFICATE:
+                if (cache)
+                {
+                    data = Cy_QiStack_Auth_Cache_Cert(BENCH_SLOT, (uint16_t)(idx * BENCH_CERT_LEN), &len);
+                }
+                else if (optiga_read(BENCH_OID_CHAIN, (uint16_t)(idx * BENCH_CERT_LEN), BENCH_CERT_LEN))
+                {
+                    data = &gl_rsp[HOST_OPTIGA_APDU_HDR];
+                }
+                ok = (data != NULL) && (len == BENCH_CERT_LEN) &&
+                     (memcmp(data, &gl_chain[idx * BENCH_CERT_LEN], BENCH_CERT_LEN) == 0);
+                break;
+            default:
+                ok = optiga_sign(digest) &&
+                     (memcmp(&gl_rsp[HOST_OPTIGA_APDU_HDR], sig, HOST_OPTIGA_SIGN_LEN) == 0);
+                break;
+        }
+    }
+    if (ok)
+    {
+        Cy_QiStack_Auth_Cache_Req_Done(&gl_ctx, cache && (request != CHALLENGE));
+    }
+
+    return ok;
+}
+
+static void print_hist(const cy_stc_qi_auth_req_hist_t *hist, const char *name)
+{
+    uint8_t bin;
+
+    printf("  %-15s %6u responses, %4u repeated, max %6u us, log2 us bins:", name,
+           (unsigned)hist->cnt, (unsigned)hist->retryCnt, (unsigned)hist->max);
+    for (bin = 0u; bin < AUTH_REQ_HIST_BINS; bin++)
+    {
+        if (hist->hist[bin] != 0u)
+        {
+            printf(" %u:%u", (unsigned)bin, (unsigned)hist->hist[bin]);
+        }
+    }
+    printf("\n");
+}
+
+static int bench_auth(const bench_run_t *run, uint32_t count)
+{
+    host_optiga_cfg_t cfg = { 20u, 60u, 1500u, 62000u, 70000u, 0u, 22u, 8000u, 4000u, 6000u };
+    cy_stc_qi_auth_req_hist_t hist[CY_QI_AUTH_REQ_HIST_MAX];
+    const host_ifx_i2c_stats_t *link = &host_ifx_i2c_stats;
+    const host_optiga_stats_t *dev = &host_optiga_stats;
+    uint64_t start;
+    uint64_t time;
+    uint32_t auth;
+    uint32_t sum;
+    uint32_t failCnt = 0u;
+    uint8_t idx;
+    uint8_t bin;
+    int result = 0;
+
+    cfg.berPpm = run->berPpm;
+    host_optiga_init(&cfg);
+    host_optiga_object(BENCH_OID_CHAIN, gl_chain, BENCH_CHAIN_LEN);
+    host_optiga_object(BENCH_OID_DIGEST, gl_digest, WPC_CERTIFICATE_CHAIN_DIGEST_LENGTH);
+
+    pal_gpio_set_low(&optiga_reset_0);
+    pal_os_timer_delay_in_milliseconds(1u);
+    pal_gpio_set_high(&optiga_reset_0);
+    (void)ifx_i2c_tl_init(&ifx_i2c_context_0, tl_event);
+
+    Cy_QiStack_Auth_Cache_Invalidate(BENCH_SLOT);
+    if (run->cache)
+    {
+        /* Filled at boot, from the secure element. */
+        if ((!optiga_read(BENCH_OID_DIGEST, 0u, WPC_CERTIFICATE_CHAIN_DIGEST_LENGTH)) ||
+            (Cy_QiStack_Auth_Cache_Fill(BENCH_SLOT, &gl_rsp[HOST_OPTIGA_APDU_HDR], gl_chain, BENCH_CHAIN_LEN) !=
+             CY_QISTACK_STAT_SUCCESS))
+        {
+            printf("%s: cache fill failed\n", run->name);
+            return 1;
+        }
+    }
+
+    memset(&host_pal_stats, 0, sizeof(host_pal_stats));
+    memset(&host_optiga_stats, 0, sizeof(host_optiga_stats));
+    memset(&host_ifx_i2c_stats, 0, sizeof(host_ifx_i2c_stats));
+    Cy_QiStack_Clear_Auth_Req_Hist(&gl_ctx);
+    gl_prxRetryCnt = 0u;
+    start = host_pal_time_ns();
+
+    for (auth = 0u; auth < count; auth++)
+    {
+        if (!auth_request(GET_DIGEST, 0u, auth, run->cache))
+        {
+            failCnt++;
+        }
+        for (idx = 0u; idx < BENCH_CERT_READS; idx++)
+        {
+            if (!auth_request(GET_CERTIFICATE, idx, auth, run->cache))
+            {
+                failCnt++;
+            }
+        }
+        if (!auth_request(CHALLENGE, 0u, auth, run->cache))
+        {
+            failCnt++;
+        }
+    }
+    time = host_pal_time_ns() - start;
+    Cy_QiStack_Get_Auth_Req_Hist(&gl_ctx, (uint8_t *)hist);
+
+    printf("%s: %u authentications, %u failed requests, %u requests repeated by the PRx\n",
+           run->name, (unsigned)count, (unsigned)failCnt, (unsigned)gl_prxRetryCnt);
+    printf("  link: %u commands, %u frames written, %u read, %.2f bus bytes per command and response byte\n",
+           (unsigned)link->xferCnt, (unsigned)link->txFrameCnt, (unsigned)link->rxFrameCnt,
+           (link->apduByteCnt != 0u) ? ((double)host_pal_stats.byteCnt / (double)link->apduByteCnt) : 0.0);
+    printf("  retries: %u bit errors, %u bad FCS at the device, %u NAKs sent, %u frames resent, "
+           "%u resyncs, %u NACK retries, %u state polls\n",
+           (unsigned)dev->bitErrCnt, (unsigned)dev->fcsErrCnt, (unsigned)link->nakCnt,
+           (unsigned)link->resendCnt, (unsigned)link->resyncCnt, (unsigned)link->nackRetryCnt,
+           (unsigned)link->pollCnt);
+    printf("  ms per authentication: %.2f total, %.2f device execution, %.2f bus, %.2f frames ready unread\n",
+           (double)time / (1e6 * count), (double)dev->execNs / (1e6 * count),
+           (double)host_pal_stats.busNs / (1e6 * count), (double)dev->readyWaitNs / (1e6 * count));
+    for (idx = 0u; idx < CY_QI_AUTH_REQ_HIST_MAX; idx++)
+    {
+        print_hist(&hist[idx], gl_reqName[idx]);
+    }
+
+    /* Every request answered, each response in its histogram. */
+    for (idx = 0u; idx < CY_QI_AUTH_REQ_HIST_MAX; idx++)
+    {
+        sum = 0u;
+        for (bin = 0u; bin < AUTH_REQ_HIST_BINS; bin++)
+        {
+            sum += hist[idx].hist[bin];
+        }
+        if ((sum != hist[idx].cnt) ||
+            (hist[idx].cnt != (count * ((idx == CY_QI_AUTH_REQ_HIST_CERTIFICATE) ? BENCH_CERT_READS : 1u))))
+        {
+            printf("  %s histogram does not hold every response\n", gl_reqName[idx]);
+            result = 1;
+        }
+    }
+    if (failCnt != 0u)
+    {
+        result = 1;
+    }
+    if ((run->berPpm == 0u) &&
+        ((dev->bitErrCnt | link->nakCnt | link->resendCnt | link->resyncCnt | gl_prxRetryCnt) != 0u))
+    {
+        printf("  retries without bit errors\n");
+        result = 1;
+    }
+    if ((run->berPpm != 0u) && ((dev->bitErrCnt == 0u) || ((link->nakCnt + dev->nakTxCnt) == 0u)))
+    {
+        printf("  bit errors were not injected or not detected\n");
+        result = 1;
+    }
+    if (run->cache && ((hist[CY_QI_AUTH_REQ_HIST_DIGEST].max | hist[CY_QI_AUTH_REQ_HIST_CERTIFICATE].max) != 0u))
+    {
+        printf("  cached requests went to the secure element\n");
+        result = 1;
+    }
+
+    return result;
+}
+
+static void session_sign_done(cy_stc_qi_context_t *qiCtx, bool success, uint16_t sigLen)
+{
+    gl_signDone = true;
+    gl_signOk = success;
+    gl_sigLen = sigLen;
+    gl_signAt = app_get_timestamp(qiCtx);
+}
+
+/* One main loop pass: the OPTIGA operation queued, the session task, then the loop period. */
+static void session_loop(void)
+{
+    host_optiga_util_run();
+    Cy_QiStack_Auth_Session_Task(&gl_ctx);
+    host_pal_wait_us(BENCH_LOOP_US);
+}
+
+/* Loops until no OPTIGA operation is in flight. */
+static void session_settle(void)
+{
+    uint32_t loops;
+
+    for (loops = 0u; (loops < 1000u) && (!Cy_QiStack_Auth_Session_Is_Sleep_Allowed()); loops++)
+    {
+        session_loop();
+    }
+}
+
+static bool session_hibernate(void)
+{
+    if (Cy_QiStack_Auth_Session_Hibernate(&gl_ctx) != CY_QISTACK_STAT_SUCCESS)
+    {
+        return false;
+    }
+    session_settle();
+
+    return (Cy_QiStack_Auth_Session_State() == CY_QI_AUTH_SESSION_HIBERNATED);
+}
+
+/*
+ * One authentication from wake: Auth_Start, the exchange for exchangeMs, then
+ * the CHALLENGE. Returns its latency in us, or 0 if the signature is wrong.
+ */
+static uint32_t session_auth(uint32_t exchangeMs, uint32_t auth)
+{
+    uint8_t digest[BENCH_DIGEST_LEN];
+    uint8_t ref[HOST_OPTIGA_SIGN_LEN];
+    uint8_t sig[HOST_OPTIGA_SIGN_LEN];
+    uint32_t start;
+    uint8_t pos;
+
+    for (pos = 0u; pos < BENCH_DIGEST_LEN; pos++)
+    {
+        digest[pos] = (uint8_t)(auth * 53u + pos);
+    }
+    host_optiga_sign(digest, BENCH_DIGEST_LEN, ref);
+
+    Cy_QiStack_Auth_Session_Auth_Start(&gl_ctx);
+    start = app_get_timestamp(&gl_ctx);
+    while ((app_get_timestamp(&gl_ctx) - start) < (exchangeMs * 1000u))
+    {
+        session_loop();
+    }
+
+    gl_signDone = false;
+    start = app_get_timestamp(&gl_ctx);
+    if (Cy_QiStack_Auth_Session_Sign(&gl_ctx, digest, BENCH_DIGEST_LEN, sig, (uint16_t)sizeof(sig),
+                                     session_sign_done) != CY_QISTACK_STAT_SUCCESS)
+    {
+        return 0u;
+    }
+    while ((!gl_signDone) && ((app_get_timestamp(&gl_ctx) - start) < BENCH_SIGN_TIMEOUT_US))
+    {
+        session_loop();
+    }
+
+    return (gl_signDone && gl_signOk && (gl_sigLen == HOST_OPTIGA_SIGN_LEN) &&
+            (memcmp(sig, ref, HOST_OPTIGA_SIGN_LEN) == 0)) ? (gl_signAt - start) : 0u;
+}
+
+static int bench_session(void)
+{
+    host_optiga_cfg_t cfg = { 20u, 60u, 1500u, 62000u, 62000u, 0u, 24u, 8000u, 4000u, 6000u };
+    cy_stc_qi_auth_session_stats_t stats;
+    uint8_t handle[APP_CONTEXT_SIZE] = { 0u };
+    uint16_t len = APP_CONTEXT_SIZE;
+    uint32_t warm;
+    uint32_t early;
+    uint32_t wake;
+    uint32_t cold;
+    uint32_t refused;
+    uint32_t again;
+    int result = 0;
+
+    host_optiga_init(&cfg);
+
+    /* Boot: nothing stored, a clean open. */
+    if ((Cy_QiStack_Auth_Session_Init(&gl_ctx) != CY_QISTACK_STAT_SUCCESS) ||
+        (Cy_QiStack_Auth_Session_Hibernate(&gl_ctx) != CY_QISTACK_STAT_FAILURE))
+    {
+        printf("session: init failed, or hibernate accepted during the open\n");
+        return 1;
+    }
+    session_settle();
+
+    warm = session_auth(BENCH_EXCHANGE_MS, 0u);
+
+    /* Restored under the exchange, then at wake with the CHALLENGE. */
+    early = session_hibernate() ? session_auth(BENCH_EXCHANGE_MS, 1u) : 0u;
+    wake = session_hibernate() ? session_auth(0u, 2u) : 0u;
+
+    /* Nothing stored: the open is clean, with the link brought up. */
+    cold = 0u;
+    if (session_hibernate())
+    {
+        (void)pal_os_datastore_write(OPTIGA_HIBERNATE_CONTEXT_ID, handle, APP_CONTEXT_SIZE);
+        cold = session_auth(0u, 3u);
+    }
+
+    /* The device lost the context: the restore is refused, then a clean open. */
+    refused = 0u;
+    if (session_hibernate())
+    {
+        host_optiga_forget();
+        refused = session_auth(0u, 4u);
+    }
+    again = session_auth(BENCH_EXCHANGE_MS, 5u);
+
+    Cy_QiStack_Get_Auth_Session_Stats(&gl_ctx, (uint8_t *)&stats);
+    (void)pal_os_datastore_read(OPTIGA_HIBERNATE_CONTEXT_ID, handle, &len);
+
+    printf("session: CHALLENGE %.1f ms warm, %.1f restored during the exchange, %.1f restored at wake, "
+           "%.1f opened cold, %.1f after a refused restore\n",
+           warm / 1000.0, early / 1000.0, wake / 1000.0, cold / 1000.0, refused / 1000.0);
+    printf("  %u opens, %u restores, %u refused, %u hibernates, %u cold signatures, %u link power ups, "
+           "last open %.1f ms\n", (unsigned)stats.openCnt, (unsigned)stats.restoreCnt,
+           (unsigned)stats.restoreErrCnt, (unsigned)stats.hibernateCnt, (unsigned)stats.coldSignCnt,
+           (unsigned)host_optiga_util_stats.linkUpCnt, stats.openTime / 1000.0);
+
+    if ((warm == 0u) || (early == 0u) || (wake == 0u) || (cold == 0u) || (refused == 0u) || (again == 0u))
+    {
+        printf("  a signature failed or was wrong\n");
+        result = 1;
+    }
+    /* Within a loop period of each other: the restore is hidden by the exchange. */
+    if ((early > (warm + BENCH_LOOP_US)) || (again > (warm + BENCH_LOOP_US)))
+    {
+        printf("  restored or reopened session slower than warm\n");
+        result = 1;
+    }
+    if ((wake <= warm) || (cold <= wake) || (refused <= cold))
+    {
+        printf("  latency order is not warm < restored at wake < cold < refused restore\n");
+        result = 1;
+    }
+    if ((stats.openCnt != 3u) || (stats.restoreCnt != 2u) || (stats.restoreErrCnt != 1u) ||
+        (stats.hibernateCnt != 4u) || (stats.coldSignCnt != 3u) || (stats.signCnt != 6u) ||
+        (stats.errCnt != 1u))
+    {
+        printf("  session counters\n");
+        result = 1;
+    }
+    if ((handle[0] | handle[APP_CONTEXT_SIZE - 1u]) != 0u)
+    {
+        printf("  refused context left in the datastore\n");
+        result = 1;
+    }
+
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t count = BENCH_AUTH_COUNT;
+    uint32_t seed = 25u;
+    uint32_t idx;
+    int result = 0;
+
+    if (argc > 1)
+    {
+        count = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+    for (idx = 0u; idx < BENCH_CHAIN_LEN; idx++)
+    {
+        gl_chain[idx] = (uint8_t)host_rand(&seed);
+    }
+    for (idx = 0u; idx < WPC_CERTIFICATE_CHAIN_DIGEST_LENGTH; idx++)
+    {
+        gl_digest[idx] = (uint8_t)host_rand(&seed);
+    }
+
+    gl_ctx.ptrAppCbk = &gl_app;
+    gl_app.get_timestamp = app_get_timestamp;
+    ifx_i2c_context_0.p_pal_i2c_ctx = &optiga_pal_i2c_context_0;
+    ifx_i2c_context_0.p_slave_vdd_pin = &optiga_vdd_0;
+    ifx_i2c_context_0.p_slave_reset_pin = &optiga_reset_0;
+    ifx_i2c_context_0.slave_address = IFX_I2C_BASE_ADDR;
+    host_pal_i2c_attach(&host_optiga_dev);
+    (void)pal_init();
+
+    for (idx = 0u; idx < (sizeof(gl_run) / sizeof(gl_run[0])); idx++)
+    {
+        result |= bench_auth(&gl_run[idx], count);
+    }
+    result |= bench_session();
+
+    return result;
+}
+
+/* [] END OF FILE */
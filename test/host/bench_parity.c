@@ -0,0 +1,278 @@
+/***************************************************************************//**
+* \file bench_parity.c
+* \version 2.0
+*
+* Host benchmark of the parity and checksum checks: CY_QI_ODD_PARITY against
+* cy_get_odd_parity, the checksum verdict of the table driven decoder against
+* cy_calc_checksum, and the decoder timed with and without the separate
+* parity and checksum pass its running checks replace.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_bmc.h"
+#include "cy_qistack_utils.h"
+#include "bmc_enc.h"
+#include "host_clock.h"
+
+#define BENCH_PKT_COUNT                             (20000u)
+#define BENCH_PARITY_LOOPS                          (100000u)
+#define BENCH_TIMING_LOOPS                          (200u)
+#define BENCH_TIMING_RUNS                           (7u)
+
+/* Packets of random length decoded per timing loop. */
+#define BENCH_TIMING_PKTS                           (64u)
+
+/* Keeps the parity under test out of line, as the library function is. */
+static __attribute__((noinline)) bool par_table(uint8_t data)
+{
+    return CY_QI_ODD_PARITY(data);
+}
+
+/* Both parity functions on all bytes, and their cost per byte. */
+static int run_parity(void)
+{
+    volatile uint32_t sink = 0u;
+    uint64_t start;
+    uint64_t loopTime;
+    uint64_t tblTime;
+    uint32_t loop;
+    uint32_t data;
+    uint32_t failCnt = 0u;
+
+    for (data = 0u; data < 256u; data++)
+    {
+        if ((par_table((uint8_t)data) != cy_get_odd_parity((uint8_t)data)) ||
+            (par_table((uint8_t)data) != ((__builtin_popcount(data) & 1) == 0)))
+        {
+            failCnt++;
+        }
+    }
+
+    start = host_cycles();
+    for (loop = 0u; loop < BENCH_PARITY_LOOPS; loop++)
+    {
+        for (data = 0u; data < 256u; data++)
+        {
+            sink += (uint32_t)cy_get_odd_parity((uint8_t)(data ^ loop));
+        }
+    }
+    loopTime = host_cycles() - start;
+
+    start = host_cycles();
+    for (loop = 0u; loop < BENCH_PARITY_LOOPS; loop++)
+    {
+        for (data = 0u; data < 256u; data++)
+        {
+            sink += (uint32_t)par_table((uint8_t)(data ^ loop));
+        }
+    }
+    tblTime = host_cycles() - start;
+    (void)sink;
+
+    printf("parity: %u mismatches over 256 bytes, %s per byte: shift loop %.2f, nibble table %.2f\n",
+           (unsigned)failCnt, HOST_CYCLES_UNIT,
+           (double)loopTime / (BENCH_PARITY_LOOPS * 256.0),
+           (double)tblTime / (BENCH_PARITY_LOOPS * 256.0));
+
+    return (failCnt == 0u) ? 0 : 1;
+}
+
+/*
+ * Packets with a good or a corrupted checksum byte. The running checksum of
+ * the decoder must give the same verdict as cy_calc_checksum over the
+ * received bytes, and the fail reason must name the checksum.
+ */
+static int run_checksum(void)
+{
+    static bmc_enc_t enc;
+    uint8_t pkt[CY_QI_ASK_DATA_SIZE + 2u];
+    cy_stc_qi_bmc_lut_dec_t dec;
+    cy_stc_qi_ask_pkt_t out;
+    cy_en_qi_ask_pkt_evt_t evt;
+    uint32_t seed = 0x0DDu;
+    uint32_t failCnt = 0u;
+    uint32_t badCnt = 0u;
+    uint32_t idx;
+    uint8_t chk;
+    uint8_t len;
+    bool bad;
+
+    for (idx = 0u; idx < BENCH_PKT_COUNT; idx++)
+    {
+        len = bmc_enc_make_pkt(pkt, (uint8_t)host_rand(&seed), &seed);
+        bad = ((idx & 1u) != 0u);
+        if (bad)
+        {
+            pkt[len - 1u] ^= (uint8_t)(1u + (host_rand(&seed) % 255u));
+            badCnt++;
+        }
+
+        bmc_enc_init(&enc, 0.0, 0.04, host_rand(&seed));
+        bmc_enc_frame(&enc, pkt, len, 12u);
+
+        (void)memset(&out, 0, sizeof(out));
+        bmc_rx_lut_init(&dec, &out);
+        evt = bmc_rx_lut_decode(&dec, enc.buf, (uint16_t)enc.bitCount);
+
+        (void)cy_calc_checksum(pkt, (uint8_t)(len - 1u), &chk);
+        if ((chk != pkt[len - 1u]) != bad)
+        {
+            /* The test packet itself is wrong. */
+            failCnt++;
+        }
+        else if (bad)
+        {
+            if ((evt != CY_QI_ASK_EVT_PKT_ERR) || (dec.failRs != CY_QI_ASK_FAIL_RS_BAD_CHECKSUM))
+            {
+                failCnt++;
+            }
+        }
+        else if ((evt != CY_QI_ASK_EVT_PKT_READY) || (out.checksum != chk))
+        {
+            failCnt++;
+        }
+        else
+        {
+            /* Decoded as sent. */
+        }
+    }
+
+    printf("checksum: %u packets, %u with a bad checksum, %u wrong verdicts\n",
+           (unsigned)BENCH_PKT_COUNT, (unsigned)badCnt, (unsigned)failCnt);
+
+    return (failCnt == 0u) ? 0 : 1;
+}
+
+/*
+ * Separate checks over a decoded packet, as made before the decoder kept its
+ * running parity and checksum: the parity of every byte, for comparison with
+ * its parity bit, then a checksum pass. Header and message are contiguous in
+ * cy_stc_qi_ask_pkt_t. Returns the parity bits, sets ok to the checksum
+ * verdict.
+ */
+static __attribute__((noinline)) uint32_t check_pass(cy_stc_qi_ask_pkt_t *out, bool *ok)
+{
+    uint8_t *data = &out->header;
+    uint32_t par = (uint32_t)cy_get_odd_parity(out->checksum);
+    uint8_t chk;
+    uint8_t idx;
+
+    for (idx = 0u; idx <= out->dataSize; idx++)
+    {
+        par = (par << 1u) | (uint32_t)cy_get_odd_parity(data[idx]);
+    }
+    (void)cy_calc_checksum(data, (uint8_t)(out->dataSize + 1u), &chk);
+    *ok = (chk == out->checksum);
+
+    return par;
+}
+
+/* Decodes every timing packet, with or without the separate pass. */
+static uint64_t time_decode(const bmc_enc_t *enc, bool pass)
+{
+    cy_stc_qi_bmc_lut_dec_t dec;
+    cy_stc_qi_ask_pkt_t out;
+    volatile uint32_t sink = 0u;
+    uint64_t start;
+    uint32_t loop;
+    uint32_t idx;
+    bool ok;
+
+    start = host_cycles();
+    for (loop = 0u; loop < BENCH_TIMING_LOOPS; loop++)
+    {
+        for (idx = 0u; idx < BENCH_TIMING_PKTS; idx++)
+        {
+            bmc_rx_lut_init(&dec, &out);
+            sink += (uint32_t)bmc_rx_lut_decode(&dec, enc[idx].buf, (uint16_t)enc[idx].bitCount);
+            if (pass)
+            {
+                sink += check_pass(&out, &ok) + (uint32_t)ok;
+            }
+        }
+    }
+    (void)sink;
+
+    return host_cycles() - start;
+}
+
+/*
+ * The same packets decoded with the running checks alone, and followed by
+ * the separate parity and checksum pass they replace. Best of several
+ * alternating runs.
+ */
+static int run_timing(void)
+{
+    static bmc_enc_t enc[BENCH_TIMING_PKTS];
+    uint8_t pkt[CY_QI_ASK_DATA_SIZE + 2u];
+    cy_stc_qi_bmc_lut_dec_t dec;
+    cy_stc_qi_ask_pkt_t out;
+    uint32_t seed = 3u;
+    uint32_t bytes = 0u;
+    uint32_t failCnt = 0u;
+    uint64_t fusedTime = UINT64_MAX;
+    uint64_t passTime = UINT64_MAX;
+    uint64_t time;
+    uint32_t run;
+    uint32_t idx;
+    uint8_t len;
+    bool ok;
+
+    for (idx = 0u; idx < BENCH_TIMING_PKTS; idx++)
+    {
+        len = bmc_enc_make_pkt(pkt, (uint8_t)host_rand(&seed), &seed);
+        bytes += len;
+        bmc_enc_init(&enc[idx], 0.0, 0.04, host_rand(&seed));
+        bmc_enc_frame(&enc[idx], pkt, len, 12u);
+
+        bmc_rx_lut_init(&dec, &out);
+        if (bmc_rx_lut_decode(&dec, enc[idx].buf, (uint16_t)enc[idx].bitCount) != CY_QI_ASK_EVT_PKT_READY)
+        {
+            failCnt++;
+        }
+        (void)check_pass(&out, &ok);
+        if (!ok)
+        {
+            failCnt++;
+        }
+    }
+
+    for (run = 0u; run < BENCH_TIMING_RUNS; run++)
+    {
+        time = time_decode(enc, false);
+        fusedTime = (time < fusedTime) ? time : fusedTime;
+        time = time_decode(enc, true);
+        passTime = (time < passTime) ? time : passTime;
+    }
+
+    printf("%u packets, %.1f bytes each, %s per packet: running checks %.0f, with separate pass %.0f (+%.1f%%)\n",
+           (unsigned)BENCH_TIMING_PKTS, (double)bytes / BENCH_TIMING_PKTS, HOST_CYCLES_UNIT,
+           (double)fusedTime / (BENCH_TIMING_LOOPS * BENCH_TIMING_PKTS),
+           (double)passTime / (BENCH_TIMING_LOOPS * BENCH_TIMING_PKTS),
+           (100.0 * ((double)passTime - (double)fusedTime)) / (double)fusedTime);
+
+    return (failCnt == 0u) ? 0 : 1;
+}
+
+int main(void)
+{
+    int result;
+
+    result = run_parity();
+    result |= run_checksum();
+    result |= run_timing();
+
+    return result;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,333 @@
+/***************************************************************************//**
+* \file bench_task_evt.c
+* \version 2.0
+*
+* Host check and cycle count of the event driven stack task. The layer tasks
+* and Cy_QiStack_Task of the prebuilt libraries are modelled here as scans of
+* the context flags they poll. The checks cover the full pass on policy and
+* timer events, the layer pass on packet events, the events kept when a layer
+* fails, and the packet event posted by the ASK receiver for good and failed
+* receptions. The cycle count compares the polled and the event driven main
+* loop while idle and in power transfer.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_pm.h"
+#include "cy_qistack_comm_bmc.h"
+#include "cy_qistack_comm_manager.h"
+#include "cy_qistack_object_manager.h"
+#include "cy_qistack_power_manager.h"
+#include "bmc_enc.h"
+#include "host_clock.h"
+
+#if (CY_QI_TASK_EVT_EN == 0)
+#error "bench_task_evt needs CY_QI_TASK_EVT_EN"
+#endif /* CY_QI_TASK_EVT_EN */
+
+/* Main loop passes per timed run. */
+#define BENCH_PASS_COUNT                            (2000000u)
+
+/* Timed runs per loop, the fastest one is reported. */
+#define BENCH_RUN_COUNT                             (5u)
+
+/* Power transfer: one packet interrupt every 20 to 200 passes. */
+#define BENCH_PT_GAP_MIN                            (20u)
+#define BENCH_PT_GAP_SPAN                           (181u)
+
+typedef enum
+{
+    BENCH_LAYER_COMM,
+    BENCH_LAYER_OBJECT,
+    BENCH_LAYER_POWER,
+    BENCH_LAYER_MAX
+} bench_layer_t;
+
+static cy_stc_qi_context_t gl_ctx;
+static cy_stc_qi_app_cbk_t gl_app;
+static uint32_t gl_layerCnt[BENCH_LAYER_MAX];
+static cy_en_qi_status_t gl_layerStatus[BENCH_LAYER_MAX];
+static uint32_t gl_fullCnt;
+static uint32_t gl_failCnt;
+static const bmc_enc_t *gl_enc;
+static uint32_t gl_encPos;
+
+uint32_t Cy_SCB_SPI_GetNumInRxFifo(CySCB_Type const *base)
+{
+    uint32_t left = (gl_enc->bitCount - gl_encPos) / CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE;
+
+    (void)base;
+    return (left > CY_QI_BMC_RX_SPI_FIFO_SIZE) ? CY_QI_BMC_RX_SPI_FIFO_SIZE : left;
+}
+
+uint32_t Cy_SCB_SPI_Read(CySCB_Type const *base)
+{
+    uint32_t word = gl_enc->buf[gl_encPos >> 3u];
+
+#if (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE > 8u)
+    word |= (uint32_t)gl_enc->buf[(gl_encPos >> 3u) + 1u] << 8u;
+#endif /* (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE > 8u) */
+    (void)base;
+    gl_encPos += CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE;
+
+    return word;
+}
+
+/* Reads a flag the way a library built separately would: from memory, every time. */
+static inline bool flag(const bool *ptr)
+{
+    return *(const volatile bool *)ptr;
+}
+
+/* Model of the library communication task: packet, transmission and timeout flags. */
+__attribute__((noinline)) cy_en_qi_status_t Cy_QiStack_Comm_Task(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_comm_ask_status_t *askCfg = &qiCtx->qiCommStat.askCfg;
+    cy_stc_qi_comm_fsk_status_t *fskCfg = &qiCtx->qiCommStat.fskCfg;
+
+    gl_layerCnt[BENCH_LAYER_COMM]++;
+    if (flag(&qiCtx->qiCommStat.askBmc.isDataReady))
+    {
+        qiCtx->qiCommStat.askBmc.isDataReady = false;
+        askCfg->askPktReady = true;
+    }
+    if (flag(&askCfg->askPktStart) || flag(&askCfg->askPathChanged) || flag(&askCfg->askStartPending) ||
+        flag(&askCfg->tNextTimeout) || flag(&askCfg->tNegTimeout) || flag(&askCfg->tTimerTimeout) ||
+        flag(&askCfg->tPowerTimeout) || flag(&askCfg->tPktAskSwitchTimeout) || flag(&askCfg->tPktTimeout) ||
+        flag(&fskCfg->updateParams) || flag(&fskCfg->pktDone))
+    {
+        fskCfg->pktDone = false;
+    }
+
+    return gl_layerStatus[BENCH_LAYER_COMM];
+}
+
+/* Model of the library object task: ping, object and FOD flags. */
+__attribute__((noinline)) cy_en_qi_status_t Cy_QiStack_Object_Task(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_status_t *qiStat = &qiCtx->qiStat;
+    cy_stc_qi_object_status_t *objStat = &qiCtx->qiObjectStat;
+
+    gl_layerCnt[BENCH_LAYER_OBJECT]++;
+    if (flag(&qiStat->anaPingPending) || flag(&qiStat->digPingPending) || flag(&qiStat->digPingWakePending) ||
+        flag(&qiStat->digIntervalTimeout) || flag(&qiStat->digtPingTimeout) ||
+        flag((const bool *)&qiStat->anaPingTimeout) || flag(&objStat->fod) || flag(&objStat->fodEptPending))
+    {
+        objStat->object = true;
+    }
+
+    return gl_layerStatus[BENCH_LAYER_OBJECT];
+}
+
+/* Model of the library power task: packet hand over and control loop flags. */
+__attribute__((noinline)) cy_en_qi_status_t Cy_QiStack_Power_Task(cy_stc_qi_context_t *qiCtx)
+{
+    cy_stc_qi_comm_ask_status_t *askCfg = &qiCtx->qiCommStat.askCfg;
+    cy_stc_qi_pid_t *pid = &qiCtx->qiPowerStat.pid;
+
+    gl_layerCnt[BENCH_LAYER_POWER]++;
+    if (flag(&askCfg->askPktReady))
+    {
+        askCfg->askPktReady = false;
+        pid->pidPending = true;
+    }
+    if (flag(&pid->pidPending) || flag(&pid->cepLow) || flag(&pid->cepHigh) || flag(&pid->pidSaturated))
+    {
+        pid->pidPending = false;
+    }
+
+    return gl_layerStatus[BENCH_LAYER_POWER];
+}
+
+/* Model of the library policy task: all layers on every call. */
+__attribute__((noinline)) cy_en_qi_status_t Cy_QiStack_Task(cy_stc_qi_context_t *qiCtx)
+{
+    gl_fullCnt++;
+    (void)Cy_QiStack_Comm_Task(qiCtx);
+    (void)Cy_QiStack_Object_Task(qiCtx);
+    (void)Cy_QiStack_Power_Task(qiCtx);
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+static void check(bool cond, const char *what)
+{
+    if (!cond)
+    {
+        printf("  failed: %s\n", what);
+        gl_failCnt++;
+    }
+}
+
+static void clear_counts(void)
+{
+    (void)memset(gl_layerCnt, 0, sizeof(gl_layerCnt));
+    gl_fullCnt = 0u;
+}
+
+/* True if the last passes ran each layer this many times and no full pass. */
+static bool layers_ran(uint32_t comm, uint32_t object, uint32_t power)
+{
+    return (gl_fullCnt == 0u) && (gl_layerCnt[BENCH_LAYER_COMM] == comm) &&
+           (gl_layerCnt[BENCH_LAYER_OBJECT] == object) && (gl_layerCnt[BENCH_LAYER_POWER] == power);
+}
+
+/* Receives one packet through the SCB FIFO handler, as the receive interrupt would. */
+static void rx_pkt(const uint8_t *pkt, uint8_t len)
+{
+    static bmc_enc_t enc;
+
+    bmc_enc_init(&enc, 0.0, 0.0, 1u);
+    bmc_enc_frame(&enc, pkt, len, 12u);
+    gl_enc = &enc;
+    gl_encPos = 0u;
+
+    bmc_rx_lut_rx_start(&gl_ctx);
+    while (Cy_SCB_SPI_GetNumInRxFifo(gl_ctx.qiCommStat.askBmc.scb) != 0u)
+    {
+        bmc_rx_lut_scb_fifo_handler(&gl_ctx);
+    }
+}
+
+static void run_events(void)
+{
+    uint32_t seed = 0x1505u;
+    uint8_t pkt[CY_QI_ASK_DATA_SIZE + 2u];
+    uint8_t len;
+
+    /* Init requests one full pass; nothing runs after it until an event is posted. */
+    Cy_QiStack_Evt_Init(&gl_ctx);
+    clear_counts();
+    check(Cy_QiStack_Evt_Task(&gl_ctx) == CY_QISTACK_STAT_SUCCESS, "policy pass status");
+    check(gl_fullCnt == 1u, "policy event runs a full pass");
+    clear_counts();
+    (void)Cy_QiStack_Evt_Task(&gl_ctx);
+    (void)Cy_QiStack_Evt_Task(&gl_ctx);
+    check(layers_ran(0u, 0u, 0u) && (gl_ctx.evt.emptyCnt == 2u), "no pass without events");
+    check(Cy_QiStack_Evt_Is_Sleep_Allowed(&gl_ctx), "sleep allowed without events");
+
+    /* A timer expiry runs a full pass. */
+    Cy_QiStack_Evt_Timer_Expired();
+    check(!Cy_QiStack_Evt_Is_Sleep_Allowed(&gl_ctx), "no sleep with a timer event");
+    (void)Cy_QiStack_Evt_Task(&gl_ctx);
+    check(gl_fullCnt == 1u, "timer event runs a full pass");
+
+    /* A packet event runs the three layers once. */
+    clear_counts();
+    Cy_QiStack_Evt_Set(&gl_ctx, CY_QI_EVT_ASK_PKT);
+    check(Cy_QiStack_Evt_Task(&gl_ctx) == CY_QISTACK_STAT_SUCCESS, "packet pass status");
+    check(layers_ran(1u, 1u, 1u), "packet event runs each layer once");
+
+    /* A failing object layer skips the power layer and keeps the events. */
+    clear_counts();
+    gl_layerStatus[BENCH_LAYER_OBJECT] = CY_QISTACK_STAT_FAILURE;
+    Cy_QiStack_Evt_Set(&gl_ctx, CY_QI_EVT_FSK_DONE);
+    check(Cy_QiStack_Evt_Task(&gl_ctx) == CY_QISTACK_STAT_FAILURE, "failing layer status");
+    check(layers_ran(1u, 1u, 0u), "power layer skipped");
+    check(gl_ctx.evt.pending == CY_QI_EVT_FSK_DONE, "events kept for the next pass");
+    gl_layerStatus[BENCH_LAYER_OBJECT] = CY_QISTACK_STAT_SUCCESS;
+    (void)Cy_QiStack_Evt_Task(&gl_ctx);
+    check(layers_ran(2u, 2u, 1u) && (gl_ctx.evt.pending == 0u), "layers run again on the next pass");
+
+    /* The receiver posts the packet event for a good and for a failed reception. */
+    len = bmc_enc_make_pkt(pkt, CY_QI_ASK_CONTROL_ERROR, &seed);
+    rx_pkt(pkt, len);
+    check((gl_ctx.bmcLut.askStats.pktOkCnt == 1u) && (gl_ctx.evt.pending == CY_QI_EVT_ASK_PKT),
+          "good reception posts the packet event");
+    clear_counts();
+    (void)Cy_QiStack_Evt_Task(&gl_ctx);
+    check(layers_ran(1u, 1u, 1u), "packet event after a good reception");
+
+    bmc_rx_lut_rx_start(&gl_ctx);
+    gl_ctx.qiCommStat.askBmc.isRcvDone = true;
+    bmc_rx_lut_task(&gl_ctx);
+    check((gl_ctx.bmcLut.askStats.pktOkCnt == 1u) && (gl_ctx.evt.pending == CY_QI_EVT_ASK_PKT),
+          "failed reception posts the packet event");
+    clear_counts();
+    (void)Cy_QiStack_Evt_Task(&gl_ctx);
+    check(layers_ran(1u, 1u, 1u), "packet event after a failed reception");
+
+    printf("events: %u wakes, %u empty passes, %u errors\n", (unsigned)gl_ctx.evt.wakeCnt,
+           (unsigned)gl_ctx.evt.emptyCnt, (unsigned)gl_failCnt);
+}
+
+/* Cycles per main loop pass, in power transfer with a packet interrupt every 20 to 200 passes. */
+static double time_loop(bool event, bool pt)
+{
+    uint64_t best = UINT64_MAX;
+    uint64_t start;
+    uint64_t cycles;
+    uint32_t seed;
+    uint32_t next;
+    uint32_t pass;
+    uint32_t run;
+
+    for (run = 0u; run < BENCH_RUN_COUNT; run++)
+    {
+        seed = 0x2021u;
+        next = pt ? (BENCH_PT_GAP_MIN + (host_rand(&seed) % BENCH_PT_GAP_SPAN)) : UINT32_MAX;
+        Cy_QiStack_Evt_Init(&gl_ctx);
+        (void)Cy_QiStack_Evt_Task(&gl_ctx);
+
+        start = host_cycles();
+        for (pass = 0u; pass < BENCH_PASS_COUNT; pass++)
+        {
+            if (pass == next)
+            {
+                /* Receive interrupt: the library flag, and the event when event driven. */
+                gl_ctx.qiCommStat.askBmc.isDataReady = true;
+                if (event)
+                {
+                    Cy_QiStack_Evt_Set(&gl_ctx, CY_QI_EVT_ASK_PKT);
+                }
+                next += BENCH_PT_GAP_MIN + (host_rand(&seed) % BENCH_PT_GAP_SPAN);
+            }
+
+            if (event)
+            {
+                (void)Cy_QiStack_Evt_Task(&gl_ctx);
+            }
+            else
+            {
+                (void)Cy_QiStack_Task(&gl_ctx);
+            }
+        }
+        cycles = host_cycles() - start;
+
+        if (cycles < best)
+        {
+            best = cycles;
+        }
+    }
+
+    return (double)best / BENCH_PASS_COUNT;
+}
+
+static void run_timing(void)
+{
+    printf("idle:           polled %5.1f, event %5.1f %s/pass\n", time_loop(false, false),
+           time_loop(true, false), HOST_CYCLES_UNIT);
+    printf("power transfer: polled %5.1f, event %5.1f %s/pass\n", time_loop(false, true),
+           time_loop(true, true), HOST_CYCLES_UNIT);
+}
+
+int main(void)
+{
+    gl_ctx.ptrAppCbk = &gl_app;
+
+    run_events();
+    run_timing();
+
+    return (gl_failCnt == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,317 @@
+/***************************************************************************//**
+* \file bench_timer_late.c
+* \version 2.0
+*
+* Host check of the timer expiry lateness instrumentation of the timing wheel:
+* known late expiries land in their log2 bin and set the maximum of their own
+* timer, other timers and a missing time source record nothing, and the HPI
+* copy and clear functions see the same histograms. A run with tick latency
+* and rare long spikes shows the resulting distribution, followed by the
+* start plus expiry cost of an instrumented and a plain timer.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_debug_monitor.h"
+#include "host_clock.h"
+
+#if ((CY_QI_TIMER_LATE_EN == 0) || (CCG_HPI_WLC_CMD_ENABLE == 0))
+#error "bench_timer_late needs CY_QI_TIMER_LATE_EN and CCG_HPI_WLC_CMD_ENABLE"
+#endif /* CY_QI_TIMER_LATE_EN, CCG_HPI_WLC_CMD_ENABLE */
+
+/* Time source units per tick: microseconds of a 1 ms tick. */
+#define BENCH_TIME_PER_TICK                         (1000u)
+
+/* Ticks of the latency run. */
+#define BENCH_RUN_TICKS                             (1000000u)
+
+/* Tick latency of the latency run: 0 to 40 us, and 1.5 to 4.5 ms on one tick in 1000. */
+#define BENCH_LAT_SPAN                              (41u)
+#define BENCH_SPIKE_PERMILLE                        (1u)
+#define BENCH_SPIKE_MIN                             (1500u)
+#define BENCH_SPIKE_SPAN                            (3001u)
+
+/* Start and expiry rounds of the cost measurement. */
+#define BENCH_TIMING_LOOPS                          (1000000u)
+
+typedef struct
+{
+    cy_timer_id_t id;
+    cy_en_qi_timer_late_t late;
+    uint16_t period;
+} bench_late_timer_t;
+
+/* The instrumented timers, with a typical period. */
+static const bench_late_timer_t gl_lateTimers[] =
+{
+    {CY_QI_T_NEXT_TIME_ID, CY_QI_TIMER_LATE_T_NEXT, CY_QI_T_NEXT_TIME},
+    {CY_QI_TIMER_PID_LOOP_TIME_ID, CY_QI_TIMER_LATE_PID_LOOP, 2u},
+    {CY_QI_TIMER_PKT_TIMEOUT_TIME_ID, CY_QI_TIMER_LATE_PKT_TIMEOUT, CY_QI_TIMER_PKT_TIMEOUT_TIME},
+    {CY_QI_ASK_PKT_RECEPTION_TIME_ID, CY_QI_TIMER_LATE_ASK_PKT_RECEPTION, CY_QI_ASK_PKT_RECEPTION_TIME},
+};
+
+#define BENCH_LATE_TIMERS                           (sizeof(gl_lateTimers) / sizeof(gl_lateTimers[0]))
+
+static cy_stc_qi_timer_wheel_t gl_wheel;
+static uint32_t gl_time;
+static uint32_t gl_expireCnt;
+static uint32_t gl_failCnt;
+
+static uint32_t get_time(void)
+{
+    return gl_time;
+}
+
+static void check(bool cond, const char *what)
+{
+    if (!cond)
+    {
+        printf("  failed: %s\n", what);
+        gl_failCnt++;
+    }
+}
+
+static void count_cb(cy_timer_id_t id, void *callbackContext)
+{
+    (void)id;
+    (void)callbackContext;
+    gl_expireCnt++;
+}
+
+/* Sum of all bins of all instrumented timers. */
+static uint32_t late_total(void)
+{
+    uint32_t sum = 0u;
+    uint32_t late;
+    uint32_t bin;
+
+    for (late = 0u; late < CY_QI_TIMER_LATE_MAX; late++)
+    {
+        for (bin = 0u; bin < CY_QI_TIMER_LATE_BINS; bin++)
+        {
+            sum += gl_wheel.late[late].hist[bin];
+        }
+    }
+
+    return sum;
+}
+
+/* Starts a timer at tick boundary 0 and expires it lateness units after its due time. */
+static void expire_late(cy_timer_id_t id, uint16_t period, int32_t lateness)
+{
+    uint32_t tick;
+
+    gl_time = 0u;
+    (void)Cy_QiStack_Timer_Wheel_Start(&gl_wheel, NULL, id, period, count_cb);
+    for (tick = 1u; tick <= period; tick++)
+    {
+        gl_time = tick * BENCH_TIME_PER_TICK;
+        if (tick == period)
+        {
+            gl_time = (uint32_t)((int32_t)gl_time + lateness);
+        }
+        Cy_QiStack_Timer_Wheel_Tick(&gl_wheel, 1u);
+    }
+}
+
+static void run_known(void)
+{
+    /* Lateness and its bin: bin n holds 2^(n-1) to 2^n - 1, early expiries count as on time. */
+    static const struct
+    {
+        int32_t lateness;
+        uint8_t bin;
+    } cases[] =
+    {
+        {0, 0u}, {-300, 0u}, {1, 1u}, {3, 2u}, {40, 6u}, {1000, 10u}, {1024, 11u}, {4500, 13u}
+    };
+    uint8_t buffer[sizeof(gl_wheel.late)];
+    const cy_stc_qi_timer_late_t *rec;
+    uint32_t idx;
+    uint32_t late;
+
+    Cy_QiStack_Timer_Wheel_Init(&gl_wheel);
+    Cy_QiStack_Timer_Late_Init(&gl_wheel, get_time, BENCH_TIME_PER_TICK);
+
+    /* Each case on each instrumented timer: only that timer's record moves. */
+    for (late = 0u; late < BENCH_LATE_TIMERS; late++)
+    {
+        rec = &gl_wheel.late[gl_lateTimers[late].late];
+        for (idx = 0u; idx < (sizeof(cases) / sizeof(cases[0])); idx++)
+        {
+            expire_late(gl_lateTimers[late].id, 3u, cases[idx].lateness);
+            check(rec->hist[cases[idx].bin] != 0u, "lateness bin");
+        }
+        check((rec->hist[0] == 2u) && (rec->hist[1] == 1u) && (rec->hist[2] == 1u) && (rec->hist[6] == 1u) &&
+              (rec->hist[10] == 1u) && (rec->hist[11] == 1u) && (rec->hist[13] == 1u), "bin counts");
+        check(rec->max == 4500u, "maximum lateness");
+        check(late_total() == ((late + 1u) * (sizeof(cases) / sizeof(cases[0]))), "other timers unchanged");
+    }
+
+    /* A timer without instrumentation and a missing time source record nothing. */
+    idx = late_total();
+    expire_late(CY_QI_T_NEG_TIME_ID, 3u, 2000);
+    check(late_total() == idx, "plain timer records nothing");
+    Cy_QiStack_Timer_Late_Init(&gl_wheel, NULL, BENCH_TIME_PER_TICK);
+    expire_late(CY_QI_T_NEXT_TIME_ID, 3u, 2000);
+    check(late_total() == 0u, "no record without a time source");
+    check(gl_expireCnt == ((BENCH_LATE_TIMERS * (sizeof(cases) / sizeof(cases[0]))) + 2u), "every timer expired");
+
+    /* The HPI copy holds the histograms, the HPI clear empties them. */
+    Cy_QiStack_Timer_Late_Init(&gl_wheel, get_time, BENCH_TIME_PER_TICK);
+    expire_late(CY_QI_TIMER_PID_LOOP_TIME_ID, 2u, 100);
+    Cy_QiStack_Get_Timer_Late_Stats(&gl_wheel, buffer);
+    rec = &((const cy_stc_qi_timer_late_t *)buffer)[CY_QI_TIMER_LATE_PID_LOOP];
+    check((memcmp(buffer, gl_wheel.late, sizeof(buffer)) == 0) && (rec->hist[7] == 1u) && (rec->max == 100u),
+          "HPI copy");
+    Cy_QiStack_Clear_Timer_Late_Stats(&gl_wheel);
+    check((late_total() == 0u) && (gl_wheel.late[CY_QI_TIMER_LATE_PID_LOOP].max == 0u), "HPI clear");
+
+    printf("known: %u cases on %u timers, %u errors\n", (unsigned)(sizeof(cases) / sizeof(cases[0])),
+           (unsigned)BENCH_LATE_TIMERS, (unsigned)gl_failCnt);
+}
+
+/* Restarts the instrumented timer from its expiry, as the stack does. */
+static void restart_cb(cy_timer_id_t id, void *callbackContext)
+{
+    const bench_late_timer_t *timer = (const bench_late_timer_t *)callbackContext;
+
+    (void)id;
+    (void)Cy_QiStack_Timer_Wheel_Start(&gl_wheel, callbackContext, timer->id, timer->period, restart_cb);
+}
+
+static void run_latency(void)
+{
+    const cy_stc_qi_timer_late_t *rec;
+    uint32_t seed = 0x1018u;
+    uint32_t spikeMax = 0u;
+    uint32_t spikeCnt = 0u;
+    uint32_t lateMax = 0u;
+    uint32_t lat;
+    uint32_t tick;
+    uint32_t late;
+    uint32_t bin;
+    uint32_t low = 0u;
+    uint32_t mid = 0u;
+    uint32_t high = 0u;
+
+    Cy_QiStack_Timer_Wheel_Init(&gl_wheel);
+    Cy_QiStack_Timer_Late_Init(&gl_wheel, get_time, BENCH_TIME_PER_TICK);
+    gl_time = 0u;
+    for (late = 0u; late < BENCH_LATE_TIMERS; late++)
+    {
+        (void)Cy_QiStack_Timer_Wheel_Start(&gl_wheel, (void *)&gl_lateTimers[late], gl_lateTimers[late].id,
+                                           gl_lateTimers[late].period, restart_cb);
+    }
+
+    /* Each tick handler runs lat after its tick boundary; restarts happen at that time. */
+    for (tick = 1u; tick <= BENCH_RUN_TICKS; tick++)
+    {
+        lat = host_rand(&seed) % BENCH_LAT_SPAN;
+        if ((host_rand(&seed) % 1000u) < BENCH_SPIKE_PERMILLE)
+        {
+            lat = BENCH_SPIKE_MIN + (host_rand(&seed) % BENCH_SPIKE_SPAN);
+            spikeCnt++;
+            if (lat > spikeMax)
+            {
+                spikeMax = lat;
+            }
+        }
+        gl_time = (tick * BENCH_TIME_PER_TICK) + lat;
+        Cy_QiStack_Timer_Wheel_Tick(&gl_wheel, 1u);
+    }
+
+    printf("latency: %u ticks, %u spikes up to %u us\n", (unsigned)BENCH_RUN_TICKS, (unsigned)spikeCnt,
+           (unsigned)spikeMax);
+    for (late = 0u; late < CY_QI_TIMER_LATE_MAX; late++)
+    {
+        rec = &gl_wheel.late[late];
+        printf("  timer %u, max %4u us:", (unsigned)late, (unsigned)rec->max);
+        for (bin = 0u; bin < 14u; bin++)
+        {
+            printf(" %u", (unsigned)rec->hist[bin]);
+        }
+        printf("\n");
+
+        /* Tick latency alone reaches bin 6 (32 to 63 us); spikes reach bins 11 to 13. */
+        for (bin = 0u; bin < CY_QI_TIMER_LATE_BINS; bin++)
+        {
+            if (bin <= 6u)
+            {
+                low += rec->hist[bin];
+            }
+            else if ((bin >= 11u) && (bin <= 13u))
+            {
+                high += rec->hist[bin];
+            }
+            else
+            {
+                mid += rec->hist[bin];
+            }
+        }
+        if (rec->max > lateMax)
+        {
+            lateMax = rec->max;
+        }
+    }
+
+    check((mid == 0u) && (high != 0u) && (low != 0u), "bins of latency and spikes");
+    check((lateMax <= spikeMax) && ((lateMax + BENCH_LAT_SPAN) > spikeMax), "maximum of the spikes");
+}
+
+/* Cycles of one start and expiry of a timer with a one tick period. */
+static double time_start_expire(cy_timer_id_t id)
+{
+    uint64_t start;
+    uint32_t loops;
+
+    start = host_cycles();
+    for (loops = 0u; loops < BENCH_TIMING_LOOPS; loops++)
+    {
+        gl_time += BENCH_TIME_PER_TICK;
+        (void)Cy_QiStack_Timer_Wheel_Start(&gl_wheel, NULL, id, 1u, count_cb);
+        Cy_QiStack_Timer_Wheel_Tick(&gl_wheel, 1u);
+    }
+
+    return (double)(host_cycles() - start) / BENCH_TIMING_LOOPS;
+}
+
+static void run_timing(void)
+{
+    double plain = 1e9;
+    double inst = 1e9;
+    double cycles;
+    uint32_t run;
+
+    Cy_QiStack_Timer_Wheel_Init(&gl_wheel);
+    Cy_QiStack_Timer_Late_Init(&gl_wheel, get_time, BENCH_TIME_PER_TICK);
+    for (run = 0u; run < 5u; run++)
+    {
+        cycles = time_start_expire(CY_QI_T_NEG_TIME_ID);
+        plain = (cycles < plain) ? cycles : plain;
+        cycles = time_start_expire(CY_QI_T_NEXT_TIME_ID);
+        inst = (cycles < inst) ? cycles : inst;
+    }
+
+    printf("start and expiry: plain %5.1f, instrumented %5.1f %s\n", plain, inst, HOST_CYCLES_UNIT);
+}
+
+int main(void)
+{
+    run_known();
+    run_latency();
+    run_timing();
+
+    return (gl_failCnt == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
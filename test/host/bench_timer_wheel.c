@@ -0,0 +1,454 @@
+/***************************************************************************//**
+* \file bench_timer_wheel.c
+* \version 2.0
+*
+* Host check and benchmark of the timing wheel timer backend against a model
+* of the PDUtils soft timer, a fixed array in which every tick decrements each
+* running timer: expiries, running set and next deadline over a random
+* sequence, then tick, restart and next deadline cost with the stack timers
+* running.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "host_clock.h"
+
+#if (CY_QI_TIMER_WHEEL_EN == 0)
+#error "bench_timer_wheel needs CY_QI_TIMER_WHEEL_EN"
+#endif /* CY_QI_TIMER_WHEEL_EN */
+
+#define BENCH_CHECK_STEPS                           (3000000u)
+#define BENCH_TIMING_TICKS                          (2000000u)
+
+/* Timers of the soft timer model, as many as the wheel pool. */
+#define BENCH_REF_TIMERS                            (CY_QI_TIMER_WHEEL_NUM_TIMERS)
+
+/* Fire tick record, indexed by the low bits of the timer ID. */
+#define BENCH_ID_MASK                               (0x3FFu)
+
+/* Model of the PDUtils soft timer. */
+typedef struct
+{
+    cy_timer_id_t id;
+    uint16_t count;
+    cy_cb_timer_t cb;
+    void *callbackContext;
+    bool active;
+} bench_ref_timer_t;
+
+static bench_ref_timer_t gl_ref[BENCH_REF_TIMERS];
+static cy_stc_qi_timer_wheel_t gl_wheel;
+
+/* Stack timers with a typical period, restarted from their callback in the benchmark. */
+static const struct
+{
+    cy_timer_id_t id;
+    uint16_t period;
+} gl_stackTimers[] =
+{
+    {CY_QI_TIMER_DELAY_START_ID, CY_QI_TIMER_DELAY_START_TIME},
+    {CY_QI_TIMER_ANA_PING_INTERVAL_ID, 400u},
+    {CY_QI_TIMER_DIG_PING_INTERVAL_ID, CY_QI_TIMER_DIG_PING_W_OBJ_INTERVAL},
+    {CY_QI_TIMER_DIG_PING_TIME_ID, CY_QI_TIMER_DIG_PING_TIME},
+    {CY_QI_TIMER_DIG_PING_WAKE_TIME_ID, CY_QI_TIMER_DIG_PING_WAKE_TIME},
+    {CY_QI_TIMER_DIG_PING_ASK_PATH_TIME_ID, CY_QI_TIMER_DIG_PING_ASK_PATH_TIME},
+    {CY_QI_TIMER_FSK_RESP_TIME_ID, CY_QI_TIMER_FSK_RESP_TIME},
+    {CY_QI_T_NEXT_TIME_ID, CY_QI_T_NEXT_TIME},
+    {CY_QI_FOD_EPT_TIME_ID, CY_QI_FOD_EPT_TIME},
+    {CY_QI_T_NEG_TIME_ID, CY_QI_T_NEG_TIME},
+    {CY_HIPP_NEG_TIME_ID, CY_HIPP_NEG_TIME},
+    {CY_QI_TIMER_RX_ACTIVE_TIME_ID, CY_QI_TIMER_RX_ACTIVE_TIME},
+    {CY_QI_TIMER_PID_LOOP_TIME_ID, 2u},
+    {CY_QI_TIMER_PCH_TIME_ID, CY_QI_TIMER_PCH_TIME},
+    {CY_QI_TIMER_SAMPLING_TASK_ID, CY_QI_TIMER_SAMPLE_TASK_TIME},
+    {CY_QI_TIMER_T_TIMER_TIME_ID, 1500u},
+    {CY_QI_TIMER_T_POWER_TIME_ID, 5750u},
+    {CY_QI_TIMER_PKT_TIMEOUT_TIME_ID, CY_QI_TIMER_PKT_TIMEOUT_TIME},
+    {CY_QI_ASK_PKT_RECEPTION_TIME_ID, CY_QI_ASK_PKT_RECEPTION_TIME},
+    {CY_QI_STAGGER_Df_TIME_ID, CY_QI_STAGGER_Df_TIME},
+    {CY_QI_SAMSUNG_FSK_ACK_RETRY_TIME_ID, CY_QI_SAMSUNG_FSK_ACK_RETRY_TIME},
+    {CY_SOLN_TIMER_0_TIME_ID, 100u},
+    {CY_SOLN_TIMER_1_TIME_ID, 250u},
+    {CY_SOLN_TIMER_2_TIME_ID, 500u},
+    {CY_QI_TIMER_PKT_AUTH_TIMEOUT_TIME_ID, 200u},
+    {CY_QI_TIMER_AUTH_STACK_TASK, 10u},
+    {CY_QI_TIMER_AUTH_STACK_LONG_TIMER, 1000u}
+};
+
+#define BENCH_STACK_TIMERS                          (sizeof(gl_stackTimers) / sizeof(gl_stackTimers[0]))
+
+/* Random check state: current tick, last fire tick per ID and fire counts. */
+static uint32_t gl_now;
+static uint32_t gl_fireWheel[BENCH_ID_MASK + 1u];
+static uint32_t gl_fireRef[BENCH_ID_MASK + 1u];
+static uint32_t gl_cntWheel;
+static uint32_t gl_cntRef;
+static bool gl_restart;
+static uint32_t gl_seed = 16u;
+
+static bool ref_start(void *callbackContext, cy_timer_id_t id, uint16_t period, cy_cb_timer_t cb)
+{
+    uint32_t free = BENCH_REF_TIMERS;
+    uint32_t idx;
+
+    for (idx = 0u; idx < BENCH_REF_TIMERS; idx++)
+    {
+        if (gl_ref[idx].active && (gl_ref[idx].id == id))
+        {
+            free = idx;
+            break;
+        }
+        if ((!gl_ref[idx].active) && (free == BENCH_REF_TIMERS))
+        {
+            free = idx;
+        }
+    }
+
+    if (free == BENCH_REF_TIMERS)
+    {
+        return false;
+    }
+
+    gl_ref[free].id = id;
+    gl_ref[free].count = (period != 0u) ? period : 1u;
+    gl_ref[free].cb = cb;
+    gl_ref[free].callbackContext = callbackContext;
+    gl_ref[free].active = true;
+
+    return true;
+}
+
+static void ref_stop(cy_timer_id_t id)
+{
+    uint32_t idx;
+
+    for (idx = 0u; idx < BENCH_REF_TIMERS; idx++)
+    {
+        if (gl_ref[idx].active && (gl_ref[idx].id == id))
+        {
+            gl_ref[idx].active = false;
+        }
+    }
+}
+
+static void ref_tick(void)
+{
+    uint32_t idx;
+
+    for (idx = 0u; idx < BENCH_REF_TIMERS; idx++)
+    {
+        if (gl_ref[idx].active)
+        {
+            gl_ref[idx].count--;
+            if (gl_ref[idx].count == 0u)
+            {
+                gl_ref[idx].active = false;
+                gl_ref[idx].cb(gl_ref[idx].id, gl_ref[idx].callbackContext);
+            }
+        }
+    }
+}
+
+static uint32_t ref_next(void)
+{
+    uint32_t next = CY_QI_TIMER_WHEEL_NONE;
+    uint32_t idx;
+
+    for (idx = 0u; idx < BENCH_REF_TIMERS; idx++)
+    {
+        if (gl_ref[idx].active && (gl_ref[idx].count < next))
+        {
+            next = gl_ref[idx].count;
+        }
+    }
+
+    return next;
+}
+
+static uint32_t ref_active(void)
+{
+    uint32_t count = 0u;
+    uint32_t idx;
+
+    for (idx = 0u; idx < BENCH_REF_TIMERS; idx++)
+    {
+        if (gl_ref[idx].active)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/* The PID loop timer restarts itself from its callback, as the stack does. */
+static void check_cb_wheel(cy_timer_id_t id, void *callbackContext)
+{
+    gl_fireWheel[id & BENCH_ID_MASK] = gl_now;
+    gl_cntWheel++;
+    if (gl_restart && (id == CY_QI_TIMER_PID_LOOP_TIME_ID))
+    {
+        (void)Cy_QiStack_Timer_Wheel_Start(&gl_wheel, callbackContext, id, 2u, check_cb_wheel);
+    }
+}
+
+static void check_cb_ref(cy_timer_id_t id, void *callbackContext)
+{
+    gl_fireRef[id & BENCH_ID_MASK] = gl_now;
+    gl_cntRef++;
+    if (gl_restart && (id == CY_QI_TIMER_PID_LOOP_TIME_ID))
+    {
+        (void)ref_start(callbackContext, id, 2u, check_cb_ref);
+    }
+}
+
+/* Random Qi or solution timer ID. */
+static cy_timer_id_t rand_id(void)
+{
+    if ((host_rand(&gl_seed) & 3u) != 0u)
+    {
+        return (cy_timer_id_t)(CY_QI_TIMER_ID_OFFSET + (host_rand(&gl_seed) % CY_QI_TIMER_WHEEL_QI_IDS));
+    }
+
+    return (cy_timer_id_t)(CY_SOLN_TIMER_ID_OFFSET + (host_rand(&gl_seed) % CY_QI_TIMER_WHEEL_SOLN_IDS));
+}
+
+static void start_pid(void)
+{
+    gl_restart = true;
+    (void)Cy_QiStack_Timer_Wheel_Start(&gl_wheel, NULL, CY_QI_TIMER_PID_LOOP_TIME_ID, 2u, check_cb_wheel);
+    (void)ref_start(NULL, CY_QI_TIMER_PID_LOOP_TIME_ID, 2u, check_cb_ref);
+}
+
+/*
+ * Random Start, Stop, Next, single and batched Ticks on the wheel and on the
+ * model. Each timer must fire on the same tick, the running set and the next
+ * deadline must match. After a batch of ticks only the expiry count is compared.
+ */
+static int run_check(void)
+{
+    cy_timer_id_t id;
+    uint32_t failCnt = 0u;
+    uint32_t step;
+    uint32_t ticks;
+    uint32_t tick;
+    uint32_t next;
+    uint32_t idx;
+    uint32_t op;
+    uint16_t period;
+    bool wheelOk;
+    bool refOk;
+
+    Cy_QiStack_Timer_Wheel_Init(&gl_wheel);
+    start_pid();
+
+    for (step = 0u; step < BENCH_CHECK_STEPS; step++)
+    {
+        op = host_rand(&gl_seed) % 100u;
+        if (op < 30u)
+        {
+            id = rand_id();
+            period = (uint16_t)(((host_rand(&gl_seed) & 7u) != 0u) ?
+                    (host_rand(&gl_seed) % 300u) : (host_rand(&gl_seed) % 5000u));
+            if (id != CY_QI_TIMER_PID_LOOP_TIME_ID)
+            {
+                wheelOk = Cy_QiStack_Timer_Wheel_Start(&gl_wheel, NULL, id, period, check_cb_wheel);
+                refOk = ref_start(NULL, id, period, check_cb_ref);
+                if (wheelOk != refOk)
+                {
+                    /* Both pools hold the same timers and must fill up together. */
+                    failCnt++;
+                    Cy_QiStack_Timer_Wheel_Stop(&gl_wheel, id);
+                    ref_stop(id);
+                }
+            }
+        }
+        else if (op < 40u)
+        {
+            id = rand_id();
+            Cy_QiStack_Timer_Wheel_Stop(&gl_wheel, id);
+            ref_stop(id);
+        }
+        else if (op < 42u)
+        {
+            next = Cy_QiStack_Timer_Wheel_Next(&gl_wheel);
+            if (next != ref_next())
+            {
+                if (failCnt < 5u)
+                {
+                    printf("  step %u: next deadline %u, model %u\n", (unsigned)step,
+                           (unsigned)next, (unsigned)ref_next());
+                }
+                failCnt++;
+            }
+        }
+        else if (op < 43u)
+        {
+            /* Ticks applied after a sleep period; timers restarted from callbacks would differ. */
+            ticks = 1u + (host_rand(&gl_seed) % 200u);
+            gl_restart = false;
+            for (tick = 0u; tick < ticks; tick++)
+            {
+                gl_now++;
+                ref_tick();
+            }
+            Cy_QiStack_Timer_Wheel_Tick(&gl_wheel, ticks);
+            if (gl_cntWheel != gl_cntRef)
+            {
+                if (failCnt < 5u)
+                {
+                    printf("  step %u: %u expiries after %u ticks, model %u\n", (unsigned)step,
+                           (unsigned)gl_cntWheel, (unsigned)ticks, (unsigned)gl_cntRef);
+                }
+                failCnt++;
+                gl_cntWheel = gl_cntRef;
+            }
+            (void)memcpy(gl_fireWheel, gl_fireRef, sizeof(gl_fireWheel));
+            start_pid();
+        }
+        else
+        {
+            gl_now++;
+            Cy_QiStack_Timer_Wheel_Tick(&gl_wheel, 1u);
+            ref_tick();
+        }
+
+        if (memcmp(gl_fireWheel, gl_fireRef, sizeof(gl_fireWheel)) != 0)
+        {
+            if (failCnt < 5u)
+            {
+                printf("  step %u: expiry tick differs at tick %u\n", (unsigned)step, (unsigned)gl_now);
+            }
+            failCnt++;
+            (void)memcpy(gl_fireWheel, gl_fireRef, sizeof(gl_fireWheel));
+        }
+
+        if ((step % 997u) == 0u)
+        {
+            for (idx = 0u; idx < BENCH_REF_TIMERS; idx++)
+            {
+                if (gl_ref[idx].active && (!Cy_QiStack_Timer_Wheel_Is_Running(&gl_wheel, gl_ref[idx].id)))
+                {
+                    failCnt++;
+                    break;
+                }
+            }
+            if (ref_active() != gl_wheel.activeCnt)
+            {
+                failCnt++;
+            }
+        }
+    }
+
+    printf("random check: %u steps, %u expiries, %u running at most, %u failed\n",
+           (unsigned)BENCH_CHECK_STEPS, (unsigned)gl_cntRef, (unsigned)gl_wheel.activeMax, (unsigned)failCnt);
+
+    return (failCnt == 0u) ? 0 : 1;
+}
+
+/* The callback context holds the period, so that each timer restarts itself. */
+static void timing_cb_wheel(cy_timer_id_t id, void *callbackContext)
+{
+    gl_cntWheel++;
+    (void)Cy_QiStack_Timer_Wheel_Start(&gl_wheel, callbackContext, id,
+            (uint16_t)(uintptr_t)callbackContext, timing_cb_wheel);
+}
+
+static void timing_cb_ref(cy_timer_id_t id, void *callbackContext)
+{
+    gl_cntRef++;
+    (void)ref_start(callbackContext, id, (uint16_t)(uintptr_t)callbackContext, timing_cb_ref);
+}
+
+/* Tick, restart and next deadline cost with all stack timers running. */
+static void run_timing(void)
+{
+    volatile uint32_t sink = 0u;
+    uint64_t start;
+    uint64_t refTime;
+    uint64_t wheelTime;
+    uint32_t tick;
+    uint32_t idx;
+
+    Cy_QiStack_Timer_Wheel_Init(&gl_wheel);
+    (void)memset(gl_ref, 0, sizeof(gl_ref));
+    for (idx = 0u; idx < BENCH_STACK_TIMERS; idx++)
+    {
+        (void)Cy_QiStack_Timer_Wheel_Start(&gl_wheel, (void *)(uintptr_t)gl_stackTimers[idx].period,
+                gl_stackTimers[idx].id, gl_stackTimers[idx].period, timing_cb_wheel);
+        (void)ref_start((void *)(uintptr_t)gl_stackTimers[idx].period, gl_stackTimers[idx].id,
+                gl_stackTimers[idx].period, timing_cb_ref);
+    }
+
+    gl_cntRef = 0u;
+    start = host_cycles();
+    for (tick = 0u; tick < BENCH_TIMING_TICKS; tick++)
+    {
+        ref_tick();
+    }
+    refTime = host_cycles() - start;
+
+    gl_cntWheel = 0u;
+    start = host_cycles();
+    for (tick = 0u; tick < BENCH_TIMING_TICKS; tick++)
+    {
+        Cy_QiStack_Timer_Wheel_Tick(&gl_wheel, 1u);
+    }
+    wheelTime = host_cycles() - start;
+
+    printf("%u timers, %u ticks, %s per tick: soft timer %.1f (%u expiries), wheel %.1f (%u expiries)\n",
+           (unsigned)BENCH_STACK_TIMERS, (unsigned)BENCH_TIMING_TICKS, HOST_CYCLES_UNIT,
+           (double)refTime / BENCH_TIMING_TICKS, (unsigned)gl_cntRef,
+           (double)wheelTime / BENCH_TIMING_TICKS, (unsigned)gl_cntWheel);
+
+    /* Restart of the last timer of the table, the longest soft timer search. */
+    start = host_cycles();
+    for (tick = 0u; tick < BENCH_TIMING_TICKS; tick++)
+    {
+        (void)ref_start(NULL, CY_QI_TIMER_AUTH_STACK_LONG_TIMER, 1000u, timing_cb_ref);
+    }
+    refTime = host_cycles() - start;
+
+    start = host_cycles();
+    for (tick = 0u; tick < BENCH_TIMING_TICKS; tick++)
+    {
+        (void)Cy_QiStack_Timer_Wheel_Start(&gl_wheel, NULL, CY_QI_TIMER_AUTH_STACK_LONG_TIMER, 1000u,
+                timing_cb_wheel);
+    }
+    wheelTime = host_cycles() - start;
+
+    printf("restart, %s: soft timer %.1f, wheel %.1f\n", HOST_CYCLES_UNIT,
+           (double)refTime / BENCH_TIMING_TICKS, (double)wheelTime / BENCH_TIMING_TICKS);
+
+    start = host_cycles();
+    for (tick = 0u; tick < (BENCH_TIMING_TICKS / 8u); tick++)
+    {
+        sink += Cy_QiStack_Timer_Wheel_Next(&gl_wheel);
+    }
+    wheelTime = host_cycles() - start;
+    (void)sink;
+
+    printf("next deadline, %s: %.1f; wheel RAM %u bytes\n", HOST_CYCLES_UNIT,
+           (double)wheelTime / (BENCH_TIMING_TICKS / 8u), (unsigned)sizeof(gl_wheel));
+}
+
+int main(void)
+{
+    int result;
+
+    result = run_check();
+    run_timing();
+
+    return result;
+}
+
+/* [] END OF FILE */
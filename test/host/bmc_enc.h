@@ -0,0 +1,190 @@
+/***************************************************************************//**
+* \file bmc_enc.h
+* \version 2.0
+*
+* Synthesizer of oversampled Qi ASK BMC waveforms for the host tests, in the
+* raw sample layout of the SPI receiver (CY_QI_BMC_RX_RAW_DATA_GET_BIT).
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef BMC_ENC_H
+#define BMC_ENC_H
+
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "host_clock.h"
+
+/* Raw sample buffer size in bytes: a 27-byte packet with a long preamble. */
+#define BMC_ENC_BUF_SIZE                            (64u * CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE)
+
+typedef struct
+{
+    /* Raw samples, LSB first */
+    uint8_t buf[BMC_ENC_BUF_SIZE];
+
+    /* Samples written to buf */
+    uint32_t bitCount;
+
+    /* Ideal time of the next edge, in samples */
+    double time;
+
+    /* Samples per bit, including the rate error */
+    double bitLen;
+
+    /* Largest edge displacement, in samples */
+    double jitter;
+
+    /* Current line level */
+    uint8_t level;
+
+    /* Random state of the jitter */
+    uint32_t seed;
+} bmc_enc_t;
+
+/* Message size of a packet header, as in the Qi specification. */
+static inline uint8_t bmc_enc_msg_size(uint8_t header)
+{
+    return (header < 0x20u) ? 1u :
+           (header < 0x80u) ? (uint8_t)(2u + ((header - 0x20u) >> 4u)) :
+           (header < 0xE0u) ? (uint8_t)(8u + ((header - 0x80u) >> 3u)) :
+                              (uint8_t)(20u + ((header - 0xE0u) >> 2u));
+}
+
+/* Builds header, random message and checksum. Returns the packet length. */
+static inline uint8_t bmc_enc_make_pkt(uint8_t *pkt, uint8_t header, uint32_t *seed)
+{
+    uint8_t size = bmc_enc_msg_size(header);
+    uint8_t chk = header;
+    uint8_t idx;
+
+    pkt[0] = header;
+    for (idx = 1u; idx <= size; idx++)
+    {
+        pkt[idx] = (uint8_t)host_rand(seed);
+        chk ^= pkt[idx];
+    }
+    pkt[size + 1u] = chk;
+
+    return (uint8_t)(size + 2u);
+}
+
+/*
+ * Starts a waveform on an idle low line. rate is the relative bit rate error,
+ * jitter the largest edge displacement as a fraction of a bit.
+ */
+static inline void bmc_enc_init(bmc_enc_t *enc, double rate, double jitter, uint32_t seed)
+{
+    (void)memset(enc->buf, 0, sizeof(enc->buf));
+    enc->bitCount = 0u;
+    enc->time = 0.0;
+    enc->bitLen = (double)CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE / (1.0 + rate);
+    enc->jitter = jitter * (double)CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE;
+    enc->level = 0u;
+    enc->seed = (seed != 0u) ? seed : 1u;
+}
+
+/* Fills the current level up to a sample position. */
+static inline void bmc_enc_fill(bmc_enc_t *enc, double pos)
+{
+    uint32_t end = (pos > 0.0) ? (uint32_t)(pos + 0.5) : 0u;
+
+    if (end > (BMC_ENC_BUF_SIZE << 3u))
+    {
+        end = BMC_ENC_BUF_SIZE << 3u;
+    }
+
+    while (enc->bitCount < end)
+    {
+        if (enc->level != 0u)
+        {
+            enc->buf[enc->bitCount >> 3u] |= (uint8_t)(1u << (enc->bitCount & 7u));
+        }
+        enc->bitCount++;
+    }
+}
+
+/* Places an edge at the current ideal time, displaced by the jitter. */
+static inline void bmc_enc_edge(bmc_enc_t *enc)
+{
+    double shift = 0.0;
+
+    if (enc->jitter > 0.0)
+    {
+        shift = enc->jitter * ((((double)(host_rand(&enc->seed) & 0xFFFFu)) / 32767.5) - 1.0);
+    }
+
+    bmc_enc_fill(enc, enc->time + shift);
+    enc->level ^= 1u;
+}
+
+/* Adds idle line, in bits. */
+static inline void bmc_enc_idle(bmc_enc_t *enc, double bits)
+{
+    enc->time += bits * enc->bitLen;
+    bmc_enc_fill(enc, enc->time);
+}
+
+/* Adds one BMC bit: an edge at the start, and one in the middle for a 1. */
+static inline void bmc_enc_bit(bmc_enc_t *enc, uint8_t bit)
+{
+    bmc_enc_edge(enc);
+    if (bit != 0u)
+    {
+        enc->time += enc->bitLen / 2.0;
+        bmc_enc_edge(enc);
+        enc->time += enc->bitLen / 2.0;
+    }
+    else
+    {
+        enc->time += enc->bitLen;
+    }
+}
+
+/* Adds a preamble and the characters of a packet, without the idle tail. */
+static inline void bmc_enc_pkt(bmc_enc_t *enc, const uint8_t *pkt, uint8_t len, uint8_t preamble)
+{
+    uint8_t idx;
+    uint8_t bit;
+
+    for (idx = 0u; idx < preamble; idx++)
+    {
+        bmc_enc_bit(enc, 1u);
+    }
+
+    for (idx = 0u; idx < len; idx++)
+    {
+        bmc_enc_bit(enc, 0u);
+        for (bit = 0u; bit < 8u; bit++)
+        {
+            bmc_enc_bit(enc, (uint8_t)((pkt[idx] >> bit) & 0x01u));
+        }
+        bmc_enc_bit(enc, (uint8_t)((__builtin_popcount(pkt[idx]) & 1) == 0));
+        bmc_enc_bit(enc, 1u);
+    }
+}
+
+/* Ends the packet with the closing edge and an idle tail, in bits. */
+static inline void bmc_enc_end(bmc_enc_t *enc, double idle)
+{
+    bmc_enc_edge(enc);
+    bmc_enc_idle(enc, idle);
+}
+
+/* Complete waveform: idle, preamble, packet, idle. */
+static inline void bmc_enc_frame(bmc_enc_t *enc, const uint8_t *pkt, uint8_t len, uint8_t preamble)
+{
+    bmc_enc_idle(enc, 3.0);
+    bmc_enc_pkt(enc, pkt, len, preamble);
+    bmc_enc_end(enc, 3.0);
+}
+
+#endif /* BMC_ENC_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,188 @@
+/***************************************************************************//**
+* \file bmc_ref.h
+* \version 2.0
+*
+* Per sample reference BMC decoder for the host tests, with the fixed
+* CY_QI_BMC_RX_HALF_MIN_COUNT, CY_QI_BMC_RX_ZERO_MIN_COUNT and
+* CY_QI_BMC_RX_FULL_MAX_COUNT thresholds.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef BMC_REF_H
+#define BMC_REF_H
+
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_utils.h"
+#include "bmc_enc.h"
+
+/* Raw sample at a position, as read by a per sample decoder. */
+#define BMC_REF_RAW_BIT(raw, pos)                   (((raw)[(pos) >> 3u] >> ((pos) & 0x7u)) & 0x01u)
+
+/* Reference decoder state. */
+typedef struct
+{
+    uint8_t inData;
+    uint8_t halfCnt;
+    bool halfPending;
+    uint8_t bitIdx;
+    uint16_t charBits;
+    uint8_t byteIdx;
+    uint8_t pktLen;
+    uint8_t bytes[CY_QI_ASK_DATA_SIZE + 2u];
+} bmc_ref_t;
+
+/*
+ * Per sample BMC decoder in the style of the library bmc_rx_task: every
+ * sample is read on its own, runs are counted sample by sample, characters
+ * are checked with cy_get_odd_parity and the checksum is computed in a second
+ * pass over the packet. The bit rules are those of the table driven decoder
+ * without CY_QI_BMC_RX_CLK_RECOVERY_EN.
+ */
+static inline cy_en_qi_ask_pkt_evt_t bmc_ref_bit(bmc_ref_t *ref, uint8_t bit, cy_stc_qi_ask_pkt_t *pkt)
+{
+    uint8_t data;
+    uint8_t chk = 0u;
+    uint8_t idx;
+
+    ref->charBits |= (uint16_t)((uint16_t)bit << ref->bitIdx);
+    ref->bitIdx++;
+    if (ref->bitIdx < 11u)
+    {
+        return CY_QI_ASK_EVT_PKT_NONE;
+    }
+
+    data = (uint8_t)(ref->charBits >> 1u);
+    if (((ref->charBits & 0x01u) != 0u) || (((ref->charBits >> 10u) & 0x01u) == 0u) ||
+        (cy_get_odd_parity(data) != (((ref->charBits >> 9u) & 0x01u) != 0u)))
+    {
+        return CY_QI_ASK_EVT_PKT_ERR;
+    }
+
+    if (ref->byteIdx == 0u)
+    {
+        ref->pktLen = (uint8_t)(bmc_enc_msg_size(data) + 2u);
+    }
+    ref->bytes[ref->byteIdx] = data;
+    ref->byteIdx++;
+    ref->bitIdx = 0u;
+    ref->charBits = 0u;
+
+    if (ref->byteIdx < ref->pktLen)
+    {
+        return CY_QI_ASK_EVT_PKT_NONE;
+    }
+
+    for (idx = 0u; idx < (ref->pktLen - 1u); idx++)
+    {
+        chk ^= ref->bytes[idx];
+    }
+    if (chk != ref->bytes[ref->pktLen - 1u])
+    {
+        return CY_QI_ASK_EVT_PKT_ERR;
+    }
+
+    pkt->header = ref->bytes[0];
+    pkt->dataSize = (uint8_t)(ref->pktLen - 2u);
+    (void)memcpy(pkt->msg, &ref->bytes[1], pkt->dataSize);
+    pkt->checksum = ref->bytes[ref->pktLen - 1u];
+
+    return CY_QI_ASK_EVT_PKT_READY;
+}
+
+static inline cy_en_qi_ask_pkt_evt_t bmc_ref_run(bmc_ref_t *ref, uint32_t len, cy_stc_qi_ask_pkt_t *pkt)
+{
+    bool half = (len >= CY_QI_BMC_RX_HALF_MIN_COUNT) && (len < CY_QI_BMC_RX_ZERO_MIN_COUNT);
+    bool full = (len >= CY_QI_BMC_RX_ZERO_MIN_COUNT) && (len <= CY_QI_BMC_RX_FULL_MAX_COUNT);
+
+    if (ref->inData == 0u)
+    {
+        if (half)
+        {
+            ref->halfCnt = (ref->halfCnt < UINT8_MAX) ? (uint8_t)(ref->halfCnt + 1u) : UINT8_MAX;
+        }
+        else if (full && ((ref->halfCnt >> 1u) >= CY_QI_BMC_RX_MIN_PREAMBLE_COUNT))
+        {
+            ref->inData = 1u;
+            ref->halfPending = false;
+            ref->bitIdx = 1u;
+            ref->charBits = 0u;
+            ref->byteIdx = 0u;
+            ref->pktLen = 0u;
+        }
+        else
+        {
+            ref->halfCnt = 0u;
+        }
+
+        return CY_QI_ASK_EVT_PKT_NONE;
+    }
+
+    if (half)
+    {
+        ref->halfPending = !ref->halfPending;
+        if ((!ref->halfPending) ||
+            ((ref->bitIdx == 10u) && ((ref->byteIdx + 1u) == ref->pktLen)))
+        {
+            ref->halfPending = false;
+            return bmc_ref_bit(ref, 1u, pkt);
+        }
+
+        return CY_QI_ASK_EVT_PKT_NONE;
+    }
+
+    if (full && (!ref->halfPending))
+    {
+        return bmc_ref_bit(ref, 0u, pkt);
+    }
+
+    return CY_QI_ASK_EVT_PKT_ERR;
+}
+
+static inline cy_en_qi_ask_pkt_evt_t bmc_ref_decode(const uint8_t *raw, uint16_t bitCount, cy_stc_qi_ask_pkt_t *pkt)
+{
+    cy_en_qi_ask_pkt_evt_t evt = CY_QI_ASK_EVT_PKT_NONE;
+    bmc_ref_t ref;
+    uint32_t run = 0u;
+    uint8_t level;
+    uint8_t sample;
+    uint16_t pos;
+
+    (void)memset(&ref, 0, sizeof(ref));
+    level = (uint8_t)BMC_REF_RAW_BIT(raw, 0u);
+
+    for (pos = 0u; pos < bitCount; pos++)
+    {
+        sample = (uint8_t)BMC_REF_RAW_BIT(raw, pos);
+        if (sample != level)
+        {
+            evt = bmc_ref_run(&ref, run, pkt);
+            if ((evt == CY_QI_ASK_EVT_PKT_READY) || (evt == CY_QI_ASK_EVT_PKT_ERR))
+            {
+                return evt;
+            }
+            level = sample;
+            run = 0u;
+        }
+        run++;
+    }
+
+    if (ref.inData != 0u)
+    {
+        /* Idle line in the middle of the packet. */
+        evt = CY_QI_ASK_EVT_PKT_ERR;
+    }
+
+    return evt;
+}
+
+#endif /* BMC_REF_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,60 @@
+/***************************************************************************//**
+* \file host_clock.h
+* \version 2.0
+*
+* Cycle counter for the QiStack host benchmarks.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef HOST_CLOCK_H
+#define HOST_CLOCK_H
+
+#include <stdint.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+
+/* Time stamp counter cycles. */
+static inline uint64_t host_cycles(void)
+{
+    return __rdtsc();
+}
+
+#define HOST_CYCLES_UNIT                            "tsc"
+#else
+
+/* Nanoseconds where no cycle counter is available. */
+static inline uint64_t host_cycles(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+#define HOST_CYCLES_UNIT                            "ns"
+#endif
+
+/* Deterministic pseudo random numbers, so that runs can be compared. */
+static inline uint32_t host_rand(uint32_t *seed)
+{
+    uint32_t x = *seed;
+
+    x ^= x << 13u;
+    x ^= x >> 17u;
+    x ^= x << 5u;
+    *seed = x;
+
+    return x;
+}
+
+#endif /* HOST_CLOCK_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,163 @@
+/***************************************************************************//**
+* \file record_capture.c
+* \version 2.0
+*
+* Records an ASK capture on the host: Qi packets of a ping to power transfer
+* exchange are modulated with rate error and jitter, drained through the SCB
+* FIFO handler in FIFO sized batches and written through cy_cb_ask_capture,
+* exactly as the capture callback of a target would store them. One packet
+* is corrupted so the capture also holds a failed reception.
+*
+*   record_capture <capture file>
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_bmc.h"
+#include "bmc_enc.h"
+#include "host_clock.h"
+
+#if (CY_QI_BMC_RX_CAPTURE_EN == 0)
+#error "record_capture needs CY_QI_BMC_RX_CAPTURE_EN"
+#endif /* CY_QI_BMC_RX_CAPTURE_EN */
+
+/* Comparator event ID recorded ahead of each packet. */
+#define RECORD_CMP_EVT_DET                          (0x01u)
+
+typedef struct
+{
+    /* Header and message bytes, the checksum is appended */
+    uint8_t pkt[CY_QI_ASK_DATA_SIZE + 2u];
+
+    /* Sample flipped in the middle of the packet, 0 for none */
+    uint32_t flip;
+} record_pkt_t;
+
+/* Signal strength, identification, configuration, control error, received power, end power transfer. */
+static const record_pkt_t gl_pkts[] =
+{
+    {{0x01u, 0x80u}, 0u},
+    {{0x71u, 0x20u, 0x02u, 0x5Au, 0x01u, 0x23u, 0x45u, 0x67u}, 0u},
+    {{0x51u, 0x05u, 0x00u, 0x00u, 0x34u, 0x00u}, 0u},
+    {{0x03u, 0x00u}, 0u},
+    {{0x03u, 0xFCu}, 300u},
+    {{0x03u, 0xFCu}, 0u},
+    {{0x31u, 0x40u, 0x52u, 0x00u}, 0u},
+    {{0x03u, 0x01u}, 0u},
+    {{0x02u, 0x01u}, 0u},
+};
+
+static cy_stc_qi_context_t gl_ctx;
+static const bmc_enc_t *gl_enc;
+static uint32_t gl_encPos;
+static FILE *gl_out;
+static bool gl_outErr;
+
+uint32_t Cy_SCB_SPI_GetNumInRxFifo(CySCB_Type const *base)
+{
+    uint32_t left = (gl_enc->bitCount - gl_encPos) / CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE;
+
+    (void)base;
+    return (left > CY_QI_BMC_RX_SPI_FIFO_SIZE) ? CY_QI_BMC_RX_SPI_FIFO_SIZE : left;
+}
+
+uint32_t Cy_SCB_SPI_Read(CySCB_Type const *base)
+{
+    uint32_t word = gl_enc->buf[gl_encPos >> 3u];
+
+#if (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE > 8u)
+    word |= (uint32_t)gl_enc->buf[(gl_encPos >> 3u) + 1u] << 8u;
+#endif /* (CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE > 8u) */
+    (void)base;
+    gl_encPos += CY_QI_BMC_RX_BIT_SPI_OVER_SAMPLE;
+
+    return word;
+}
+
+static void ask_capture(void *callbackContext, const uint8_t *rec, uint8_t len)
+{
+    (void)callbackContext;
+    if (fwrite(rec, 1u, len, gl_out) != len)
+    {
+        gl_outErr = true;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static bmc_enc_t enc;
+    cy_stc_qi_comm_ask_bmc_t *askBmc = &gl_ctx.qiCommStat.askBmc;
+    uint8_t pkt[CY_QI_ASK_DATA_SIZE + 2u];
+    uint32_t seed = 0x5005u;
+    uint32_t idx;
+    uint8_t len;
+    uint8_t pos;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <capture file>\n", argv[0]);
+        return 2;
+    }
+
+    gl_out = fopen(argv[1], "wb");
+    if (gl_out == NULL)
+    {
+        perror(argv[1]);
+        return 2;
+    }
+
+    gl_ctx.qiCommStat.askCfg.askPath = CY_QI_ASK_PATH_VOLT_H;
+    gl_ctx.bmcLut.cy_cb_ask_capture = ask_capture;
+
+    for (idx = 0u; idx < (sizeof(gl_pkts) / sizeof(gl_pkts[0])); idx++)
+    {
+        (void)memcpy(pkt, gl_pkts[idx].pkt, sizeof(pkt));
+        len = (uint8_t)(bmc_enc_msg_size(pkt[0]) + 1u);
+        pkt[len] = 0u;
+        for (pos = 0u; pos < len; pos++)
+        {
+            pkt[len] ^= pkt[pos];
+        }
+        len++;
+
+        bmc_enc_init(&enc, ((double)(host_rand(&seed) % 41u) - 20.0) / 1000.0,
+                     (double)(host_rand(&seed) % 7u) / 100.0, host_rand(&seed));
+        bmc_enc_frame(&enc, pkt, len, 12u);
+        if (gl_pkts[idx].flip != 0u)
+        {
+            enc.buf[gl_pkts[idx].flip >> 3u] ^= (uint8_t)(1u << (gl_pkts[idx].flip & 7u));
+        }
+
+        gl_enc = &enc;
+        gl_encPos = 0u;
+        bmc_rx_lut_rx_start(&gl_ctx);
+        bmc_rx_lut_cap_cmp_event(&gl_ctx, RECORD_CMP_EVT_DET);
+        while (Cy_SCB_SPI_GetNumInRxFifo(askBmc->scb) != 0u)
+        {
+            bmc_rx_lut_scb_fifo_handler(&gl_ctx);
+        }
+
+        /* Packet timeout: the task ends a reception the FIFO handler did not complete. */
+        askBmc->isRcvDone = true;
+        bmc_rx_lut_task(&gl_ctx);
+    }
+
+    if ((fclose(gl_out) != 0) || gl_outErr)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,171 @@
+/***************************************************************************//**
+* \file replay_capture.c
+* \version 2.0
+*
+* Linux driver of bmc_rx_lut_replay: replays an ASK capture file through the
+* BMC receive path and prints one line per reception, "READY" with the
+* header, message and checksum bytes in hex, or "ERR". Given an expected
+* packet file, in the same format with '#' comment lines, it fails on the
+* first difference.
+*
+*   replay_capture <capture file> [expected packets]
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_comm_bmc.h"
+
+#if (CY_QI_BMC_RX_CAPTURE_EN == 0)
+#error "replay_capture needs CY_QI_BMC_RX_CAPTURE_EN"
+#endif /* CY_QI_BMC_RX_CAPTURE_EN */
+
+/* Largest capture file, 64 KiB covers several hundred packets. */
+#define REPLAY_CAP_MAX_SIZE                         (0x10000u)
+
+/* Longest result line: "READY" and three characters per packet byte. */
+#define REPLAY_LINE_SIZE                            (8u + ((CY_QI_ASK_DATA_SIZE + 2u) * 3u))
+
+static cy_stc_qi_context_t gl_ctx;
+static FILE *gl_expect;
+static uint32_t gl_rcvCnt;
+static uint32_t gl_failCnt;
+
+/* Next expected line without its line end, skipping comments and blank lines. */
+static bool expect_line(char *line, size_t size)
+{
+    size_t end;
+
+    while (fgets(line, (int)size, gl_expect) != NULL)
+    {
+        end = strcspn(line, "\r\n");
+        line[end] = '\0';
+        if ((end != 0u) && (line[0] != '#'))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static cy_en_qi_status_t ask_pkt_evt(void *callbackContext, cy_en_qi_ask_pkt_evt_t pktEvt)
+{
+    const cy_stc_qi_ask_pkt_t *pkt = &gl_ctx.qiCommStat.askBmc.pkt;
+    char line[REPLAY_LINE_SIZE];
+    char expect[REPLAY_LINE_SIZE + 2u];
+    int pos;
+    uint8_t idx;
+
+    (void)callbackContext;
+    if ((pktEvt != CY_QI_ASK_EVT_PKT_READY) && (pktEvt != CY_QI_ASK_EVT_PKT_ERR))
+    {
+        return CY_QISTACK_STAT_SUCCESS;
+    }
+
+    if (pktEvt == CY_QI_ASK_EVT_PKT_READY)
+    {
+        pos = snprintf(line, sizeof(line), "READY %02x", pkt->header);
+        for (idx = 0u; idx < pkt->dataSize; idx++)
+        {
+            pos += snprintf(&line[pos], sizeof(line) - (size_t)pos, " %02x", pkt->msg[idx]);
+        }
+        (void)snprintf(&line[pos], sizeof(line) - (size_t)pos, " %02x", pkt->checksum);
+    }
+    else
+    {
+        (void)snprintf(line, sizeof(line), "ERR");
+    }
+
+    gl_rcvCnt++;
+    printf("%s\n", line);
+
+    if (gl_expect != NULL)
+    {
+        if (!expect_line(expect, sizeof(expect)))
+        {
+            (void)snprintf(expect, sizeof(expect), "end of file");
+        }
+        if (strcmp(line, expect) != 0)
+        {
+            if (gl_failCnt == 0u)
+            {
+                printf("  reception %u: expected %s\n", (unsigned)gl_rcvCnt, expect);
+            }
+            gl_failCnt++;
+        }
+    }
+
+    return CY_QISTACK_STAT_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+    static uint8_t cap[REPLAY_CAP_MAX_SIZE];
+    char expect[REPLAY_LINE_SIZE + 2u];
+    FILE *in;
+    size_t len;
+
+    if ((argc != 2) && (argc != 3))
+    {
+        fprintf(stderr, "usage: %s <capture file> [expected packets]\n", argv[0]);
+        return 2;
+    }
+
+    in = fopen(argv[1], "rb");
+    if (in == NULL)
+    {
+        perror(argv[1]);
+        return 2;
+    }
+    len = fread(cap, 1u, sizeof(cap), in);
+    if ((ferror(in) != 0) || (!feof(in)))
+    {
+        fprintf(stderr, "%s: read error or larger than %u bytes\n", argv[1], (unsigned)sizeof(cap));
+        (void)fclose(in);
+        return 2;
+    }
+    (void)fclose(in);
+
+    if (argc == 3)
+    {
+        gl_expect = fopen(argv[2], "r");
+        if (gl_expect == NULL)
+        {
+            perror(argv[2]);
+            return 2;
+        }
+    }
+
+    gl_ctx.qiCommStat.askBmc.cy_cb_ask_pkt_evt = ask_pkt_evt;
+    if (bmc_rx_lut_replay(&gl_ctx, cap, (uint32_t)len) != CY_QISTACK_STAT_SUCCESS)
+    {
+        printf("%s: malformed capture\n", argv[1]);
+        gl_failCnt++;
+    }
+
+    if (gl_expect != NULL)
+    {
+        if (expect_line(expect, sizeof(expect)))
+        {
+            printf("  after reception %u: expected %s\n", (unsigned)gl_rcvCnt, expect);
+            gl_failCnt++;
+        }
+        (void)fclose(gl_expect);
+    }
+
+    printf("%s: %u bytes, %u receptions, %u mismatches\n", argv[1], (unsigned)len,
+           (unsigned)gl_rcvCnt, (unsigned)gl_failCnt);
+
+    return (gl_failCnt == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
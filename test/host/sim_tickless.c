@@ -0,0 +1,219 @@
+/***************************************************************************//**
+* \file sim_tickless.c
+* \version 2.0
+*
+* Host simulation of 24 h of standby on the timing wheel, with the 1 ms soft
+* timer tick and with Cy_QiStack_Tickless_Idle: deep sleep residency, wake
+* count and ping count of both.
+*
+* Model: analog ping every 400 ms, 1 ms active. Keys on the pad from 01:00 to
+* 05:00: digital ping every CY_QI_TIMER_DIG_PING_W_OBJ_INTERVAL, active for
+* CY_QI_TIMER_DIG_PING_TIME. A 1 s LED heartbeat, 20 us awake. A host
+* interrupt about once a minute. Each wake costs 60 us.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_pm.h"
+#include "host_clock.h"
+
+#if (CY_QI_TICKLESS_EN == 0)
+#error "sim_tickless needs CY_QI_TICKLESS_EN"
+#endif /* CY_QI_TICKLESS_EN */
+
+/* Simulated time, in 1 ms ticks. */
+#define SIM_DAY_TICKS                               (24u * 3600u * 1000u)
+#define SIM_OBJ_START_TICKS                         (1u * 3600u * 1000u)
+#define SIM_OBJ_END_TICKS                           (5u * 3600u * 1000u)
+
+/* Deep sleep exit, tick interrupt and sleep entry, in us. */
+#define SIM_WAKE_US                                 (60u)
+
+#define SIM_ANA_INTERVAL                            (400u)
+#define SIM_ANA_ACTIVE                              (1u)
+#define SIM_LED_INTERVAL                            (1000u)
+#define SIM_LED_US                                  (20u)
+
+/* Average ticks between host interrupts. */
+#define SIM_HOST_INTR_TICKS                         (60000u)
+
+typedef struct
+{
+    uint64_t awakeUs;
+    uint64_t sleepUs;
+    uint32_t wakes;
+    uint32_t pings;
+    uint32_t earlyWakes;
+} sim_result_t;
+
+static cy_stc_qi_context_t gl_ctx;
+static cy_stc_qi_app_cbk_t gl_app;
+static cy_stc_qi_timer_wheel_t gl_wheel;
+static sim_result_t gl_res;
+static uint32_t gl_seed;
+static uint32_t gl_wakeTicks;
+static bool gl_active;
+static bool gl_object;
+
+/* Deep sleep is allowed between pings. */
+bool Cy_QiStack_Is_DeepSleep_Alowed(cy_stc_qi_context_t *qiCtx)
+{
+    (void)qiCtx;
+    return !gl_active;
+}
+
+static void app_lp_timer_start(struct cy_stc_qi_context *qiCtx, uint32_t ticks)
+{
+    (void)qiCtx;
+    gl_wakeTicks = ticks;
+}
+
+static void app_deep_sleep_enter(struct cy_stc_qi_context *qiCtx)
+{
+    (void)qiCtx;
+}
+
+/* A host interrupt ends the sleep early. */
+static uint32_t app_lp_timer_stop(struct cy_stc_qi_context *qiCtx)
+{
+    uint32_t elapsed = gl_wakeTicks;
+
+    (void)qiCtx;
+
+    if ((host_rand(&gl_seed) % SIM_HOST_INTR_TICKS) < gl_wakeTicks)
+    {
+        elapsed = 1u + (host_rand(&gl_seed) % gl_wakeTicks);
+    }
+    if (elapsed < gl_wakeTicks)
+    {
+        gl_res.earlyWakes++;
+    }
+
+    return elapsed;
+}
+
+static void sim_ping_end(cy_timer_id_t id, void *callbackContext);
+
+static void sim_ping(cy_timer_id_t id, void *callbackContext)
+{
+    (void)id;
+    (void)callbackContext;
+
+    gl_res.pings++;
+    gl_active = true;
+    if (gl_object)
+    {
+        (void)Cy_QiStack_Timer_Wheel_Start(&gl_wheel, NULL, CY_QI_TIMER_DIG_PING_TIME_ID,
+                CY_QI_TIMER_DIG_PING_TIME, sim_ping_end);
+    }
+    else
+    {
+        (void)Cy_QiStack_Timer_Wheel_Start(&gl_wheel, NULL, CY_QI_TIMER_DELAY_START_ID,
+                SIM_ANA_ACTIVE, sim_ping_end);
+    }
+}
+
+static void sim_ping_end(cy_timer_id_t id, void *callbackContext)
+{
+    (void)callbackContext;
+
+    gl_active = false;
+    (void)Cy_QiStack_Timer_Wheel_Start(&gl_wheel, NULL, CY_QI_TIMER_ANA_PING_INTERVAL_ID,
+            (id == CY_QI_TIMER_DIG_PING_TIME_ID) ? CY_QI_TIMER_DIG_PING_W_OBJ_INTERVAL : SIM_ANA_INTERVAL,
+            sim_ping);
+}
+
+static void sim_led(cy_timer_id_t id, void *callbackContext)
+{
+    gl_res.awakeUs += SIM_LED_US;
+    (void)Cy_QiStack_Timer_Wheel_Start(&gl_wheel, callbackContext, id, SIM_LED_INTERVAL, sim_led);
+}
+
+static void sim_run(bool tickless)
+{
+    uint32_t now = 0u;
+    uint32_t elapsed;
+    bool active;
+
+    gl_seed = 17u;
+    gl_active = false;
+    gl_res = (sim_result_t){0u};
+    gl_ctx.tickless = (cy_stc_qi_tickless_t){0u};
+
+    Cy_QiStack_Timer_Wheel_Init(&gl_wheel);
+    (void)Cy_QiStack_Timer_Wheel_Start(&gl_wheel, NULL, CY_QI_TIMER_ANA_PING_INTERVAL_ID,
+            CY_QI_TIMER_DELAY_START_TIME, sim_ping);
+    (void)Cy_QiStack_Timer_Wheel_Start(&gl_wheel, NULL, CY_SOLN_TIMER_0_TIME_ID, SIM_LED_INTERVAL, sim_led);
+
+    while (now < SIM_DAY_TICKS)
+    {
+        gl_object = (now >= SIM_OBJ_START_TICKS) && (now < SIM_OBJ_END_TICKS);
+
+        elapsed = tickless ? Cy_QiStack_Tickless_Idle(&gl_ctx, &gl_wheel) : 0u;
+        if (elapsed != 0u)
+        {
+            now += elapsed;
+            gl_res.wakes++;
+            gl_res.sleepUs += ((uint64_t)elapsed * 1000u) - SIM_WAKE_US;
+            gl_res.awakeUs += SIM_WAKE_US;
+            continue;
+        }
+
+        active = gl_active;
+        Cy_QiStack_Timer_Wheel_Tick(&gl_wheel, 1u);
+        now++;
+        gl_res.wakes++;
+        if (active)
+        {
+            gl_res.awakeUs += 1000u;
+        }
+        else
+        {
+            gl_res.sleepUs += 1000u - SIM_WAKE_US;
+            gl_res.awakeUs += SIM_WAKE_US;
+        }
+    }
+
+    printf("%-9s deep sleep residency %6.2f %%, %9u wakes, %6u pings, %4u early wakes\n",
+           tickless ? "tickless" : "1 ms tick",
+           (100.0 * (double)gl_res.sleepUs) / (double)(gl_res.sleepUs + gl_res.awakeUs),
+           (unsigned)gl_res.wakes, (unsigned)gl_res.pings, (unsigned)gl_res.earlyWakes);
+}
+
+int main(void)
+{
+    sim_result_t tick;
+    int result = 0;
+
+    gl_ctx.ptrAppCbk = &gl_app;
+    gl_app.lp_timer_start = app_lp_timer_start;
+    gl_app.lp_timer_stop = app_lp_timer_stop;
+    gl_app.deep_sleep_enter = app_deep_sleep_enter;
+
+    sim_run(false);
+    tick = gl_res;
+    sim_run(true);
+
+    printf("          %u sleeps, %u sleep ticks, %u early wakes, %u skipped\n",
+           (unsigned)gl_ctx.tickless.sleepCnt, (unsigned)gl_ctx.tickless.sleepTicks,
+           (unsigned)gl_ctx.tickless.earlyWakeCnt, (unsigned)gl_ctx.tickless.skipCnt);
+
+    /* Sleeping through the tick must not skip any ping. */
+    if ((gl_res.pings != tick.pings) || (gl_res.sleepUs <= tick.sleepUs))
+    {
+        printf("tickless idle changed the ping count or did not sleep longer\n");
+        result = 1;
+    }
+
+    return result;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,37 @@
+/***************************************************************************//**
+* \file size_ctx.c
+* \version 2.0
+*
+* Host size report of the QiStack context for the switch set it is built
+* with. Pointers are 8 bytes on the host, 4 on the target.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+
+#include "cy_qistack_common.h"
+
+#ifndef SIZE_CTX_CFG
+#define SIZE_CTX_CFG                                "default"
+#endif /* SIZE_CTX_CFG */
+
+int main(void)
+{
+    printf("%-10s context %5u, askBmc %4u", SIZE_CTX_CFG, (unsigned)sizeof(cy_stc_qi_context_t),
+           (unsigned)sizeof(cy_stc_qi_comm_ask_bmc_t));
+#if (CY_QI_BMC_RX_LUT_EN != 0)
+    printf(", bmcLut %4u, decoder %3u", (unsigned)sizeof(cy_stc_qi_bmc_lut_t),
+           (unsigned)sizeof(cy_stc_qi_bmc_lut_dec_t));
+#endif /* CY_QI_BMC_RX_LUT_EN */
+    printf("\n");
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,42 @@
+/***************************************************************************//**
+* \file cy_pdutils_sw_timer.h
+* \version 2.0
+*
+* Host stub of the PDUtils soft timer interface.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef CY_PDUTILS_SW_TIMER_H
+#define CY_PDUTILS_SW_TIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CY_PDUTILS_TIMER_USER_START_ID              (0xC0u)
+#define CY_PDUTILS_TIMER_WLC_START_ID               (0x300u)
+
+typedef uint16_t cy_timer_id_t;
+
+typedef void (*cy_cb_timer_t)(cy_timer_id_t id, void *callbackContext);
+
+typedef struct
+{
+    uint32_t reserved;
+} cy_stc_pdutils_sw_timer_t;
+
+bool Cy_PdUtils_SwTimer_Start(cy_stc_pdutils_sw_timer_t *context, void *callbackContext,
+        cy_timer_id_t id, uint16_t period, cy_cb_timer_t cb);
+void Cy_PdUtils_SwTimer_Stop(cy_stc_pdutils_sw_timer_t *context, cy_timer_id_t id);
+void Cy_PdUtils_SwTimer_StopRange(cy_stc_pdutils_sw_timer_t *context, cy_timer_id_t start,
+        cy_timer_id_t end);
+bool Cy_PdUtils_SwTimer_IsRunning(cy_stc_pdutils_sw_timer_t *context, cy_timer_id_t id);
+
+#endif /* CY_PDUTILS_SW_TIMER_H */
+
+/* [] END OF FILE */
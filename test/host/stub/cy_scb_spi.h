@@ -0,0 +1,28 @@
+/***************************************************************************//**
+* \file cy_scb_spi.h
+* \version 2.0
+*
+* Host stub of the PDL SCB SPI driver. The RX FIFO is provided by the test.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef CY_SCB_SPI_H
+#define CY_SCB_SPI_H
+
+#include "cy_usbpd_defines.h"
+
+#define CY_SCB_RX_INTR_LEVEL                        (1u)
+
+uint32_t Cy_SCB_SPI_GetNumInRxFifo(CySCB_Type const *base);
+uint32_t Cy_SCB_SPI_Read(CySCB_Type const *base);
+void Cy_SCB_ClearRxInterrupt(CySCB_Type *base, uint32_t interruptMask);
+
+#endif /* CY_SCB_SPI_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,35 @@
+/***************************************************************************//**
+* \file cy_syslib.h
+* \version 2.0
+*
+* Host stub of the PDL system library. Tests are single threaded, so critical
+* sections do nothing and barriers map to the compiler builtin.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef CY_SYSLIB_H
+#define CY_SYSLIB_H
+
+#include <stdint.h>
+
+#define __DMB()                                     __sync_synchronize()
+
+static inline uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+    return 0u;
+}
+
+static inline void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus)
+{
+    (void)savedIntrStatus;
+}
+
+#endif /* CY_SYSLIB_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,31 @@
+/***************************************************************************//**
+* \file cy_tcpwm_counter.h
+* \version 2.0
+*
+* Host stub of the PDL TCPWM counter driver, backed by the model in
+* host_tcpwm.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef CY_TCPWM_COUNTER_H
+#define CY_TCPWM_COUNTER_H
+
+#include "cy_usbpd_defines.h"
+
+#define CY_TCPWM_INT_ON_TC                          (1u)
+
+void Cy_TCPWM_Counter_SetPeriod(TCPWM_Type *base, uint32_t cntNum, uint32_t period);
+void Cy_TCPWM_Counter_SetCounter(TCPWM_Type *base, uint32_t cntNum, uint32_t count);
+void Cy_TCPWM_TriggerStart(TCPWM_Type *base, uint32_t counters);
+void Cy_TCPWM_TriggerStopOrKill(TCPWM_Type *base, uint32_t counters);
+void Cy_TCPWM_ClearInterrupt(TCPWM_Type *base, uint32_t cntNum, uint32_t source);
+
+#endif /* CY_TCPWM_COUNTER_H */
+
+/* [] END OF FILE */
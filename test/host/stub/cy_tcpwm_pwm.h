@@ -0,0 +1,26 @@
+/***************************************************************************//**
+* \file cy_tcpwm_pwm.h
+* \version 2.0
+*
+* Host stub of the PDL TCPWM PWM driver, backed by the model in host_tcpwm.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef CY_TCPWM_PWM_H
+#define CY_TCPWM_PWM_H
+
+#include "cy_usbpd_defines.h"
+
+void Cy_TCPWM_PWM_SetPeriod1(TCPWM_Type *base, uint32_t cntNum, uint32_t period1);
+void Cy_TCPWM_PWM_SetCompare1(TCPWM_Type *base, uint32_t cntNum, uint32_t compare1);
+void Cy_TCPWM_TriggerCaptureOrSwap(TCPWM_Type *base, uint32_t counters);
+
+#endif /* CY_TCPWM_PWM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,27 @@
+/***************************************************************************//**
+* \file cy_usbpd_common.h
+* \version 2.0
+*
+* Host stub of the PDL USBPD context.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef CY_USBPD_COMMON_H
+#define CY_USBPD_COMMON_H
+
+#include "cy_usbpd_defines.h"
+
+typedef struct
+{
+    uint32_t reserved;
+} cy_stc_usbpd_context_t;
+
+#endif /* CY_USBPD_COMMON_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,20 @@
+/***************************************************************************//**
+* \file cy_usbpd_config_table.h
+* \version 2.0
+*
+* Host stub of the PDL USBPD configuration table. Nothing is used on the host.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef CY_USBPD_CONFIG_TABLE_H
+#define CY_USBPD_CONFIG_TABLE_H
+
+#endif /* CY_USBPD_CONFIG_TABLE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,40 @@
+/***************************************************************************//**
+* \file cy_usbpd_defines.h
+* \version 2.0
+*
+* Host stub of the PDL USBPD definitions used by the QiStack headers.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef CY_USBPD_DEFINES_H
+#define CY_USBPD_DEFINES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef char char_t;
+typedef int IRQn_Type;
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t PERIOD;
+    volatile uint32_t PERIOD_BUFF;
+    volatile uint32_t COUNTER;
+} TCPWM_Type;
+
+typedef struct
+{
+    volatile uint32_t RX_FIFO_RD;
+    volatile uint32_t RX_FIFO_STATUS;
+} CySCB_Type;
+
+#endif /* CY_USBPD_DEFINES_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,387 @@
+/***************************************************************************//**
+* \file host_ifx_i2c.c
+* \version 2.0
+*
+* Host IFX I2C master for the OPTIGA benchmarks.
+*
+* Physical layer: a frame is written to DATA; I2C_STATE is then read every
+* PL_POLLING_INVERVAL_US until a frame is ready, or every
+* PL_DATA_POLLING_INVERVAL_US while a command executes, and the frame is read
+* from DATA. An address NACK is retried every PL_POLLING_INVERVAL_US, up to
+* PL_POLLING_MAX_CNT times. Accesses are PL_GUARD_TIME_INTERVAL_US apart.
+*
+* Data link layer: window of one frame. A frame read with a bad FCS is NAKed,
+* a frame NAKed or not acknowledged within PL_TRANS_TIMEOUT_MS is written
+* again, each up to DL_TRANS_REPEAT times. A failed transceive
+* resynchronizes the frame numbers.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "host_ifx_i2c.h"
+#include "host_optiga.h"
+#include "host_pal.h"
+
+#define IFX_I2C_TL_CHUNK(ctx)                       ((ctx)->frame_size - DL_HEADER_SIZE - TL_HEADER_SIZE)
+
+host_ifx_i2c_stats_t host_ifx_i2c_stats;
+
+static volatile bool gl_i2cDone;
+static optiga_lib_status_t gl_i2cEvent;
+
+/* Last frame written, for a NAK. */
+static uint8_t gl_lastFrame[IFX_I2C_FRAME_SIZE];
+static uint16_t gl_lastLen;
+
+/* Data frame that acknowledged ours, kept for the receive. */
+static bool gl_rxKept;
+static uint16_t gl_rxLen;
+
+static void pl_i2c_event(void *ctx, optiga_lib_status_t event)
+{
+    (void)ctx;
+    gl_i2cEvent = event;
+    gl_i2cDone = true;
+}
+
+static bool pl_access(ifx_i2c_context_t *p_ctx, bool read, uint8_t *data, uint16_t len)
+{
+    pal_status_t status;
+
+    for (p_ctx->pl.retry_counter = 0u; p_ctx->pl.retry_counter <= PL_POLLING_MAX_CNT; p_ctx->pl.retry_counter++)
+    {
+        gl_i2cDone = false;
+        status = read ? pal_i2c_read(p_ctx->p_pal_i2c_ctx, data, len) :
+                        pal_i2c_write(p_ctx->p_pal_i2c_ctx, data, len);
+        if (status == PAL_STATUS_SUCCESS)
+        {
+            host_pal_run(&gl_i2cDone);
+            if (gl_i2cEvent == PAL_I2C_EVENT_SUCCESS)
+            {
+                host_pal_wait_us(PL_GUARD_TIME_INTERVAL_US);
+                return true;
+            }
+        }
+        host_ifx_i2c_stats.nackRetryCnt++;
+        host_pal_wait_us(PL_POLLING_INVERVAL_US);
+    }
+
+    return false;
+}
+
+static bool pl_write_frame(ifx_i2c_context_t *p_ctx, const uint8_t *frame, uint16_t len)
+{
+    p_ctx->pl.buffer[0] = HOST_OPTIGA_REG_DATA;
+    memcpy(&p_ctx->pl.buffer[1], frame, len);
+    host_ifx_i2c_stats.txFrameCnt++;
+
+    return pl_access(p_ctx, false, p_ctx->pl.buffer, (uint16_t)(len + 1u));
+}
+
+/* Reads the next frame into rx_frame_buffer. */
+static bool pl_read_frame(ifx_i2c_context_t *p_ctx, uint32_t timeoutUs, uint32_t pollUs, uint16_t *len)
+{
+    uint8_t state[HOST_OPTIGA_STATE_LEN];
+    uint32_t start = pal_os_timer_get_time_in_microseconds();
+    uint16_t frameLen;
+
+    for (;;)
+    {
+        p_ctx->pl.buffer[0] = HOST_OPTIGA_REG_STATE;
+        if ((!pl_access(p_ctx, false, p_ctx->pl.buffer, 1u)) ||
+            (!pl_access(p_ctx, true, state, HOST_OPTIGA_STATE_LEN)))
+        {
+            return false;
+        }
+
+        frameLen = (uint16_t)((state[2] << 8u) | state[3]);
+        if (((state[0] & HOST_OPTIGA_STATE_RESP_RDY) != 0u) && (frameLen != 0u) && (frameLen <= p_ctx->frame_size))
+        {
+            p_ctx->pl.buffer[0] = HOST_OPTIGA_REG_DATA;
+            if ((!pl_access(p_ctx, false, p_ctx->pl.buffer, 1u)) ||
+                (!pl_access(p_ctx, true, p_ctx->rx_frame_buffer, frameLen)))
+            {
+                return false;
+            }
+            host_ifx_i2c_stats.rxFrameCnt++;
+            *len = frameLen;
+            return true;
+        }
+
+        if ((pal_os_timer_get_time_in_microseconds() - start) >= timeoutUs)
+        {
+            host_ifx_i2c_stats.timeoutCnt++;
+            return false;
+        }
+        host_ifx_i2c_stats.pollCnt++;
+        host_pal_wait_us(((state[0] & HOST_OPTIGA_STATE_BUSY) != 0u) ? PL_DATA_POLLING_INVERVAL_US : pollUs);
+    }
+}
+
+static uint16_t dl_build(uint8_t *frame, uint8_t fctr, const uint8_t *payload, uint16_t len)
+{
+    uint16_t fcs;
+
+    frame[0] = fctr;
+    frame[1] = (uint8_t)(len >> 8u);
+    frame[2] = (uint8_t)len;
+    if (len != 0u)
+    {
+        memcpy(&frame[3], payload, len);
+    }
+    fcs = host_optiga_fcs(frame, (uint16_t)(len + 3u));
+    frame[len + 3u] = (uint8_t)(fcs >> 8u);
+    frame[len + 4u] = (uint8_t)fcs;
+
+    return (uint16_t)(len + DL_HEADER_SIZE);
+}
+
+static bool dl_write(ifx_i2c_context_t *p_ctx, const uint8_t *frame, uint16_t len)
+{
+    if (frame != gl_lastFrame)
+    {
+        memcpy(gl_lastFrame, frame, len);
+        gl_lastLen = len;
+    }
+
+    return pl_write_frame(p_ctx, gl_lastFrame, gl_lastLen);
+}
+
+static bool dl_control(ifx_i2c_context_t *p_ctx, uint8_t seq, uint8_t acknr)
+{
+    uint8_t frame[DL_HEADER_SIZE];
+
+    return dl_write(p_ctx, frame, dl_build(frame, (uint8_t)(HOST_OPTIGA_FCTR_CONTROL | seq | acknr), NULL, 0u));
+}
+
+static bool dl_frame_ok(const uint8_t *frame, uint16_t len)
+{
+    return (len >= DL_HEADER_SIZE) && ((((uint16_t)(frame[1] << 8u) | frame[2]) + DL_HEADER_SIZE) == len) &&
+           (host_optiga_fcs(frame, (uint16_t)(len - 2u)) == (uint16_t)((frame[len - 2u] << 8u) | frame[len - 1u]));
+}
+
+/* Reads a frame with a good FCS, NAKing bad ones. */
+static bool dl_read(ifx_i2c_context_t *p_ctx, uint32_t timeoutUs, uint32_t pollUs, uint16_t *len)
+{
+    uint8_t naks;
+
+    for (naks = 0u; naks <= DL_TRANS_REPEAT; naks++)
+    {
+        if (!pl_read_frame(p_ctx, timeoutUs, pollUs, len))
+        {
+            return false;
+        }
+        if (dl_frame_ok(p_ctx->rx_frame_buffer, *len))
+        {
+            return true;
+        }
+        host_ifx_i2c_stats.nakCnt++;
+        if (!dl_control(p_ctx, HOST_OPTIGA_FCTR_SEQ_NAK, p_ctx->dl.rx_seq_nr))
+        {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+static bool dl_send(ifx_i2c_context_t *p_ctx, const uint8_t *payload, uint16_t len)
+{
+    uint8_t fctr;
+    uint16_t rxLen;
+
+    if (!dl_write(p_ctx, p_ctx->tx_frame_buffer,
+                  dl_build(p_ctx->tx_frame_buffer, HOST_OPTIGA_FCTR(p_ctx->dl.tx_seq_nr, p_ctx->dl.rx_seq_nr),
+                           payload, len)))
+    {
+        return false;
+    }
+
+    for (p_ctx->dl.retransmit_counter = 0u; p_ctx->dl.retransmit_counter <= DL_TRANS_REPEAT;
+         p_ctx->dl.retransmit_counter++)
+    {
+        if (dl_read(p_ctx, PL_TRANS_TIMEOUT_MS * 1000u, PL_POLLING_INVERVAL_US, &rxLen))
+        {
+            fctr = p_ctx->rx_frame_buffer[0];
+            if (HOST_OPTIGA_FCTR_ACKNR(fctr) == p_ctx->dl.tx_seq_nr)
+            {
+                if ((fctr & HOST_OPTIGA_FCTR_CONTROL) == 0u)
+                {
+                    /* The response acknowledges the frame. */
+                    gl_rxKept = true;
+                    gl_rxLen = rxLen;
+                }
+                if (((fctr & HOST_OPTIGA_FCTR_CONTROL) == 0u) ||
+                    ((fctr & HOST_OPTIGA_FCTR_SEQ_MASK) == HOST_OPTIGA_FCTR_SEQ_ACK))
+                {
+                    p_ctx->dl.tx_seq_nr = (p_ctx->dl.tx_seq_nr + 1u) & 0x03u;
+                    return true;
+                }
+            }
+        }
+
+        host_ifx_i2c_stats.resendCnt++;
+        if (!pl_write_frame(p_ctx, gl_lastFrame, gl_lastLen))
+        {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+/* Receives the next data frame into rx_frame_buffer and acknowledges it. */
+static bool dl_receive(ifx_i2c_context_t *p_ctx, uint32_t timeoutUs, uint16_t *len)
+{
+    uint8_t fctr;
+    uint8_t tries;
+
+    for (tries = 0u; tries <= (2u * DL_TRANS_REPEAT); tries++)
+    {
+        if (gl_rxKept)
+        {
+            gl_rxKept = false;
+            *len = gl_rxLen;
+        }
+        else if (!dl_read(p_ctx, timeoutUs, PL_POLLING_INVERVAL_US, len))
+        {
+            return false;
+        }
+
+        fctr = p_ctx->rx_frame_buffer[0];
+        if ((fctr & HOST_OPTIGA_FCTR_CONTROL) != 0u)
+        {
+            /* The device NAKed our ACK: write it again. */
+            if ((fctr & HOST_OPTIGA_FCTR_SEQ_MASK) == HOST_OPTIGA_FCTR_SEQ_NAK)
+            {
+                host_ifx_i2c_stats.resendCnt++;
+                if (!pl_write_frame(p_ctx, gl_lastFrame, gl_lastLen))
+                {
+                    return false;
+                }
+            }
+            continue;
+        }
+
+        if (HOST_OPTIGA_FCTR_FRNR(fctr) != p_ctx->dl.rx_seq_nr)
+        {
+            p_ctx->dl.rx_seq_nr = HOST_OPTIGA_FCTR_FRNR(fctr);
+            return dl_control(p_ctx, HOST_OPTIGA_FCTR_SEQ_ACK, p_ctx->dl.rx_seq_nr);
+        }
+
+        /* Repeated as our ACK was lost. */
+        if (!dl_control(p_ctx, HOST_OPTIGA_FCTR_SEQ_ACK, p_ctx->dl.rx_seq_nr))
+        {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+static void dl_resync(ifx_i2c_context_t *p_ctx)
+{
+    host_ifx_i2c_stats.resyncCnt++;
+    (void)dl_control(p_ctx, HOST_OPTIGA_FCTR_SEQ_RESYNC, 0u);
+    p_ctx->dl.tx_seq_nr = 0u;
+    p_ctx->dl.rx_seq_nr = 3u;
+    gl_rxKept = false;
+}
+
+static bool tl_transceive(ifx_i2c_context_t *p_ctx, const uint8_t *p_packet, uint16_t packet_len,
+                          uint8_t *p_recv_packet, uint16_t *p_recv_packet_len)
+{
+    uint8_t payload[IFX_I2C_FRAME_SIZE];
+    uint16_t chunk = (uint16_t)IFX_I2C_TL_CHUNK(p_ctx);
+    uint16_t off = 0u;
+    uint16_t len;
+    uint16_t rxLen;
+    uint8_t pctr;
+
+    do
+    {
+        len = (uint16_t)(packet_len - off);
+        if (len > chunk)
+        {
+            len = chunk;
+            pctr = (off == 0u) ? HOST_OPTIGA_PCTR_FIRST : HOST_OPTIGA_PCTR_NEXT;
+        }
+        else
+        {
+            pctr = (off == 0u) ? HOST_OPTIGA_PCTR_SINGLE : HOST_OPTIGA_PCTR_LAST;
+        }
+        payload[0] = pctr;
+        memcpy(&payload[TL_HEADER_SIZE], &p_packet[off], len);
+        if (!dl_send(p_ctx, payload, (uint16_t)(len + TL_HEADER_SIZE)))
+        {
+            return false;
+        }
+        off += len;
+    } while (off < packet_len);
+
+    off = 0u;
+    do
+    {
+        if (!dl_receive(p_ctx, TL_MAX_EXIT_TIMEOUT * 1000u, &rxLen))
+        {
+            return false;
+        }
+        len = (uint16_t)(rxLen - DL_HEADER_SIZE - TL_HEADER_SIZE);
+        pctr = p_ctx->rx_frame_buffer[IFX_I2C_TL_HEADER_OFFSET] & HOST_OPTIGA_PCTR_CHAIN_MASK;
+        if ((off + len) > *p_recv_packet_len)
+        {
+            return false;
+        }
+        memcpy(&p_recv_packet[off], &p_ctx->rx_frame_buffer[IFX_I2C_TL_HEADER_OFFSET + TL_HEADER_SIZE], len);
+        off += len;
+    } while ((pctr != HOST_OPTIGA_PCTR_SINGLE) && (pctr != HOST_OPTIGA_PCTR_LAST));
+
+    *p_recv_packet_len = off;
+    host_ifx_i2c_stats.apduByteCnt += (uint64_t)packet_len + off;
+
+    return true;
+}
+
+optiga_lib_status_t ifx_i2c_tl_init(ifx_i2c_context_t *p_ctx, ifx_i2c_event_handler_t handler)
+{
+    p_ctx->tl.upper_layer_event_handler = handler;
+    p_ctx->p_pal_i2c_ctx->upper_layer_event_handler = (void *)pl_i2c_event;
+    p_ctx->p_pal_i2c_ctx->p_upper_layer_ctx = p_ctx;
+    if (p_ctx->frame_size == 0u)
+    {
+        p_ctx->frame_size = IFX_I2C_FRAME_SIZE;
+    }
+    p_ctx->dl.tx_seq_nr = 0u;
+    p_ctx->dl.rx_seq_nr = 3u;
+    gl_rxKept = false;
+
+    return (pal_i2c_init(p_ctx->p_pal_i2c_ctx) == PAL_STATUS_SUCCESS) ? IFX_I2C_STACK_SUCCESS : IFX_I2C_STACK_ERROR;
+}
+
+optiga_lib_status_t ifx_i2c_tl_transceive(ifx_i2c_context_t *p_ctx, uint8_t *p_packet, uint16_t packet_len,
+                                          uint8_t *p_recv_packet, uint16_t *p_recv_packet_len)
+{
+    optiga_lib_status_t event = IFX_I2C_STACK_SUCCESS;
+
+    host_ifx_i2c_stats.xferCnt++;
+    if (!tl_transceive(p_ctx, p_packet, packet_len, p_recv_packet, p_recv_packet_len))
+    {
+        host_ifx_i2c_stats.xferErrCnt++;
+        dl_resync(p_ctx);
+        *p_recv_packet_len = 0u;
+        event = IFX_I2C_STACK_ERROR;
+    }
+
+    p_ctx->tl.upper_layer_event_handler(p_ctx, event, p_recv_packet, *p_recv_packet_len);
+
+    return IFX_I2C_STACK_SUCCESS;
+}
+
+/* [] END OF FILE */
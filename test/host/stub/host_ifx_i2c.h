@@ -0,0 +1,61 @@
+/***************************************************************************//**
+* \file host_ifx_i2c.h
+* \version 2.0
+*
+* Host IFX I2C master for the OPTIGA benchmarks: ifx_i2c_tl_init and
+* ifx_i2c_tl_transceive of the shipped transport layer header, on pal_i2c,
+* with the data link and physical layer parameters of ifx_i2c_config.h. The
+* prebuilt stack is ARM only. Unlike it, a transceive runs to completion,
+* with host_pal_run, and raises its handler before returning.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef HOST_IFX_I2C_H
+#define HOST_IFX_I2C_H
+
+#include <stdint.h>
+
+#include "ifx_i2c_config.h"
+#include "ifx_i2c_transport_layer.h"
+
+typedef struct
+{
+    /* Transceives, and those that failed */
+    uint32_t xferCnt;
+    uint32_t xferErrCnt;
+
+    /* Frames written and read */
+    uint32_t txFrameCnt;
+    uint32_t rxFrameCnt;
+
+    /* Frames written again after a NAK or no answer */
+    uint32_t resendCnt;
+
+    /* NAKs sent for frames read with a bad FCS */
+    uint32_t nakCnt;
+
+    /* Bus accesses repeated after an address NACK */
+    uint32_t nackRetryCnt;
+
+    /* I2C_STATE reads without a frame ready */
+    uint32_t pollCnt;
+
+    /* Frames not ready in time, and resynchronizations */
+    uint32_t timeoutCnt;
+    uint32_t resyncCnt;
+
+    /* Command and response bytes */
+    uint64_t apduByteCnt;
+} host_ifx_i2c_stats_t;
+
+extern host_ifx_i2c_stats_t host_ifx_i2c_stats;
+
+#endif /* HOST_IFX_I2C_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,567 @@
+/***************************************************************************//**
+* \file host_optiga.c
+* \version 2.0
+*
+* Host model of an OPTIGA Trust device on I2C.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "ifx_i2c_config.h"
+#include "host_clock.h"
+#include "host_optiga.h"
+
+/* Transport payload of one data frame, after the PCTR byte. */
+#define OPTIGA_CHUNK                                (IFX_I2C_FRAME_SIZE - HOST_OPTIGA_DL_OVERHEAD - TL_HEADER_SIZE)
+
+typedef struct
+{
+    uint16_t oid;
+    uint16_t len;
+    uint8_t data[HOST_OPTIGA_APDU_MAX];
+} optiga_object_t;
+
+typedef struct
+{
+    host_optiga_cfg_t cfg;
+    uint32_t seed;
+    bool held;
+
+    /* Bus NACKed until busyUntil; register of the next read */
+    uint64_t busyUntil;
+    uint8_t reg;
+
+    /* Frame offered on DATA, readable from outAt */
+    uint8_t out[IFX_I2C_FRAME_SIZE];
+    uint16_t outLen;
+    uint64_t outAt;
+    bool outReady;
+    bool outSent;
+
+    /* Data link: next frame number to send, last one received */
+    uint8_t txNext;
+    uint8_t rxLast;
+    bool txWaitAck;
+
+    /* Command being received, and its response being sent */
+    uint8_t apdu[HOST_OPTIGA_APDU_MAX];
+    uint16_t apduLen;
+    uint8_t rsp[HOST_OPTIGA_APDU_MAX + HOST_OPTIGA_APDU_HDR];
+    uint16_t rspLen;
+    uint16_t rspOff;
+    uint64_t rspAt;
+    bool rspPending;
+    bool exec;
+
+    optiga_object_t obj[HOST_OPTIGA_OBJECTS];
+    uint8_t objCnt;
+
+    /* Application open; hibernated context and the handle that restores it */
+    bool appOpen;
+    bool ctxSaved;
+    uint8_t ctxHandle[HOST_OPTIGA_CONTEXT_LEN];
+    uint32_t ctxCnt;
+} optiga_dev_t;
+
+host_optiga_stats_t host_optiga_stats;
+
+static optiga_dev_t gl_dev;
+
+static bool optiga_probe(void *ctx);
+static bool optiga_write(void *ctx, const uint8_t *data, uint16_t len);
+static bool optiga_read(void *ctx, uint8_t *data, uint16_t len);
+
+const host_pal_i2c_dev_t host_optiga_dev =
+{
+    optiga_probe,
+    optiga_write,
+    optiga_read,
+    &gl_dev
+};
+
+/* Reflected CRC-16 CCITT, a byte at a time. */
+uint16_t host_optiga_fcs(const uint8_t *data, uint16_t len)
+{
+    uint16_t crc = 0u;
+    uint16_t h1;
+    uint16_t h2;
+    uint16_t h3;
+    uint16_t h4;
+    uint16_t idx;
+
+    for (idx = 0u; idx < len; idx++)
+    {
+        h1 = (crc ^ data[idx]) & 0xFFu;
+        h2 = h1 & 0x0Fu;
+        h3 = (uint16_t)(h2 << 4u) ^ h1;
+        h4 = h3 >> 4u;
+        crc = (uint16_t)((uint16_t)((uint16_t)((uint16_t)((uint16_t)(h3 << 1u) ^ h4) << 4u) ^ h2) << 3u) ^
+              h4 ^ (crc >> 8u);
+    }
+
+    return crc;
+}
+
+static uint32_t optiga_between(uint32_t min, uint32_t max)
+{
+    return (max > min) ? (min + (host_rand(&gl_dev.seed) % (max - min + 1u))) : min;
+}
+
+static void optiga_flip(uint8_t *data, uint16_t len)
+{
+    uint16_t idx;
+    uint8_t bit;
+
+    if (gl_dev.cfg.berPpm == 0u)
+    {
+        return;
+    }
+    for (idx = 0u; idx < len; idx++)
+    {
+        for (bit = 0u; bit < 8u; bit++)
+        {
+            if ((host_rand(&gl_dev.seed) % 1000000u) < gl_dev.cfg.berPpm)
+            {
+                data[idx] ^= (uint8_t)(1u << bit);
+                host_optiga_stats.bitErrCnt++;
+            }
+        }
+    }
+}
+
+static uint64_t optiga_frame_time(uint64_t now)
+{
+    uint64_t done = now + ((uint64_t)optiga_between(gl_dev.cfg.frameMinUs, gl_dev.cfg.frameMaxUs) * 1000u);
+
+    gl_dev.busyUntil = done;
+
+    return done;
+}
+
+/* Offers a frame on DATA once the frame in processing is done. */
+static void optiga_offer(uint8_t fctr, const uint8_t *payload, uint16_t len, uint64_t at)
+{
+    uint16_t fcs;
+
+    gl_dev.out[0] = fctr;
+    gl_dev.out[1] = (uint8_t)(len >> 8u);
+    gl_dev.out[2] = (uint8_t)len;
+    if (len != 0u)
+    {
+        memcpy(&gl_dev.out[3], payload, len);
+    }
+    fcs = host_optiga_fcs(gl_dev.out, (uint16_t)(len + 3u));
+    gl_dev.out[len + 3u] = (uint8_t)(fcs >> 8u);
+    gl_dev.out[len + 4u] = (uint8_t)fcs;
+    gl_dev.outLen = (uint16_t)(len + HOST_OPTIGA_DL_OVERHEAD);
+    gl_dev.outAt = at;
+    gl_dev.outReady = true;
+    gl_dev.outSent = true;
+}
+
+static void optiga_control(uint8_t seq, uint8_t acknr, uint64_t at)
+{
+    optiga_offer((uint8_t)(HOST_OPTIGA_FCTR_CONTROL | seq | acknr), NULL, 0u, at);
+}
+
+/* Frames the next response chunk once the command has executed. */
+static void optiga_update(uint64_t now)
+{
+    uint8_t payload[OPTIGA_CHUNK + TL_HEADER_SIZE];
+    uint16_t len = (uint16_t)(gl_dev.rspLen - gl_dev.rspOff);
+    uint8_t pctr;
+
+    if (gl_dev.outReady || (!gl_dev.rspPending) || gl_dev.txWaitAck || (now < gl_dev.rspAt))
+    {
+        return;
+    }
+
+    if (len > OPTIGA_CHUNK)
+    {
+        len = OPTIGA_CHUNK;
+        pctr = (gl_dev.rspOff == 0u) ? HOST_OPTIGA_PCTR_FIRST : HOST_OPTIGA_PCTR_NEXT;
+    }
+    else
+    {
+        pctr = (gl_dev.rspOff == 0u) ? HOST_OPTIGA_PCTR_SINGLE : HOST_OPTIGA_PCTR_LAST;
+    }
+    payload[0] = pctr;
+    memcpy(&payload[TL_HEADER_SIZE], &gl_dev.rsp[gl_dev.rspOff], len);
+
+    optiga_offer(HOST_OPTIGA_FCTR(gl_dev.txNext, gl_dev.rxLast), payload, (uint16_t)(len + TL_HEADER_SIZE),
+                 gl_dev.rspAt);
+    gl_dev.txNext = (gl_dev.txNext + 1u) & 0x03u;
+    gl_dev.txWaitAck = true;
+    gl_dev.exec = false;
+    gl_dev.rspOff += len;
+    gl_dev.rspPending = (gl_dev.rspOff < gl_dev.rspLen);
+}
+
+static const optiga_object_t *optiga_find(uint16_t oid)
+{
+    uint8_t idx;
+
+    for (idx = 0u; idx < gl_dev.objCnt; idx++)
+    {
+        if (gl_dev.obj[idx].oid == oid)
+        {
+            return &gl_dev.obj[idx];
+        }
+    }
+
+    return NULL;
+}
+
+static void optiga_execute(uint64_t now)
+{
+    const uint8_t *data = &gl_dev.apdu[HOST_OPTIGA_APDU_HDR];
+    const optiga_object_t *obj;
+    uint16_t len = 0u;
+    uint16_t off;
+    uint32_t us = gl_dev.cfg.readUs;
+    uint8_t sta = HOST_OPTIGA_STA_ERROR;
+
+    host_optiga_stats.cmdCnt++;
+
+    if ((gl_dev.apdu[0] == HOST_OPTIGA_CMD_GET_DATA_OBJECT) && (gl_dev.apduLen >= (HOST_OPTIGA_APDU_HDR + 6u)))
+    {
+        obj = optiga_find((uint16_t)((data[0] << 8u) | data[1]));
+        off = (uint16_t)((data[2] << 8u) | data[3]);
+        len = (uint16_t)((data[4] << 8u) | data[5]);
+        if ((obj != NULL) && (off < obj->len))
+        {
+            if (len > (obj->len - off))
+            {
+                len = (uint16_t)(obj->len - off);
+            }
+            memcpy(&gl_dev.rsp[HOST_OPTIGA_APDU_HDR], &obj->data[off], len);
+            sta = HOST_OPTIGA_STA_SUCCESS;
+        }
+        else
+        {
+            len = 0u;
+        }
+    }
+    else if ((gl_dev.apdu[0] == HOST_OPTIGA_CMD_CALC_SIGN) && (gl_dev.apduLen > (HOST_OPTIGA_APDU_HDR + 3u)))
+    {
+        /* Digest tag, length, digest. */
+        host_optiga_sign(&data[3], (uint16_t)((data[1] << 8u) | data[2]), &gl_dev.rsp[HOST_OPTIGA_APDU_HDR]);
+        len = HOST_OPTIGA_SIGN_LEN;
+        us = optiga_between(gl_dev.cfg.signMinUs, gl_dev.cfg.signMaxUs);
+        sta = HOST_OPTIGA_STA_SUCCESS;
+    }
+    else if (gl_dev.apdu[0] == HOST_OPTIGA_CMD_OPEN_APP)
+    {
+        if (gl_dev.apdu[1] == HOST_OPTIGA_APP_CLEAN)
+        {
+            /* A clean open discards a hibernated context. */
+            gl_dev.ctxSaved = false;
+            gl_dev.appOpen = true;
+            us = gl_dev.cfg.openUs;
+            sta = HOST_OPTIGA_STA_SUCCESS;
+        }
+        else
+        {
+            /* The context handle follows the AID; a context restores once. */
+            us = gl_dev.cfg.restoreUs;
+            if ((gl_dev.ctxSaved) && (gl_dev.apduLen == (HOST_OPTIGA_APDU_HDR + HOST_OPTIGA_AID_LEN +
+                                                         HOST_OPTIGA_CONTEXT_LEN)) &&
+                (memcmp(&data[HOST_OPTIGA_AID_LEN], gl_dev.ctxHandle, HOST_OPTIGA_CONTEXT_LEN) == 0))
+            {
+                gl_dev.ctxSaved = false;
+                gl_dev.appOpen = true;
+                sta = HOST_OPTIGA_STA_SUCCESS;
+            }
+        }
+    }
+    else if ((gl_dev.apdu[0] == HOST_OPTIGA_CMD_CLOSE_APP) && (gl_dev.appOpen))
+    {
+        gl_dev.appOpen = false;
+        us = gl_dev.cfg.closeUs;
+        sta = HOST_OPTIGA_STA_SUCCESS;
+        if (gl_dev.apdu[1] == HOST_OPTIGA_APP_HIBERNATE)
+        {
+            gl_dev.ctxCnt++;
+            for (off = 0u; off < HOST_OPTIGA_CONTEXT_LEN; off++)
+            {
+                gl_dev.ctxHandle[off] = (uint8_t)((gl_dev.ctxCnt * 0x9Du) + off + 1u);
+            }
+            memcpy(&gl_dev.rsp[HOST_OPTIGA_APDU_HDR], gl_dev.ctxHandle, HOST_OPTIGA_CONTEXT_LEN);
+            len = HOST_OPTIGA_CONTEXT_LEN;
+            gl_dev.ctxSaved = true;
+        }
+    }
+    else
+    {
+        /* Unknown command. */
+    }
+
+    gl_dev.rsp[0] = sta;
+    gl_dev.rsp[1] = 0u;
+    gl_dev.rsp[2] = (uint8_t)(len >> 8u);
+    gl_dev.rsp[3] = (uint8_t)len;
+    gl_dev.rspLen = (uint16_t)(len + HOST_OPTIGA_APDU_HDR);
+    gl_dev.rspOff = 0u;
+    gl_dev.rspAt = now + ((uint64_t)us * 1000u);
+    gl_dev.rspPending = true;
+    gl_dev.exec = true;
+    host_optiga_stats.execNs += (uint64_t)us * 1000u;
+}
+
+static void optiga_data_frame(const uint8_t *frame, uint16_t len, uint64_t at)
+{
+    uint8_t frnr = HOST_OPTIGA_FCTR_FRNR(frame[0]);
+    uint8_t pctr;
+
+    /* A data frame acknowledges the last one sent. */
+    if (gl_dev.txWaitAck && (HOST_OPTIGA_FCTR_ACKNR(frame[0]) == ((gl_dev.txNext + 3u) & 0x03u)))
+    {
+        gl_dev.txWaitAck = false;
+    }
+
+    if (frnr == gl_dev.rxLast)
+    {
+        /* Repeated as our ACK was lost. */
+        host_optiga_stats.dupCnt++;
+        optiga_control(HOST_OPTIGA_FCTR_SEQ_ACK, frnr, at);
+        return;
+    }
+    if ((frnr != ((gl_dev.rxLast + 1u) & 0x03u)) || (len == 0u))
+    {
+        host_optiga_stats.nakTxCnt++;
+        optiga_control(HOST_OPTIGA_FCTR_SEQ_NAK, gl_dev.rxLast, at);
+        return;
+    }
+    gl_dev.rxLast = frnr;
+    optiga_control(HOST_OPTIGA_FCTR_SEQ_ACK, frnr, at);
+
+    pctr = frame[3] & HOST_OPTIGA_PCTR_CHAIN_MASK;
+    if ((pctr == HOST_OPTIGA_PCTR_SINGLE) || (pctr == HOST_OPTIGA_PCTR_FIRST))
+    {
+        gl_dev.apduLen = 0u;
+    }
+    len -= TL_HEADER_SIZE;
+    if ((gl_dev.apduLen + len) > HOST_OPTIGA_APDU_MAX)
+    {
+        len = (uint16_t)(HOST_OPTIGA_APDU_MAX - gl_dev.apduLen);
+    }
+    memcpy(&gl_dev.apdu[gl_dev.apduLen], &frame[3u + TL_HEADER_SIZE], len);
+    gl_dev.apduLen += len;
+
+    if ((pctr == HOST_OPTIGA_PCTR_SINGLE) || (pctr == HOST_OPTIGA_PCTR_LAST))
+    {
+        optiga_execute(at);
+    }
+}
+
+static void optiga_frame(uint8_t *frame, uint16_t len, uint64_t now)
+{
+    uint64_t at = optiga_frame_time(now);
+    uint16_t plen;
+
+    optiga_flip(frame, len);
+    host_optiga_stats.rxFrameCnt++;
+
+    plen = (len >= HOST_OPTIGA_DL_OVERHEAD) ? (uint16_t)((frame[1] << 8u) | frame[2]) : 0u;
+    if ((len < HOST_OPTIGA_DL_OVERHEAD) || ((plen + HOST_OPTIGA_DL_OVERHEAD) != len) ||
+        (host_optiga_fcs(frame, (uint16_t)(len - 2u)) != (uint16_t)((frame[len - 2u] << 8u) | frame[len - 1u])))
+    {
+        host_optiga_stats.fcsErrCnt++;
+        host_optiga_stats.nakTxCnt++;
+        optiga_control(HOST_OPTIGA_FCTR_SEQ_NAK, gl_dev.rxLast, at);
+        return;
+    }
+
+    if ((frame[0] & HOST_OPTIGA_FCTR_CONTROL) == 0u)
+    {
+        optiga_data_frame(frame, plen, at);
+        return;
+    }
+
+    switch (frame[0] & HOST_OPTIGA_FCTR_SEQ_MASK)
+    {
+        case HOST_OPTIGA_FCTR_SEQ_ACK:
+            if (gl_dev.txWaitAck && (HOST_OPTIGA_FCTR_ACKNR(frame[0]) == ((gl_dev.txNext + 3u) & 0x03u)))
+            {
+                gl_dev.txWaitAck = false;
+                gl_dev.rspAt = at;
+            }
+            break;
+        case HOST_OPTIGA_FCTR_SEQ_NAK:
+            /* Offer the last frame again. */
+            if (gl_dev.outSent)
+            {
+                host_optiga_stats.resendCnt++;
+                gl_dev.outReady = true;
+                gl_dev.outAt = at;
+            }
+            break;
+        default:
+            /* Resynchronization: restart the frame numbers. */
+            gl_dev.txNext = 0u;
+            gl_dev.rxLast = 3u;
+            gl_dev.txWaitAck = false;
+            gl_dev.rspPending = false;
+            gl_dev.exec = false;
+            break;
+    }
+}
+
+/* The address is NACKed in reset and while a frame is processed. */
+static bool optiga_probe(void *ctx)
+{
+    (void)ctx;
+
+    return (!gl_dev.held) && (host_pal_time_ns() >= gl_dev.busyUntil);
+}
+
+static bool optiga_write(void *ctx, const uint8_t *data, uint16_t len)
+{
+    uint8_t frame[IFX_I2C_FRAME_SIZE];
+    uint64_t now = host_pal_time_ns();
+
+    (void)ctx;
+    if (len == 0u)
+    {
+        return false;
+    }
+
+    gl_dev.reg = data[0];
+    if ((data[0] == HOST_OPTIGA_REG_DATA) && (len > 1u))
+    {
+        len--;
+        if (len > IFX_I2C_FRAME_SIZE)
+        {
+            len = IFX_I2C_FRAME_SIZE;
+        }
+        memcpy(frame, &data[1], len);
+        optiga_frame(frame, len, now);
+    }
+    else if (data[0] == HOST_OPTIGA_REG_SOFT_RESET)
+    {
+        host_optiga_init(&gl_dev.cfg);
+    }
+    else
+    {
+        /* Register address of the next read. */
+    }
+
+    return true;
+}
+
+static bool optiga_read(void *ctx, uint8_t *data, uint16_t len)
+{
+    uint64_t now = host_pal_time_ns();
+    bool ready;
+
+    (void)ctx;
+    optiga_update(now);
+    ready = gl_dev.outReady && (now >= gl_dev.outAt);
+
+    if (gl_dev.reg == HOST_OPTIGA_REG_STATE)
+    {
+        uint8_t state[HOST_OPTIGA_STATE_LEN] = {0u};
+
+        if (gl_dev.exec)
+        {
+            state[0] |= HOST_OPTIGA_STATE_BUSY;
+            host_optiga_stats.busyPollCnt++;
+        }
+        if (ready)
+        {
+            state[0] |= HOST_OPTIGA_STATE_RESP_RDY;
+            state[2] = (uint8_t)(gl_dev.outLen >> 8u);
+            state[3] = (uint8_t)gl_dev.outLen;
+        }
+        memcpy(data, state, (len < HOST_OPTIGA_STATE_LEN) ? len : HOST_OPTIGA_STATE_LEN);
+        return true;
+    }
+
+    if ((gl_dev.reg != HOST_OPTIGA_REG_DATA) || (!ready))
+    {
+        return false;
+    }
+
+    if (len > gl_dev.outLen)
+    {
+        len = gl_dev.outLen;
+    }
+    memcpy(data, gl_dev.out, len);
+    optiga_flip(data, len);
+    gl_dev.outReady = false;
+    host_optiga_stats.txFrameCnt++;
+    host_optiga_stats.readyWaitNs += now - gl_dev.outAt;
+
+    return true;
+}
+
+void host_optiga_init(const host_optiga_cfg_t *cfg)
+{
+    gl_dev.cfg = *cfg;
+    gl_dev.seed = (cfg->seed != 0u) ? cfg->seed : 1u;
+    gl_dev.busyUntil = 0u;
+    gl_dev.reg = HOST_OPTIGA_REG_STATE;
+    gl_dev.outReady = false;
+    gl_dev.outSent = false;
+    gl_dev.txNext = 0u;
+    gl_dev.rxLast = 3u;
+    gl_dev.txWaitAck = false;
+    gl_dev.apduLen = 0u;
+    gl_dev.rspPending = false;
+    gl_dev.exec = false;
+    gl_dev.appOpen = false;
+}
+
+void host_optiga_object(uint16_t oid, const uint8_t *data, uint16_t len)
+{
+    optiga_object_t *obj = (optiga_object_t *)optiga_find(oid);
+
+    if (obj == NULL)
+    {
+        if (gl_dev.objCnt >= HOST_OPTIGA_OBJECTS)
+        {
+            return;
+        }
+        obj = &gl_dev.obj[gl_dev.objCnt++];
+        obj->oid = oid;
+    }
+    obj->len = (len < HOST_OPTIGA_APDU_MAX) ? len : HOST_OPTIGA_APDU_MAX;
+    memcpy(obj->data, data, obj->len);
+}
+
+/* Not a real signature: a DER shaped function of the digest. */
+void host_optiga_sign(const uint8_t *digest, uint16_t len, uint8_t *sig)
+{
+    uint16_t idx;
+
+    sig[0] = 0x30u;
+    sig[1] = HOST_OPTIGA_SIGN_LEN - 2u;
+    for (idx = 2u; idx < HOST_OPTIGA_SIGN_LEN; idx++)
+    {
+        sig[idx] = (uint8_t)(((len != 0u) ? digest[idx % len] : 0u) ^ (uint8_t)(idx * 37u));
+    }
+}
+
+void host_optiga_forget(void)
+{
+    gl_dev.ctxSaved = false;
+}
+
+void host_optiga_reset_pin(void *ctx, bool level)
+{
+    (void)ctx;
+    gl_dev.held = !level;
+    if (!level)
+    {
+        host_optiga_init(&gl_dev.cfg);
+    }
+}
+
+/* [] END OF FILE */
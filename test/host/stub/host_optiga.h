@@ -0,0 +1,150 @@
+/***************************************************************************//**
+* \file host_optiga.h
+* \version 2.0
+*
+* Host model of an OPTIGA Trust device on I2C, behind host_pal. It has the
+* IFX I2C registers, the data link frames (FCTR, LEN, payload, FCS) with their
+* ACK, NAK and sequence numbers, transport chaining, and GetDataObject,
+* CalcSign, OpenApplication and CloseApplication with a set processing time.
+* A hibernated application context is kept across resets, as in the
+* device's non-volatile memory, and restored once with its handle. Frame writes are NACKed while the
+* device processes the previous frame, I2C_STATE reports BUSY while a
+* command executes, and bits of the frames on the bus can be flipped at a
+* set rate in both directions.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef HOST_OPTIGA_H
+#define HOST_OPTIGA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "host_pal.h"
+
+/* IFX I2C registers. */
+#define HOST_OPTIGA_REG_DATA                        (0x80u)
+#define HOST_OPTIGA_REG_DATA_LEN                    (0x81u)
+#define HOST_OPTIGA_REG_STATE                       (0x82u)
+#define HOST_OPTIGA_REG_SOFT_RESET                  (0x88u)
+
+/* I2C_STATE: flags, reserved, then the ready frame length, big endian. */
+#define HOST_OPTIGA_STATE_LEN                       (4u)
+#define HOST_OPTIGA_STATE_BUSY                      (0x80u)
+#define HOST_OPTIGA_STATE_RESP_RDY                  (0x40u)
+
+/* Data link frame control: type, sequence control, frame and ACK numbers. */
+#define HOST_OPTIGA_FCTR_CONTROL                    (0x80u)
+#define HOST_OPTIGA_FCTR_SEQ_MASK                   (0x60u)
+#define HOST_OPTIGA_FCTR_SEQ_ACK                    (0x00u)
+#define HOST_OPTIGA_FCTR_SEQ_NAK                    (0x20u)
+#define HOST_OPTIGA_FCTR_SEQ_RESYNC                 (0x40u)
+#define HOST_OPTIGA_FCTR_FRNR(fctr)                 (((fctr) >> 2u) & 0x03u)
+#define HOST_OPTIGA_FCTR_ACKNR(fctr)                ((fctr) & 0x03u)
+#define HOST_OPTIGA_FCTR(frnr, acknr)               ((uint8_t)(((frnr) << 2u) | (acknr)))
+
+/* Data link header and trailer: FCTR, LEN and FCS. */
+#define HOST_OPTIGA_DL_OVERHEAD                     (5u)
+
+/* Transport chaining of the PCTR byte. */
+#define HOST_OPTIGA_PCTR_CHAIN_MASK                 (0x07u)
+#define HOST_OPTIGA_PCTR_SINGLE                     (0x00u)
+#define HOST_OPTIGA_PCTR_FIRST                      (0x01u)
+#define HOST_OPTIGA_PCTR_NEXT                       (0x02u)
+#define HOST_OPTIGA_PCTR_LAST                       (0x04u)
+
+/* Commands and responses: header of command or status, param, length. */
+#define HOST_OPTIGA_APDU_HDR                        (4u)
+#define HOST_OPTIGA_CMD_GET_DATA_OBJECT             (0x81u)
+#define HOST_OPTIGA_CMD_CALC_SIGN                   (0xB1u)
+#define HOST_OPTIGA_CMD_OPEN_APP                    (0xF0u)
+#define HOST_OPTIGA_CMD_CLOSE_APP                   (0xF1u)
+#define HOST_OPTIGA_STA_SUCCESS                     (0x00u)
+#define HOST_OPTIGA_STA_ERROR                       (0xFFu)
+
+/* OpenApplication and CloseApplication param: restore, or hibernate. */
+#define HOST_OPTIGA_APP_CLEAN                       (0x00u)
+#define HOST_OPTIGA_APP_HIBERNATE                   (0x01u)
+
+/* Application identifier sent with OpenApplication, and the hibernate context handle. */
+#define HOST_OPTIGA_AID_LEN                         (16u)
+#define HOST_OPTIGA_CONTEXT_LEN                     (8u)
+
+/* ECDSA P-256 signature, DER encoded. */
+#define HOST_OPTIGA_SIGN_LEN                        (70u)
+
+#define HOST_OPTIGA_OBJECTS                         (4u)
+#define HOST_OPTIGA_APDU_MAX                        (1024u)
+
+typedef struct
+{
+    /* Frame processing, NACKing the bus, in us: from min to max */
+    uint32_t frameMinUs;
+    uint32_t frameMaxUs;
+
+    /* GetDataObject processing in us */
+    uint32_t readUs;
+
+    /* CalcSign processing in us: from min to max */
+    uint32_t signMinUs;
+    uint32_t signMaxUs;
+
+    /* Bit errors per 10^6 bits of the frames, both directions */
+    uint32_t berPpm;
+
+    uint32_t seed;
+
+    /* OpenApplication clean and restoring, and CloseApplication processing in us */
+    uint32_t openUs;
+    uint32_t restoreUs;
+    uint32_t closeUs;
+} host_optiga_cfg_t;
+
+typedef struct
+{
+    uint32_t rxFrameCnt;
+    uint32_t txFrameCnt;
+    uint32_t fcsErrCnt;
+    uint32_t nakTxCnt;
+    uint32_t resendCnt;
+    uint32_t dupCnt;
+    uint32_t bitErrCnt;
+    uint32_t cmdCnt;
+    uint32_t busyPollCnt;
+    uint64_t execNs;
+    uint64_t readyWaitNs;
+} host_optiga_stats_t;
+
+/* CRC-16 of the data link frame check sequence. */
+uint16_t host_optiga_fcs(const uint8_t *data, uint16_t len);
+
+/* Resets the device and sets its timing and error rate. */
+void host_optiga_init(const host_optiga_cfg_t *cfg);
+
+/* Sets the contents of a data object. */
+void host_optiga_object(uint16_t oid, const uint8_t *data, uint16_t len);
+
+/* Signature CalcSign returns for a digest. */
+void host_optiga_sign(const uint8_t *digest, uint16_t len, uint8_t *sig);
+
+/*
+ * Drops the hibernated application context, as a clean open by other code
+ * would: the next restore is refused.
+ */
+void host_optiga_forget(void);
+
+/* Holds the device in reset while the pin is low. */
+void host_optiga_reset_pin(void *ctx, bool level);
+
+extern const host_pal_i2c_dev_t host_optiga_dev;
+extern host_optiga_stats_t host_optiga_stats;
+
+#endif /* HOST_OPTIGA_H */
+
+/* [] END OF FILE */
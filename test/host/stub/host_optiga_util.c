@@ -0,0 +1,321 @@
+/***************************************************************************//**
+* \file host_optiga_util.c
+* \version 2.0
+*
+* Host optiga_util and optiga_crypt for the warm OPTIGA session.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "optiga_util.h"
+#include "optiga_crypt.h"
+#include "pal_os_datastore.h"
+#include "host_ifx_i2c.h"
+#include "host_optiga.h"
+#include "host_optiga_util.h"
+#include "host_pal.h"
+
+/* CalcSign: digest tag, length, digest, key tag, length, key OID. */
+#define UTIL_SIGN_HDR                               (3u)
+#define UTIL_SIGN_KEY                               (5u)
+#define UTIL_DIGEST_MAX                             (64u)
+
+typedef enum
+{
+    UTIL_OP_NONE = 0,
+    UTIL_OP_OPEN,
+    UTIL_OP_CLOSE,
+    UTIL_OP_SIGN
+} util_op_t;
+
+typedef struct
+{
+    util_op_t op;
+    bool flag;
+    const uint8_t *digest;
+    uint8_t digestLen;
+    optiga_key_id_t key;
+    uint8_t *sig;
+    uint16_t *sigLen;
+} util_pending_t;
+
+host_optiga_util_stats_t host_optiga_util_stats;
+
+static optiga_util_t gl_util;
+static optiga_crypt_t gl_crypt;
+static util_pending_t gl_pending;
+static bool gl_linkUp;
+static uint8_t gl_rsp[HOST_OPTIGA_APDU_MAX];
+static uint16_t gl_rspLen;
+static bool gl_xferOk;
+
+/* The OPTIGA_HIBERNATE_CONTEXT_ID datastore. */
+static uint8_t gl_store[APP_CONTEXT_SIZE];
+
+static void util_tl_event(struct ifx_i2c_context *p_ctx, optiga_lib_status_t event, const uint8_t *data,
+                          uint16_t data_len)
+{
+    (void)p_ctx;
+    (void)data;
+    (void)data_len;
+    gl_xferOk = (event == IFX_I2C_STACK_SUCCESS);
+}
+
+/*
+ * Power up as ifx_i2c_open does: reset pulse, startup time, then the link.
+ * Both times are in us, as the library passes them to pal_os_event.
+ */
+static bool util_link_up(void)
+{
+    ifx_i2c_context_t *ctx = &ifx_i2c_context_0;
+
+    if (gl_linkUp)
+    {
+        return true;
+    }
+
+    host_optiga_util_stats.linkUpCnt++;
+    pal_gpio_set_low(ctx->p_slave_reset_pin);
+    host_pal_wait_us(RESET_LOW_TIME_MSEC);
+    pal_gpio_set_high(ctx->p_slave_reset_pin);
+    host_pal_wait_us(STARTUP_TIME_MSEC);
+    gl_linkUp = (ifx_i2c_tl_init(ctx, util_tl_event) == IFX_I2C_STACK_SUCCESS);
+
+    return gl_linkUp;
+}
+
+/* One command; the response data is in gl_rsp after the header. */
+static bool util_command(uint8_t *apdu, uint16_t len)
+{
+    gl_xferOk = false;
+    gl_rspLen = sizeof(gl_rsp);
+    if ((!util_link_up()) ||
+        (ifx_i2c_tl_transceive(&ifx_i2c_context_0, apdu, len, gl_rsp, &gl_rspLen) != IFX_I2C_STACK_SUCCESS))
+    {
+        return false;
+    }
+
+    return gl_xferOk && (gl_rspLen >= HOST_OPTIGA_APDU_HDR) && (gl_rsp[0] == HOST_OPTIGA_STA_SUCCESS);
+}
+
+static bool util_open(bool restore)
+{
+    uint8_t apdu[HOST_OPTIGA_APDU_HDR + HOST_OPTIGA_AID_LEN + HOST_OPTIGA_CONTEXT_LEN] =
+    {
+        HOST_OPTIGA_CMD_OPEN_APP, HOST_OPTIGA_APP_CLEAN, 0x00u, HOST_OPTIGA_AID_LEN
+    };
+    uint16_t len = HOST_OPTIGA_APDU_HDR + HOST_OPTIGA_AID_LEN;
+    uint16_t ctxLen = APP_CONTEXT_SIZE;
+
+    if (restore)
+    {
+        /* The library sends the handle the hibernate stored. */
+        if ((pal_os_datastore_read(OPTIGA_HIBERNATE_CONTEXT_ID, &apdu[len], &ctxLen) != PAL_STATUS_SUCCESS) ||
+            (ctxLen != HOST_OPTIGA_CONTEXT_LEN))
+        {
+            return false;
+        }
+        apdu[1] = HOST_OPTIGA_APP_HIBERNATE;
+        apdu[3] = HOST_OPTIGA_AID_LEN + HOST_OPTIGA_CONTEXT_LEN;
+        len += HOST_OPTIGA_CONTEXT_LEN;
+    }
+
+    return util_command(apdu, len);
+}
+
+static bool util_close(bool hibernate)
+{
+    uint8_t apdu[HOST_OPTIGA_APDU_HDR] =
+    {
+        HOST_OPTIGA_CMD_CLOSE_APP, hibernate ? HOST_OPTIGA_APP_HIBERNATE : HOST_OPTIGA_APP_CLEAN, 0x00u, 0x00u
+    };
+    bool ok = util_command(apdu, sizeof(apdu));
+
+    if (ok && hibernate)
+    {
+        ok = (gl_rspLen == (HOST_OPTIGA_APDU_HDR + HOST_OPTIGA_CONTEXT_LEN)) &&
+             (pal_os_datastore_write(OPTIGA_HIBERNATE_CONTEXT_ID, &gl_rsp[HOST_OPTIGA_APDU_HDR],
+                                     HOST_OPTIGA_CONTEXT_LEN) == PAL_STATUS_SUCCESS);
+    }
+
+    /* The OPTIGA may be powered down from here on. */
+    gl_linkUp = false;
+
+    return ok;
+}
+
+static bool util_sign(const util_pending_t *op)
+{
+    uint8_t apdu[HOST_OPTIGA_APDU_HDR + UTIL_SIGN_HDR + UTIL_DIGEST_MAX + UTIL_SIGN_KEY] =
+    {
+        HOST_OPTIGA_CMD_CALC_SIGN, 0x11u, 0x00u, 0x00u, 0x01u, 0x00u, 0x00u
+    };
+    uint16_t len = (uint16_t)(UTIL_SIGN_HDR + op->digestLen + UTIL_SIGN_KEY);
+    uint16_t sigLen;
+    uint8_t *key;
+
+    if (op->digestLen > UTIL_DIGEST_MAX)
+    {
+        return false;
+    }
+
+    key = &apdu[HOST_OPTIGA_APDU_HDR + UTIL_SIGN_HDR + op->digestLen];
+    apdu[3] = (uint8_t)len;
+    apdu[HOST_OPTIGA_APDU_HDR + 2u] = op->digestLen;
+    memcpy(&apdu[HOST_OPTIGA_APDU_HDR + UTIL_SIGN_HDR], op->digest, op->digestLen);
+    key[0] = 0x03u;
+    key[1] = 0x00u;
+    key[2] = 0x02u;
+    key[3] = (uint8_t)((uint16_t)op->key >> 8u);
+    key[4] = (uint8_t)op->key;
+
+    if (!util_command(apdu, (uint16_t)(HOST_OPTIGA_APDU_HDR + len)))
+    {
+        return false;
+    }
+
+    sigLen = (uint16_t)(gl_rspLen - HOST_OPTIGA_APDU_HDR);
+    if (sigLen > *op->sigLen)
+    {
+        return false;
+    }
+    memcpy(op->sig, &gl_rsp[HOST_OPTIGA_APDU_HDR], sigLen);
+    *op->sigLen = sigLen;
+
+    return true;
+}
+
+/* Queues an operation; one at a time, as on the single OPTIGA instance. */
+static optiga_lib_status_t util_queue(const util_pending_t *op)
+{
+    if (gl_pending.op != UTIL_OP_NONE)
+    {
+        return OPTIGA_UTIL_ERROR;
+    }
+
+    gl_pending = *op;
+
+    return OPTIGA_LIB_SUCCESS;
+}
+
+void host_optiga_util_run(void)
+{
+    util_pending_t op = gl_pending;
+    callback_handler_t handler = gl_util.handler;
+    void *ctx = gl_util.caller_context;
+    bool ok;
+
+    if (op.op == UTIL_OP_NONE)
+    {
+        return;
+    }
+
+    switch (op.op)
+    {
+        case UTIL_OP_OPEN:
+            ok = util_open(op.flag);
+            break;
+        case UTIL_OP_CLOSE:
+            ok = util_close(op.flag);
+            break;
+        default:
+            ok = util_sign(&op);
+            handler = gl_crypt.handler;
+            ctx = gl_crypt.caller_context;
+            break;
+    }
+
+    gl_pending.op = UTIL_OP_NONE;
+    host_optiga_util_stats.opCnt++;
+    if (!ok)
+    {
+        host_optiga_util_stats.opErrCnt++;
+    }
+    if (handler != NULL)
+    {
+        handler(ctx, ok ? OPTIGA_LIB_SUCCESS : OPTIGA_CMD_ERROR);
+    }
+}
+
+optiga_util_t *optiga_util_create(uint8_t optiga_instance_id, callback_handler_t handler, void *caller_context)
+{
+    (void)optiga_instance_id;
+    gl_util.handler = handler;
+    gl_util.caller_context = caller_context;
+
+    return &gl_util;
+}
+
+optiga_lib_status_t optiga_util_open_application(optiga_util_t *me, bool_t perform_restore)
+{
+    util_pending_t op = { UTIL_OP_OPEN, (perform_restore != FALSE), NULL, 0u, 0, NULL, NULL };
+
+    (void)me;
+
+    return util_queue(&op);
+}
+
+optiga_lib_status_t optiga_util_close_application(optiga_util_t *me, bool_t perform_hibernate)
+{
+    util_pending_t op = { UTIL_OP_CLOSE, (perform_hibernate != FALSE), NULL, 0u, 0, NULL, NULL };
+
+    (void)me;
+
+    return util_queue(&op);
+}
+
+optiga_crypt_t *optiga_crypt_create(uint8_t optiga_instance_id, callback_handler_t handler, void *caller_context)
+{
+    (void)optiga_instance_id;
+    gl_crypt.handler = handler;
+    gl_crypt.caller_context = caller_context;
+
+    return &gl_crypt;
+}
+
+optiga_lib_status_t optiga_crypt_ecdsa_sign(optiga_crypt_t *me, const uint8_t *digest, uint8_t digest_length,
+                                            optiga_key_id_t private_key, uint8_t *signature,
+                                            uint16_t *signature_length)
+{
+    util_pending_t op = { UTIL_OP_SIGN, false, digest, digest_length, private_key, signature, signature_length };
+
+    (void)me;
+
+    return util_queue(&op);
+}
+
+pal_status_t pal_os_datastore_read(uint16_t datastore_id, uint8_t *p_buffer, uint16_t *p_buffer_length)
+{
+    if ((datastore_id != OPTIGA_HIBERNATE_CONTEXT_ID) || (*p_buffer_length < APP_CONTEXT_SIZE))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+
+    memcpy(p_buffer, gl_store, APP_CONTEXT_SIZE);
+    *p_buffer_length = APP_CONTEXT_SIZE;
+
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_os_datastore_write(uint16_t datastore_id, const uint8_t *p_buffer, uint16_t length)
+{
+    if ((datastore_id != OPTIGA_HIBERNATE_CONTEXT_ID) || (length > APP_CONTEXT_SIZE))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+
+    memset(gl_store, 0, APP_CONTEXT_SIZE);
+    memcpy(gl_store, p_buffer, length);
+
+    return PAL_STATUS_SUCCESS;
+}
+
+/* [] END OF FILE */
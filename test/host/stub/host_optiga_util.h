@@ -0,0 +1,44 @@
+/***************************************************************************//**
+* \file host_optiga_util.h
+* \version 2.0
+*
+* Host optiga_util and optiga_crypt for the warm OPTIGA session: open and
+* close of the application, and ECDSA signing, as OpenApplication,
+* CloseApplication and CalcSign commands on the host IFX I2C master. The
+* prebuilt OPTIGA library is ARM only. Like it, a call only queues the
+* operation and its handler is raised later, here from host_optiga_util_run;
+* an open powers the link up with the reset pulse and startup time of
+* ifx_i2c_config.h, and a close powers it down. The hibernate context handle
+* is kept in a RAM pal_os_datastore.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef HOST_OPTIGA_UTIL_H
+#define HOST_OPTIGA_UTIL_H
+
+#include <stdint.h>
+
+typedef struct
+{
+    /* Link power ups, with the reset pulse and startup time */
+    uint32_t linkUpCnt;
+
+    /* Operations completed, and those that failed */
+    uint32_t opCnt;
+    uint32_t opErrCnt;
+} host_optiga_util_stats_t;
+
+extern host_optiga_util_stats_t host_optiga_util_stats;
+
+/* Runs the queued operation to completion and raises its handler. */
+void host_optiga_util_run(void);
+
+#endif /* HOST_OPTIGA_UTIL_H */
+
+/* [] END OF FILE */
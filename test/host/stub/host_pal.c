@@ -0,0 +1,329 @@
+/***************************************************************************//**
+* \file host_pal.c
+* \version 2.0
+*
+* Host OPTIGA platform abstraction on a simulated clock.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+
+#include "host_pal.h"
+
+/* One pending I2C completion and one pending os event callback. */
+#define HOST_PAL_SLOT_I2C                           (0u)
+#define HOST_PAL_SLOT_EVENT                         (1u)
+#define HOST_PAL_SLOTS                              (2u)
+
+/* Bits per byte on the bus, with the ACK. */
+#define HOST_PAL_I2C_BYTE_BITS                      (9u)
+
+typedef struct
+{
+    uint64_t due;
+    void (*cb)(void *ctx, uint16_t arg);
+    void *ctx;
+    uint16_t arg;
+    bool active;
+} host_pal_slot_t;
+
+host_pal_stats_t host_pal_stats;
+
+static host_pal_slot_t gl_slot[HOST_PAL_SLOTS];
+static const host_pal_i2c_dev_t *gl_dev;
+static uint8_t *gl_i2cData;
+static uint16_t gl_i2cLen;
+static bool gl_i2cRead;
+static uint64_t gl_now;
+static uint32_t gl_i2cKhz = HOST_PAL_I2C_KHZ;
+static pal_os_event_t gl_event;
+
+static void pal_slot_set(uint8_t slot, uint64_t due, void (*cb)(void *ctx, uint16_t arg), void *ctx, uint16_t arg)
+{
+    gl_slot[slot].due = due;
+    gl_slot[slot].cb = cb;
+    gl_slot[slot].ctx = ctx;
+    gl_slot[slot].arg = arg;
+    gl_slot[slot].active = true;
+}
+
+/* Fires the earliest callback due by limit. Returns false if there is none. */
+static bool pal_slot_fire(uint64_t limit)
+{
+    host_pal_slot_t *next = NULL;
+    uint8_t slot;
+
+    for (slot = 0u; slot < HOST_PAL_SLOTS; slot++)
+    {
+        if ((gl_slot[slot].active) && (gl_slot[slot].due <= limit) &&
+            ((next == NULL) || (gl_slot[slot].due < next->due)))
+        {
+            next = &gl_slot[slot];
+        }
+    }
+    if (next == NULL)
+    {
+        return false;
+    }
+
+    if (next->due > gl_now)
+    {
+        gl_now = next->due;
+    }
+    next->active = false;
+    next->cb(next->ctx, next->arg);
+
+    return true;
+}
+
+void host_pal_i2c_attach(const host_pal_i2c_dev_t *dev)
+{
+    gl_dev = dev;
+}
+
+uint64_t host_pal_time_ns(void)
+{
+    return gl_now;
+}
+
+void host_pal_run(volatile bool *done)
+{
+    while ((!*done) && pal_slot_fire(UINT64_MAX))
+    {
+    }
+}
+
+void host_pal_wait_us(uint32_t us)
+{
+    uint64_t end = gl_now + ((uint64_t)us * 1000u);
+
+    while (pal_slot_fire(end))
+    {
+    }
+    gl_now = end;
+}
+
+pal_status_t pal_init(void)
+{
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_deinit(void)
+{
+    return PAL_STATUS_SUCCESS;
+}
+
+static void pal_i2c_done(void *ctx, uint16_t event)
+{
+    const pal_i2c_t *i2c = (const pal_i2c_t *)ctx;
+    bool ack;
+
+    if (event == PAL_I2C_EVENT_SUCCESS)
+    {
+        ack = gl_i2cRead ? gl_dev->read(gl_dev->ctx, gl_i2cData, gl_i2cLen) :
+                           gl_dev->write(gl_dev->ctx, gl_i2cData, gl_i2cLen);
+        if (!ack)
+        {
+            host_pal_stats.nackCnt++;
+            event = PAL_I2C_EVENT_ERROR;
+        }
+    }
+
+    ((upper_layer_callback_t)i2c->upper_layer_event_handler)(i2c->p_upper_layer_ctx, event);
+}
+
+/* Bus time of the address byte and, if the device ACKed it, the data. */
+static pal_status_t pal_i2c_xfer(pal_i2c_t *p_i2c_context, uint8_t *p_data, uint16_t length, bool read)
+{
+    bool ack = gl_dev->probe(gl_dev->ctx);
+    uint32_t bytes = ack ? (1u + (uint32_t)length) : 1u;
+    uint64_t busNs = ((uint64_t)bytes * HOST_PAL_I2C_BYTE_BITS * 1000000u) / gl_i2cKhz;
+
+    host_pal_stats.byteCnt += bytes;
+    host_pal_stats.busNs += busNs;
+    if (!ack)
+    {
+        host_pal_stats.nackCnt++;
+    }
+
+    gl_i2cData = p_data;
+    gl_i2cLen = length;
+    gl_i2cRead = read;
+    pal_slot_set(HOST_PAL_SLOT_I2C, gl_now + busNs, pal_i2c_done, p_i2c_context,
+                 ack ? PAL_I2C_EVENT_SUCCESS : PAL_I2C_EVENT_ERROR);
+
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_i2c_init(const pal_i2c_t *p_i2c_context)
+{
+    (void)p_i2c_context;
+    gl_slot[HOST_PAL_SLOT_I2C].active = false;
+
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_i2c_deinit(const pal_i2c_t *p_i2c_context)
+{
+    (void)p_i2c_context;
+
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_i2c_set_bitrate(const pal_i2c_t *p_i2c_context, uint16_t bitrate)
+{
+    (void)p_i2c_context;
+    if (bitrate == 0u)
+    {
+        return PAL_STATUS_INVALID_INPUT;
+    }
+    gl_i2cKhz = bitrate;
+
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_i2c_write(pal_i2c_t *p_i2c_context, uint8_t *p_data, uint16_t length)
+{
+    if (gl_slot[HOST_PAL_SLOT_I2C].active)
+    {
+        return PAL_STATUS_I2C_BUSY;
+    }
+    host_pal_stats.writeCnt++;
+
+    return pal_i2c_xfer(p_i2c_context, p_data, length, false);
+}
+
+pal_status_t pal_i2c_read(pal_i2c_t *p_i2c_context, uint8_t *p_data, uint16_t length)
+{
+    if (gl_slot[HOST_PAL_SLOT_I2C].active)
+    {
+        return PAL_STATUS_I2C_BUSY;
+    }
+    host_pal_stats.readCnt++;
+
+    return pal_i2c_xfer(p_i2c_context, p_data, length, true);
+}
+
+static void pal_os_event_fire(void *ctx, uint16_t arg)
+{
+    pal_os_event_t *evt = (pal_os_event_t *)ctx;
+
+    (void)arg;
+    evt->is_event_triggered = TRUE;
+    evt->callback_registered(evt->callback_ctx);
+}
+
+pal_os_event_t *pal_os_event_create(register_callback callback, void *callback_args)
+{
+    if (callback != NULL)
+    {
+        pal_os_event_start(&gl_event, callback, callback_args);
+    }
+
+    return &gl_event;
+}
+
+void pal_os_event_destroy(pal_os_event_t *pal_os_event)
+{
+    pal_os_event_stop(pal_os_event);
+}
+
+void pal_os_event_register_callback_oneshot(pal_os_event_t *p_pal_os_event, register_callback callback,
+                                            void *callback_args, uint32_t time_us)
+{
+    p_pal_os_event->callback_registered = callback;
+    p_pal_os_event->callback_ctx = callback_args;
+    p_pal_os_event->is_event_triggered = FALSE;
+    pal_slot_set(HOST_PAL_SLOT_EVENT, gl_now + ((uint64_t)time_us * 1000u), pal_os_event_fire, p_pal_os_event, 0u);
+}
+
+void pal_os_event_trigger_registered_callback(void)
+{
+    if (gl_event.callback_registered != NULL)
+    {
+        gl_event.callback_registered(gl_event.callback_ctx);
+    }
+}
+
+void pal_os_event_start(pal_os_event_t *p_pal_os_event, register_callback callback, void *callback_args)
+{
+    pal_os_event_register_callback_oneshot(p_pal_os_event, callback, callback_args, 0u);
+}
+
+void pal_os_event_stop(pal_os_event_t *p_pal_os_event)
+{
+    (void)p_pal_os_event;
+    gl_slot[HOST_PAL_SLOT_EVENT].active = false;
+}
+
+uint32_t pal_os_timer_get_time_in_microseconds(void)
+{
+    return (uint32_t)(gl_now / 1000u);
+}
+
+uint32_t pal_os_timer_get_time_in_milliseconds(void)
+{
+    return (uint32_t)(gl_now / 1000000u);
+}
+
+/* Blocking: nothing runs meanwhile. */
+void pal_os_timer_delay_in_milliseconds(uint16_t milliseconds)
+{
+    gl_now += (uint64_t)milliseconds * 1000000u;
+}
+
+pal_status_t pal_timer_init(void)
+{
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_timer_deinit(void)
+{
+    return PAL_STATUS_SUCCESS;
+}
+
+static void pal_gpio_set(const pal_gpio_t *p_gpio_context, bool level)
+{
+    host_pal_gpio_t *gpio = (host_pal_gpio_t *)p_gpio_context->p_gpio_hw;
+
+    if ((gpio != NULL) && (gpio->level != level))
+    {
+        gpio->level = level;
+        if (gpio->hook != NULL)
+        {
+            gpio->hook(gpio->ctx, level);
+        }
+    }
+}
+
+void pal_gpio_set_high(const pal_gpio_t *p_gpio_context)
+{
+    pal_gpio_set(p_gpio_context, true);
+}
+
+void pal_gpio_set_low(const pal_gpio_t *p_gpio_context)
+{
+    pal_gpio_set(p_gpio_context, false);
+}
+
+pal_status_t pal_gpio_init(const pal_gpio_t *p_gpio_context)
+{
+    (void)p_gpio_context;
+
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_gpio_deinit(const pal_gpio_t *p_gpio_context)
+{
+    (void)p_gpio_context;
+
+    return PAL_STATUS_SUCCESS;
+}
+
+/* [] END OF FILE */
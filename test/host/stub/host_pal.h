@@ -0,0 +1,78 @@
+/***************************************************************************//**
+* \file host_pal.h
+* \version 2.0
+*
+* Host OPTIGA platform abstraction: pal_i2c, pal_os_event, pal_os_timer and
+* pal_gpio on a simulated clock. An I2C transfer is handed to the attached
+* device and completes after its bus time; event callbacks run from
+* host_pal_run, which advances the clock to the next due one.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef HOST_PAL_H
+#define HOST_PAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "pal_i2c.h"
+#include "pal_gpio.h"
+#include "pal_os_event.h"
+#include "pal_os_timer.h"
+
+/* I2C bus clock in kHz until pal_i2c_set_bitrate. */
+#define HOST_PAL_I2C_KHZ                            (400u)
+
+/*
+ * I2C device. probe ACKs the address at the start of a transfer; write and
+ * read run at its end, returning false to NACK the data.
+ */
+typedef struct
+{
+    bool (*probe)(void *ctx);
+    bool (*write)(void *ctx, const uint8_t *data, uint16_t len);
+    bool (*read)(void *ctx, uint8_t *data, uint16_t len);
+    void *ctx;
+} host_pal_i2c_dev_t;
+
+/* GPIO: level, and an optional hook on each change. */
+typedef struct
+{
+    bool level;
+    void (*hook)(void *ctx, bool level);
+    void *ctx;
+} host_pal_gpio_t;
+
+/* Bus counters. */
+typedef struct
+{
+    uint32_t writeCnt;
+    uint32_t readCnt;
+    uint32_t nackCnt;
+    uint64_t byteCnt;
+    uint64_t busNs;
+} host_pal_stats_t;
+
+extern host_pal_stats_t host_pal_stats;
+
+/* Attaches the device behind pal_i2c. */
+void host_pal_i2c_attach(const host_pal_i2c_dev_t *dev);
+
+/* Simulated time in ns. */
+uint64_t host_pal_time_ns(void);
+
+/* Runs due callbacks, advancing the clock, until *done or none is left. */
+void host_pal_run(volatile bool *done);
+
+/* Advances the clock by us, running the callbacks due meanwhile. */
+void host_pal_wait_us(uint32_t us);
+
+#endif /* HOST_PAL_H */
+
+/* [] END OF FILE */
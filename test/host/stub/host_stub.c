@@ -0,0 +1,67 @@
+/***************************************************************************//**
+* \file host_stub.c
+* \version 2.0
+*
+* Host stubs of prebuilt library and PDL functions the QiStack sources call.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_qistack_common.h"
+#include "cy_qistack_utils.h"
+#include "cy_scb_spi.h"
+
+/* Shift loop, as in a typical implementation of the library function. */
+bool cy_get_odd_parity(uint8_t data)
+{
+    uint8_t par = 1u;
+
+    while (data != 0u)
+    {
+        par ^= (uint8_t)(data & 0x01u);
+        data >>= 1u;
+    }
+
+    return (par != 0u);
+}
+
+/* XOR of all bytes, as in the Qi packet checksum. */
+bool cy_calc_checksum(uint8_t * buff, uint8_t size, uint8_t * checksum)
+{
+    uint8_t chk = 0u;
+    uint8_t idx;
+
+    for (idx = 0u; idx < size; idx++)
+    {
+        chk ^= buff[idx];
+    }
+    *checksum = chk;
+
+    return true;
+}
+
+/* Empty SCB RX FIFO, for tests that do not drive the FIFO handler. */
+__attribute__((weak)) uint32_t Cy_SCB_SPI_GetNumInRxFifo(CySCB_Type const *base)
+{
+    (void)base;
+    return 0u;
+}
+
+__attribute__((weak)) uint32_t Cy_SCB_SPI_Read(CySCB_Type const *base)
+{
+    (void)base;
+    return 0u;
+}
+
+__attribute__((weak)) void Cy_SCB_ClearRxInterrupt(CySCB_Type *base, uint32_t interruptMask)
+{
+    (void)base;
+    (void)interruptMask;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,108 @@
+/***************************************************************************//**
+* \file host_tcpwm.c
+* \version 2.0
+*
+* Host model of the TCPWM edge counter and inverter PWM.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cy_tcpwm_counter.h"
+#include "cy_tcpwm_pwm.h"
+#include "host_tcpwm.h"
+
+host_tcpwm_t host_tcpwm;
+
+static void host_tcpwm_swap(void)
+{
+    uint32_t period = host_tcpwm.pwmPeriod;
+
+    host_tcpwm.pwmPeriod = host_tcpwm.pwmPeriodBuf;
+    host_tcpwm.pwmPeriodBuf = period;
+}
+
+bool host_tcpwm_edge(void)
+{
+    if (!host_tcpwm.cntRunning)
+    {
+        return false;
+    }
+
+    if (host_tcpwm.cntCounter != host_tcpwm.cntPeriod)
+    {
+        host_tcpwm.cntCounter++;
+        return false;
+    }
+
+    host_tcpwm.cntCounter = 0u;
+    if (host_tcpwm.swapOnTc)
+    {
+        host_tcpwm_swap();
+    }
+
+    return true;
+}
+
+void Cy_TCPWM_Counter_SetPeriod(TCPWM_Type *base, uint32_t cntNum, uint32_t period)
+{
+    (void)base;
+    (void)cntNum;
+    host_tcpwm.cntPeriod = period;
+}
+
+void Cy_TCPWM_Counter_SetCounter(TCPWM_Type *base, uint32_t cntNum, uint32_t count)
+{
+    (void)base;
+    (void)cntNum;
+    host_tcpwm.cntCounter = count;
+}
+
+void Cy_TCPWM_TriggerStart(TCPWM_Type *base, uint32_t counters)
+{
+    (void)base;
+    (void)counters;
+    host_tcpwm.cntRunning = true;
+}
+
+void Cy_TCPWM_TriggerStopOrKill(TCPWM_Type *base, uint32_t counters)
+{
+    (void)base;
+    (void)counters;
+    host_tcpwm.cntRunning = false;
+}
+
+void Cy_TCPWM_ClearInterrupt(TCPWM_Type *base, uint32_t cntNum, uint32_t source)
+{
+    (void)base;
+    (void)cntNum;
+    (void)source;
+}
+
+void Cy_TCPWM_PWM_SetPeriod1(TCPWM_Type *base, uint32_t cntNum, uint32_t period1)
+{
+    (void)base;
+    (void)cntNum;
+    host_tcpwm.pwmPeriodBuf = period1;
+}
+
+void Cy_TCPWM_PWM_SetCompare1(TCPWM_Type *base, uint32_t cntNum, uint32_t compare1)
+{
+    (void)base;
+    (void)cntNum;
+    host_tcpwm.pwmCompareBuf = compare1;
+}
+
+/* The swap is applied at once, at the end of the current inverter cycle. */
+void Cy_TCPWM_TriggerCaptureOrSwap(TCPWM_Type *base, uint32_t counters)
+{
+    (void)base;
+    (void)counters;
+    host_tcpwm_swap();
+}
+
+/* [] END OF FILE */
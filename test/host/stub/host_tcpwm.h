@@ -0,0 +1,47 @@
+/***************************************************************************//**
+* \file host_tcpwm.h
+* \version 2.0
+*
+* Host model of the FSK hardware: the edge counter, clocked by inverter
+* edges, and the inverter PWM with its buffered period. With swapOnTc, the
+* terminal count of the edge counter swaps the PWM period with its buffer, as
+* wired for CY_QI_FSK_HW_SWAP_EN.
+*
+********************************************************************************
+* \copyright
+* Copyright 2023, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef HOST_TCPWM_H
+#define HOST_TCPWM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct
+{
+    /* Edge counter period, counter and run state */
+    uint32_t cntPeriod;
+    uint32_t cntCounter;
+    bool cntRunning;
+
+    /* Inverter PWM period in use, and the buffered one applied by a swap */
+    uint32_t pwmPeriod;
+    uint32_t pwmPeriodBuf;
+    uint32_t pwmCompareBuf;
+
+    /* Terminal count of the edge counter triggers the PWM swap */
+    bool swapOnTc;
+} host_tcpwm_t;
+
+extern host_tcpwm_t host_tcpwm;
+
+/* Clocks the edge counter by one inverter edge. Returns true on terminal count. */
+bool host_tcpwm_edge(void);
+
+#endif /* HOST_TCPWM_H */
+
+/* [] END OF FILE */